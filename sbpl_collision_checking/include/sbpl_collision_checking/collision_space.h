@@ -47,6 +47,7 @@
 // project includes
 #include <sbpl_collision_checking/allowed_collisions_interface.h>
 #include <sbpl_collision_checking/collision_model_config.h>
+#include <sbpl_collision_checking/dynamic_obstacle_model.h>
 #include <sbpl_collision_checking/robot_collision_model.h>
 #include <sbpl_collision_checking/robot_motion_collision_model.h>
 #include <sbpl_collision_checking/robot_collision_state.h>
@@ -57,7 +58,11 @@
 namespace smpl {
 namespace collision {
 
-class CollisionSpace : public CollisionChecker
+class CollisionSpace :
+    public CollisionChecker,
+    public CloneableCollisionCheckerExtension,
+    public TimedCollisionCheckerExtension,
+    public SelfCollisionCheckerExtension
 {
 public:
 
@@ -109,6 +114,17 @@ public:
     bool moveShapes(const CollisionObject* object);
     bool insertShapes(const CollisionObject* object);
     bool removeShapes(const CollisionObject* object);
+
+    void setVoxelizationCache(const VoxelizationCachePtr& cache);
+    auto voxelizationCache() const -> const VoxelizationCachePtr&;
+    ///@}
+
+    /// \name Dynamic Obstacles
+    ///@{
+    bool insertDynamicObject(
+        const CollisionObject* object,
+        const DynamicObjectTrajectory& trajectory);
+    bool removeDynamicObject(const CollisionObject* object);
     ///@}
 
     /// \name Attached Objects
@@ -143,6 +159,12 @@ public:
     auto selfCollisionModel() const -> SelfCollisionModelConstPtr
     { return m_scm; }
 
+    auto dynamicObstacleModel() -> const DynamicObstacleModelPtr&
+    { return m_dom; }
+
+    auto dynamicObstacleModel() const -> DynamicObstacleModelConstPtr
+    { return m_dom; }
+
     /// \name Visualization
     ///@{
     auto getWorldVisualization() const -> visualization_msgs::MarkerArray;
@@ -209,6 +231,49 @@ public:
         std::vector<RobotState>& path) override;
     ///@}
 
+    /// \name Required Functions from CloneableCollisionCheckerExtension
+    ///@{
+    auto clone() -> std::unique_ptr<CollisionChecker> override;
+    ///@}
+
+    /// \name Required Functions from TimedCollisionCheckerExtension
+    ///@{
+    bool hasTimedObstacles() override;
+
+    bool isStateValidAtTime(
+        const RobotState& state,
+        double time,
+        bool verbose = false) override;
+
+    bool isStateToStateValidAtTime(
+        const RobotState& start,
+        double start_time,
+        const RobotState& finish,
+        double finish_time,
+        bool verbose = false) override;
+    ///@}
+
+    /// \name Required Functions from SelfCollisionCheckerExtension
+    ///@{
+    bool isStateSelfValid(
+        const RobotState& state,
+        bool verbose = false) override;
+
+    bool isStateToStateSelfValid(
+        const RobotState& start,
+        const RobotState& finish,
+        bool verbose = false) override;
+
+    bool isStateWorldValid(
+        const RobotState& state,
+        bool verbose = false) override;
+
+    bool isStateToStateWorldValid(
+        const RobotState& start,
+        const RobotState& finish,
+        bool verbose = false) override;
+    ///@}
+
     /// \name Reimplemented Functions from CollisionChecker
     ///@{
     auto getCollisionModelVisualization(const RobotState& vals)
@@ -231,6 +296,9 @@ public:
 
     WorldCollisionModelPtr          m_wcm;
     SelfCollisionModelPtr           m_scm;
+    DynamicObstacleModelPtr         m_dom;
+
+    std::vector<const CollisionSphereState*> m_dynamic_q;
 
     // Collision Group
     std::string                     m_group_name;
@@ -257,6 +325,14 @@ public:
     void copyState();
 
     bool withinJointPositionLimits(const std::vector<double>& positions) const;
+
+    bool isMotionValid(
+        const RobotState& start,
+        const RobotState& finish,
+        bool (CollisionSpace::*is_state_valid)(const RobotState&, bool),
+        bool verbose);
+
+    bool checkDynamicObstacleCollisions(const OccupancyGrid& grid);
 };
 
 typedef std::shared_ptr<CollisionSpace> CollisionSpacePtr;
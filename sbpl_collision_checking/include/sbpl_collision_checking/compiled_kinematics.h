@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SBPL_COLLISION_CHECKING_COMPILED_KINEMATICS_H
+#define SBPL_COLLISION_CHECKING_COMPILED_KINEMATICS_H
+
+// standard includes
+#include <memory>
+#include <ostream>
+#include <string>
+
+// system includes
+#include <Eigen/Dense>
+
+namespace smpl {
+namespace collision {
+
+class RobotCollisionModel;
+
+/// Forward kinematics routine specialized for a single RobotCollisionModel.
+///
+/// Implementations are generated offline from a RobotCollisionModel by
+/// WriteCompiledKinematicsSource (see the generate_fk node), compiled into a
+/// shared library, and loaded at runtime with LoadCompiledKinematics. The
+/// generated routine unrolls the kinematic tree, folds chains of fixed joints
+/// into constant transforms, and expands each joint transform into scalar
+/// expressions in the sine and cosine (or displacement) of its variable with
+/// the constant zero terms removed.
+class CompiledKinematics
+{
+public:
+
+    virtual ~CompiledKinematics() { }
+
+    /// \name Model Description
+    /// Used to verify that the routine was generated for a given model.
+    ///@{
+    virtual auto modelName() const -> const char* = 0;
+    virtual int linkCount() const = 0;
+    virtual auto linkName(int lidx) const -> const char* = 0;
+    virtual int jointVarCount() const = 0;
+    virtual auto jointVarName(int vidx) const -> const char* = 0;
+    ///@}
+
+    /// \brief Compute the transforms of all links in the model
+    ///
+    /// \param jvals The positions of all joint variables, in model order
+    /// \param transforms The link transforms, in model order. The transform of
+    ///     the root link, which is determined by the world joint, is read from
+    ///     transforms[0]; the transforms of all other links are overwritten.
+    virtual void computeLinkTransforms(
+        const double* jvals,
+        Eigen::Affine3d* transforms) const = 0;
+};
+
+/// Name of the factory function exported by generated kinematics libraries
+#define SBPL_COLLISION_COMPILED_KINEMATICS_FACTORY "sbpl_collision_create_compiled_kinematics"
+
+using CompiledKinematicsPtr = std::shared_ptr<CompiledKinematics>;
+using CompiledKinematicsConstPtr = std::shared_ptr<const CompiledKinematics>;
+
+/// \brief Load compiled kinematics from a shared library
+///
+/// The library is unloaded when the last reference to the returned object is
+/// released.
+auto LoadCompiledKinematics(const std::string& path) -> CompiledKinematicsPtr;
+
+/// \brief Return whether the routine was generated for a model with the same
+///     links and joint variables as \p model
+bool IsCompatible(
+    const CompiledKinematics& kinematics,
+    const RobotCollisionModel& model);
+
+/// \brief Write C++ source for a CompiledKinematics implementation for
+///     \p model
+bool WriteCompiledKinematicsSource(
+    const RobotCollisionModel& model,
+    std::ostream& o);
+
+} // namespace collision
+} // namespace smpl
+
+#endif
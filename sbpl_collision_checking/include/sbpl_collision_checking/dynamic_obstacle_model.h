@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SBPL_COLLISION_CHECKING_DYNAMIC_OBSTACLE_MODEL_H
+#define SBPL_COLLISION_CHECKING_DYNAMIC_OBSTACLE_MODEL_H
+
+// standard includes
+#include <memory>
+#include <vector>
+
+// system includes
+#include <Eigen/Dense>
+#include <smpl/occupancy_grid.h>
+
+// project includes
+#include <sbpl_collision_checking/types.h>
+#include <sbpl_collision_checking/voxelization_cache.h>
+
+namespace smpl {
+namespace collision {
+
+struct CollisionObject;
+
+/// Known motion of a collision object, as a sequence of timed keyframes. Each
+/// keyframe pose is applied to the object's shapes, so an identity pose leaves
+/// the object where its shape poses place it. Poses are interpolated between
+/// keyframes and held at the first and last keyframes outside of them. If the
+/// trajectory is periodic, the motion repeats every duration() seconds.
+struct DynamicObjectTrajectory
+{
+    std::vector<double> times;
+    Affine3dVector poses;
+    bool periodic = false;
+
+    double duration() const { return times.empty() ? 0.0 : times.back(); }
+
+    auto pose(double time) const -> Eigen::Affine3d;
+};
+
+auto MakeLinearTrajectory(
+    const Eigen::Affine3d& start,
+    const Eigen::Vector3d& velocity,
+    double duration,
+    bool periodic = false)
+    -> DynamicObjectTrajectory;
+
+class DynamicObstacleModel
+{
+public:
+
+    DynamicObstacleModel(const OccupancyGrid* grid);
+
+    auto grid() const -> const OccupancyGrid* { return m_grid; }
+
+    double timeResolution() const { return m_time_res; }
+    void setTimeResolution(double res);
+
+    double timeHorizon() const { return m_time_horizon; }
+    void setTimeHorizon(double horizon);
+
+    bool insertObject(
+        const CollisionObject* object,
+        const DynamicObjectTrajectory& trajectory);
+    bool removeObject(const CollisionObject* object);
+    bool hasObject(const CollisionObject* object) const;
+    void removeAllObjects();
+
+    bool empty() const { return m_object_models.empty(); }
+
+    /// Return the number of time buckets, including the final bucket for all
+    /// times past the horizon.
+    int bucketCount() const { return (int)m_buckets.size(); }
+    int bucketIndex(double time) const;
+
+    /// Return whether queries for times past the horizon wrap around to the
+    /// start of the horizon.
+    bool cyclic() const { return m_cyclic; }
+
+    auto bucketGrid(int bidx) const -> const OccupancyGrid*;
+
+    /// Return the grid of cells swept by the objects during the time bucket
+    /// that contains the given time.
+    auto bucketGrid(double time) const -> const OccupancyGrid*
+    { return bucketGrid(bucketIndex(time)); }
+
+private:
+
+    const OccupancyGrid* m_grid;
+
+    double m_time_res;
+    double m_time_horizon;
+
+    struct DynamicObjectModel
+    {
+        const CollisionObject* object;
+        DynamicObjectTrajectory trajectory;
+    };
+    std::vector<DynamicObjectModel> m_object_models;
+
+    // one grid, backed by a sparse distance map, per time bucket, containing
+    // the cells swept by all objects during that bucket
+    std::vector<std::unique_ptr<OccupancyGrid>> m_buckets;
+    bool m_cyclic = false;
+
+    VoxelizationCache m_voxelization_cache;
+
+    bool isCyclic() const;
+    int horizonBucketCount() const;
+    void rebuildBuckets();
+    bool sweepObject(const DynamicObjectModel& model);
+    bool sweepInterval(
+        const DynamicObjectModel& model,
+        double radius,
+        double t0,
+        double t1,
+        std::vector<Eigen::Vector3d>& voxels);
+    bool voxelizeObject(
+        const CollisionObject& object,
+        const Eigen::Affine3d& pose,
+        std::vector<Eigen::Vector3d>& voxels);
+};
+
+typedef std::shared_ptr<DynamicObstacleModel> DynamicObstacleModelPtr;
+typedef std::shared_ptr<const DynamicObstacleModel> DynamicObstacleModelConstPtr;
+
+} // namespace collision
+} // namespace smpl
+
+#endif
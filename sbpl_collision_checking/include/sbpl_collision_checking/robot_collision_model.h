@@ -47,6 +47,7 @@
 // project includes
 #include <sbpl_collision_checking/base_collision_models.h>
 #include <sbpl_collision_checking/collision_model_config.h>
+#include <sbpl_collision_checking/compiled_kinematics.h>
 #include <sbpl_collision_checking/debug.h>
 #include <sbpl_collision_checking/shapes.h>
 #include <sbpl_collision_checking/types.h>
@@ -154,6 +155,18 @@ public:
     auto   linkChildJointIndices(int lidx) const -> const std::vector<int>&;
     ///@}
 
+    /// \name Robot Model - Compiled Kinematics
+    ///@{
+
+    /// \brief Use a forward kinematics routine generated for this model to
+    ///     compute link transforms in place of the generic per-joint
+    ///     transform functions
+    /// \return false if the routine was generated for a different model, in
+    ///     which case it is not used
+    bool setCompiledKinematics(const CompiledKinematicsConstPtr& kinematics);
+    auto compiledKinematics() const -> const CompiledKinematics*;
+    ///@}
+
     /// \name Collision Model
     ///@{
     size_t sphereModelCount() const;
@@ -217,6 +230,8 @@ private:
     std::vector<int>                        m_link_parent_joints;
     std::vector<std::vector<int>>           m_link_children_joints;
     hash_map<std::string, int>              m_link_name_to_index;
+
+    CompiledKinematicsConstPtr              m_compiled_kinematics;
     ///@}
 
     /// \name Collision Model
@@ -560,6 +575,13 @@ const std::vector<int>& RobotCollisionModel::linkChildJointIndices(
     return m_link_children_joints[lidx];
 }
 
+inline
+auto RobotCollisionModel::compiledKinematics() const
+    -> const CompiledKinematics*
+{
+    return m_compiled_kinematics.get();
+}
+
 inline
 size_t RobotCollisionModel::sphereModelCount() const
 {
@@ -168,6 +168,10 @@ private:
     void initRobotState();
     void initCollisionState();
 
+    // update all link transforms at once using the model's compiled
+    // kinematics
+    void updateCompiledLinkTransforms(const CompiledKinematics& kinematics);
+
     bool checkCollisionStateReferences() const;
 };
 
@@ -381,6 +385,11 @@ inline bool RobotCollisionState::updateLinkTransform(int lidx)
         return false;
     }
 
+    if (auto* kinematics = m_model->compiledKinematics()) {
+        updateCompiledLinkTransforms(*kinematics);
+        return true;
+    }
+
     int pjidx = m_model->linkParentJointIndex(lidx);
     int plidx = m_model->jointParentLinkIndex(pjidx);
 
@@ -468,13 +477,14 @@ inline bool RobotCollisionState::updateVoxelsState(int vsidx)
 
     const Eigen::Affine3d& T_model_link = m_link_transforms[lidx];
 
-    // transform voxels into the model frame
-    std::vector<Eigen::Vector3d> new_voxels(state.model->voxels.size());
-    for (size_t i = 0; i < state.model->voxels.size(); ++i) {
-        new_voxels[i] = T_model_link * state.model->voxels[i];
+    // transform voxels into the model frame, in place; the state's buffer is
+    // sized to the model's voxels on the first update and reused thereafter
+    const auto& model_voxels = state.model->voxels;
+    state.voxels.resize(model_voxels.size());
+    for (size_t i = 0; i < model_voxels.size(); ++i) {
+        state.voxels[i] = T_model_link * model_voxels[i];
     }
 
-    state.voxels = std::move(new_voxels);
     m_dirty_voxels_states[vsidx] = false;
     return true;
 }
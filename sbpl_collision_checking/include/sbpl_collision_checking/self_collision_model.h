@@ -64,8 +64,12 @@ public:
         const RobotCollisionModel* rcm,
         const AttachedBodiesCollisionModel* ab_model);
 
+    SelfCollisionModel(const SelfCollisionModel& o);
+
     ~SelfCollisionModel();
 
+    SelfCollisionModel& operator=(const SelfCollisionModel&) = delete;
+
     const AllowedCollisionMatrix& allowedCollisionMatrix() const;
     void updateAllowedCollisionMatrix(const AllowedCollisionMatrix& acm);
     void setAllowedCollisionMatrix(const AllowedCollisionMatrix& acm);
@@ -74,6 +78,11 @@ public:
 
     void setWorldToModelTransform(const Eigen::Affine3d& transform);
 
+    bool updateOccupancyGrid(
+        const RobotCollisionState& state,
+        const AttachedBodiesCollisionState& ab_state,
+        const int gidx);
+
     bool checkCollision(
         const RobotCollisionState& state,
         const AttachedBodiesCollisionState& ab_state,
@@ -87,6 +96,24 @@ public:
         const int gidx,
         double& dist);
 
+    /// Check the group for collisions with the environment, which includes the
+    /// links outside the group, and check attached bodies for all collisions.
+    /// Together with checkSelfCollision(), makes the same checks as
+    /// checkCollision().
+    bool checkWorldCollision(
+        const RobotCollisionState& state,
+        const AttachedBodiesCollisionState& ab_state,
+        const int gidx,
+        double& dist);
+
+    /// Check for collisions between pairs of links within the group that are
+    /// not allowed to collide.
+    bool checkSelfCollision(
+        const RobotCollisionState& state,
+        const AttachedBodiesCollisionState& ab_state,
+        const int gidx,
+        double& dist);
+
     bool checkMotionCollision(
         RobotCollisionState& state,
         AttachedBodiesCollisionState& ab_state,
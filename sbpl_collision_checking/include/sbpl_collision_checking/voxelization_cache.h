@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SBPL_COLLISION_CHECKING_VOXELIZATION_CACHE_H
+#define SBPL_COLLISION_CHECKING_VOXELIZATION_CACHE_H
+
+// standard includes
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// system includes
+#include <Eigen/Dense>
+
+// project includes
+#include <sbpl_collision_checking/shapes.h>
+
+namespace smpl {
+namespace collision {
+
+/// Cache of shape voxelizations, keyed by the contents of the shape and the
+/// voxel resolution.
+///
+/// Each shape is voxelized once, in its own frame, the first time it is
+/// requested. Subsequent requests for shapes with the same contents, at any
+/// pose, transform the cached voxels into the grid instead of rasterizing the
+/// shape again. Each cached voxel is treated as a cube, and every grid cell
+/// overlapped by the axis-aligned bounds of the transformed cube is occupied,
+/// so the result is conservative with respect to the cached voxelization. The
+/// cost is that surfaces at poses that are not aligned with the grid may be up
+/// to one cell thicker than a direct voxelization, and may differ from it in
+/// cells that lie near, but do not touch, the cached voxels.
+///
+/// Planes, which depend on the grid bounds, and octrees, which are already
+/// voxelized, are not cached.
+///
+/// The cache may be shared between collision models and used from multiple
+/// threads.
+class VoxelizationCache
+{
+public:
+
+    bool voxelizeShape(
+        const CollisionShape& shape,
+        const Eigen::Affine3d& pose,
+        double res,
+        const Eigen::Vector3d& go,
+        std::vector<Eigen::Vector3d>& voxels);
+
+    static bool IsCacheable(const CollisionShape& shape);
+
+    size_t size() const;
+    size_t hitCount() const;
+    size_t missCount() const;
+
+    void clear();
+
+private:
+
+    struct Key
+    {
+        // the type and dimensions of the shape, or its vertices and triangles
+        std::string shape;
+        double res;
+
+        bool operator==(const Key& o) const {
+            return res == o.res && shape == o.shape;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    // occupied voxel centers in the frame of the shape
+    using VoxelList = std::vector<Eigen::Vector3d>;
+    using VoxelListConstPtr = std::shared_ptr<const VoxelList>;
+
+    // guards the entries and statistics; entries are shared so that they
+    // outlive a concurrent clear()
+    mutable std::mutex m_mutex;
+
+    std::unordered_map<Key, VoxelListConstPtr, KeyHash> m_entries;
+
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+
+    auto getShapeVoxels(const CollisionShape& shape, double res)
+        -> VoxelListConstPtr;
+};
+
+using VoxelizationCachePtr = std::shared_ptr<VoxelizationCache>;
+
+} // namespace collision
+} // namespace smpl
+
+#endif
@@ -33,6 +33,7 @@
 #define SBPL_COLLISION_WORLD_COLLISION_DETECTOR_H
 
 // standard includes
+#include <utility>
 #include <vector>
 
 // system includes
@@ -85,6 +86,23 @@ public:
         const int gidx,
         double& dist) const;
 
+    bool checkSweptMotionCollision(
+        RobotCollisionState& state,
+        const RobotMotionCollisionModel& rmcm,
+        const std::vector<double>& start,
+        const std::vector<double>& finish,
+        const int gidx,
+        double& dist) const;
+
+    bool checkSweptMotionCollision(
+        RobotCollisionState& state,
+        AttachedBodiesCollisionState& ab_state,
+        const RobotMotionCollisionModel& rmcm,
+        const std::vector<double>& start,
+        const std::vector<double>& finish,
+        const int gidx,
+        double& dist) const;
+
 private:
 
     const RobotCollisionModel* m_rcm;
@@ -92,14 +110,19 @@ private:
 
     mutable std::vector<const CollisionSphereState*> m_vq;
 
+    // intervals of waypoints remaining to be checked during swept checks
+    mutable std::vector<std::pair<int, int>> m_sweep_q;
+
     bool checkRobotSpheresStateCollisions(
         RobotCollisionState& state,
         int gidx,
+        double padding,
         double& dist) const;
 
     bool checkAttachedBodySpheresStateCollisions(
         AttachedBodiesCollisionState& state,
         int gidx,
+        double padding,
         double& dist) const;
 };
 
@@ -42,6 +42,9 @@
 #include <smpl/occupancy_grid.h>
 #include <visualization_msgs/MarkerArray.h>
 
+// project includes
+#include <sbpl_collision_checking/voxelization_cache.h>
+
 namespace smpl {
 namespace collision {
 
@@ -77,6 +80,15 @@ public:
     void setPadding(double padding) { m_padding = padding; }
     double padding() const { return m_padding; }
 
+    /// Use a cache of shape voxelizations, which may be shared between world
+    /// collision models, when objects are inserted. Pass null to voxelize
+    /// every shape directly.
+    void setVoxelizationCache(const VoxelizationCachePtr& cache)
+    { m_voxelization_cache = cache; }
+
+    auto voxelizationCache() const -> const VoxelizationCachePtr&
+    { return m_voxelization_cache; }
+
 private:
 
     OccupancyGrid* m_grid;
@@ -93,6 +105,14 @@ private:
 
     double m_padding;
 
+    VoxelizationCachePtr m_voxelization_cache;
+
+    bool voxelizeObject(
+        const CollisionObject& object,
+        std::vector<VoxelList>& all_voxels);
+
+    bool updateObject(const CollisionObject* object);
+
     ////////////////////
     // Generic Shapes //
     ////////////////////
@@ -101,6 +121,8 @@ private:
 
     auto getObjectCollisionModel(const CollisionObject* object) const
         -> const ObjectCollisionModel*;
+    auto getObjectCollisionModel(const CollisionObject* object)
+        -> ObjectCollisionModel*;
 
     bool checkObjectInsert(const CollisionObject* object) const;
     bool checkObjectRemove(const CollisionObject* object) const;
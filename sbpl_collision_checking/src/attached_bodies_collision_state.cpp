@@ -68,13 +68,13 @@ bool AttachedBodiesCollisionState::updateVoxelsState(int vsidx)
 
     const Eigen::Affine3d& T_model_body = attachedBodyTransform(bidx);
 
-    // transform voxels into the model frame
-    std::vector<Eigen::Vector3d> new_voxels(state.model->voxels.size());
-    for (size_t i = 0; i < state.model->voxels.size(); ++i) {
-        new_voxels[i] = T_model_body * state.model->voxels[i];
+    // transform voxels into the model frame, in place
+    const auto& model_voxels = state.model->voxels;
+    state.voxels.resize(model_voxels.size());
+    for (size_t i = 0; i < model_voxels.size(); ++i) {
+        state.voxels[i] = T_model_body * model_voxels[i];
     }
 
-    state.voxels = std::move(new_voxels);
     m_voxels_state_versions[vsidx] = attachedBodyTransformVersion(bidx);
     return true;
 }
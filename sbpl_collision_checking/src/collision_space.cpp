@@ -50,6 +50,7 @@
 
 // project includes
 #include <sbpl_collision_checking/shapes.h>
+#include "collision_operations.h"
 
 namespace smpl {
 namespace collision {
@@ -139,6 +140,22 @@ void CollisionSpace::setAllowedCollisionMatrix(
     m_scm->setAllowedCollisionMatrix(acm);
 }
 
+/// \brief Set the cache of shape voxelizations used when objects are inserted
+///     into the world
+///
+/// The cache may be shared with other collision spaces. Objects already in the
+/// world are not voxelized again. Pass null to voxelize every shape directly.
+void CollisionSpace::setVoxelizationCache(const VoxelizationCachePtr& cache)
+{
+    m_wcm->setVoxelizationCache(cache);
+}
+
+/// \brief Return the cache of shape voxelizations, which may be null
+auto CollisionSpace::voxelizationCache() const -> const VoxelizationCachePtr&
+{
+    return m_wcm->voxelizationCache();
+}
+
 /// \brief Insert an object into the world
 /// \param object The object
 /// \return true if the object was inserted; false otherwise
@@ -191,6 +208,35 @@ bool CollisionSpace::removeShapes(const CollisionObject* object)
     return m_wcm->removeShapes(object);
 }
 
+/// \brief Insert an object with known motion into the world
+/// \param object The object
+/// \param trajectory The motion of the object, from the start of the plan
+/// \return true if the object was inserted; false otherwise
+bool CollisionSpace::insertDynamicObject(
+    const CollisionObject* object,
+    const DynamicObjectTrajectory& trajectory)
+{
+    if (!m_dom->insertObject(object, trajectory)) {
+        ROS_WARN_NAMED(LOG, "Reject insertion of dynamic object '%s'. Failed to add to dynamic obstacle model.", object->id.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/// \brief Remove an object with known motion from the world
+/// \param object The object
+/// \return true if the object was removed; false otherwise
+bool CollisionSpace::removeDynamicObject(const CollisionObject* object)
+{
+    if (!m_dom->removeObject(object)) {
+        ROS_WARN_NAMED(LOG, "Reject removal of dynamic object '%s'. Failed to remove from dynamic obstacle model.", object->id.c_str());
+        return false;
+    }
+
+    return true;
+}
+
 /// \brief Attach a collision object to the robot
 /// \param id The name of the object
 /// \param shapes The shapes composing the object
@@ -394,7 +440,11 @@ bool CollisionSpace::collisionDetails(
 
 Extension* CollisionSpace::getExtension(size_t class_code)
 {
-    if (class_code == GetClassCode<CollisionChecker>()) {
+    if (class_code == GetClassCode<CollisionChecker>() ||
+        class_code == GetClassCode<CloneableCollisionCheckerExtension>() ||
+        class_code == GetClassCode<TimedCollisionCheckerExtension>() ||
+        class_code == GetClassCode<SelfCollisionCheckerExtension>())
+    {
         return this;
     }
     return nullptr;
@@ -410,6 +460,17 @@ bool CollisionSpace::isStateToStateValid(
     const RobotState& start,
     const RobotState& finish,
     bool verbose)
+{
+    return isMotionValid(start, finish, &CollisionSpace::isStateValid, verbose);
+}
+
+/// Check the states interpolated along a motion with one of the state validity
+/// checks.
+bool CollisionSpace::isMotionValid(
+    const RobotState& start,
+    const RobotState& finish,
+    bool (CollisionSpace::*is_state_valid)(const RobotState&, bool),
+    bool verbose)
 {
     const double res = 0.05;
 
@@ -436,7 +497,7 @@ bool CollisionSpace::isStateToStateValid(
         for (int i = 0; i < inc_cc; i++) {
             for (size_t j = i; j < interp.waypointCount(); j = j + inc_cc) {
                 interp.interpolate(j, interm, m_planning_joint_to_collision_model_indices);
-                if (!isStateValid(interm, verbose)) {
+                if (!(this->*is_state_valid)(interm, verbose)) {
                     return false;
                 }
             }
@@ -444,7 +505,7 @@ bool CollisionSpace::isStateToStateValid(
     } else {
         for (size_t i = 0; i < interp.waypointCount(); i++) {
             interp.interpolate(i, interm, m_planning_joint_to_collision_model_indices);
-            if (!isStateValid(interm, verbose)) {
+            if (!(this->*is_state_valid)(interm, verbose)) {
                 return false;
             }
         }
@@ -453,6 +514,98 @@ bool CollisionSpace::isStateToStateValid(
     return true;
 }
 
+bool CollisionSpace::isStateSelfValid(const RobotState& state, bool verbose)
+{
+    updateState(state);
+    double dist = std::numeric_limits<double>::max();
+    return m_scm->checkSelfCollision(*m_rcs, *m_abcs, m_gidx, dist);
+}
+
+bool CollisionSpace::isStateToStateSelfValid(
+    const RobotState& start,
+    const RobotState& finish,
+    bool verbose)
+{
+    return isMotionValid(start, finish, &CollisionSpace::isStateSelfValid, verbose);
+}
+
+bool CollisionSpace::isStateWorldValid(const RobotState& state, bool verbose)
+{
+    updateState(state);
+    double dist = std::numeric_limits<double>::max();
+    return m_scm->checkWorldCollision(*m_rcs, *m_abcs, m_gidx, dist);
+}
+
+bool CollisionSpace::isStateToStateWorldValid(
+    const RobotState& start,
+    const RobotState& finish,
+    bool verbose)
+{
+    return isMotionValid(start, finish, &CollisionSpace::isStateWorldValid, verbose);
+}
+
+bool CollisionSpace::hasTimedObstacles()
+{
+    return !m_dom->empty();
+}
+
+/// Check a state against the static world, then check the group's spheres
+/// against the cells swept by dynamic obstacles during the time bucket that
+/// contains the given time.
+bool CollisionSpace::isStateValidAtTime(
+    const RobotState& state,
+    double time,
+    bool verbose)
+{
+    if (!isStateValid(state, verbose)) {
+        return false;
+    }
+
+    auto* grid = m_dom->bucketGrid(time);
+    if (!grid) {
+        return true;
+    }
+
+    // the robot state has been updated by the static check
+    return checkDynamicObstacleCollisions(*grid);
+}
+
+bool CollisionSpace::isStateToStateValidAtTime(
+    const RobotState& start,
+    double start_time,
+    const RobotState& finish,
+    double finish_time,
+    bool verbose)
+{
+    if (m_dom->empty()) {
+        return isStateToStateValid(start, finish, verbose);
+    }
+
+    const double res = 0.05;
+
+    MotionInterpolation interp(m_rcm.get());
+
+    m_rmcm->fillMotionInterpolation(
+            start,
+            finish,
+            m_planning_joint_to_collision_model_indices,
+            res,
+            interp);
+
+    RobotState interm;
+    const int count = interp.waypointCount();
+    for (int i = 0; i < count; ++i) {
+        const double alpha = count > 1 ? (double)i / (double)(count - 1) : 0.0;
+        const double time = start_time + alpha * (finish_time - start_time);
+        interp.interpolate(i, interm, m_planning_joint_to_collision_model_indices);
+        if (!isStateValidAtTime(interm, time, verbose)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool CollisionSpace::interpolatePath(
     const RobotState& start,
     const RobotState& finish,
@@ -487,6 +640,47 @@ bool CollisionSpace::interpolatePath(
     return true;
 }
 
+/// \brief Create a collision space for use by another thread
+///
+/// The clone shares the occupancy grid, the robot collision model, the world
+/// collision model, and the attached bodies model with this collision space,
+/// and holds its own copy of the robot state, the allowed collision matrix, and
+/// the scratch storage used during collision checks. The clone is positioned
+/// at the current state of this collision space.
+///
+/// The occupancy grid is first brought up to date with the voxels models
+/// outside the planning group, so that queries made to the clone only read
+/// from the shared grid. This collision space must not be modified while any of
+/// its clones are in use.
+auto CollisionSpace::clone() -> std::unique_ptr<CollisionChecker>
+{
+    copyState();
+    if (!m_scm->updateOccupancyGrid(*m_rcs, *m_abcs, m_gidx)) {
+        ROS_ERROR_NAMED(LOG, "Failed to prepare occupancy grid for cloning");
+        return std::unique_ptr<CollisionChecker>();
+    }
+
+    std::unique_ptr<CollisionSpace> cspace(new CollisionSpace);
+    cspace->m_grid = m_grid;
+    cspace->m_planning_variables = m_planning_variables;
+    cspace->m_rcm = m_rcm;
+    cspace->m_abcm = m_abcm;
+    cspace->m_rmcm = m_rmcm;
+    cspace->m_rcs = std::make_shared<RobotCollisionState>(m_rcm.get());
+    cspace->m_abcs = std::make_shared<AttachedBodiesCollisionState>(
+            m_abcm.get(), cspace->m_rcs.get());
+    cspace->m_joint_vars = m_joint_vars;
+    cspace->m_wcm = m_wcm;
+    cspace->m_scm = std::make_shared<SelfCollisionModel>(*m_scm);
+    cspace->m_dom = m_dom;
+    cspace->m_group_name = m_group_name;
+    cspace->m_gidx = m_gidx;
+    cspace->m_planning_joint_to_collision_model_indices =
+            m_planning_joint_to_collision_model_indices;
+    cspace->copyState();
+    return std::move(cspace);
+}
+
 auto CollisionSpace::getCollisionModelVisualization(const RobotState& state)
     -> std::vector<visual::Marker>
 {
@@ -592,6 +786,7 @@ bool CollisionSpace::init(
     m_abcs = std::make_shared<AttachedBodiesCollisionState>(m_abcm.get(), m_rcs.get());
     m_wcm = std::make_shared<WorldCollisionModel>(m_grid);
     m_scm = std::make_shared<SelfCollisionModel>(m_grid, m_rcm.get(), m_abcm.get());
+    m_dom = std::make_shared<DynamicObstacleModel>(m_grid);
 
     m_joint_vars.assign(
         m_rcs->getJointVarPositions(),
@@ -635,6 +830,29 @@ void CollisionSpace::copyState()
     m_rcs->setJointVarPositions(m_joint_vars.data());
 }
 
+/// Check the spheres of the planning group, and of the bodies attached to it,
+/// against the cells occupied in a grid of dynamic obstacles.
+bool CollisionSpace::checkDynamicObstacleCollisions(const OccupancyGrid& grid)
+{
+    const double padding = m_wcm->padding();
+    double dist;
+
+    auto& q = m_dynamic_q;
+    q.clear();
+    for (const int ssidx : m_rcs->groupSpheresStateIndices(m_gidx)) {
+        q.push_back(m_rcs->spheresState(ssidx).spheres.root());
+    }
+    if (!CheckVoxelsCollisions(*m_rcs, q, grid, padding, dist)) {
+        return false;
+    }
+
+    q.clear();
+    for (const int ssidx : m_abcs->groupSpheresStateIndices(m_gidx)) {
+        q.push_back(m_abcs->spheresState(ssidx).spheres.root());
+    }
+    return CheckVoxelsCollisions(*m_abcs, q, grid, padding, dist);
+}
+
 /// \brief Check whether the planning joint variables are within limits
 /// \return true if all variables are within limits; false otherwise
 bool CollisionSpace::withinJointPositionLimits(
@@ -0,0 +1,455 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <sbpl_collision_checking/compiled_kinematics.h>
+
+// standard includes
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+
+// system includes
+#include <dlfcn.h>
+#include <ros/console.h>
+
+// project includes
+#include <sbpl_collision_checking/robot_collision_model.h>
+
+namespace smpl {
+namespace collision {
+
+static const char* LOG = "compiled_kinematics";
+
+auto LoadCompiledKinematics(const std::string& path) -> CompiledKinematicsPtr
+{
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        ROS_ERROR_NAMED(LOG, "Failed to load compiled kinematics library '%s': %s", path.c_str(), dlerror());
+        return nullptr;
+    }
+
+    using FactoryFunction = CompiledKinematics* (*)();
+    auto create = reinterpret_cast<FactoryFunction>(
+            dlsym(handle, SBPL_COLLISION_COMPILED_KINEMATICS_FACTORY));
+    if (!create) {
+        ROS_ERROR_NAMED(LOG, "Library '%s' does not export '%s'", path.c_str(), SBPL_COLLISION_COMPILED_KINEMATICS_FACTORY);
+        dlclose(handle);
+        return nullptr;
+    }
+
+    CompiledKinematics* kinematics = create();
+    if (!kinematics) {
+        ROS_ERROR_NAMED(LOG, "Library '%s' failed to create compiled kinematics", path.c_str());
+        dlclose(handle);
+        return nullptr;
+    }
+
+    ROS_INFO_NAMED(LOG, "Loaded compiled kinematics for robot '%s' from '%s'", kinematics->modelName(), path.c_str());
+
+    // the object's code lives in the library, so it must be destroyed before
+    // the library is unloaded
+    return CompiledKinematicsPtr(kinematics, [handle](CompiledKinematics* k)
+    {
+        delete k;
+        dlclose(handle);
+    });
+}
+
+bool IsCompatible(
+    const CompiledKinematics& kinematics,
+    const RobotCollisionModel& model)
+{
+    if (model.name() != kinematics.modelName()) {
+        ROS_WARN_NAMED(LOG, "Compiled kinematics were generated for robot '%s', not '%s'", kinematics.modelName(), model.name().c_str());
+        return false;
+    }
+
+    if (kinematics.linkCount() != (int)model.linkCount() ||
+        kinematics.jointVarCount() != (int)model.jointVarCount())
+    {
+        ROS_WARN_NAMED(LOG, "Compiled kinematics have %d links and %d variables, model has %zu links and %zu variables", kinematics.linkCount(), kinematics.jointVarCount(), model.linkCount(), model.jointVarCount());
+        return false;
+    }
+
+    for (int lidx = 0; lidx < kinematics.linkCount(); ++lidx) {
+        if (model.linkName(lidx) != kinematics.linkName(lidx)) {
+            ROS_WARN_NAMED(LOG, "Link %d of compiled kinematics is '%s', not '%s'", lidx, kinematics.linkName(lidx), model.linkName(lidx).c_str());
+            return false;
+        }
+    }
+
+    for (int vidx = 0; vidx < kinematics.jointVarCount(); ++vidx) {
+        if (model.jointVarName(vidx) != kinematics.jointVarName(vidx)) {
+            ROS_WARN_NAMED(LOG, "Variable %d of compiled kinematics is '%s', not '%s'", vidx, kinematics.jointVarName(vidx), model.jointVarName(vidx).c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Constants smaller than this are treated as zero when folding transforms.
+// Rotations built from urdf rpy angles commonly leave residues of ~1e-17
+// where the exact value is zero.
+static const double kZeroTolerance = 1e-12;
+
+// A linear combination of symbols; the empty symbol denotes a constant term
+using Expr = std::map<std::string, double>;
+
+static void AddTerm(Expr& e, const std::string& symbol, double coeff)
+{
+    e[symbol] += coeff;
+}
+
+static void Prune(Expr& e)
+{
+    for (auto it = e.begin(); it != e.end(); ) {
+        if (std::fabs(it->second) < kZeroTolerance) {
+            it = e.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+static auto ToString(double d) -> std::string
+{
+    std::ostringstream ss;
+    ss << std::setprecision(17) << d;
+    auto s = ss.str();
+    // keep the literal a double
+    if (s.find_first_of(".en") == std::string::npos) {
+        s += ".0";
+    }
+    return s;
+}
+
+static auto ToString(const Expr& e) -> std::string
+{
+    if (e.empty()) {
+        return "0.0";
+    }
+
+    std::string s;
+    for (auto& term : e) {
+        auto& symbol = term.first;
+        double coeff = term.second;
+        if (s.empty()) {
+            if (coeff < 0.0) {
+                s += "-";
+            }
+        } else {
+            s += coeff < 0.0 ? " - " : " + ";
+        }
+        double mag = std::fabs(coeff);
+        if (symbol.empty()) {
+            s += ToString(mag);
+        } else if (mag == 1.0) {
+            s += symbol;
+        } else {
+            s += ToString(mag) + " * " + symbol;
+        }
+    }
+    return s;
+}
+
+static bool IsOne(const Expr& e)
+{
+    return e.size() == 1 && e.begin()->first.empty() && e.begin()->second == 1.0;
+}
+
+static auto Quote(const std::string& s) -> std::string
+{
+    std::string q = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            q += '\\';
+        }
+        q += c;
+    }
+    q += '"';
+    return q;
+}
+
+// The 3x4 transform from a link's anchor to the link, in terms of the
+// variables of the link's parent joint
+struct LinkExpr
+{
+    Expr m[3][4];
+};
+
+static auto ConstantExpr(const Eigen::Affine3d& C) -> LinkExpr
+{
+    LinkExpr e;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            AddTerm(e.m[r][c], "", C(r, c));
+            Prune(e.m[r][c]);
+        }
+    }
+    return e;
+}
+
+// C * R(axis, q), where R = cos(q) * (I - aa') + sin(q) * [a]x + aa'
+static auto RevoluteExpr(
+    const Eigen::Affine3d& C,
+    const Eigen::Vector3d& a,
+    const std::string& cos_q,
+    const std::string& sin_q)
+    -> LinkExpr
+{
+    Eigen::Matrix3d aat = a * a.transpose();
+    Eigen::Matrix3d cos_coeffs = Eigen::Matrix3d::Identity() - aat;
+    Eigen::Matrix3d sin_coeffs;
+    sin_coeffs <<
+            0.0, -a.z(), a.y(),
+            a.z(), 0.0, -a.x(),
+            -a.y(), a.x(), 0.0;
+
+    LinkExpr e;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            auto& entry = e.m[r][c];
+            for (int j = 0; j < 3; ++j) {
+                AddTerm(entry, cos_q, C(r, j) * cos_coeffs(j, c));
+                AddTerm(entry, sin_q, C(r, j) * sin_coeffs(j, c));
+                AddTerm(entry, "", C(r, j) * aat(j, c));
+            }
+            Prune(entry);
+        }
+        AddTerm(e.m[r][3], "", C(r, 3));
+        Prune(e.m[r][3]);
+    }
+    return e;
+}
+
+// C * Translation(q * axis)
+static auto PrismaticExpr(
+    const Eigen::Affine3d& C,
+    const Eigen::Vector3d& a,
+    const std::string& q)
+    -> LinkExpr
+{
+    LinkExpr e = ConstantExpr(C);
+    for (int r = 0; r < 3; ++r) {
+        double coeff = 0.0;
+        for (int j = 0; j < 3; ++j) {
+            coeff += C(r, j) * a[j];
+        }
+        AddTerm(e.m[r][3], q, coeff);
+        Prune(e.m[r][3]);
+    }
+    return e;
+}
+
+static void WriteAffine(
+    std::ostream& o,
+    const char* indent,
+    const char* name,
+    const Eigen::Affine3d& T)
+{
+    o << indent << "Eigen::Affine3d " << name << ";\n";
+    o << indent << name << ".matrix() <<\n";
+    for (int r = 0; r < 4; ++r) {
+        o << indent << "        ";
+        for (int c = 0; c < 4; ++c) {
+            o << ToString(T(r, c)) << ((r == 3 && c == 3) ? ";\n" : ", ");
+        }
+        if (r != 3) {
+            o << "\n";
+        }
+    }
+}
+
+bool WriteCompiledKinematicsSource(
+    const RobotCollisionModel& model,
+    std::ostream& o)
+{
+    // per-link nearest ancestor (or self) whose transform depends on a joint
+    // variable, and the constant transform from that link; chains of fixed
+    // joints collapse into these
+    std::vector<int> anchors(model.linkCount(), 0);
+    Affine3dVector offsets(model.linkCount(), Eigen::Affine3d::Identity());
+
+    std::ostringstream body;
+    std::vector<bool> trig_vars(model.jointVarCount(), false);
+
+    for (size_t lidx = 1; lidx < model.linkCount(); ++lidx) {
+        const int jidx = model.linkParentJointIndex(lidx);
+        const int plidx = model.jointParentLinkIndex(jidx);
+        if (plidx < 0 || plidx >= (int)lidx) {
+            ROS_ERROR_NAMED(LOG, "Link '%s' does not follow its parent link", model.linkName(lidx).c_str());
+            return false;
+        }
+
+        const int anchor = anchors[plidx];
+        const Eigen::Affine3d C = offsets[plidx] * model.jointOrigin(jidx);
+        const int vidx = model.jointVarIndexFirst(jidx);
+        const std::string q = "q[" + std::to_string(vidx) + "]";
+
+        body << "        // " << model.linkName(lidx) << " (joint '" << model.jointName(jidx) << "')\n";
+
+        LinkExpr e;
+        switch (model.jointType(jidx)) {
+        case JointType::FIXED:
+            anchors[lidx] = anchor;
+            offsets[lidx] = C;
+            e = ConstantExpr(C);
+            break;
+        case JointType::REVOLUTE:
+        case JointType::CONTINUOUS: {
+            anchors[lidx] = lidx;
+            trig_vars[vidx] = true;
+            const std::string v = std::to_string(vidx);
+            e = RevoluteExpr(C, model.jointAxis(jidx), "c" + v, "s" + v);
+        }   break;
+        case JointType::PRISMATIC:
+            anchors[lidx] = lidx;
+            e = PrismaticExpr(C, model.jointAxis(jidx), q);
+            break;
+        case JointType::PLANAR:
+        case JointType::FLOATING: {
+            // rare below the root; defer to Eigen
+            anchors[lidx] = lidx;
+            body << "        {\n";
+            WriteAffine(body, "            ", "C", C);
+            body << "            T[" << lidx << "] = T[" << anchor << "] * C";
+            if (model.jointType(jidx) == JointType::PLANAR) {
+                body << " * Eigen::Translation3d(q[" << vidx << "], q[" << vidx + 1 << "], 0.0)"
+                        " * Eigen::AngleAxisd(q[" << vidx + 2 << "], Eigen::Vector3d::UnitZ());\n";
+            } else {
+                body << " * Eigen::Translation3d(q[" << vidx << "], q[" << vidx + 1 << "], q[" << vidx + 2 << "])"
+                        " * Eigen::Quaterniond(q[" << vidx + 6 << "], q[" << vidx + 3 << "], q[" << vidx + 4 << "], q[" << vidx + 5 << "]);\n";
+            }
+            body << "        }\n";
+            continue;
+        }
+        }
+
+        // T[lidx] = T[anchor] * e
+        body << "        {\n";
+        body << "            const Eigen::Affine3d& a = T[" << anchor << "];\n";
+        body << "            Eigen::Affine3d& t = T[" << lidx << "];\n";
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                std::string rhs;
+                for (int j = 0; j < 3; ++j) {
+                    auto& m = e.m[j][c];
+                    if (m.empty()) {
+                        continue;
+                    }
+                    if (!rhs.empty()) {
+                        rhs += " + ";
+                    }
+                    rhs += "a(" + std::to_string(r) + "," + std::to_string(j) + ")";
+                    if (!IsOne(m)) {
+                        rhs += " * (" + ToString(m) + ")";
+                    }
+                }
+                if (c == 3) {
+                    if (!rhs.empty()) {
+                        rhs += " + ";
+                    }
+                    rhs += "a(" + std::to_string(r) + ",3)";
+                }
+                if (rhs.empty()) {
+                    rhs = "0.0";
+                }
+                body << "            t(" << r << "," << c << ") = " << rhs << ";\n";
+            }
+        }
+        body << "            t.makeAffine();\n";
+        body << "        }\n";
+    }
+
+    o << "// Forward kinematics for the robot '" << model.name() << "'\n";
+    o << "//\n";
+    o << "// Generated by generate_fk from the RobotCollisionModel of the robot.\n";
+    o << "// Regenerate this file if the robot description or the world joint of\n";
+    o << "// the collision model changes.\n";
+    o << "\n";
+    o << "#include <cmath>\n";
+    o << "\n";
+    o << "#include <Eigen/Dense>\n";
+    o << "#include <sbpl_collision_checking/compiled_kinematics.h>\n";
+    o << "\n";
+    o << "namespace {\n";
+    o << "\n";
+    o << "const char* kLinkNames[] = {\n";
+    for (auto& name : model.linkNames()) {
+        o << "    " << Quote(name) << ",\n";
+    }
+    o << "};\n";
+    o << "\n";
+    o << "const char* kJointVarNames[] = {\n";
+    for (auto& name : model.jointVarNames()) {
+        o << "    " << Quote(name) << ",\n";
+    }
+    o << "};\n";
+    o << "\n";
+    o << "class GeneratedKinematics : public smpl::collision::CompiledKinematics\n";
+    o << "{\n";
+    o << "public:\n";
+    o << "\n";
+    o << "    auto modelName() const -> const char* override { return " << Quote(model.name()) << "; }\n";
+    o << "    int linkCount() const override { return " << model.linkCount() << "; }\n";
+    o << "    auto linkName(int lidx) const -> const char* override { return kLinkNames[lidx]; }\n";
+    o << "    int jointVarCount() const override { return " << model.jointVarCount() << "; }\n";
+    o << "    auto jointVarName(int vidx) const -> const char* override { return kJointVarNames[vidx]; }\n";
+    o << "\n";
+    o << "    void computeLinkTransforms(const double* q, Eigen::Affine3d* T) const override\n";
+    o << "    {\n";
+    for (size_t vidx = 0; vidx < trig_vars.size(); ++vidx) {
+        if (trig_vars[vidx]) {
+            o << "        const double c" << vidx << " = std::cos(q[" << vidx << "]);\n";
+            o << "        const double s" << vidx << " = std::sin(q[" << vidx << "]);\n";
+        }
+    }
+    o << "\n";
+    o << body.str();
+    o << "    }\n";
+    o << "};\n";
+    o << "\n";
+    o << "} // namespace\n";
+    o << "\n";
+    o << "extern \"C\" smpl::collision::CompiledKinematics* " SBPL_COLLISION_COMPILED_KINEMATICS_FACTORY "()\n";
+    o << "{\n";
+    o << "    return new GeneratedKinematics;\n";
+    o << "}\n";
+
+    return o.good();
+}
+
+} // namespace collision
+} // namespace smpl
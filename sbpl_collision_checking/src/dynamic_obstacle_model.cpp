@@ -0,0 +1,443 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <sbpl_collision_checking/dynamic_obstacle_model.h>
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// system includes
+#include <ros/console.h>
+#include <smpl/distance_map/sparse_distance_map.h>
+
+// project includes
+#include <sbpl_collision_checking/shapes.h>
+#include <sbpl_collision_checking/voxelize_collision_object.h>
+
+namespace smpl {
+namespace collision {
+
+static const char* LOG = "dynamic_obstacles";
+
+/// Return the pose of the object at a given time.
+auto DynamicObjectTrajectory::pose(double time) const -> Eigen::Affine3d
+{
+    if (poses.empty()) {
+        return Eigen::Affine3d::Identity();
+    }
+
+    if (periodic && duration() > 0.0) {
+        time = std::fmod(time, duration());
+        if (time < 0.0) {
+            time += duration();
+        }
+    }
+
+    if (time <= times.front()) {
+        return poses.front();
+    }
+    if (time >= times.back()) {
+        return poses.back();
+    }
+
+    // times[i - 1] <= time < times[i]
+    auto it = std::upper_bound(begin(times), end(times), time);
+    const size_t i = std::distance(begin(times), it);
+
+    const double alpha = (time - times[i - 1]) / (times[i] - times[i - 1]);
+    const Eigen::Vector3d pos =
+            (1.0 - alpha) * poses[i - 1].translation() +
+            alpha * poses[i].translation();
+    const Eigen::Quaterniond q0(poses[i - 1].rotation());
+    const Eigen::Quaterniond q1(poses[i].rotation());
+    return Eigen::Translation3d(pos) * q0.slerp(alpha, q1);
+}
+
+/// Construct a trajectory that moves an object with constant velocity, from
+/// a start pose, for a given duration.
+auto MakeLinearTrajectory(
+    const Eigen::Affine3d& start,
+    const Eigen::Vector3d& velocity,
+    double duration,
+    bool periodic)
+    -> DynamicObjectTrajectory
+{
+    DynamicObjectTrajectory traj;
+    traj.times = { 0.0, duration };
+    traj.poses.push_back(start);
+    traj.poses.push_back(Eigen::Translation3d(velocity * duration) * start);
+    traj.periodic = periodic;
+    return traj;
+}
+
+/// \class DynamicObstacleModel
+///
+/// This class manages the collision representations for a set of objects with
+/// known motion. Time, from the start of the plan up to the time horizon, is
+/// divided into buckets of fixed duration, and each bucket holds a grid, with
+/// the same extents and resolution as the world grid, of the cells swept by all
+/// objects during that bucket.
+///
+/// If every object moves periodically, with a period that divides the time
+/// horizon, queries for times past the horizon wrap around to the bucket for
+/// the same point in the cycle. Otherwise, they use a final bucket holding
+/// every cell that each object may occupy after the horizon: the cells swept
+/// over a full period for periodic objects, and the cells swept from the
+/// horizon until the end of the trajectory for all other objects.
+///
+/// As with the WorldCollisionModel, storage for the objects is managed
+/// externally and must be stable throughout the lifetime of the model, and
+/// duplicates of the same object are disallowed.
+
+DynamicObstacleModel::DynamicObstacleModel(const OccupancyGrid* grid) :
+    m_grid(grid),
+    m_time_res(0.1),
+    m_time_horizon(10.0)
+{
+}
+
+void DynamicObstacleModel::setTimeResolution(double res)
+{
+    if (res <= 0.0) {
+        ROS_ERROR_NAMED(LOG, "Time resolution must be positive");
+        return;
+    }
+    m_time_res = res;
+    rebuildBuckets();
+}
+
+void DynamicObstacleModel::setTimeHorizon(double horizon)
+{
+    if (horizon <= 0.0) {
+        ROS_ERROR_NAMED(LOG, "Time horizon must be positive");
+        return;
+    }
+    m_time_horizon = horizon;
+    rebuildBuckets();
+}
+
+/// Add an object, moving along a trajectory, to the model.
+bool DynamicObstacleModel::insertObject(
+    const CollisionObject* object,
+    const DynamicObjectTrajectory& trajectory)
+{
+    if (hasObject(object)) {
+        ROS_ERROR_NAMED(LOG, "Already have dynamic collision object '%s'", object->id.c_str());
+        return false;
+    }
+
+    if (object->shapes.size() != object->shape_poses.size()) {
+        ROS_ERROR_NAMED(LOG, "Mismatched sizes of shapes and shape poses");
+        return false;
+    }
+
+    if (trajectory.times.empty() ||
+        trajectory.times.size() != trajectory.poses.size())
+    {
+        ROS_ERROR_NAMED(LOG, "Trajectory for dynamic collision object '%s' must have one pose per keyframe", object->id.c_str());
+        return false;
+    }
+
+    if (!std::is_sorted(begin(trajectory.times), end(trajectory.times))) {
+        ROS_ERROR_NAMED(LOG, "Trajectory keyframes for dynamic collision object '%s' are out of order", object->id.c_str());
+        return false;
+    }
+
+    DynamicObjectModel model;
+    model.object = object;
+    model.trajectory = trajectory;
+    m_object_models.push_back(std::move(model));
+
+    if (m_buckets.empty() || isCyclic() != m_cyclic) {
+        rebuildBuckets();
+    } else if (!sweepObject(m_object_models.back())) {
+        ROS_ERROR_NAMED(LOG, "Failed to voxelize dynamic collision object '%s'", object->id.c_str());
+        m_object_models.pop_back();
+        rebuildBuckets();
+        return false;
+    }
+
+    return true;
+}
+
+/// Remove an object from the model. The buckets are rebuilt from the remaining
+/// objects.
+bool DynamicObstacleModel::removeObject(const CollisionObject* object)
+{
+    auto rit = std::remove_if(begin(m_object_models), end(m_object_models),
+            [&](const DynamicObjectModel& model) {
+                return model.object == object;
+            });
+    if (rit == end(m_object_models)) {
+        ROS_ERROR_NAMED(LOG, "Rejecting removal of dynamic collision object '%s'", object->id.c_str());
+        return false;
+    }
+    m_object_models.erase(rit, end(m_object_models));
+    rebuildBuckets();
+    return true;
+}
+
+bool DynamicObstacleModel::hasObject(const CollisionObject* object) const
+{
+    return std::any_of(begin(m_object_models), end(m_object_models),
+            [&](const DynamicObjectModel& model) {
+                return model.object == object;
+            });
+}
+
+void DynamicObstacleModel::removeAllObjects()
+{
+    m_object_models.clear();
+    m_buckets.clear();
+    m_cyclic = false;
+}
+
+/// Return the index of the time bucket that contains the given time, or -1 if
+/// the model contains no objects.
+int DynamicObstacleModel::bucketIndex(double time) const
+{
+    if (m_buckets.empty()) {
+        return -1;
+    }
+    const int bidx = (int)std::floor(time / m_time_res);
+    if (bidx < 0) {
+        return 0;
+    }
+    const int horizon_buckets = bucketCount() - 1;
+    if (bidx >= horizon_buckets) {
+        return m_cyclic ? bidx % horizon_buckets : horizon_buckets;
+    }
+    return bidx;
+}
+
+auto DynamicObstacleModel::bucketGrid(int bidx) const -> const OccupancyGrid*
+{
+    if (bidx < 0 || bidx >= bucketCount()) {
+        return nullptr;
+    }
+    return m_buckets[bidx].get();
+}
+
+// Return whether the motion of every object repeats with a period that
+// divides the time spanned by the buckets up to the horizon.
+bool DynamicObstacleModel::isCyclic() const
+{
+    const double horizon = m_time_res * (double)horizonBucketCount();
+    for (auto& model : m_object_models) {
+        auto& traj = model.trajectory;
+        if (!traj.periodic) {
+            return false;
+        }
+        if (traj.duration() <= 0.0) {
+            continue; // stationary
+        }
+        const double cycles = horizon / traj.duration();
+        if (std::fabs(cycles - std::round(cycles)) > 1e-6) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int DynamicObstacleModel::horizonBucketCount() const
+{
+    return std::max(1, (int)std::ceil(m_time_horizon / m_time_res - 1e-9));
+}
+
+void DynamicObstacleModel::rebuildBuckets()
+{
+    m_buckets.clear();
+    m_cyclic = false;
+    if (m_object_models.empty()) {
+        return;
+    }
+
+    m_cyclic = isCyclic();
+
+    auto& df = m_grid->getDistanceField();
+
+    // one bucket per time step up to the horizon, and one for all times after
+    const int bucket_count = horizonBucketCount() + 1;
+    m_buckets.reserve(bucket_count);
+    for (int bidx = 0; bidx < bucket_count; ++bidx) {
+        auto dmap = std::make_shared<SparseDistanceMap>(
+                df->originX(), df->originY(), df->originZ(),
+                df->sizeX(), df->sizeY(), df->sizeZ(),
+                df->resolution(),
+                df->getUninitializedDistance());
+        std::unique_ptr<OccupancyGrid> bucket(new OccupancyGrid(dmap));
+        bucket->setReferenceFrame(m_grid->getReferenceFrame());
+        m_buckets.push_back(std::move(bucket));
+    }
+
+    for (auto& model : m_object_models) {
+        if (!sweepObject(model)) {
+            ROS_ERROR_NAMED(LOG, "Failed to voxelize dynamic collision object '%s'", model.object->id.c_str());
+        }
+    }
+}
+
+/// Add the cells swept by an object to each time bucket.
+bool DynamicObstacleModel::sweepObject(const DynamicObjectModel& model)
+{
+    auto& traj = model.trajectory;
+
+    // bound the distance of any voxel from the origin of the trajectory pose,
+    // to bound the motion of the object due to rotation
+    std::vector<Eigen::Vector3d> voxels;
+    const Eigen::Affine3d pose0 = traj.pose(0.0);
+    if (!voxelizeObject(*model.object, pose0, voxels)) {
+        return false;
+    }
+    double radius = 0.0;
+    for (auto& v : voxels) {
+        radius = std::max(radius, (v - pose0.translation()).norm());
+    }
+
+    const int horizon_buckets = bucketCount() - 1;
+    for (int bidx = 0; bidx < horizon_buckets; ++bidx) {
+        const double t0 = m_time_res * (double)bidx;
+        voxels.clear();
+        if (!sweepInterval(model, radius, t0, t0 + m_time_res, voxels)) {
+            return false;
+        }
+        ROS_DEBUG_NAMED(LOG, "Add %zu voxels of dynamic collision object '%s' to bucket %d", voxels.size(), model.object->id.c_str(), bidx);
+        m_buckets[bidx]->addPointsToField(voxels);
+    }
+
+    // the cells the object may occupy at any time after the horizon
+    const double horizon = m_time_res * (double)horizon_buckets;
+    double t0, t1;
+    if (traj.periodic) {
+        t0 = 0.0;
+        t1 = traj.duration();
+    } else {
+        t0 = horizon;
+        t1 = std::max(horizon, traj.duration());
+    }
+    voxels.clear();
+    if (!sweepInterval(model, radius, t0, t1, voxels)) {
+        return false;
+    }
+    ROS_DEBUG_NAMED(LOG, "Add %zu voxels of dynamic collision object '%s' to the bucket past the horizon", voxels.size(), model.object->id.c_str());
+    m_buckets.back()->addPointsToField(voxels);
+
+    return true;
+}
+
+/// Voxelize an object over an interval of its trajectory, at enough poses that
+/// no point on the object moves more than half a cell between consecutive
+/// poses. \p radius bounds the distance of any point on the object from the
+/// origin of its pose. Output voxels are appended to the input voxel vector.
+bool DynamicObstacleModel::sweepInterval(
+    const DynamicObjectModel& model,
+    double radius,
+    double t0,
+    double t1,
+    std::vector<Eigen::Vector3d>& voxels)
+{
+    auto& traj = model.trajectory;
+    const double res = m_grid->resolution();
+
+    // sweep spans of at most one time step, so the estimated path length
+    // follows the trajectory closely
+    const int spans = std::max(1, (int)std::ceil((t1 - t0) / m_time_res - 1e-9));
+    const int path_samples = 8;
+    for (int span = 0; span < spans; ++span) {
+        const double s0 = t0 + (t1 - t0) * (double)span / (double)spans;
+        const double s1 = t0 + (t1 - t0) * (double)(span + 1) / (double)spans;
+
+        // estimate how far the object moves during this span
+        double path_len = 0.0;
+        Eigen::Affine3d prev = traj.pose(s0);
+        for (int i = 1; i <= path_samples; ++i) {
+            const Eigen::Affine3d curr =
+                    traj.pose(s0 + (s1 - s0) * (double)i / (double)path_samples);
+            const Eigen::AngleAxisd rot(prev.rotation().transpose() * curr.rotation());
+            path_len += (curr.translation() - prev.translation()).norm();
+            path_len += std::fabs(rot.angle()) * radius;
+            prev = curr;
+        }
+
+        const int steps = std::max(1, (int)std::ceil(path_len / (0.5 * res)));
+        for (int i = 0; i <= steps; ++i) {
+            const double t = s0 + (s1 - s0) * (double)i / (double)steps;
+            if (!voxelizeObject(*model.object, traj.pose(t), voxels)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/// Voxelize an object at a given pose into the reference frame of the grid.
+/// Output voxels are appended to the input voxel vector.
+bool DynamicObstacleModel::voxelizeObject(
+    const CollisionObject& object,
+    const Eigen::Affine3d& pose,
+    std::vector<Eigen::Vector3d>& voxels)
+{
+    const double res = m_grid->resolution();
+    const Eigen::Vector3d origin(
+            m_grid->originX(), m_grid->originY(), m_grid->originZ());
+
+    const Eigen::Vector3d gmin(
+            m_grid->originX(), m_grid->originY(), m_grid->originZ());
+
+    const Eigen::Vector3d gmax(
+            m_grid->originX() + m_grid->sizeX(),
+            m_grid->originY() + m_grid->sizeY(),
+            m_grid->originZ() + m_grid->sizeZ());
+
+    for (size_t i = 0; i < object.shapes.size(); ++i) {
+        auto& shape = *object.shapes[i];
+        const Eigen::Affine3d shape_pose = pose * object.shape_poses[i];
+        if (VoxelizationCache::IsCacheable(shape)) {
+            if (!m_voxelization_cache.voxelizeShape(
+                    shape, shape_pose, res, origin, voxels))
+            {
+                return false;
+            }
+        } else if (!VoxelizeShape(
+                shape, shape_pose, res, origin, gmin, gmax, voxels))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace collision
+} // namespace smpl
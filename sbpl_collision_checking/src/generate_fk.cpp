@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+// Generates a forward kinematics routine specialized for a robot's collision
+// model. The robot is read from the 'robot_description' parameter and the
+// world joint from the collision model configuration, as when constructing a
+// CollisionSpace, and the source is written to the file given on the command
+// line. The result may be built as a shared library and loaded with
+// smpl::collision::LoadCompiledKinematics, e.g.
+//
+//   add_library(pr2_fk MODULE pr2_fk.cpp)
+
+// standard includes
+#include <fstream>
+
+// system includes
+#include <ros/ros.h>
+#include <urdf/model.h>
+
+// project includes
+#include <sbpl_collision_checking/collision_model_config.h>
+#include <sbpl_collision_checking/compiled_kinematics.h>
+#include <sbpl_collision_checking/robot_collision_model.h>
+
+int main(int argc, char* argv[])
+{
+    ros::init(argc, argv, "generate_fk");
+    ros::NodeHandle nh;
+    ros::NodeHandle ph("~");
+
+    if (argc < 2) {
+        ROS_ERROR("Usage: generate_fk <output file>");
+        return 1;
+    }
+
+    std::string robot_description_key;
+    if (!nh.searchParam("robot_description", robot_description_key)) {
+        ROS_ERROR("Failed to find 'robot_description' key on the param server");
+        return 1;
+    }
+
+    urdf::Model urdf;
+    if (!urdf.initParam(robot_description_key)) {
+        ROS_ERROR("Failed to initialize URDF from parameter '%s'", robot_description_key.c_str());
+        return 1;
+    }
+
+    smpl::collision::CollisionModelConfig config;
+    if (!smpl::collision::CollisionModelConfig::Load(ph, config)) {
+        ROS_ERROR("Failed to load collision model config");
+        return 1;
+    }
+
+    auto rcm = smpl::collision::RobotCollisionModel::Load(urdf, config);
+    if (!rcm) {
+        ROS_ERROR("Failed to load robot collision model");
+        return 1;
+    }
+
+    std::ofstream ofs(argv[1]);
+    if (!ofs.is_open()) {
+        ROS_ERROR("Failed to open '%s' for writing", argv[1]);
+        return 1;
+    }
+
+    if (!smpl::collision::WriteCompiledKinematicsSource(*rcm, ofs)) {
+        ROS_ERROR("Failed to write compiled kinematics");
+        return 1;
+    }
+
+    ROS_INFO("Wrote kinematics for robot '%s' (%zu links, %zu variables) to '%s'", rcm->name().c_str(), rcm->linkCount(), rcm->jointVarCount(), argv[1]);
+    return 0;
+}
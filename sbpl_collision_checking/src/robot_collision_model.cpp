@@ -99,6 +99,18 @@ bool RobotCollisionModel::init(
     return success;
 }
 
+bool RobotCollisionModel::setCompiledKinematics(
+    const CompiledKinematicsConstPtr& kinematics)
+{
+    if (kinematics && !IsCompatible(*kinematics, *this)) {
+        ROS_ERROR_NAMED(LOG, "Compiled kinematics are not compatible with robot model '%s'", m_name.c_str());
+        return false;
+    }
+
+    m_compiled_kinematics = kinematics;
+    return true;
+}
+
 bool RobotCollisionModel::initRobotModel(
     const ::urdf::ModelInterface& urdf,
     const WorldJointConfig& config)
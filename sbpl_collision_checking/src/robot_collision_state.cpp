@@ -165,6 +165,41 @@ bool RobotCollisionState::setJointVarPositions(const double* positions)
     return true;
 }
 
+void RobotCollisionState::updateCompiledLinkTransforms(
+    const CompiledKinematics& kinematics)
+{
+    ROS_DEBUG_NAMED(RCS_LOGGER, "Updating all link transforms using compiled kinematics");
+
+    // the root link transform is read, not written, by the compiled routine,
+    // so compute it first from the world joint, whose variables may have been
+    // set along with the others
+    if (m_dirty_link_transforms[0]) {
+        const int wjidx = m_model->linkParentJointIndex(0);
+        if (m_dirty_joint_transforms[wjidx]) {
+            JointTransformFunction fn = m_model->jointTransformFn(wjidx);
+            const Eigen::Affine3d& joint_origin = m_model->jointOrigin(wjidx);
+            const Eigen::Vector3d& joint_axis = m_model->jointAxis(wjidx);
+            int fvidx = m_model->jointVarIndexFirst(wjidx);
+            double* variables = m_jvar_positions.data() + fvidx;
+            m_joint_transforms[wjidx] = fn(joint_origin, joint_axis, variables);
+            m_dirty_joint_transforms[wjidx] = false;
+        }
+        m_link_transforms[0] = m_joint_transforms[wjidx];
+    }
+
+    kinematics.computeLinkTransforms(
+            m_jvar_positions.data(), m_link_transforms.data());
+
+    // transforms of clean links are recomputed from the same variables, so
+    // only the dirty links have changed
+    for (size_t lidx = 0; lidx < m_link_transforms.size(); ++lidx) {
+        if (m_dirty_link_transforms[lidx]) {
+            m_dirty_link_transforms[lidx] = false;
+            ++m_link_transform_versions[lidx];
+        }
+    }
+}
+
 auto RobotCollisionState::getVisualization() const
     -> visualization_msgs::MarkerArray
 {
@@ -75,6 +75,44 @@ SelfCollisionModel::SelfCollisionModel(
     initAllowedCollisionMatrix();
 }
 
+/// Construct a self collision model that shares the occupancy grid and
+/// collision models of another, but owns its own collision state.
+///
+/// The copy adopts the group and the voxels models already inserted into the
+/// occupancy grid by the source model, and will not modify the occupancy grid
+/// as long as it is only queried with states that differ from the source's
+/// last query in the positions of joints that do not move outside-group
+/// voxels models. This allows multiple copies to be queried concurrently.
+SelfCollisionModel::SelfCollisionModel(const SelfCollisionModel& o)
+:
+    m_grid(o.m_grid),
+    m_rcm(o.m_rcm),
+    m_abcm(o.m_abcm),
+    m_rcs(o.m_rcm),
+    m_abcs(o.m_abcm, &m_rcs),
+    m_gidx(o.m_gidx),
+    m_voxels_indices(o.m_voxels_indices),
+    m_ab_voxels_indices(o.m_ab_voxels_indices),
+    m_checked_spheres_states(o.m_checked_spheres_states),
+    m_checked_attached_body_spheres_states(o.m_checked_attached_body_spheres_states),
+    m_checked_attached_body_robot_spheres_states(o.m_checked_attached_body_robot_spheres_states),
+    m_acm(o.m_acm),
+    m_padding(o.m_padding),
+    m_q(),
+    m_vq()
+{
+    // bring the outside-group voxels states up to date with the source state
+    // without touching the occupancy grid; the source has already inserted
+    // these voxels
+    (void)m_rcs.setJointVarPositions(o.m_rcs.getJointVarPositions());
+    for (int vsidx : m_voxels_indices) {
+        m_rcs.updateVoxelsState(vsidx);
+    }
+    for (int vsidx : m_ab_voxels_indices) {
+        m_abcs.updateVoxelsState(vsidx);
+    }
+}
+
 /// Seed the allowed collision matrix with pairs of adjacent links.
 void SelfCollisionModel::initAllowedCollisionMatrix()
 {
@@ -203,6 +241,21 @@ void SelfCollisionModel::setWorldToModelTransform(
     (void)m_rcs.setWorldToModelTransform(transform);
 }
 
+/// Update the occupancy grid with the voxels models outside a group at a given
+/// state, as is done implicitly at the start of every collision check.
+bool SelfCollisionModel::updateOccupancyGrid(
+    const RobotCollisionState& state,
+    const AttachedBodiesCollisionState& ab_state,
+    const int gidx)
+{
+    if (!checkCommonInputs(state, ab_state, gidx)) {
+        return false;
+    }
+
+    prepareState(gidx, state.getJointVarPositions());
+    return true;
+}
+
 bool SelfCollisionModel::checkCollision(
     const RobotCollisionState& state,
     const AttachedBodiesCollisionState& ab_state,
@@ -250,6 +303,43 @@ bool SelfCollisionModel::checkCollision(
     return true;
 }
 
+bool SelfCollisionModel::checkWorldCollision(
+    const RobotCollisionState& state,
+    const AttachedBodiesCollisionState& ab_state,
+    const int gidx,
+    double& dist)
+{
+    if (!checkCommonInputs(state, ab_state, gidx)) {
+        return false;
+    }
+
+    prepareState(gidx, state.getJointVarPositions());
+
+    if (!checkRobotVoxelsStateCollisions(dist) ||
+        !checkAttachedBodyVoxelsStateCollisions(dist) ||
+        !checkAttachedBodySpheresStateCollisions(dist))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool SelfCollisionModel::checkSelfCollision(
+    const RobotCollisionState& state,
+    const AttachedBodiesCollisionState& ab_state,
+    const int gidx,
+    double& dist)
+{
+    if (!checkCommonInputs(state, ab_state, gidx)) {
+        return false;
+    }
+
+    prepareState(gidx, state.getJointVarPositions());
+
+    return checkRobotSpheresStateCollisions(dist);
+}
+
 bool SelfCollisionModel::checkMotionCollision(
     RobotCollisionState& state,
     AttachedBodiesCollisionState& ab_state,
@@ -624,14 +714,11 @@ void SelfCollisionModel::updateVoxelsStates()
         }
     }
 
-    // update occupancy grid with new voxel data
-    if (!v_rem.empty()) {
-        ROS_DEBUG_NAMED(SCM_LOGGER, "  Remove %zu voxels", v_rem.size());
-        m_grid->removePointsFromField(v_rem);
-    }
-    if (!v_ins.empty()) {
-        ROS_DEBUG_NAMED(SCM_LOGGER, "  Insert %zu voxels", v_ins.size());
-        m_grid->addPointsToField(v_ins);
+    // update occupancy grid with new voxel data; most of the displaced voxels
+    // of a small motion are reoccupied, so only the difference is applied
+    if (!v_rem.empty() || !v_ins.empty()) {
+        ROS_DEBUG_NAMED(SCM_LOGGER, "  Remove %zu voxels, insert %zu voxels", v_rem.size(), v_ins.size());
+        m_grid->updatePointsInField(v_rem, v_ins);
     }
 }
 
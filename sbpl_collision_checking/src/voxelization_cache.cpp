@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <sbpl_collision_checking/voxelization_cache.h>
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+// system includes
+#include <ros/console.h>
+
+// project includes
+#include <sbpl_collision_checking/voxelize_collision_object.h>
+
+namespace smpl {
+namespace collision {
+
+static const char* LOG = "voxelization_cache";
+
+template <typename T>
+static void AppendValue(std::string& bytes, const T& value)
+{
+    bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void AppendBytes(std::string& bytes, const void* data, size_t size)
+{
+    bytes.append(static_cast<const char*>(data), size);
+}
+
+// Serialize everything that determines the voxelization of a shape in its
+// own frame
+static void SerializeShape(const CollisionShape& shape, std::string& bytes)
+{
+    AppendValue(bytes, (int)shape.type);
+    switch (shape.type) {
+    case ShapeType::Sphere: {
+        auto& sphere = static_cast<const SphereShape&>(shape);
+        AppendValue(bytes, sphere.radius);
+        break;
+    }
+    case ShapeType::Cylinder: {
+        auto& cylinder = static_cast<const CylinderShape&>(shape);
+        AppendValue(bytes, cylinder.radius);
+        AppendValue(bytes, cylinder.height);
+        break;
+    }
+    case ShapeType::Cone: {
+        auto& cone = static_cast<const ConeShape&>(shape);
+        AppendValue(bytes, cone.radius);
+        AppendValue(bytes, cone.height);
+        break;
+    }
+    case ShapeType::Box: {
+        auto& box = static_cast<const BoxShape&>(shape);
+        AppendBytes(bytes, box.size, sizeof(box.size));
+        break;
+    }
+    case ShapeType::Mesh: {
+        auto& mesh = static_cast<const MeshShape&>(shape);
+        AppendValue(bytes, mesh.vertex_count);
+        AppendValue(bytes, mesh.triangle_count);
+        AppendBytes(bytes, mesh.vertices, 3 * mesh.vertex_count * sizeof(double));
+        AppendBytes(bytes, mesh.triangles, 3 * mesh.triangle_count * sizeof(std::uint32_t));
+        break;
+    }
+    case ShapeType::Plane:
+    case ShapeType::OcTree:
+        break;
+    }
+}
+
+// FNV-1a
+static void HashBytes(std::uint64_t& h, const void* data, size_t size)
+{
+    auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+}
+
+size_t VoxelizationCache::KeyHash::operator()(const Key& key) const
+{
+    std::uint64_t h = 14695981039346656037ull;
+    HashBytes(h, key.shape.data(), key.shape.size());
+    HashBytes(h, &key.res, sizeof(key.res));
+    return (size_t)h;
+}
+
+/// Return whether voxelizations of a shape may be cached.
+bool VoxelizationCache::IsCacheable(const CollisionShape& shape)
+{
+    return shape.type != ShapeType::Plane && shape.type != ShapeType::OcTree;
+}
+
+/// Voxelize a shape at a given pose, using a cached voxelization of the shape
+/// if one exists. Output voxels are appended to the input voxel vector.
+bool VoxelizationCache::voxelizeShape(
+    const CollisionShape& shape,
+    const Eigen::Affine3d& pose,
+    double res,
+    const Eigen::Vector3d& go,
+    std::vector<Eigen::Vector3d>& voxels)
+{
+    if (!IsCacheable(shape)) {
+        ROS_ERROR_NAMED(LOG, "Voxelizations of %s shapes are not cached", to_cstring(shape.type));
+        return false;
+    }
+
+    auto shape_voxels = getShapeVoxels(shape, res);
+    if (!shape_voxels) {
+        return false;
+    }
+
+    // half extents of the axis-aligned bounds of a rotated voxel, shrunk
+    // slightly so that a voxel that lands exactly on a cell occupies only that
+    // cell
+    const Eigen::Matrix3d R = pose.rotation();
+    const double eps = 1e-6 * res;
+    const Eigen::Vector3d half_extents =
+            (0.5 * res * R.cwiseAbs().rowwise().sum()).array() - eps;
+
+    const double inv_res = 1.0 / res;
+    auto discretize = [&](const Eigen::Vector3d& p) {
+        return Eigen::Vector3i(
+                (int)std::floor((p.x() - go.x()) * inv_res + 0.5),
+                (int)std::floor((p.y() - go.y()) * inv_res + 0.5),
+                (int)std::floor((p.z() - go.z()) * inv_res + 0.5));
+    };
+
+    std::vector<Eigen::Vector3i> cells;
+    for (auto& v : *shape_voxels) {
+        const Eigen::Vector3d c = pose * v;
+        const Eigen::Vector3i lo = discretize(c - half_extents);
+        const Eigen::Vector3i hi = discretize(c + half_extents);
+        for (int x = lo.x(); x <= hi.x(); ++x) {
+        for (int y = lo.y(); y <= hi.y(); ++y) {
+        for (int z = lo.z(); z <= hi.z(); ++z) {
+            cells.emplace_back(x, y, z);
+        }
+        }
+        }
+    }
+
+    auto cell_less = [](const Eigen::Vector3i& a, const Eigen::Vector3i& b) {
+        return std::tie(a.x(), a.y(), a.z()) < std::tie(b.x(), b.y(), b.z());
+    };
+    std::sort(begin(cells), end(cells), cell_less);
+    cells.erase(std::unique(begin(cells), end(cells)), end(cells));
+
+    voxels.reserve(voxels.size() + cells.size());
+    for (auto& cell : cells) {
+        voxels.push_back(go + res * cell.cast<double>());
+    }
+
+    return true;
+}
+
+size_t VoxelizationCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t VoxelizationCache::hitCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t VoxelizationCache::missCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+/// Remove all cached voxelizations.
+void VoxelizationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+auto VoxelizationCache::getShapeVoxels(const CollisionShape& shape, double res)
+    -> VoxelListConstPtr
+{
+    Key key;
+    SerializeShape(shape, key.shape);
+    key.res = res;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != end(m_entries)) {
+            ++m_hits;
+            return it->second;
+        }
+        ++m_misses;
+    }
+
+    // voxelize in the frame of the shape, on a lattice with a cell centered
+    // at the origin, without holding the lock
+    auto voxels = std::make_shared<VoxelList>();
+    if (!VoxelizeShape(
+            shape,
+            Eigen::Affine3d::Identity(),
+            res,
+            Eigen::Vector3d::Zero(),
+            *voxels))
+    {
+        return nullptr;
+    }
+
+    ROS_DEBUG_NAMED(LOG, "Cache %zu voxels for %s shape at resolution %0.3f", voxels->size(), to_cstring(shape.type), res);
+
+    // another thread may have cached the same shape in the meantime, in which
+    // case its (identical) voxelization is kept
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto ent = m_entries.insert(std::make_pair(std::move(key), std::move(voxels)));
+    return ent.first->second;
+}
+
+} // namespace collision
+} // namespace smpl
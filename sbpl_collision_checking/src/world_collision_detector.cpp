@@ -31,6 +31,10 @@
 
 #include <sbpl_collision_checking/world_collision_detector.h>
 
+// standard includes
+#include <algorithm>
+#include <limits>
+
 // system includes
 #include <ros/console.h>
 
@@ -47,7 +51,8 @@ WorldCollisionDetector::WorldCollisionDetector(
 :
     m_rcm(rcm),
     m_wcm(wcm),
-    m_vq()
+    m_vq(),
+    m_sweep_q()
 {
 }
 
@@ -61,7 +66,8 @@ bool WorldCollisionDetector::checkCollision(
         return false;
     }
 
-    return checkRobotSpheresStateCollisions(state, gidx, dist);
+    return checkRobotSpheresStateCollisions(
+            state, gidx, m_wcm->padding(), dist);
 }
 
 bool WorldCollisionDetector::checkCollision(
@@ -77,8 +83,10 @@ bool WorldCollisionDetector::checkCollision(
         return false;
     }
 
-    return checkRobotSpheresStateCollisions(state, gidx, dist) &&
-            checkAttachedBodySpheresStateCollisions(ab_state, gidx, dist);
+    return checkRobotSpheresStateCollisions(
+                    state, gidx, m_wcm->padding(), dist) &&
+            checkAttachedBodySpheresStateCollisions(
+                    ab_state, gidx, m_wcm->padding(), dist);
 }
 
 bool WorldCollisionDetector::checkMotionCollision(
@@ -128,11 +136,135 @@ bool WorldCollisionDetector::checkMotionCollision(
     return true;
 }
 
+/// Check a motion for collisions with the world using a conservative bound on
+/// the volume swept by the group's spheres.
+///
+/// The motion is discretized into the same waypoints as checkMotionCollision,
+/// but instead of checking every waypoint, intervals of waypoints are checked
+/// at their midpoint with every sphere inflated by an upper bound on the
+/// distance any sphere may travel within the interval. If the inflated spheres
+/// are collision-free, the entire interval is collision-free. Otherwise, the
+/// interval is bisected, and intervals that are short enough are checked
+/// waypoint by waypoint. The result is identical to that of
+/// checkMotionCollision, but motions through free space require forward
+/// kinematics at only a handful of states. As with checkMotionCollision, \p
+/// dist receives the minimum distance reported by any of the checks.
+bool WorldCollisionDetector::checkSweptMotionCollision(
+    RobotCollisionState& state,
+    const RobotMotionCollisionModel& rmcm,
+    const std::vector<double>& start,
+    const std::vector<double>& finish,
+    const int gidx,
+    double& dist) const
+{
+    if (gidx < 0 || gidx >= state.model()->groupCount()) {
+        ROS_ERROR_NAMED(WCM_LOGGER, "World Collision Check is for non-existent group");
+        return false;
+    }
+
+    const double res = 0.05;
+    MotionInterpolation interp(m_rcm);
+    rmcm.fillMotionInterpolation(start, finish, res, interp);
+
+    RobotState interm;
+    if (interp.waypointCount() < 3) {
+        for (int i = 0; i < interp.waypointCount(); ++i) {
+            interp.interpolate(i, interm);
+            state.setJointVarPositions(interm.data());
+            if (!checkCollision(state, gidx, dist)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // sphere motion is bounded linearly in the distance traveled along the
+    // interpolated segment, so the bound for an interval of waypoints is a
+    // fraction of the bound for the entire motion
+    const double motion = rmcm.getMaxSphereMotion(start, finish);
+    const double motion_per_waypoint =
+            motion / (double)(interp.waypointCount() - 1);
+
+    const double padding = m_wcm->padding();
+
+    dist = std::numeric_limits<double>::infinity();
+
+    auto& q = m_sweep_q;
+    q.clear();
+    q.emplace_back(0, interp.waypointCount() - 1);
+    while (!q.empty()) {
+        const int lo = q.back().first;
+        const int hi = q.back().second;
+        q.pop_back();
+
+        if (hi - lo < 3) {
+            // too short to benefit from further bisection
+            for (int i = lo; i <= hi; ++i) {
+                interp.interpolate(i, interm);
+                state.setJointVarPositions(interm.data());
+                if (!checkRobotSpheresStateCollisions(state, gidx, padding, dist)) {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        const int mid = lo + (hi - lo) / 2;
+        interp.interpolate(mid, interm);
+        state.setJointVarPositions(interm.data());
+
+        const double sweep =
+                motion_per_waypoint * (double)std::max(mid - lo, hi - mid);
+        double sweep_dist = std::numeric_limits<double>::infinity();
+        if (checkRobotSpheresStateCollisions(
+                state, gidx, padding + sweep, sweep_dist))
+        {
+            dist = std::min(dist, sweep_dist);
+            continue;
+        }
+
+        q.emplace_back(mid, hi);
+        q.emplace_back(lo, mid);
+    }
+
+    return true;
+}
+
+/// Swept variant of checkMotionCollision that includes attached bodies.
+///
+/// The sphere motion bounds of the RobotMotionCollisionModel only account for
+/// robot links, so motions of groups carrying attached bodies are checked at
+/// every waypoint.
+bool WorldCollisionDetector::checkSweptMotionCollision(
+    RobotCollisionState& state,
+    AttachedBodiesCollisionState& ab_state,
+    const RobotMotionCollisionModel& rmcm,
+    const std::vector<double>& start,
+    const std::vector<double>& finish,
+    const int gidx,
+    double& dist) const
+{
+    if (gidx < 0 || gidx >= state.model()->groupCount() ||
+        gidx >= ab_state.model()->groupCount())
+    {
+        ROS_ERROR_NAMED(WCM_LOGGER, "World Collision Check is for non-existent group");
+        return false;
+    }
+
+    if (!ab_state.groupSpheresStateIndices(gidx).empty()) {
+        return checkMotionCollision(
+                state, ab_state, rmcm, start, finish, gidx, dist);
+    }
+
+    return checkSweptMotionCollision(state, rmcm, start, finish, gidx, dist);
+}
+
 /// logical const, but not thread-safe, since it makes use of an internal
 /// stack to traverse the sphere tree hierarchy.
 bool WorldCollisionDetector::checkRobotSpheresStateCollisions(
     RobotCollisionState& state,
     int gidx,
+    double padding,
     double& dist) const
 {
     // TODO: refactor commonality with self collision model here
@@ -145,12 +277,13 @@ bool WorldCollisionDetector::checkRobotSpheresStateCollisions(
         q.push_back(s);
     }
 
-    return CheckVoxelsCollisions(state, q, *m_wcm->grid(), m_wcm->padding(), dist);
+    return CheckVoxelsCollisions(state, q, *m_wcm->grid(), padding, dist);
 }
 
 bool WorldCollisionDetector::checkAttachedBodySpheresStateCollisions(
     AttachedBodiesCollisionState& state,
     int gidx,
+    double padding,
     double& dist) const
 {
     // TODO: see note in checkRobotSpheresStateCollisions()
@@ -163,7 +296,7 @@ bool WorldCollisionDetector::checkAttachedBodySpheresStateCollisions(
         q.push_back(s);
     }
 
-    return CheckVoxelsCollisions(state, q, *m_wcm->grid(), m_wcm->padding(), dist);
+    return CheckVoxelsCollisions(state, q, *m_wcm->grid(), padding, dist);
 }
 
 } // namespace collision
@@ -76,7 +76,8 @@ WorldCollisionModel::WorldCollisionModel(
 :
     m_grid(grid),
     m_object_models(o.m_object_models),
-    m_padding(o.m_padding)
+    m_padding(o.m_padding),
+    m_voxelization_cache(o.m_voxelization_cache)
 {
     // TODO: check for different voxel origin/resolution/etc here...if they
     // differ, need to do a deep copy + revoxelization of the objects over just
@@ -93,20 +94,8 @@ bool WorldCollisionModel::insertObject(const CollisionObject* object)
         return false;
     }
 
-    const double res = m_grid->resolution();
-    const Eigen::Vector3d origin(
-            m_grid->originX(), m_grid->originY(), m_grid->originZ());
-
-    const Eigen::Vector3d gmin(
-            m_grid->originX(), m_grid->originY(), m_grid->originZ());
-
-    const Eigen::Vector3d gmax(
-            m_grid->originX() + m_grid->sizeX(),
-            m_grid->originY() + m_grid->sizeY(),
-            m_grid->originZ() + m_grid->sizeZ());
-
     std::vector<std::vector<Eigen::Vector3d>> all_voxels;
-    if (!VoxelizeObject(*object, res, origin, gmin, gmax, all_voxels)) {
+    if (!voxelizeObject(*object, all_voxels)) {
         ROS_ERROR_NAMED(LOG, "Failed to voxelize object '%s'", object->id.c_str());
         return false;
     }
@@ -155,24 +144,33 @@ bool WorldCollisionModel::removeObject(const CollisionObject* object)
 /// shapes moving with a collision object.
 bool WorldCollisionModel::moveShapes(const CollisionObject* object)
 {
-    // TODO: optimized version
-    return removeObject(object) && insertObject(object);
+    if (!checkObjectMoveShape(object)) {
+        ROS_ERROR_NAMED(LOG, "Rejecting movement of shapes in collision object '%s'", object->id.c_str());
+        return false;
+    }
+    return updateObject(object);
 }
 
 /// Update the collision model in response to shapes being added to a collision
 /// object.
 bool WorldCollisionModel::insertShapes(const CollisionObject* object)
 {
-    // TODO: optimized version
-    return removeObject(object) && insertObject(object);
+    if (!checkObjectInsertShape(object)) {
+        ROS_ERROR_NAMED(LOG, "Rejecting addition of shapes to collision object '%s'", object->id.c_str());
+        return false;
+    }
+    return updateObject(object);
 }
 
 /// Update the collision model in response to shapes being removed from a
 /// collision object.
 bool WorldCollisionModel::removeShapes(const CollisionObject* object)
 {
-    // TODO: optimized version
-    return removeObject(object) && insertObject(object);
+    if (!checkObjectRemoveShape(object)) {
+        ROS_ERROR_NAMED(LOG, "Rejecting removal of shapes from collision object '%s'", object->id.c_str());
+        return false;
+    }
+    return updateObject(object);
 }
 
 /// Return true if the collision model contains the object.
@@ -297,6 +295,88 @@ auto WorldCollisionModel::getCollisionWorldVisualization() const
     return ma;
 }
 
+/// Voxelize each shape of an object into the reference frame of the grid,
+/// using the voxelization cache for shapes it supports, if one is set.
+bool WorldCollisionModel::voxelizeObject(
+    const CollisionObject& object,
+    std::vector<VoxelList>& all_voxels)
+{
+    const double res = m_grid->resolution();
+    const Eigen::Vector3d origin(
+            m_grid->originX(), m_grid->originY(), m_grid->originZ());
+
+    const Eigen::Vector3d gmin(
+            m_grid->originX(), m_grid->originY(), m_grid->originZ());
+
+    const Eigen::Vector3d gmax(
+            m_grid->originX() + m_grid->sizeX(),
+            m_grid->originY() + m_grid->sizeY(),
+            m_grid->originZ() + m_grid->sizeZ());
+
+    if (!m_voxelization_cache) {
+        return VoxelizeObject(object, res, origin, gmin, gmax, all_voxels);
+    }
+
+    for (size_t i = 0; i < object.shapes.size(); ++i) {
+        auto& shape = *object.shapes[i];
+        auto& pose = object.shape_poses[i];
+        VoxelList voxels;
+        if (VoxelizationCache::IsCacheable(shape)) {
+            if (!m_voxelization_cache->voxelizeShape(
+                    shape, pose, res, origin, voxels))
+            {
+                all_voxels.clear();
+                return false;
+            }
+        } else if (!VoxelizeShape(shape, pose, res, origin, gmin, gmax, voxels)) {
+            all_voxels.clear();
+            return false;
+        }
+        all_voxels.push_back(std::move(voxels));
+    }
+
+    return true;
+}
+
+/// Revoxelize an object already in the collision model and update only the
+/// cells of the distance map whose occupancy differs between the old and new
+/// voxelizations, rather than clearing and propagating the entire object
+/// twice. If the object can no longer be voxelized, it is removed.
+bool WorldCollisionModel::updateObject(const CollisionObject* object)
+{
+    auto* model = getObjectCollisionModel(object);
+    assert(model != NULL);
+
+    if (object->shapes.size() != object->shape_poses.size()) {
+        ROS_ERROR_NAMED(LOG, "Mismatched sizes of shapes and shape poses");
+        removeObject(object);
+        return false;
+    }
+
+    std::vector<VoxelList> all_voxels;
+    if (!voxelizeObject(*object, all_voxels)) {
+        ROS_ERROR_NAMED(LOG, "Failed to voxelize object '%s'", object->id.c_str());
+        removeObject(object);
+        return false;
+    }
+
+    VoxelList old_voxels;
+    for (auto& voxel_list : model->cached_voxels) {
+        old_voxels.insert(end(old_voxels), begin(voxel_list), end(voxel_list));
+    }
+
+    VoxelList new_voxels;
+    for (auto& voxel_list : all_voxels) {
+        new_voxels.insert(end(new_voxels), begin(voxel_list), end(voxel_list));
+    }
+
+    ROS_DEBUG_NAMED(LOG, "Updating %zu -> %zu voxels from collision object '%s' in the distance transform", old_voxels.size(), new_voxels.size(), object->id.c_str());
+    m_grid->updatePointsInField(old_voxels, new_voxels);
+
+    model->cached_voxels = std::move(all_voxels);
+    return true;
+}
+
 bool WorldCollisionModel::haveObject(const CollisionObject* object) const
 {
     auto it = std::find_if(begin(m_object_models), end(m_object_models),
@@ -318,6 +398,18 @@ auto WorldCollisionModel::getObjectCollisionModel(
     return NULL;
 }
 
+auto WorldCollisionModel::getObjectCollisionModel(
+    const CollisionObject* object)
+    -> ObjectCollisionModel*
+{
+    for (auto& model : m_object_models) {
+        if (model.object == object) {
+            return &model;
+        }
+    }
+    return NULL;
+}
+
 // Return true if the model does not already contain this object and the object
 // is not malformed.
 bool WorldCollisionModel::checkObjectInsert(const CollisionObject* object) const
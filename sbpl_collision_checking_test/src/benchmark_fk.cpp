@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+// Compares link transform and sphere position updates computed with the
+// generic per-joint transform functions against those computed by a forward
+// kinematics routine generated by generate_fk for the same robot.
+
+// standard includes
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// system includes
+#include <ros/ros.h>
+#include <sbpl_collision_checking/compiled_kinematics.h>
+#include <sbpl_collision_checking/robot_collision_model.h>
+#include <sbpl_collision_checking/robot_collision_state.h>
+#include <urdf/model.h>
+
+namespace collision = smpl::collision;
+
+static auto CreateRandomState(
+    const collision::RobotCollisionModel& rcm,
+    std::default_random_engine& rng)
+    -> std::vector<double>
+{
+    std::vector<double> out(rcm.jointVarCount(), 0.0);
+    for (size_t vidx = 0; vidx < rcm.jointVarCount(); ++vidx) {
+        // leave the world joint at the origin
+        if (rcm.jointVarJointIndex(vidx) == 0) {
+            continue;
+        }
+        if (rcm.jointVarIsContinuous(vidx)) {
+            std::uniform_real_distribution<double> dist(-M_PI, M_PI);
+            out[vidx] = dist(rng);
+        } else if (!rcm.jointVarHasPositionBounds(vidx)) {
+            std::uniform_real_distribution<double> dist;
+            out[vidx] = dist(rng);
+        } else {
+            std::uniform_real_distribution<double> dist(
+                    rcm.jointVarMinPosition(vidx),
+                    rcm.jointVarMaxPosition(vidx));
+            out[vidx] = dist(rng);
+        }
+    }
+    return out;
+}
+
+// time updating all link transforms and sphere positions for each state
+static double ProfileUpdates(
+    collision::RobotCollisionState& state,
+    const std::vector<std::vector<double>>& states)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& positions : states) {
+        state.setJointVarPositions(positions.data());
+        state.updateSphereStates();
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    ros::init(argc, argv, "benchmark_fk");
+    ros::NodeHandle nh;
+    ros::NodeHandle ph("~");
+
+    std::string robot_description_key;
+    if (!nh.searchParam("robot_description", robot_description_key)) {
+        ROS_ERROR("Failed to find 'robot_description' key on the param server");
+        return 1;
+    }
+
+    urdf::Model urdf;
+    if (!urdf.initParam(robot_description_key)) {
+        ROS_ERROR("Failed to initialize URDF from parameter '%s'", robot_description_key.c_str());
+        return 1;
+    }
+
+    collision::CollisionModelConfig config;
+    if (!collision::CollisionModelConfig::Load(ph, config)) {
+        ROS_ERROR("Failed to load collision model config");
+        return 1;
+    }
+
+    std::string library;
+    if (!ph.getParam("kinematics_library", library)) {
+        ROS_ERROR("Failed to retrieve 'kinematics_library' from the param server");
+        return 1;
+    }
+
+    int state_count;
+    ph.param("state_count", state_count, 100000);
+
+    auto generic_rcm = collision::RobotCollisionModel::Load(urdf, config);
+    auto compiled_rcm = collision::RobotCollisionModel::Load(urdf, config);
+    if (!generic_rcm || !compiled_rcm) {
+        ROS_ERROR("Failed to load robot collision model");
+        return 1;
+    }
+
+    auto kinematics = collision::LoadCompiledKinematics(library);
+    if (!kinematics || !compiled_rcm->setCompiledKinematics(kinematics)) {
+        return 1;
+    }
+
+    collision::RobotCollisionState generic_state(generic_rcm.get());
+    collision::RobotCollisionState compiled_state(compiled_rcm.get());
+
+    std::default_random_engine rng;
+    std::vector<std::vector<double>> states;
+    states.reserve(state_count);
+    for (int i = 0; i < state_count; ++i) {
+        states.push_back(CreateRandomState(*generic_rcm, rng));
+    }
+
+    // verify that both agree before timing
+    double max_error = 0.0;
+    for (size_t i = 0; i < std::min(states.size(), size_t(1000)); ++i) {
+        generic_state.setJointVarPositions(states[i].data());
+        compiled_state.setJointVarPositions(states[i].data());
+        generic_state.updateLinkTransforms();
+        compiled_state.updateLinkTransforms();
+        for (size_t lidx = 0; lidx < generic_rcm->linkCount(); ++lidx) {
+            auto& g = generic_state.linkTransform(lidx);
+            auto& c = compiled_state.linkTransform(lidx);
+            max_error = std::max(max_error,
+                    (g.matrix() - c.matrix()).cwiseAbs().maxCoeff());
+        }
+    }
+
+    ROS_INFO("Robot '%s': %zu links, %zu variables, %zu spheres models", generic_rcm->name().c_str(), generic_rcm->linkCount(), generic_rcm->jointVarCount(), generic_rcm->spheresModelCount());
+    ROS_INFO("  Max link transform error: %g", max_error);
+    if (max_error > 1e-9) {
+        ROS_ERROR("Compiled kinematics disagree with the generic model");
+        return 1;
+    }
+
+    const double generic_time = ProfileUpdates(generic_state, states);
+    const double compiled_time = ProfileUpdates(compiled_state, states);
+
+    ROS_INFO("  Generic:  %0.3f us/state", 1e6 * generic_time / state_count);
+    ROS_INFO("  Compiled: %0.3f us/state", 1e6 * compiled_time / state_count);
+    ROS_INFO("  Speedup:  %0.2fx", generic_time / compiled_time);
+
+    return 0;
+}
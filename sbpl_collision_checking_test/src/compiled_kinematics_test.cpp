@@ -0,0 +1,177 @@
+#include <stdlib.h>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE CompiledKinematicsTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <sbpl_collision_checking/collision_model_config.h>
+#include <sbpl_collision_checking/compiled_kinematics.h>
+#include <sbpl_collision_checking/robot_collision_model.h>
+#include <sbpl_collision_checking/robot_collision_state.h>
+#include <urdf/model.h>
+
+namespace collision = smpl::collision;
+
+// a small arm mixing revolute, prismatic, continuous, and fixed joints, with
+// non-trivial joint origins
+static const char* kUrdf = R"(
+<robot name="test_arm">
+  <link name="base_link"/>
+  <link name="shoulder_link"/>
+  <link name="upper_arm_link"/>
+  <link name="slider_link"/>
+  <link name="wrist_link"/>
+  <link name="tool_link"/>
+  <joint name="shoulder_joint" type="revolute">
+    <parent link="base_link"/>
+    <child link="shoulder_link"/>
+    <origin xyz="0.1 0.0 0.3" rpy="0.0 0.0 0.5"/>
+    <axis xyz="0 0 1"/>
+    <limit lower="-2.0" upper="2.0" effort="1.0" velocity="1.0"/>
+  </joint>
+  <joint name="elbow_joint" type="revolute">
+    <parent link="shoulder_link"/>
+    <child link="upper_arm_link"/>
+    <origin xyz="0.0 0.05 0.2" rpy="0.3 0.0 0.0"/>
+    <axis xyz="0 1 0"/>
+    <limit lower="-2.0" upper="2.0" effort="1.0" velocity="1.0"/>
+  </joint>
+  <joint name="slider_joint" type="prismatic">
+    <parent link="upper_arm_link"/>
+    <child link="slider_link"/>
+    <origin xyz="0.3 0.0 0.0" rpy="0.0 0.2 0.0"/>
+    <axis xyz="1 0 0"/>
+    <limit lower="-0.5" upper="0.5" effort="1.0" velocity="1.0"/>
+  </joint>
+  <joint name="wrist_joint" type="continuous">
+    <parent link="slider_link"/>
+    <child link="wrist_link"/>
+    <origin xyz="0.1 0.0 0.0" rpy="0.0 0.0 0.0"/>
+    <axis xyz="1 0 0"/>
+  </joint>
+  <joint name="tool_joint" type="fixed">
+    <parent link="wrist_link"/>
+    <child link="tool_link"/>
+    <origin xyz="0.05 0.0 0.02" rpy="0.1 0.2 0.3"/>
+  </joint>
+</robot>
+)";
+
+static auto LoadModel(const std::string& world_joint_type)
+    -> collision::RobotCollisionModelPtr
+{
+    urdf::Model urdf;
+    BOOST_REQUIRE(urdf.initString(kUrdf));
+
+    collision::CollisionModelConfig config;
+    config.world_joint.name = "world_joint";
+    config.world_joint.type = world_joint_type;
+
+    auto model = collision::RobotCollisionModel::Load(urdf, config);
+    BOOST_REQUIRE(model);
+    return model;
+}
+
+// Generate the kinematics source for the model, build it into a shared
+// library with the compiler this test was built with, and load it
+static auto CompileKinematics(
+    const collision::RobotCollisionModel& model,
+    const std::string& name)
+    -> collision::CompiledKinematicsPtr
+{
+    char dir_template[] = "/tmp/compiled_kinematics_test.XXXXXX";
+    const char* dir = mkdtemp(dir_template);
+    BOOST_REQUIRE(dir != NULL);
+
+    const std::string source = std::string(dir) + "/" + name + ".cpp";
+    const std::string library = std::string(dir) + "/lib" + name + ".so";
+
+    {
+        std::ofstream ofs(source);
+        BOOST_REQUIRE(collision::WriteCompiledKinematicsSource(model, ofs));
+    }
+
+    const std::string command =
+            std::string(TEST_CXX_COMPILER) +
+            " -std=c++11 -O2 -shared -fPIC " TEST_FK_INCLUDE_FLAGS " " +
+            source + " -o " + library;
+    BOOST_TEST_MESSAGE(command);
+    BOOST_REQUIRE(std::system(command.c_str()) == 0);
+
+    auto kinematics = collision::LoadCompiledKinematics(library);
+    BOOST_REQUIRE(kinematics);
+    return kinematics;
+}
+
+// Set random positions, including those of the world joint, on both states
+// and compare the transforms of every link
+static void CheckAgainstInterpreted(
+    const collision::RobotCollisionModel& interpreted_model,
+    const collision::RobotCollisionModel& compiled_model)
+{
+    collision::RobotCollisionState interpreted(&interpreted_model);
+    collision::RobotCollisionState compiled(&compiled_model);
+
+    std::default_random_engine rng;
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    std::vector<double> positions(interpreted_model.jointVarCount());
+    for (int i = 0; i < 100; ++i) {
+        for (auto& p : positions) {
+            p = dist(rng);
+        }
+
+        interpreted.setJointVarPositions(positions.data());
+        compiled.setJointVarPositions(positions.data());
+
+        interpreted.updateLinkTransforms();
+        compiled.updateLinkTransforms();
+
+        for (size_t lidx = 0; lidx < interpreted_model.linkCount(); ++lidx) {
+            BOOST_CHECK(!compiled.linkTransformDirty(lidx));
+            BOOST_CHECK(!compiled.updateLinkTransform(lidx));
+
+            const Eigen::Affine3d& Ti = interpreted.linkTransform(lidx);
+            const Eigen::Affine3d& Tc = compiled.linkTransform(lidx);
+            BOOST_CHECK_MESSAGE(
+                    Ti.isApprox(Tc, 1e-9),
+                    "link " << interpreted_model.linkName(lidx) << ":\n" <<
+                    Ti.matrix() << "\n!=\n" << Tc.matrix());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(FixedWorldJointTest)
+{
+    auto interpreted_model = LoadModel("fixed");
+    auto compiled_model = LoadModel("fixed");
+    auto kinematics = CompileKinematics(*compiled_model, "fixed_fk");
+    BOOST_REQUIRE(compiled_model->setCompiledKinematics(kinematics));
+
+    CheckAgainstInterpreted(*interpreted_model, *compiled_model);
+}
+
+BOOST_AUTO_TEST_CASE(PlanarWorldJointTest)
+{
+    auto interpreted_model = LoadModel("planar");
+    auto compiled_model = LoadModel("planar");
+    auto kinematics = CompileKinematics(*compiled_model, "planar_fk");
+    BOOST_REQUIRE(compiled_model->setCompiledKinematics(kinematics));
+
+    CheckAgainstInterpreted(*interpreted_model, *compiled_model);
+}
+
+BOOST_AUTO_TEST_CASE(FloatingWorldJointTest)
+{
+    auto interpreted_model = LoadModel("floating");
+    auto compiled_model = LoadModel("floating");
+    auto kinematics = CompileKinematics(*compiled_model, "floating_fk");
+    BOOST_REQUIRE(compiled_model->setCompiledKinematics(kinematics));
+
+    CheckAgainstInterpreted(*interpreted_model, *compiled_model);
+}
@@ -0,0 +1,142 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE VoxelizationCacheTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <sbpl_collision_checking/shapes.h>
+#include <sbpl_collision_checking/voxelization_cache.h>
+
+namespace collision = smpl::collision;
+
+static const double kRes = 0.02;
+
+static auto Voxelize(
+    collision::VoxelizationCache& cache,
+    const collision::CollisionShape& shape,
+    const Eigen::Affine3d& pose = Eigen::Affine3d::Identity())
+    -> std::vector<Eigen::Vector3d>
+{
+    std::vector<Eigen::Vector3d> voxels;
+    BOOST_REQUIRE(cache.voxelizeShape(
+            shape, pose, kRes, Eigen::Vector3d::Zero(), voxels));
+    return voxels;
+}
+
+BOOST_AUTO_TEST_CASE(HitTest)
+{
+    collision::VoxelizationCache cache;
+    collision::BoxShape box(0.1, 0.2, 0.3);
+
+    auto first = Voxelize(cache, box);
+    auto second = Voxelize(cache, box);
+    BOOST_CHECK(first == second);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK_EQUAL(cache.missCount(), 1);
+    BOOST_CHECK_EQUAL(cache.hitCount(), 1);
+
+    // a different shape object with the same contents shares the entry
+    collision::BoxShape same_box(0.1, 0.2, 0.3);
+    Voxelize(cache, same_box);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK_EQUAL(cache.hitCount(), 2);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK_EQUAL(cache.hitCount(), 0);
+    BOOST_CHECK_EQUAL(cache.missCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DistinctShapesTest)
+{
+    collision::VoxelizationCache cache;
+
+    // same dimensions, different types
+    collision::CylinderShape cylinder(0.1, 0.3);
+    collision::ConeShape cone(0.1, 0.3);
+
+    // same vertices, different triangles
+    double vertices[] = {
+        0.0, 0.0, 0.0,
+        0.2, 0.0, 0.0,
+        0.0, 0.2, 0.0,
+        0.0, 0.0, 0.2,
+    };
+    std::uint32_t tris_a[] = { 0, 1, 2, 0, 1, 3 };
+    std::uint32_t tris_b[] = { 0, 1, 2, 0, 2, 3 };
+    collision::MeshShape mesh_a;
+    mesh_a.vertices = vertices;
+    mesh_a.vertex_count = 4;
+    mesh_a.triangles = tris_a;
+    mesh_a.triangle_count = 2;
+    collision::MeshShape mesh_b = mesh_a;
+    mesh_b.triangles = tris_b;
+
+    auto cylinder_voxels = Voxelize(cache, cylinder);
+    auto cone_voxels = Voxelize(cache, cone);
+    auto mesh_a_voxels = Voxelize(cache, mesh_a);
+    auto mesh_b_voxels = Voxelize(cache, mesh_b);
+
+    BOOST_CHECK_EQUAL(cache.size(), 4);
+    BOOST_CHECK_EQUAL(cache.missCount(), 4);
+    BOOST_CHECK_EQUAL(cache.hitCount(), 0);
+    BOOST_CHECK(cylinder_voxels != cone_voxels);
+    BOOST_CHECK(mesh_a_voxels != mesh_b_voxels);
+
+    // each shape is served its own voxelization
+    collision::VoxelizationCache fresh;
+    BOOST_CHECK(Voxelize(cache, cone) == Voxelize(fresh, cone));
+    BOOST_CHECK(Voxelize(cache, mesh_b) == Voxelize(fresh, mesh_b));
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentTest)
+{
+    std::vector<collision::BoxShape> boxes;
+    for (int i = 0; i < 8; ++i) {
+        boxes.emplace_back(0.1 + 0.02 * i, 0.1, 0.1);
+    }
+
+    const Eigen::Affine3d pose(
+            Eigen::Translation3d(0.5, 0.5, 0.5) *
+            Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitZ()));
+
+    std::vector<std::vector<Eigen::Vector3d>> expected;
+    {
+        collision::VoxelizationCache cache;
+        for (auto& box : boxes) {
+            expected.push_back(Voxelize(cache, box, pose));
+        }
+    }
+
+    collision::VoxelizationCache cache;
+    const int thread_count = 4;
+    const int iterations = 50;
+    std::vector<int> mismatches(thread_count, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]()
+        {
+            for (int i = 0; i < iterations; ++i) {
+                const size_t bidx = (t + i) % boxes.size();
+                std::vector<Eigen::Vector3d> voxels;
+                if (!cache.voxelizeShape(
+                        boxes[bidx], pose, kRes, Eigen::Vector3d::Zero(), voxels) ||
+                    voxels != expected[bidx])
+                {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < thread_count; ++t) {
+        BOOST_CHECK_EQUAL(mismatches[t], 0);
+    }
+    BOOST_CHECK_EQUAL(cache.size(), boxes.size());
+    BOOST_CHECK_EQUAL(cache.hitCount() + cache.missCount(), thread_count * iterations);
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SBPL_KDL_ROBOT_MODEL_ANALYTIC_IK_SOLVER_H
+#define SBPL_KDL_ROBOT_MODEL_ANALYTIC_IK_SOLVER_H
+
+// standard includes
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// system includes
+#include <Eigen/Geometry>
+
+namespace smpl {
+
+/// Closed-form inverse kinematics solver for a kinematic chain, such as one
+/// generated by IKFast, used by KDLRobotModel in place of its numeric solver.
+///
+/// Poses are expressed in the frame of the chain's base link, and joint
+/// variables are ordered as in the chain. Chains with more joint variables
+/// than the solver can determine from a pose fix the remaining "free"
+/// variables to given values.
+class AnalyticIKSolver
+{
+public:
+
+    virtual ~AnalyticIKSolver();
+
+    /// \name Chain Description
+    /// Used to verify that the solver was generated for a given chain.
+    ///@{
+    virtual auto baseLink() const -> const char* = 0;
+    virtual auto tipLink() const -> const char* = 0;
+    virtual int jointVariableCount() const = 0;
+    ///@}
+
+    virtual int freeVariableCount() const = 0;
+    virtual int freeVariableIndex(int fidx) const = 0;
+
+    /// \brief Compute all solutions for a pose
+    ///
+    /// \param pose The pose of the tip link
+    /// \param free The values of the free variables
+    /// \param solutions Each solution found is appended to this array as
+    ///     jointVariableCount() consecutive values
+    /// \return The number of solutions found
+    virtual int solve(
+        const Eigen::Affine3d& pose,
+        const double* free,
+        std::vector<double>& solutions) = 0;
+
+    /// \brief Compute all solutions for several poses
+    ///
+    /// The free variable values for the i'th pose are read from
+    /// free[i * freeVariableCount()]. The solutions for all poses are appended
+    /// to \p solutions in order and the number of solutions found for the i'th
+    /// pose is stored in solution_counts[i].
+    ///
+    /// The default implementation calls solve() for each pose. Solvers that can
+    /// evaluate several poses at once, e.g. with vector instructions, should
+    /// override it.
+    virtual void solveBatch(
+        const Eigen::Affine3d* poses,
+        const double* free,
+        std::size_t count,
+        std::vector<double>& solutions,
+        int* solution_counts);
+};
+
+/// Name of the factory function exported by analytic ik solver libraries
+#define SBPL_KDL_ANALYTIC_IK_SOLVER_FACTORY "sbpl_kdl_create_analytic_ik_solver"
+
+using AnalyticIKSolverPtr = std::shared_ptr<AnalyticIKSolver>;
+
+/// \brief Load an analytic ik solver from a shared library
+///
+/// The library must export an `extern "C"` function named by
+/// SBPL_KDL_ANALYTIC_IK_SOLVER_FACTORY that takes no arguments and returns a
+/// new AnalyticIKSolver. The library is unloaded when the last reference to
+/// the returned object is released.
+auto LoadAnalyticIKSolver(const std::string& path) -> AnalyticIKSolverPtr;
+
+} // namespace smpl
+
+#endif
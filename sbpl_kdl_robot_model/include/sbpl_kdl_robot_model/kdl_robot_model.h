@@ -36,6 +36,7 @@
 // standard includes
 #include <memory>
 #include <string>
+#include <vector>
 
 // system includes
 #include <kdl/chain.hpp>
@@ -48,17 +49,36 @@
 #include <smpl_urdf_robot_model/smpl_urdf_robot_model.h>
 #include <urdf/model.h>
 
+// project includes
+#include <sbpl_kdl_robot_model/analytic_ik_solver.h>
+
 namespace smpl {
 
+class ThreadPool;
+
+/// Timing statistics for the calls made to one of the inverse kinematics
+/// backends of a KDLRobotModel. Times are in seconds.
+struct IKSolverStats
+{
+    int num_calls = 0;
+    int num_solved = 0;
+    double total_time = 0.0;
+    double max_time = 0.0;
+};
+
 class KDLRobotModel :
     public virtual urdf::URDFRobotModel,
     public virtual InverseKinematicsInterface,
-    public virtual RedundantManipulatorInterface
+    public virtual RedundantManipulatorInterface,
+    public virtual BatchRedundantManipulatorInterface
 {
 public:
 
     static const int DEFAULT_FREE_ANGLE_INDEX = 2;
 
+    KDLRobotModel();
+    ~KDLRobotModel();
+
     bool init(
         const std::string& robot_description,
         const std::string& base_link,
@@ -73,8 +93,43 @@ public:
         const RobotState& start,
         RobotState& solution);
 
+    bool numericIKSearch(
+        const Eigen::Affine3d& pose,
+        const RobotState& start,
+        RobotState& solution);
+
+    bool computeMultipleIKSearch(
+        const Eigen::Affine3d& pose,
+        const RobotState& start,
+        std::vector<RobotState>& solutions);
+
+    void numericMultipleIKSearch(
+        const Eigen::Affine3d& pose,
+        const RobotState& start,
+        std::vector<RobotState>& solutions);
+
+    void setIKSearchThreadCount(int num_threads);
+    int ikSearchThreadCount() const;
+
+    void setMaxIKSolutions(int count);
+    int maxIKSolutions() const;
+
+    void setIKSolutionTolerance(double tol);
+    double ikSolutionTolerance() const;
+
     void printRobotModelInformation();
 
+    /// \brief Use a closed-form solver in place of the numeric solver
+    ///
+    /// The solver must have been generated for the same chain as this model.
+    /// Passing nullptr restores the numeric solver.
+    bool setAnalyticIKSolver(const AnalyticIKSolverPtr& solver);
+    auto analyticIKSolver() const -> const AnalyticIKSolverPtr&;
+
+    auto analyticIKStats() const -> const IKSolverStats&;
+    auto numericIKStats() const -> const IKSolverStats&;
+    void resetIKStats();
+
     /// \name RedundantManipulatorInterface
     /// @{
     const int redundantVariableCount() const override { return 0; }
@@ -85,6 +140,16 @@ public:
         RobotState& solution) override;
     /// @}
 
+    /// \name BatchRedundantManipulatorInterface
+    /// @{
+    void computeFastIKBatch(
+        const Eigen::Affine3d* poses,
+        const RobotState* seeds,
+        std::size_t count,
+        RobotState* solutions,
+        bool* solved) override;
+    /// @}
+
     /// \name InverseKinematicsInterface Interface
     ///@{
     bool computeIK(
@@ -123,6 +188,11 @@ public:
     std::unique_ptr<KDL::ChainIkSolverVel_pinv>         m_ik_vel_solver;
     std::unique_ptr<KDL::ChainIkSolverPos_NR_JL>        m_ik_solver;
 
+    AnalyticIKSolverPtr m_analytic_ik_solver;
+
+    IKSolverStats m_analytic_ik_stats;
+    IKSolverStats m_numeric_ik_stats;
+
     // ik solver settings
     int m_max_iterations;
     double m_kdl_eps;
@@ -130,11 +200,19 @@ public:
     // temporary storage
     KDL::JntArray m_jnt_pos_in;
     KDL::JntArray m_jnt_pos_out;
+    std::vector<double> m_ik_solutions;
 
     // ik search configuration
     int m_free_angle;
     double m_search_discretization;
     double m_timeout;
+
+    // multiple ik search configuration
+    struct IKSearchContext;
+    std::unique_ptr<ThreadPool> m_ik_search_pool;
+    std::vector<std::unique_ptr<IKSearchContext>> m_ik_search_contexts;
+    int m_max_ik_solutions;
+    double m_ik_solution_tolerance;
 };
 
 } // namespace smpl
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <sbpl_kdl_robot_model/analytic_ik_solver.h>
+
+// system includes
+#include <dlfcn.h>
+#include <ros/console.h>
+
+namespace smpl {
+
+AnalyticIKSolver::~AnalyticIKSolver()
+{
+}
+
+void AnalyticIKSolver::solveBatch(
+    const Eigen::Affine3d* poses,
+    const double* free,
+    std::size_t count,
+    std::vector<double>& solutions,
+    int* solution_counts)
+{
+    auto free_count = freeVariableCount();
+    for (std::size_t i = 0; i < count; ++i) {
+        solution_counts[i] = solve(poses[i], free + i * free_count, solutions);
+    }
+}
+
+auto LoadAnalyticIKSolver(const std::string& path) -> AnalyticIKSolverPtr
+{
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        ROS_ERROR("Failed to load analytic ik solver library '%s': %s", path.c_str(), dlerror());
+        return nullptr;
+    }
+
+    using FactoryFunction = AnalyticIKSolver* (*)();
+    auto create = reinterpret_cast<FactoryFunction>(
+            dlsym(handle, SBPL_KDL_ANALYTIC_IK_SOLVER_FACTORY));
+    if (!create) {
+        ROS_ERROR("Library '%s' does not export '%s'", path.c_str(), SBPL_KDL_ANALYTIC_IK_SOLVER_FACTORY);
+        dlclose(handle);
+        return nullptr;
+    }
+
+    AnalyticIKSolver* solver = create();
+    if (!solver) {
+        ROS_ERROR("Library '%s' failed to create an analytic ik solver", path.c_str());
+        dlclose(handle);
+        return nullptr;
+    }
+
+    ROS_INFO("Loaded analytic ik solver for chain (%s, %s) from '%s'", solver->baseLink(), solver->tipLink(), path.c_str());
+
+    // the object's code lives in the library, so it must be destroyed before
+    // the library is unloaded
+    return AnalyticIKSolverPtr(solver, [handle](AnalyticIKSolver* s)
+    {
+        delete s;
+        dlclose(handle);
+    });
+}
+
+} // namespace smpl
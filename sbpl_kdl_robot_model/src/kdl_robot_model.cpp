@@ -32,6 +32,15 @@
 
 #include <sbpl_kdl_robot_model/kdl_robot_model.h>
 
+// standard includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+
 // system includes
 #include <eigen_conversions/eigen_kdl.h>
 #include <kdl/frames.hpp>
@@ -40,11 +49,23 @@
 #include <leatherman/utils.h>
 #include <ros/console.h>
 #include <smpl/angles.h>
+#include <smpl/thread_pool.h>
 #include <smpl/time.h>
 #include <smpl/stl/memory.h>
 
 namespace smpl {
 
+// Solvers and temporary storage for one thread of the multiple ik search
+struct KDLRobotModel::IKSearchContext
+{
+    std::unique_ptr<KDL::ChainFkSolverPos_recursive>    fk_solver;
+    std::unique_ptr<KDL::ChainIkSolverVel_pinv>         ik_vel_solver;
+    std::unique_ptr<KDL::ChainIkSolverPos_NR_JL>        ik_solver;
+
+    KDL::JntArray jnt_pos_in;
+    KDL::JntArray jnt_pos_out;
+};
+
 static
 bool getCount(int& count, int max_count, int min_count)
 {
@@ -71,6 +92,22 @@ bool getCount(int& count, int max_count, int min_count)
     }
 }
 
+static
+void GetSolverLimits(KDLRobotModel* model, KDL::JntArray* q_min, KDL::JntArray* q_max)
+{
+    q_min->resize(model->jointVariableCount());
+    q_max->resize(model->jointVariableCount());
+    for (size_t i = 0; i < model->jointVariableCount(); ++i) {
+        if (model->vprops[i].continuous) {
+            (*q_min)(i) = -M_PI;
+            (*q_max)(i) = M_PI;
+        } else {
+            (*q_min)(i) = model->vprops[i].min_position;
+            (*q_max)(i) = model->vprops[i].max_position;
+        }
+    }
+}
+
 static
 bool Init(
     KDLRobotModel* model,
@@ -151,17 +188,9 @@ bool Init(
     model->m_ik_vel_solver = make_unique<KDL::ChainIkSolverVel_pinv>(model->m_chain);
 
     // IK solver
-    KDL::JntArray q_min(model->jointVariableCount());
-    KDL::JntArray q_max(model->jointVariableCount());
-    for (size_t i = 0; i < model->jointVariableCount(); ++i) {
-        if (model->vprops[i].continuous) {
-            q_min(i) = -M_PI;
-            q_max(i) = M_PI;
-        } else {
-            q_min(i) = model->vprops[i].min_position;
-            q_max(i) = model->vprops[i].max_position;
-        }
-    }
+    KDL::JntArray q_min;
+    KDL::JntArray q_max;
+    GetSolverLimits(model, &q_min, &q_max);
 
     model->m_max_iterations = 200;
     model->m_kdl_eps = 0.001;
@@ -179,9 +208,21 @@ bool Init(
     model->m_free_angle = free_angle;
     model->m_search_discretization = 0.02;
     model->m_timeout = 0.005;
+
+    model->m_max_ik_solutions = 1;
+    model->m_ik_solution_tolerance = 0.01;
+    model->setIKSearchThreadCount(1);
     return true;
 }
 
+KDLRobotModel::KDLRobotModel()
+{
+}
+
+KDLRobotModel::~KDLRobotModel()
+{
+}
+
 bool KDLRobotModel::init(
     const std::string& robot_description,
     const std::string& base_link,
@@ -191,6 +232,74 @@ bool KDLRobotModel::init(
     return Init(this, robot_description, base_link, tip_link, free_angle);
 }
 
+/// Set the number of threads used by computeMultipleIKSearch. A value <= 0
+/// selects the hardware concurrency.
+void KDLRobotModel::setIKSearchThreadCount(int num_threads)
+{
+    if (num_threads <= 0) {
+        num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    if (num_threads > 1) {
+        m_ik_search_pool = make_unique<ThreadPool>(num_threads);
+    } else {
+        m_ik_search_pool.reset();
+    }
+
+    // KDL's solvers are not reentrant, so each thread gets its own
+    KDL::JntArray q_min;
+    KDL::JntArray q_max;
+    GetSolverLimits(this, &q_min, &q_max);
+
+    m_ik_search_contexts.clear();
+    for (int i = 0; i < num_threads; ++i) {
+        auto context = make_unique<IKSearchContext>();
+        context->fk_solver = make_unique<KDL::ChainFkSolverPos_recursive>(m_chain);
+        context->ik_vel_solver = make_unique<KDL::ChainIkSolverVel_pinv>(m_chain);
+        context->ik_solver = make_unique<KDL::ChainIkSolverPos_NR_JL>(
+                m_chain,
+                q_min,
+                q_max,
+                *context->fk_solver,
+                *context->ik_vel_solver,
+                m_max_iterations,
+                m_kdl_eps);
+        context->jnt_pos_in.resize(m_chain.getNrOfJoints());
+        context->jnt_pos_out.resize(m_chain.getNrOfJoints());
+        m_ik_search_contexts.push_back(std::move(context));
+    }
+}
+
+int KDLRobotModel::ikSearchThreadCount() const
+{
+    return (int)m_ik_search_contexts.size();
+}
+
+/// Set the number of distinct solutions after which computeIK stops searching
+/// when asked for multiple solutions. With a value of 1, computeIK returns the
+/// single solution found by computeIKSearch.
+void KDLRobotModel::setMaxIKSolutions(int count)
+{
+    m_max_ik_solutions = std::max(1, count);
+}
+
+int KDLRobotModel::maxIKSolutions() const
+{
+    return m_max_ik_solutions;
+}
+
+/// Set the distance, in every joint variable, within which two solutions are
+/// considered the same.
+void KDLRobotModel::setIKSolutionTolerance(double tol)
+{
+    m_ik_solution_tolerance = tol;
+}
+
+double KDLRobotModel::ikSolutionTolerance() const
+{
+    return m_ik_solution_tolerance;
+}
+
 auto KDLRobotModel::getBaseLink() const -> const std::string&
 {
     return m_base_link;
@@ -221,15 +330,321 @@ double GetSolverMinPosition(KDLRobotModel* model, int vidx)
     }
 }
 
+static
+double GetSolverMaxPosition(KDLRobotModel* model, int vidx)
+{
+    if (model->vprops[vidx].continuous) {
+        return M_PI;
+    } else {
+        return model->vprops[vidx].max_position;
+    }
+}
+
+static
+void RecordIKCalls(IKSolverStats* stats, int calls, int solved, double time)
+{
+    stats->num_calls += calls;
+    stats->num_solved += solved;
+    stats->total_time += time;
+    stats->max_time = std::max(stats->max_time, time / calls);
+}
+
+static
+bool IsWithinLimits(KDLRobotModel* model, const double* q)
+{
+    for (auto i = 0; i < model->jointVariableCount(); ++i) {
+        auto& vprops = model->vprops[i];
+        if (!vprops.continuous && vprops.bounded &&
+            (q[i] < vprops.min_position || q[i] > vprops.max_position))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static
+bool IsSameSolution(
+    KDLRobotModel* model,
+    const RobotState& a,
+    const RobotState& b,
+    double tol)
+{
+    for (auto i = 0; i < model->jointVariableCount(); ++i) {
+        auto d = model->vprops[i].continuous ?
+                smpl::angles::shortest_angle_dist(a[i], b[i]) :
+                std::fabs(a[i] - b[i]);
+        if (d > tol) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static
+bool IsNewSolution(
+    KDLRobotModel* model,
+    const RobotState* first,
+    const RobotState* last,
+    const RobotState& solution)
+{
+    for (auto* s = first; s != last; ++s) {
+        if (IsSameSolution(model, *s, solution, model->m_ik_solution_tolerance)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Return the values of a free variable to try in a search, in order of
+// increasing distance from the initial value.
+static
+void MakeFreeVariableSeeds(
+    KDLRobotModel* model,
+    int vidx,
+    double initial_guess,
+    std::vector<double>& seeds)
+{
+    auto num_positive_increments =
+            (int)((GetSolverMaxPosition(model, vidx) - initial_guess) /
+                    model->m_search_discretization);
+    auto num_negative_increments =
+            (int)((initial_guess - GetSolverMinPosition(model, vidx)) /
+                    model->m_search_discretization);
+
+    seeds.clear();
+    seeds.push_back(initial_guess);
+    auto count = 0;
+    while (getCount(count, num_positive_increments, -num_negative_increments)) {
+        seeds.push_back(initial_guess + model->m_search_discretization * count);
+    }
+}
+
+// Select, from the analytic solutions, the solution within joint limits that
+// is nearest to the seed state.
+static
+bool SelectAnalyticSolution(
+    KDLRobotModel* model,
+    const double* solutions,
+    int count,
+    const RobotState& seed,
+    RobotState& solution)
+{
+    auto var_count = model->jointVariableCount();
+    auto best_dist = std::numeric_limits<double>::infinity();
+    const double* best = NULL;
+    for (auto sidx = 0; sidx < count; ++sidx) {
+        auto* q = solutions + sidx * var_count;
+        if (!IsWithinLimits(model, q)) {
+            continue;
+        }
+        auto dist = 0.0;
+        for (auto i = 0; i < var_count; ++i) {
+            if (model->vprops[i].continuous) {
+                auto d = smpl::angles::shortest_angle_dist(q[i], seed[i]);
+                dist += d * d;
+            } else {
+                dist += (q[i] - seed[i]) * (q[i] - seed[i]);
+            }
+        }
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = q;
+        }
+    }
+
+    if (best == NULL) {
+        return false;
+    }
+
+    solution.resize(var_count);
+    for (auto i = 0; i < var_count; ++i) {
+        if (model->vprops[i].continuous) {
+            solution[i] = smpl::angles::normalize_angle(best[i]);
+        } else {
+            solution[i] = best[i];
+        }
+    }
+    return true;
+}
+
+// Compute the analytic solution, nearest to the seed state, for a pose in the
+// kinematics frame with the free variables set to the given values.
+static
+bool SolveAnalyticIK(
+    KDLRobotModel* model,
+    const Eigen::Affine3d& pose,
+    const double* free,
+    const RobotState& seed,
+    RobotState& solution)
+{
+    model->m_ik_solutions.clear();
+    auto count = model->m_analytic_ik_solver->solve(
+            pose, free, model->m_ik_solutions);
+    return SelectAnalyticSolution(
+            model, model->m_ik_solutions.data(), count, seed, solution);
+}
+
+// Search over the first free variable, outward from its seed value, for a pose
+// in the kinematics frame that has an analytic solution.
+static
+bool AnalyticIKSearch(
+    KDLRobotModel* model,
+    const Eigen::Affine3d& pose,
+    const RobotState& start,
+    RobotState& solution)
+{
+    auto& solver = *model->m_analytic_ik_solver;
+
+    std::vector<double> free(solver.freeVariableCount());
+    for (size_t i = 0; i < free.size(); ++i) {
+        free[i] = start[solver.freeVariableIndex(i)];
+    }
+
+    if (free.empty()) {
+        return SolveAnalyticIK(model, pose, NULL, start, solution);
+    }
+
+    auto fvidx = solver.freeVariableIndex(0);
+    if (model->vprops[fvidx].continuous) {
+        free[0] = smpl::angles::normalize_angle(free[0]);
+    }
+    auto initial_guess = free[0];
+
+    auto start_time = smpl::clock::now();
+    auto loop_time = 0.0;
+    auto count = 0;
+
+    auto num_positive_increments =
+            (int)((GetSolverMaxPosition(model, fvidx) - initial_guess) /
+                    model->m_search_discretization);
+    auto num_negative_increments =
+            (int)((initial_guess - GetSolverMinPosition(model, fvidx)) /
+                    model->m_search_discretization);
+
+    while (loop_time < model->m_timeout) {
+        if (SolveAnalyticIK(model, pose, free.data(), start, solution)) {
+            return true;
+        }
+        if (!getCount(count, num_positive_increments, -num_negative_increments)) {
+            return false;
+        }
+        free[0] = initial_guess + model->m_search_discretization * count;
+        loop_time = to_seconds(smpl::clock::now() - start_time);
+    }
+
+    ROS_DEBUG("IK Timed out in %f seconds", model->m_timeout);
+    return false;
+}
+
+// Collect distinct analytic solutions, within joint limits, over values of the
+// first free variable in order of increasing distance from its seed value.
+static
+void AnalyticMultipleIKSearch(
+    KDLRobotModel* model,
+    const Eigen::Affine3d& pose,
+    const RobotState& start,
+    std::vector<RobotState>& solutions)
+{
+    auto& solver = *model->m_analytic_ik_solver;
+    auto var_count = model->jointVariableCount();
+
+    std::vector<double> free(solver.freeVariableCount());
+    for (size_t i = 0; i < free.size(); ++i) {
+        free[i] = start[solver.freeVariableIndex(i)];
+    }
+
+    std::vector<double> free_seeds;
+    if (free.empty()) {
+        free_seeds.push_back(0.0);
+    } else {
+        auto fvidx = solver.freeVariableIndex(0);
+        if (model->vprops[fvidx].continuous) {
+            free[0] = smpl::angles::normalize_angle(free[0]);
+        }
+        MakeFreeVariableSeeds(model, fvidx, free[0], free_seeds);
+    }
+
+    auto first_new = solutions.size();
+    auto start_time = smpl::clock::now();
+    for (auto free_seed : free_seeds) {
+        if (to_seconds(smpl::clock::now() - start_time) >= model->m_timeout) {
+            ROS_DEBUG("IK Timed out in %f seconds", model->m_timeout);
+            return;
+        }
+
+        if (!free.empty()) {
+            free[0] = free_seed;
+        }
+
+        model->m_ik_solutions.clear();
+        auto count = solver.solve(pose, free.data(), model->m_ik_solutions);
+        for (auto sidx = 0; sidx < count; ++sidx) {
+            auto* q = &model->m_ik_solutions[sidx * var_count];
+            if (!IsWithinLimits(model, q)) {
+                continue;
+            }
+
+            RobotState solution(q, q + var_count);
+            for (auto i = 0; i < var_count; ++i) {
+                if (model->vprops[i].continuous) {
+                    solution[i] = smpl::angles::normalize_angle(solution[i]);
+                }
+            }
+
+            if (IsNewSolution(
+                    model,
+                    solutions.data() + first_new,
+                    solutions.data() + solutions.size(),
+                    solution))
+            {
+                solutions.push_back(std::move(solution));
+                if ((int)(solutions.size() - first_new) >= model->m_max_ik_solutions) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
 bool KDLRobotModel::computeIKSearch(
     const Eigen::Affine3d& pose,
     const RobotState& start,
     RobotState& solution)
 {
-    // transform into kinematics and convert to kdl
+    auto start_time = smpl::clock::now();
+
     auto* T_map_kinematics = GetLinkTransform(&this->robot_state, m_kinematics_link);
+
+    if (m_analytic_ik_solver) {
+        auto solved = AnalyticIKSearch(
+                this, T_map_kinematics->inverse() * pose, start, solution);
+        RecordIKCalls(
+                &m_analytic_ik_stats,
+                1,
+                solved,
+                to_seconds(smpl::clock::now() - start_time));
+        return solved;
+    }
+
+    auto solved = numericIKSearch(
+            T_map_kinematics->inverse() * pose, start, solution);
+    RecordIKCalls(
+            &m_numeric_ik_stats,
+            1,
+            solved,
+            to_seconds(smpl::clock::now() - start_time));
+    return solved;
+}
+
+bool KDLRobotModel::numericIKSearch(
+    const Eigen::Affine3d& pose,
+    const RobotState& start,
+    RobotState& solution)
+{
+    // convert to kdl; the pose is expressed in the kinematics frame
     KDL::Frame frame_des;
-    tf::transformEigenToKDL(T_map_kinematics->inverse() * pose, frame_des);
+    tf::transformEigenToKDL(pose, frame_des);
 
     // seed configuration
     for (size_t i = 0; i < start.size(); i++) {
@@ -246,7 +661,7 @@ bool KDLRobotModel::computeIKSearch(
     auto count = 0;
 
     auto num_positive_increments =
-            (int)((GetSolverMinPosition(this, m_free_angle) - initial_guess) /
+            (int)((GetSolverMaxPosition(this, m_free_angle) - initial_guess) /
                     this->m_search_discretization);
     auto num_negative_increments =
             (int)((initial_guess - GetSolverMinPosition(this, m_free_angle)) /
@@ -279,6 +694,139 @@ bool KDLRobotModel::computeIKSearch(
     return false;
 }
 
+/// Search for up to maxIKSolutions() distinct solutions, restarting the solver
+/// from values of the free variable in order of increasing distance from its
+/// seed value. Restarts are distributed over ikSearchThreadCount() threads and
+/// the search stops once enough solutions are found or the search timeout
+/// expires. Solutions are appended to \p solutions in the order of the
+/// restarts that found them.
+bool KDLRobotModel::computeMultipleIKSearch(
+    const Eigen::Affine3d& pose,
+    const RobotState& start,
+    std::vector<RobotState>& solutions)
+{
+    auto start_time = smpl::clock::now();
+
+    auto* T_map_kinematics = GetLinkTransform(&this->robot_state, m_kinematics_link);
+
+    auto prev_count = solutions.size();
+
+    if (m_analytic_ik_solver) {
+        AnalyticMultipleIKSearch(
+                this, T_map_kinematics->inverse() * pose, start, solutions);
+        RecordIKCalls(
+                &m_analytic_ik_stats,
+                1,
+                solutions.size() > prev_count,
+                to_seconds(smpl::clock::now() - start_time));
+        return solutions.size() > prev_count;
+    }
+
+    numericMultipleIKSearch(T_map_kinematics->inverse() * pose, start, solutions);
+    RecordIKCalls(
+            &m_numeric_ik_stats,
+            1,
+            solutions.size() > prev_count,
+            to_seconds(smpl::clock::now() - start_time));
+    return solutions.size() > prev_count;
+}
+
+void KDLRobotModel::numericMultipleIKSearch(
+    const Eigen::Affine3d& pose,
+    const RobotState& start,
+    std::vector<RobotState>& solutions)
+{
+    // convert to kdl; the pose is expressed in the kinematics frame
+    KDL::Frame frame_des;
+    tf::transformEigenToKDL(pose, frame_des);
+
+    // seed configuration
+    KDL::JntArray jnt_seed(m_chain.getNrOfJoints());
+    for (size_t i = 0; i < start.size(); i++) {
+        jnt_seed(i) = start[i];
+    }
+
+    // must be normalized for CartToJntSearch
+    NormalizeAngles(this, &jnt_seed);
+
+    std::vector<double> free_seeds;
+    MakeFreeVariableSeeds(this, m_free_angle, jnt_seed(m_free_angle), free_seeds);
+
+    auto num_threads = (int)m_ik_search_contexts.size();
+
+    // distinct solutions, tagged with the index of the restart that found them
+    std::vector<std::pair<size_t, RobotState>> found;
+    std::vector<RobotState> found_solutions;
+    std::mutex found_mutex;
+    std::atomic<bool> done(false);
+
+    auto start_time = smpl::clock::now();
+
+    // thread i tries restarts i, i + num_threads, ...
+    auto search = [&](int tidx)
+    {
+        auto& context = *m_ik_search_contexts[tidx];
+        context.jnt_pos_in = jnt_seed;
+
+        RobotState solution(start.size());
+        for (auto sidx = (size_t)tidx; sidx < free_seeds.size(); sidx += num_threads) {
+            if (done || to_seconds(smpl::clock::now() - start_time) >= m_timeout) {
+                return;
+            }
+
+            context.jnt_pos_in(m_free_angle) = free_seeds[sidx];
+            if (context.ik_solver->CartToJnt(
+                    context.jnt_pos_in, frame_des, context.jnt_pos_out) < 0)
+            {
+                continue;
+            }
+
+            NormalizeAngles(this, &context.jnt_pos_out);
+            for (size_t i = 0; i < solution.size(); ++i) {
+                solution[i] = context.jnt_pos_out(i);
+            }
+
+            std::unique_lock<std::mutex> lock(found_mutex);
+
+            // another thread may have reached the limit since the check above
+            if ((int)found.size() >= m_max_ik_solutions) {
+                done = true;
+                return;
+            }
+
+            if (!IsNewSolution(
+                    this,
+                    found_solutions.data(),
+                    found_solutions.data() + found_solutions.size(),
+                    solution))
+            {
+                continue;
+            }
+            found_solutions.push_back(solution);
+            found.emplace_back(sidx, solution);
+            if ((int)found.size() >= m_max_ik_solutions) {
+                done = true;
+            }
+        }
+    };
+
+    if (m_ik_search_pool) {
+        m_ik_search_pool->parallelFor(num_threads, search);
+    } else {
+        search(0);
+    }
+
+    std::sort(begin(found), end(found),
+            [](const std::pair<size_t, RobotState>& a,
+                const std::pair<size_t, RobotState>& b)
+            {
+                return a.first < b.first;
+            });
+    for (auto& f : found) {
+        solutions.push_back(std::move(f.second));
+    }
+}
+
 bool KDLRobotModel::computeIK(
     const Eigen::Affine3d& pose,
     const RobotState& start,
@@ -298,6 +846,13 @@ bool KDLRobotModel::computeIK(
     std::vector<RobotState>& solutions,
     ik_option::IkOption option)
 {
+    if (m_max_ik_solutions > 1) {
+        if (option != ik_option::UNRESTRICTED) {
+            return false;
+        }
+        return computeMultipleIKSearch(pose, start, solutions);
+    }
+
     // NOTE: only returns one solution
     RobotState solution;
     if (computeIK(pose, start, solution)) {
@@ -311,8 +866,27 @@ bool KDLRobotModel::computeFastIK(
     const RobotState& start,
     RobotState& solution)
 {
-    // transform into kinematics frame and convert to kdl
+    auto start_time = smpl::clock::now();
+
     auto* T_map_kinematics = GetLinkTransform(&this->robot_state, m_kinematics_link);
+
+    if (m_analytic_ik_solver) {
+        auto& solver = *m_analytic_ik_solver;
+        std::vector<double> free(solver.freeVariableCount());
+        for (size_t i = 0; i < free.size(); ++i) {
+            free[i] = start[solver.freeVariableIndex(i)];
+        }
+        auto solved = SolveAnalyticIK(
+                this, T_map_kinematics->inverse() * pose, free.data(), start, solution);
+        RecordIKCalls(
+                &m_analytic_ik_stats,
+                1,
+                solved,
+                to_seconds(smpl::clock::now() - start_time));
+        return solved;
+    }
+
+    // transform into kinematics frame and convert to kdl
     KDL::Frame frame_des;
     tf::transformEigenToKDL(T_map_kinematics->inverse() * pose, frame_des);
 
@@ -325,6 +899,11 @@ bool KDLRobotModel::computeFastIK(
     NormalizeAngles(this, &m_jnt_pos_in);
 
     if (m_ik_solver->CartToJnt(m_jnt_pos_in, frame_des, m_jnt_pos_out) < 0) {
+        RecordIKCalls(
+                &m_numeric_ik_stats,
+                1,
+                0,
+                to_seconds(smpl::clock::now() - start_time));
         return false;
     }
 
@@ -335,17 +914,133 @@ bool KDLRobotModel::computeFastIK(
         solution[i] = m_jnt_pos_out(i);
     }
 
+    RecordIKCalls(
+            &m_numeric_ik_stats,
+            1,
+            1,
+            to_seconds(smpl::clock::now() - start_time));
     return true;
 }
 
+void KDLRobotModel::computeFastIKBatch(
+    const Eigen::Affine3d* poses,
+    const RobotState* seeds,
+    std::size_t count,
+    RobotState* solutions,
+    bool* solved)
+{
+    if (!m_analytic_ik_solver) {
+        for (std::size_t i = 0; i < count; ++i) {
+            solved[i] = computeFastIK(poses[i], seeds[i], solutions[i]);
+        }
+        return;
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    auto start_time = smpl::clock::now();
+
+    auto& solver = *m_analytic_ik_solver;
+    auto free_count = solver.freeVariableCount();
+
+    auto* T_map_kinematics = GetLinkTransform(&this->robot_state, m_kinematics_link);
+    Eigen::Affine3d T_kinematics_map = T_map_kinematics->inverse();
+
+    std::vector<Eigen::Affine3d, Eigen::aligned_allocator<Eigen::Affine3d>> kposes(count);
+    std::vector<double> free(count * free_count);
+    for (std::size_t i = 0; i < count; ++i) {
+        kposes[i] = T_kinematics_map * poses[i];
+        for (auto j = 0; j < free_count; ++j) {
+            free[i * free_count + j] = seeds[i][solver.freeVariableIndex(j)];
+        }
+    }
+
+    std::vector<int> solution_counts(count);
+    m_ik_solutions.clear();
+    solver.solveBatch(
+            kposes.data(),
+            free.data(),
+            count,
+            m_ik_solutions,
+            solution_counts.data());
+
+    auto num_solved = 0;
+    auto* q = m_ik_solutions.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        solved[i] = SelectAnalyticSolution(
+                this, q, solution_counts[i], seeds[i], solutions[i]);
+        num_solved += solved[i];
+        q += solution_counts[i] * jointVariableCount();
+    }
+
+    RecordIKCalls(
+            &m_analytic_ik_stats,
+            (int)count,
+            num_solved,
+            to_seconds(smpl::clock::now() - start_time));
+}
+
 void KDLRobotModel::printRobotModelInformation()
 {
     leatherman::printKDLChain(m_chain, "robot_model");
 }
 
+bool KDLRobotModel::setAnalyticIKSolver(const AnalyticIKSolverPtr& solver)
+{
+    if (!solver) {
+        m_analytic_ik_solver.reset();
+        return true;
+    }
+
+    if (m_base_link != solver->baseLink() || m_tip_link != solver->tipLink()) {
+        ROS_ERROR("Analytic IK solver was generated for chain (%s, %s), not (%s, %s)", solver->baseLink(), solver->tipLink(), m_base_link.c_str(), m_tip_link.c_str());
+        return false;
+    }
+
+    if (solver->jointVariableCount() != jointVariableCount()) {
+        ROS_ERROR("Analytic IK solver has %d joint variables, chain has %d", solver->jointVariableCount(), jointVariableCount());
+        return false;
+    }
+
+    for (auto i = 0; i < solver->freeVariableCount(); ++i) {
+        auto vidx = solver->freeVariableIndex(i);
+        if (vidx < 0 || vidx >= jointVariableCount()) {
+            ROS_ERROR("Analytic IK solver free variable index %d is out of range", vidx);
+            return false;
+        }
+    }
+
+    m_analytic_ik_solver = solver;
+    return true;
+}
+
+auto KDLRobotModel::analyticIKSolver() const -> const AnalyticIKSolverPtr&
+{
+    return m_analytic_ik_solver;
+}
+
+auto KDLRobotModel::analyticIKStats() const -> const IKSolverStats&
+{
+    return m_analytic_ik_stats;
+}
+
+auto KDLRobotModel::numericIKStats() const -> const IKSolverStats&
+{
+    return m_numeric_ik_stats;
+}
+
+void KDLRobotModel::resetIKStats()
+{
+    m_analytic_ik_stats = IKSolverStats();
+    m_numeric_ik_stats = IKSolverStats();
+}
+
 auto KDLRobotModel::getExtension(size_t class_code) -> Extension*
 {
     if (class_code == GetClassCode<InverseKinematicsInterface>()) return this;
+    if (class_code == GetClassCode<BatchRedundantManipulatorInterface>()) return this;
     return URDFRobotModel::getExtension(class_code);
 }
 
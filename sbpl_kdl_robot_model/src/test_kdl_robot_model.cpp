@@ -79,6 +79,15 @@ int main(int argc, char* argv[])
     ROS_WARN("Robot Model Information");
     rm.printRobotModelInformation();
 
+    std::string analytic_ik_path;
+    if (ph.getParam("analytic_ik_solver", analytic_ik_path)) {
+        auto solver = smpl::LoadAnalyticIKSolver(analytic_ik_path);
+        if (!solver || !rm.setAnalyticIKSolver(solver)) {
+            ROS_ERROR("Failed to use analytic ik solver '%s'", analytic_ik_path.c_str());
+            return 0;
+        }
+    }
+
     smpl::RobotState fka(planning_joints.size(), 0.0);
     fka[0] = -0.5;
     fka[1] = -0.3;
@@ -113,6 +122,29 @@ int main(int argc, char* argv[])
     ROS_INFO("[fk]  input_angles: % 0.3f % 0.3f % 0.3f % 0.3f % 0.3f % 0.3f % 0.3f pose: %s",
             ika[0], ika[1], ika[2], ika[3], ika[4], ika[5], ika[6], buff);
 
+    int max_ik_solutions;
+    int ik_search_threads;
+    ph.param("max_ik_solutions", max_ik_solutions, 4);
+    ph.param("ik_search_threads", ik_search_threads, 0);
+    rm.setMaxIKSolutions(max_ik_solutions);
+    rm.setIKSearchThreadCount(ik_search_threads);
+
+    std::vector<smpl::RobotState> solutions;
+    rm.computeIK(pose, seed, solutions);
+    ROS_INFO("[ik] found %zu distinct solutions using %d threads",
+            solutions.size(), rm.ikSearchThreadCount());
+    for (auto& s : solutions) {
+        ROS_INFO("[ik]   % 0.3f % 0.3f % 0.3f % 0.3f % 0.3f % 0.3f % 0.3f",
+                s[0], s[1], s[2], s[3], s[4], s[5], s[6]);
+    }
+
+    auto& ik_stats = rm.analyticIKSolver() ? rm.analyticIKStats() : rm.numericIKStats();
+    ROS_INFO("[ik] calls: %d, solved: %d, total time: %f, max time: %f",
+            ik_stats.num_calls,
+            ik_stats.num_solved,
+            ik_stats.total_time,
+            ik_stats.max_time);
+
     ROS_INFO("done");
     return 1;
 }
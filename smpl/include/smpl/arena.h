@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_ARENA_H
+#define SMPL_ARENA_H
+
+// standard includes
+#include <assert.h>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace smpl {
+
+/// A slab allocator for many small objects of the same size, such as the
+/// nodes of a search.
+///
+/// Blocks of a fixed size are carved, in order, out of large contiguous
+/// chunks. Individual blocks are never freed; instead, all blocks are returned
+/// to the arena at once by reset(), which retains the chunks for reuse, or by
+/// release(), which returns them to the system. Objects constructed in the
+/// arena are not destroyed by either, so the arena should only hold trivially
+/// destructible types unless the owner destroys them explicitly.
+///
+/// The block size is fixed when the arena is empty, which allows the arena to
+/// hold objects whose size is only known at runtime, e.g. structures that are
+/// overallocated for a variable number of trailing elements. Blocks are
+/// aligned for any fundamental type.
+///
+/// Chunks are allocated, and first written, by the thread that calls
+/// allocate(), so under a first-touch memory policy they are local to the node
+/// that thread runs on.
+class Arena
+{
+public:
+
+    explicit Arena(size_t block_size = 0, size_t blocks_per_chunk = 4096);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    size_t blockSize() const { return m_block_size; }
+
+    /// \brief Set the size of each block. All memory held by the arena is
+    ///     released.
+    void setBlockSize(size_t block_size);
+
+    size_t blocksPerChunk() const { return m_blocks_per_chunk; }
+
+    /// \brief Return a pointer to uninitialized storage for one block.
+    void* allocate();
+
+    /// \brief Default-construct an object of type T in a new block.
+    template <class T>
+    T* create()
+    {
+        assert(sizeof(T) <= m_block_size);
+        return new (allocate()) T;
+    }
+
+    /// \brief Return all blocks to the arena, keeping the chunks that hold them
+    ///     for reuse.
+    void reset();
+
+    /// \brief Return all blocks to the arena and free all chunks.
+    void release();
+
+    /// \brief Return the number of blocks allocated since the last reset.
+    size_t size() const { return m_size; }
+
+    /// \brief Return the number of blocks that may be allocated before
+    ///     another chunk is required.
+    size_t capacity() const { return m_chunks.size() * m_blocks_per_chunk; }
+
+private:
+
+    size_t m_block_size;
+    size_t m_blocks_per_chunk;
+
+    std::vector<char*> m_chunks;
+
+    // number of chunks from which blocks have been allocated
+    size_t m_chunks_used;
+
+    // remaining storage in the current chunk
+    char* m_next;
+    char* m_end;
+
+    size_t m_size;
+};
+
+} // namespace smpl
+
+#endif
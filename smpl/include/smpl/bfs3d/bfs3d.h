@@ -53,6 +53,23 @@ public:
 
     void getDimensions(int* length, int* width, int* height);
 
+    /// \brief Enable or disable lazy evaluation of the BFS.
+    ///
+    /// When lazy evaluation is enabled, run() does not flood the grid in a
+    /// background thread. Instead, the wavefront is advanced on the calling
+    /// thread only as far as necessary to discover the cells queried via
+    /// getDistance() and isUndiscovered(). Since all edges have unit cost, the
+    /// distance to a cell is final once it has been discovered.
+    void setLazy(bool lazy);
+    bool lazy() const { return m_lazy; }
+
+    /// \brief Set the number of cells expanded eagerly by run() in lazy mode.
+    ///
+    /// A negative budget expands the entire reachable region up front, which
+    /// is equivalent to a non-lazy BFS run on the calling thread.
+    void setPrecomputeBudget(int expansions);
+    int precomputeBudget() const { return m_precompute_budget; }
+
     void setWall(int x, int y, int z);
 
     // \brief Clear cells around a given cell until freespace is encountered.
@@ -77,14 +94,17 @@ public:
     /// \brief Return the distance, in cells, to the nearest occupied cell.
     ///
     /// This function is blocking if the BFS is running in parallel and a value
-    /// has not yet been computed for this cell.
+    /// has not yet been computed for this cell. In lazy mode, the wavefront is
+    /// advanced until a value has been computed for this cell.
     int getDistance(int x, int y, int z) const;
 
     /// \brief Return whether this cell has been discovered.
     ///
     /// This function is blocking if the BFS is running. Once the BFS has
     /// finished, this function will return true for cells that are isolated
-    /// from the region of the grid containing the start cell.
+    /// from the region of the grid containing the start cell. In lazy mode, the
+    /// wavefront is advanced until this cell is discovered or the wavefront is
+    /// exhausted.
     bool isUndiscovered(int x, int y, int z) const;
 
     int getNearestFreeNodeDist(int x, int y, int z);
@@ -106,10 +126,15 @@ private:
     int volatile* m_distance_grid;
 
     int* m_queue;
-    int m_queue_head, m_queue_tail;
+
+    // advanced by const accessors when running in lazy mode
+    mutable int m_queue_head, m_queue_tail;
 
     volatile bool m_running;
 
+    bool m_lazy;
+    int m_precompute_budget;
+
     int m_neighbor_offsets[26];
     std::vector<bool> m_closed;
     std::vector<int> m_distances;
@@ -142,6 +167,8 @@ private:
         int& frontier_queue_head,
         int& frontier_queue_tail);
 
+    void resume(int node, int max_expansions) const;
+
     template <typename Visitor>
     void visit_free_cells(int node, const Visitor& visitor);
 };
@@ -184,6 +211,11 @@ void BFS_3D::run(InputIt cells_begin, InputIt cells_end)
 
     m_queue_tail = start_count;
 
+    if (m_lazy) {
+        resume(-1, m_precompute_budget);
+        return;
+    }
+
     // fire off background thread to compute bfs
     m_search_thread = std::thread([&]()
     {
@@ -34,6 +34,7 @@
 #define SMPL_COLLISION_CHECKER_H
 
 // standard includes
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -111,6 +112,102 @@ public:
         const RobotState& finish) = 0;
 };
 
+/// Extension for collision checkers that can check for collisions between parts
+/// of the robot separately from collisions between the robot and its
+/// environment.
+///
+/// Together, the two categories of checks must cover exactly the checks made
+/// by isStateValid() and isStateToStateValid(). Self collision checks should
+/// depend only on the positions of the planning variables, so that they may be
+/// precomputed, e.g. by a PrimitiveCollisionTable; collisions with parts of
+/// the robot that move independently of the planning variables, or with
+/// attached objects, belong to the environment.
+class SelfCollisionCheckerExtension : public virtual Extension
+{
+public:
+
+    /// Return whether a state is free of collisions between parts of the
+    /// robot.
+    virtual bool isStateSelfValid(
+        const RobotState& state,
+        bool verbose = false) = 0;
+
+    /// Return whether the interpolated path between two states is free of
+    /// collisions between parts of the robot.
+    virtual bool isStateToStateSelfValid(
+        const RobotState& start,
+        const RobotState& finish,
+        bool verbose = false) = 0;
+
+    /// Return whether a state is free of collisions with the environment,
+    /// ignoring collisions between parts of the robot.
+    virtual bool isStateWorldValid(
+        const RobotState& state,
+        bool verbose = false) = 0;
+
+    /// Return whether the interpolated path between two states is free of
+    /// collisions with the environment, ignoring collisions between parts of
+    /// the robot.
+    virtual bool isStateToStateWorldValid(
+        const RobotState& start,
+        const RobotState& finish,
+        bool verbose = false) = 0;
+};
+
+/// Extension for collision checkers that can produce independent copies of
+/// themselves for use by concurrent callers (parallel search, shortcutting,
+/// benchmarking).
+///
+/// A clone shares the immutable parts of the collision model (the robot model,
+/// the world representation, and the allowed collision matrix as of the time
+/// of cloning) with its source, but owns all of the mutable state required to
+/// answer queries. The contract is:
+///
+/// * Each clone, and the source, may be queried from a different thread
+///   concurrently. A single checker must never be used from more than one
+///   thread at a time.
+/// * Clones reflect the source as it was when clone() was called. The source
+///   must not be modified (world updates, attached objects, allowed
+///   collisions, padding, joint positions outside the planning group) while
+///   any of its clones are in use; clones should be discarded and recreated
+///   after such modifications.
+/// * clone() itself must be called from the thread that owns the source.
+class CloneableCollisionCheckerExtension : public virtual Extension
+{
+public:
+
+    /// Return a new collision checker, equivalent to this one, that may be
+    /// used concurrently with it. Returns null if a clone could not be made.
+    virtual auto clone() -> std::unique_ptr<CollisionChecker> = 0;
+};
+
+/// Extension for collision checkers whose environment contains obstacles with
+/// known motion. Times are measured in seconds from the start of the plan.
+class TimedCollisionCheckerExtension : public virtual Extension
+{
+public:
+
+    /// Return whether the environment contains any obstacles with known
+    /// motion. When it does not, the queries below are equivalent to those of
+    /// CollisionChecker, and callers may use those instead.
+    virtual bool hasTimedObstacles() = 0;
+
+    /// Return whether a state is valid at a given time.
+    virtual bool isStateValidAtTime(
+        const RobotState& state,
+        double time,
+        bool verbose = false) = 0;
+
+    /// Return whether a motion is valid, given that it starts at start_time
+    /// and arrives at finish_time, progressing uniformly in between.
+    virtual bool isStateToStateValidAtTime(
+        const RobotState& start,
+        double start_time,
+        const RobotState& finish,
+        double finish_time,
+        bool verbose = false) = 0;
+};
+
 } // namespace smpl
 
 #endif
@@ -33,9 +33,13 @@
 #include <smpl/geometry/shortcut.h>
 
 // standard includes
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 
+// project includes
+#include <smpl/thread_pool.h>
+
 namespace smpl {
 namespace shortcut {
 
@@ -437,8 +441,392 @@ bool DivideAndConquerShortcutPath(
     return true;
 }
 
+// The result of asking one path generator for a shortcut between two points
+template <typename PointType, typename CostType>
+struct ShortcutResult
+{
+    bool valid;
+    CostType cost;
+    std::vector<PointType> path;
+};
+
+// Evaluate a batch of shortcut requests concurrently. Request i is answered by
+// generator (i % num_generators) of the copy of the generators owned by the
+// worker that runs it. Each worker handles a fixed stride of the requests so
+// that no copy is ever used by two threads at once.
+template <
+    typename PointIt,
+    typename GeneratorIt,
+    typename PointType,
+    typename CostType,
+    typename EndpointsFn>
+void EvaluateShortcuts(
+    ThreadPool& pool,
+    const std::vector<PointIt>& points,
+    GeneratorIt gfirst,
+    size_t num_generators,
+    size_t num_workers,
+    size_t num_requests,
+    const EndpointsFn& endpoints,
+    std::vector<ShortcutResult<PointType, CostType>>& results)
+{
+    if (results.size() < num_requests) {
+        results.resize(num_requests);
+    }
+
+    pool.parallelFor((int)std::min(num_workers, num_requests), [&](int w)
+    {
+        auto wgfirst = gfirst;
+        std::advance(wgfirst, w * num_generators);
+        for (size_t i = w; i < num_requests; i += num_workers) {
+            auto git = wgfirst;
+            std::advance(git, i % num_generators);
+
+            size_t from, to;
+            endpoints(i / num_generators, from, to);
+
+            auto& r = results[i];
+            r.path.clear();
+            r.valid = (*git)(
+                    *points[from], *points[to],
+                    std::back_inserter(r.path), r.cost);
+        }
+    });
+}
+
+template <
+    typename InputPathIt,
+    typename InputCostIt,
+    typename GeneratorIt,
+    typename OutputPathIt,
+    typename CostCompare>
+bool ParallelShortcutPath(
+    ThreadPool& pool,
+    InputPathIt pfirst, InputPathIt plast,
+    InputCostIt cfirst, InputCostIt clast,
+    GeneratorIt gfirst, GeneratorIt glast,
+    size_t num_generators,
+    OutputPathIt ofirst,
+    size_t window,
+    size_t granularity,
+    const CostCompare& leq)
+{
+    typedef typename std::iterator_traits<InputPathIt>::value_type PointType;
+    typedef typename std::iterator_traits<InputCostIt>::value_type CostType;
+
+    const size_t gsize = (size_t)std::distance(gfirst, glast);
+    const size_t num_workers = num_generators ? gsize / num_generators : 0;
+    if (num_workers == 0 || granularity == 0) {
+        return ShortcutPath(
+                pfirst, plast,
+                cfirst, clast,
+                gfirst, gfirst,
+                ofirst,
+                window,
+                granularity,
+                leq);
+    }
+
+    const size_t psize = (size_t)std::distance(pfirst, plast);
+    const size_t csize = (size_t)std::distance(cfirst, clast);
+
+    if (psize == 0) {
+        return true;
+    }
+
+    // in all other cases, assert one cost per point transition
+    if (psize != csize + 1) {
+        return false;
+    }
+
+    // nothing to do with a trivial path
+    if (psize < 2) {
+        for (auto pit = pfirst; pit != plast; ++pit) {
+            *ofirst++ = *pit;
+        }
+        return true;
+    }
+
+    // gather the accumulated original costs per point
+    std::vector<CostType> accum(psize);
+    accum[0] = (CostType)0;
+    auto cit = cfirst;
+    for (size_t i = 1; i < accum.size(); ++i) {
+        accum[i] = accum[i - 1] + *cit++;
+    }
+
+    std::vector<InputPathIt> points(psize);
+    {
+        auto pit = pfirst;
+        for (size_t i = 0; i < psize; ++i) {
+            points[i] = pit++;
+        }
+    }
+
+    // the k'th point considered as the end of the segment beginning at s
+    auto lookahead = [&](size_t s, size_t k) {
+        return std::min(s + k * granularity, psize - 1);
+    };
+
+    // number of lookahead points speculatively evaluated per batch
+    const size_t batch_size = num_workers;
+
+    std::vector<ShortcutResult<PointType, CostType>> results;
+
+    // the best path found for the segment of interest, either the original
+    // path or a path returned from a generator
+    bool best_is_original = true;
+    std::vector<PointType> best_path;
+    CostType best_cost;
+
+    auto record_best_path = [&](size_t s, size_t e) {
+        if (best_is_original) {
+            for (size_t i = s + 1; i <= e; ++i) {
+                *ofirst++ = *points[i];
+            }
+        } else {
+            auto bit = best_path.begin(); ++bit;
+            for (; bit != best_path.end(); ++bit) {
+                *ofirst++ = *bit;
+            }
+        }
+    };
+
+    *ofirst++ = *pfirst;
+
+    size_t s = 0; // start of the segment of interest
+    size_t e = 0; // end of the segment of interest
+    size_t k = 1; // index of the next lookahead point to consume
+    while (true) {
+        // request shortcuts to the next batch of lookahead points
+        size_t kfirst = k;
+        size_t count = 0;
+        while (count < batch_size && (count == 0 || lookahead(s, kfirst + count - 1) != psize - 1)) {
+            ++count;
+        }
+
+        EvaluateShortcuts<InputPathIt, GeneratorIt, PointType, CostType>(
+                pool, points, gfirst, num_generators, num_workers,
+                count * num_generators,
+                [&](size_t j, size_t& from, size_t& to) {
+                    from = s;
+                    to = lookahead(s, kfirst + j);
+                },
+                results);
+
+        // consume the results in the order they would have been requested
+        bool rejected = false;
+        for (size_t j = 0; j < count; ++j, ++k) {
+            size_t t = lookahead(s, k);
+            auto* r = &results[j * num_generators];
+
+            if (k == 1) {
+                // initialize the best path for a brand new segment of interest
+                best_is_original = true;
+                best_cost = accum[t] - accum[s];
+                for (size_t gi = 0; gi < num_generators; ++gi) {
+                    if (r[gi].valid && leq(r[gi].cost, best_cost)) {
+                        best_is_original = false;
+                        best_cost = r[gi].cost;
+                        best_path.swap(r[gi].path);
+                    }
+                }
+                e = t;
+                continue;
+            }
+
+            CostType new_cost = best_cost + (accum[t] - accum[e]);
+            bool cost_improved = false;
+            for (size_t gi = 0; gi < num_generators; ++gi) {
+                if (r[gi].valid && leq(r[gi].cost, new_cost)) {
+                    cost_improved = true;
+                    best_is_original = false;
+                    new_cost = r[gi].cost;
+                    best_path.swap(r[gi].path);
+                }
+            }
+            best_cost = new_cost;
+
+            if (cost_improved) {
+                e = t;
+            } else {
+                // begin a new segment of interest at the end of this one
+                record_best_path(s, e);
+                s = e;
+                k = 1;
+                rejected = true;
+                break;
+            }
+        }
+
+        if (!rejected && e == psize - 1) {
+            break;
+        }
+    }
+
+    record_best_path(s, e);
+    return true;
+}
+
+template <
+    typename InputPathIt,
+    typename InputCostIt,
+    typename GeneratorIt,
+    typename OutputPathIt,
+    typename CostCompare>
+bool ParallelDivideAndConquerShortcutPath(
+    ThreadPool& pool,
+    InputPathIt pfirst, InputPathIt plast,
+    InputCostIt cfirst, InputCostIt clast,
+    GeneratorIt gfirst, GeneratorIt glast,
+    size_t num_generators,
+    OutputPathIt ofirst,
+    const CostCompare& leq)
+{
+    typedef typename std::iterator_traits<InputPathIt>::value_type PointType;
+    typedef typename std::iterator_traits<InputCostIt>::value_type CostType;
+
+    const size_t gsize = (size_t)std::distance(gfirst, glast);
+    const size_t num_workers = num_generators ? gsize / num_generators : 0;
+    if (num_workers == 0) {
+        return DivideAndConquerShortcutPath(
+                pfirst, plast, cfirst, clast, gfirst, gfirst, ofirst, leq);
+    }
+
+    const size_t psize = std::distance(pfirst, plast);
+    const size_t csize = std::distance(cfirst, clast);
+
+    if (psize == 0) {
+        return true;
+    }
+
+    if (psize != csize + 1) {
+        return false;
+    }
+
+    if (psize < 2) {
+        for (auto pit = pfirst; pit != plast; ++pit) {
+            *ofirst++ = *pit;
+        }
+        return true;
+    }
+
+    // compute accumulated costs at each point
+    std::vector<CostType> accum(psize);
+    accum[0] = (CostType)0;
+    auto cit = cfirst;
+    for (size_t i = 1; i < accum.size(); ++i) {
+        accum[i] = accum[i - 1] + *cit++;
+    }
+
+    std::vector<InputPathIt> points(psize);
+    {
+        auto pit = pfirst;
+        for (size_t i = 0; i < psize; ++i) {
+            points[i] = pit++;
+        }
+    }
+
+    struct Segment
+    {
+        size_t first;
+        size_t last;
+        bool resolved;
+        std::vector<PointType> path; // shortcut path, if one was found
+    };
+
+    // the segments covering the path, in order
+    std::vector<Segment> segments(1);
+    segments[0].first = 0;
+    segments[0].last = psize - 1;
+    segments[0].resolved = false;
+
+    std::vector<size_t> pending;
+    std::vector<ShortcutResult<PointType, CostType>> results;
+
+    while (true) {
+        // segments of a single transition can't be shortcut any further
+        pending.clear();
+        for (size_t i = 0; i < segments.size(); ++i) {
+            auto& seg = segments[i];
+            if (!seg.resolved) {
+                if (seg.last - seg.first == 1) {
+                    seg.resolved = true;
+                } else {
+                    pending.push_back(i);
+                }
+            }
+        }
+
+        if (pending.empty()) {
+            break;
+        }
+
+        // ask every generator for a shortcut for each unresolved segment
+        EvaluateShortcuts<InputPathIt, GeneratorIt, PointType, CostType>(
+                pool, points, gfirst, num_generators, num_workers,
+                pending.size() * num_generators,
+                [&](size_t j, size_t& from, size_t& to) {
+                    from = segments[pending[j]].first;
+                    to = segments[pending[j]].last;
+                },
+                results);
+
+        // accept the best shortcut for each segment or divide it in two
+        std::vector<Segment> next;
+        next.reserve(segments.size() + pending.size());
+        size_t j = 0;
+        for (auto& seg : segments) {
+            if (seg.resolved) {
+                next.push_back(std::move(seg));
+                continue;
+            }
+
+            auto* r = &results[j++ * num_generators];
+            bool cost_improved = false;
+            CostType best_cost = accum[seg.last] - accum[seg.first];
+            for (size_t gi = 0; gi < num_generators; ++gi) {
+                if (r[gi].valid && leq(r[gi].cost, best_cost)) {
+                    cost_improved = true;
+                    best_cost = r[gi].cost;
+                    seg.path.swap(r[gi].path);
+                }
+            }
+
+            if (cost_improved) {
+                seg.resolved = true;
+                next.push_back(std::move(seg));
+            } else {
+                size_t mid = seg.first + ((seg.last - seg.first) >> 1);
+                Segment left, right;
+                left.first = seg.first;
+                left.last = mid;
+                left.resolved = false;
+                right.first = mid;
+                right.last = seg.last;
+                right.resolved = false;
+                next.push_back(std::move(left));
+                next.push_back(std::move(right));
+            }
+        }
+        segments.swap(next);
+    }
+
+    *ofirst++ = *pfirst;
+    for (auto& seg : segments) {
+        if (seg.path.empty()) {
+            *ofirst++ = *points[seg.last];
+        } else {
+            auto pit = seg.path.begin(); ++pit;
+            for (; pit != seg.path.end(); ++pit) {
+                *ofirst++ = *pit;
+            }
+        }
+    }
+    return true;
+}
+
 } // namespace shortcut
 } // namespace smpl
 
 #endif
-
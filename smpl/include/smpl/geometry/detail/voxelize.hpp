@@ -32,6 +32,9 @@
 
 #include <smpl/geometry/voxelize.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <smpl/geometry/utils.h>
 
 namespace smpl {
@@ -50,6 +53,26 @@ void VoxelizeTriangle(
     const Vector3& b,
     const Vector3& c,
     VoxelGrid<Discretizer>& vg)
+{
+    VoxelizeTriangle(
+            a, b, c,
+            vg.memoryToGrid(MemoryCoord(0, 0, 0)).x,
+            vg.memoryToGrid(MemoryCoord(vg.sizeX() - 1, 0, 0)).x,
+            vg);
+}
+
+/// \brief Voxelize the part of a triangle within a range of grid x coordinates
+///
+/// Only voxels with grid x coordinates in [min_gx, max_gx] are filled, so that
+/// disjoint ranges of the same voxel grid may be filled concurrently.
+template <typename Discretizer>
+void VoxelizeTriangle(
+    const Vector3& a,
+    const Vector3& b,
+    const Vector3& c,
+    int min_gx,
+    int max_gx,
+    VoxelGrid<Discretizer>& vg)
 {
     Vector3 p1 = a;
     Vector3 p2 = b;
@@ -114,23 +137,41 @@ void VoxelizeTriangle(
     double d2 = -e2.dot(p2);
     double d3 = -e3.dot(p3);
 
-    Vector3 mintri;
-    Vector3 maxtri;
-    std::vector<Vector3> tri_verts(3);
-    tri_verts[0] = a;
-    tri_verts[1] = b;
-    tri_verts[2] = c;
-    ComputeAxisAlignedBoundingBox(tri_verts, mintri, maxtri);
+    const Vector3 mintri = a.cwiseMin(b).cwiseMin(c);
+    const Vector3 maxtri = a.cwiseMax(b).cwiseMax(c);
 
     const WorldCoord minwc(mintri.x(), mintri.y(), mintri.z());
     const WorldCoord maxwc(maxtri.x(), maxtri.y(), maxtri.z());
     const GridCoord mingc = vg.worldToGrid(minwc);
     const GridCoord maxgc = vg.worldToGrid(maxwc);
 
+    // every criterion below is satisfied only by voxels within rc (vertices
+    // and edges, which lie in the plane) or t (thickness) of the triangle
+    // plane, so each column of voxels is clipped to the slab around the plane.
+    // t may exceed rc slightly, since the corner directions above are rounded
+    // up from 1/sqrt(3).
+    const double nz_eps = 1e-9;
+    const double slab_radius = std::max(rc, t) * (1.0 + 1e-6);
+
     // consider all voxels that this triangle can voxelize
-    for (int gx = mingc.x; gx <= maxgc.x; gx++) {
+    for (int gx = std::max(mingc.x, min_gx); gx <= std::min(maxgc.x, max_gx); gx++) {
     for (int gy = mingc.y; gy <= maxgc.y; gy++) {
-    for (int gz = mingc.z; gz <= maxgc.z; gz++) {
+        int min_gz = mingc.z;
+        int max_gz = maxgc.z;
+        if (std::fabs(n.z()) > nz_eps) {
+            const WorldCoord cwc = vg.gridToWorld(GridCoord(gx, gy, mingc.z));
+            const double c0 = n.x() * cwc.x + n.y() * cwc.y + d;
+            double zlo = (-slab_radius - c0) / n.z();
+            double zhi = (slab_radius - c0) / n.z();
+            if (zlo > zhi) {
+                std::swap(zlo, zhi);
+            }
+            // widen by a cell to absorb rounding in the discretization
+            min_gz = std::max(min_gz, vg.worldToGrid(WorldCoord(cwc.x, cwc.y, zlo)).z - 1);
+            max_gz = std::min(max_gz, vg.worldToGrid(WorldCoord(cwc.x, cwc.y, zhi)).z + 1);
+        }
+
+    for (int gz = min_gz; gz <= max_gz; gz++) {
         const GridCoord gc(gx, gy, gz);
         if (vg[gc]) {
             continue;
@@ -138,12 +179,17 @@ void VoxelizeTriangle(
 
         const WorldCoord wc = vg.gridToWorld(gc);
 
-        // TODO: shortcut based off of distance to triangle plane?
-
         // check if the voxel point is in the plane of the triangle and
         // within the edges
         const Vector3 voxel_p(wc.x, wc.y, wc.z);
 
+        // allow a small tolerance so that rounding can't exclude a voxel
+        // accepted by the tests below
+        const double ndp = n.dot(voxel_p);
+        if (std::fabs(ndp + d) > slab_radius) {
+            continue;
+        }
+
         Vector3 dx1 = voxel_p - p1;
         Vector3 dx2 = voxel_p - p2;
         Vector3 dx3 = voxel_p - p3;
@@ -164,12 +210,9 @@ void VoxelizeTriangle(
             vg[gc] = 1;
         }
         else {
-            double ddd = n.dot(voxel_p) + (d + t);
-            double ddd1 = n.dot(voxel_p) + (d - t);
             if (// then check for...
                 // ...inside triangle thickness
-                utils::sign(n.dot(voxel_p) + (d + t)) !=
-                        utils::sign(n.dot(voxel_p) + (d - t)) &&
+                utils::sign(ndp + (d + t)) != utils::sign(ndp + (d - t)) &&
                 // ...inside the edge bounding planes
                 (e1.dot(voxel_p) + d1 > 0.0) &&
                 (e2.dot(voxel_p) + d2 > 0.0) &&
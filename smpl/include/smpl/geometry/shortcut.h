@@ -35,6 +35,9 @@
 #include <vector>
 
 namespace smpl {
+
+class ThreadPool;
+
 namespace shortcut {
 
 /// \brief Convenience class for specifying path generator requirements
@@ -187,6 +190,66 @@ bool DivideAndConquerShortcutPath(
     OutputPathIt ofirst,
     const CostCompare& leq = CostCompare());
 
+/// \brief Apply iterative path shortcutting to a range of path elements,
+///     evaluating candidate shortcuts concurrently.
+///
+/// Produces the same path as the equivalent call to ShortcutPath. Rather than
+/// asking the path generators for one shortcut at a time, the shortcuts from
+/// the start of the current segment to each of the next several lookahead
+/// points are requested concurrently, and the results are then consumed in
+/// the order the sequential routine would have requested them. Results past
+/// the first rejected shortcut are discarded.
+///
+/// Path generators are not required to be safe to call concurrently. Instead,
+/// the range [gfirst, glast) must contain one copy of the sequence of
+/// \p num_generators path generators for each worker, and each copy is only
+/// ever called from one thread at a time. Typically, each copy refers to a
+/// different collision checker.
+///
+/// \param pool The thread pool used to evaluate shortcuts
+/// \param num_generators The number of path generators in each copy
+template <
+    typename InputPathIt,
+    typename InputCostIt,
+    typename GeneratorIt,
+    typename OutputPathIt,
+    typename CostCompare = std::less_equal<
+            typename std::iterator_traits<InputCostIt>::value_type>>
+bool ParallelShortcutPath(
+    ThreadPool& pool,
+    InputPathIt pfirst, InputPathIt plast,
+    InputCostIt cfirst, InputCostIt clast,
+    GeneratorIt gfirst, GeneratorIt glast,
+    size_t num_generators,
+    OutputPathIt ofirst,
+    size_t window = 1,
+    size_t granularity = 1,
+    const CostCompare& leq = CostCompare());
+
+/// \brief Apply recursive path shortcutting to a range of path elements,
+///     evaluating candidate shortcuts concurrently.
+///
+/// Produces the same path as the equivalent call to
+/// DivideAndConquerShortcutPath. The recursion is unrolled breadth-first so
+/// that all segments at the same depth are shortcut concurrently. The
+/// requirements on the path generators are the same as for
+/// ParallelShortcutPath.
+template <
+    typename InputPathIt,
+    typename InputCostIt,
+    typename GeneratorIt,
+    typename OutputPathIt,
+    typename CostCompare = std::less_equal<
+            typename std::iterator_traits<InputCostIt>::value_type>>
+bool ParallelDivideAndConquerShortcutPath(
+    ThreadPool& pool,
+    InputPathIt pfirst, InputPathIt plast,
+    InputCostIt cfirst, InputCostIt clast,
+    GeneratorIt gfirst, GeneratorIt glast,
+    size_t num_generators,
+    OutputPathIt ofirst,
+    const CostCompare& leq = CostCompare());
+
 } // namespace shortcut
 } // namespace smpl
 
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_SO3_GRID_H
+#define SMPL_SO3_GRID_H
+
+// standard includes
+#include <vector>
+
+// project includes
+#include <smpl/spatial.h>
+
+namespace smpl {
+namespace geometry {
+
+/// \brief A uniform discretization of the rotation group SO(3)
+///
+/// The grid is constructed from the Hopf fibration of the unit quaternions, as
+/// described in Yershova et al., "Generating Uniform Incremental Grids on SO(3)
+/// Using the Hopf Fibration". Rotations are parameterized by a direction on
+/// the 2-sphere and an angle about it. The 2-sphere is discretized by the
+/// HEALPix ring scheme with 12 * nside^2 cells, and the circle by 6 * nside
+/// evenly spaced cells, giving 72 * nside^3 cells of nearly equal volume and
+/// shape. Unlike independent bins for roll, pitch, and yaw, cells do not
+/// crowd together near pitch = +/-pi/2.
+///
+/// The center of each cell and the cells adjacent to it are precomputed when
+/// the grid is initialized.
+class SO3Grid
+{
+public:
+
+    /// \brief Initialize the grid with the smallest resolution parameter for
+    ///     which the spacing between cells is no larger than \p res radians
+    void init(double res);
+
+    /// \brief Initialize the grid with a given HEALPix resolution parameter
+    void initNSide(int nside);
+
+    int nside() const { return m_nside; }
+
+    /// \brief Return the approximate angle, in radians, between the centers of
+    ///     adjacent cells
+    double resolution() const { return m_res; }
+
+    int cellCount() const { return (int)m_centers.size(); }
+
+    /// \brief Return the index of the cell containing a rotation
+    ///
+    /// Cells approximate the Voronoi regions of their centers; the center of
+    /// the returned cell is the nearest center, or within a small fraction of
+    /// the resolution of it.
+    int cellIndex(const Quaternion& q) const;
+
+    /// \brief Return the rotation at the center of a cell
+    auto cellCenter(int cidx) const -> const Quaternion& { return m_centers[cidx]; }
+
+    /// \brief Return the cells adjacent to a cell, as [first, last)
+    auto neighborsBegin(int cidx) const -> const int*
+    {
+        return m_neighbors.data() + m_neighbor_offsets[cidx];
+    }
+
+    auto neighborsEnd(int cidx) const -> const int*
+    {
+        return m_neighbors.data() + m_neighbor_offsets[cidx + 1];
+    }
+
+    int neighborCount(int cidx) const
+    {
+        return m_neighbor_offsets[cidx + 1] - m_neighbor_offsets[cidx];
+    }
+
+private:
+
+    int m_nside = 0;
+    double m_res = 0.0;
+
+    // number of cells along each fiber
+    int m_fiber_count = 0;
+
+    std::vector<Quaternion, Eigen::aligned_allocator<Quaternion>> m_centers;
+
+    // cells adjacent to cell i are stored in
+    // m_neighbors[m_neighbor_offsets[i], m_neighbor_offsets[i + 1])
+    std::vector<int> m_neighbor_offsets;
+    std::vector<int> m_neighbors;
+
+    void computeNeighbors();
+};
+
+/// \brief Return the index of the HEALPix pixel, in the ring scheme, that
+///     contains a direction given by its polar and azimuthal angles
+int HealpixAngleToPixel(int nside, double theta, double phi);
+
+/// \brief Return the polar and azimuthal angles of the center of a HEALPix
+///     pixel, in the ring scheme
+void HealpixPixelToAngle(int nside, int pix, double* theta, double* phi);
+
+} // namespace geometry
+} // namespace smpl
+
+#endif
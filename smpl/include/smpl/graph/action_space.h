@@ -60,6 +60,19 @@ public:
     /// CollisionChecker's isStateToStateValid function during a search.
     virtual bool apply(const RobotState& parent, std::vector<Action>& actions) = 0;
 
+    /// \brief Return the set of actions available from a state, reusing the
+    ///     storage of a buffer of actions.
+    ///
+    /// On return, the first \p count elements of \p actions store the actions
+    /// available from \p parent. Elements past the first \p count are left in
+    /// an unspecified state so that their storage may be reused by subsequent
+    /// calls. The default implementation moves the actions returned by apply()
+    /// into the buffer.
+    virtual bool applyBuffered(
+        const RobotState& parent,
+        std::vector<Action>& actions,
+        std::size_t& count);
+
     virtual void updateStart(const RobotState& state) { }
     virtual void updateGoal(const GoalConstraint& goal) { }
 
@@ -35,6 +35,7 @@
 
 // standard includes
 #include <time.h>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -53,6 +54,7 @@
 #include <smpl/types.h>
 #include <smpl/graph/robot_planning_space.h>
 #include <smpl/graph/action_space.h>
+#include <smpl/graph/primitive_collision_table.h>
 
 namespace smpl {
 
@@ -64,12 +66,18 @@ struct ManipLatticeState
 {
     RobotCoord coord;   // discrete coordinate
     RobotState state;   // corresponding continuous coordinate
+
+    // number of actions taken from the start to reach the state, when
+    // planning around obstacles with known motion, and 0 otherwise. Part of
+    // the state's identity, so that every path to a state reaches it at the
+    // same time.
+    int step = 0;
 };
 
 inline
 bool operator==(const ManipLatticeState& a, const ManipLatticeState& b)
 {
-    return a.coord == b.coord;
+    return a.coord == b.coord && a.step == b.step;
 }
 
 } // namespace smpl
@@ -92,7 +100,8 @@ namespace smpl {
 class ManipLattice :
     public RobotPlanningSpace,
     public PoseProjectionExtension,
-    public ExtractRobotStateExtension
+    public ExtractRobotStateExtension,
+    public ProjectionContextExtension
 {
 public:
 
@@ -115,8 +124,41 @@ public:
 
     auto getDiscreteCenter(const RobotState& state) const -> RobotState;
 
+    /// Set the time taken to execute each action, used to determine when
+    /// actions are executed if the collision checker supports obstacles with
+    /// known motion. While the collision checker reports such obstacles, the
+    /// lattice distinguishes states by the number of actions taken to reach
+    /// them, as well as by their coordinates.
+    void setActionDuration(double duration) { m_action_duration = duration; }
+    double actionDuration() const { return m_action_duration; }
+
+    /// Set a table of the regions in which the primitives of the action space
+    /// are known to be free of, or in, self collision. Actions certified free
+    /// of self collisions are only checked for collisions with the
+    /// environment. Actions believed to be in self collision are checked for
+    /// self collisions first, so that they are rejected early, and are never
+    /// rejected without a check. Requires a collision checker that supports
+    /// SelfCollisionCheckerExtension. The table is not owned by the lattice.
+    /// The table is not consulted while the collision checker reports
+    /// obstacles with known motion, as actions are then checked in full at
+    /// their times.
+    ///
+    /// Since the table is built by sampling, extracted paths are checked in
+    /// full for collisions, and extraction fails if any motion along the path
+    /// is invalid.
+    void setPrimitiveCollisionTable(const PrimitiveCollisionTable* table);
+
+    auto primitiveCollisionTable() const -> const PrimitiveCollisionTable*
+    { return m_prim_table; }
+
     void clearStates();
 
+    /// Append the ids of the states, among those created so far, that satisfy
+    /// the current goal to \p state_ids. When the goal moves, these are the
+    /// states whose incoming edges now lead to the goal state, for notifying
+    /// a search that repairs its search tree via costs_changed().
+    void getGoalSatisfyingStates(std::vector<int>& state_ids);
+
     /// \name Reimplemented Public Functions from RobotPlanningSpace
     ///@{
     void GetLazySuccs(
@@ -137,6 +179,12 @@ public:
     bool projectToPose(int state_id, Affine3& pos) override;
     ///@}
 
+    /// \name Required Public Functions from ProjectionContextExtension
+    ///@{
+    auto createProjectionContext()
+        -> std::unique_ptr<PoseProjectionExtension> override;
+    ///@}
+
     /// \name Required Public Functions from RobotPlanningSpace
     ///@{
     bool setStart(const RobotState& state) override;
@@ -176,11 +224,20 @@ protected:
 
     ManipLatticeState* getHashEntry(int state_id) const;
 
-    int getHashEntry(const RobotCoord& coord);
-    int createHashEntry(const RobotCoord& coord, const RobotState& state);
-    int getOrCreateState(const RobotCoord& coord, const RobotState& state);
+    int getHashEntry(const RobotCoord& coord, int step = 0);
+    int createHashEntry(
+        const RobotCoord& coord,
+        const RobotState& state,
+        int step = 0);
+    int getOrCreateState(
+        const RobotCoord& coord,
+        const RobotState& state,
+        int step = 0);
     int reserveHashEntry();
 
+    int successorStep(const ManipLatticeState* entry);
+    double stateTime(const ManipLatticeState* entry) const;
+
     Affine3 computePlanningFrameFK(const RobotState& state) const;
 
     int cost(
@@ -188,18 +245,47 @@ protected:
         ManipLatticeState* HashEntry2,
         bool bState2IsGoal) const;
 
-    bool checkAction(const RobotState& state, const Action& action);
+    bool checkAction(
+        const RobotState& state,
+        const Action& action,
+        double time = 0.0);
+    bool checkTimedAction(
+        const RobotState& state,
+        const Action& action,
+        double time);
+    bool checkTimedTransition(int parent_id, int child_id, double time);
+    bool hasTimedObstacles();
 
     bool isGoal(const RobotState& state);
 
+    /// Store the actions available from a state in \p actions, reusing its
+    /// storage, and the number of actions in \p count. The cost of each
+    /// action is multiplied by \p cost_scale. The default implementation
+    /// applies the action space with a cost scale of 1.
+    virtual bool applyActions(
+        int state_id,
+        std::vector<Action>& actions,
+        std::size_t& count,
+        int& cost_scale);
+
     auto getStateVisualization(const RobotState& vars, const std::string& ns)
         -> std::vector<visual::Marker>;
 
 private:
 
     ForwardKinematicsInterface* m_fk_iface = nullptr;
+    TimedCollisionCheckerExtension* m_timed_checker = nullptr;
+    SelfCollisionCheckerExtension* m_self_checker = nullptr;
+    const PrimitiveCollisionTable* m_prim_table = nullptr;
     ActionSpace* m_actions = nullptr;
 
+    // actions available from the most recently expanded state, reused across
+    // expansions to avoid reallocating actions and their waypoints
+    std::vector<Action> m_action_buffer;
+    std::size_t m_action_count = 0;
+
+    double m_action_duration = 0.1;
+
     // cached from robot model
     std::vector<double> m_min_limits;
     std::vector<double> m_max_limits;
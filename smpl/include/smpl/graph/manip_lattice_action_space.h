@@ -93,10 +93,48 @@ public:
     bool apply(const RobotState& parent, std::vector<Action>& actions) override;
     ///@}
 
+    /// \name Reimplemented Public Functions from ActionSpace
+    ///@{
+    bool applyBuffered(
+        const RobotState& parent,
+        std::vector<Action>& actions,
+        std::size_t& count) override;
+    void updateStart(const RobotState& state) override;
+    void updateGoal(const GoalConstraint& goal) override;
+    ///@}
+
 protected:
 
     std::vector<MotionPrimitive> m_mprims;
 
+    // Long and short distance motion primitives, compiled from m_mprims, with
+    // the deltas of all waypoints of all primitives stored contiguously in
+    // m_template_deltas. Adaptive motion primitives are still applied via
+    // getAction().
+    struct PrimitiveTemplate
+    {
+        MotionPrimitive::Type type;
+        std::size_t offset;
+        int waypoint_count;
+
+        // number of variables in each waypoint, or -1 if the waypoints of the
+        // primitive differ in size
+        int var_count;
+    };
+
+    std::vector<PrimitiveTemplate> m_templates;
+    std::vector<double> m_template_deltas;
+    bool m_templates_dirty = true;
+
+    // start and goal distances of the last state to which actions were
+    // applied, invalidated when the start or goal changes
+    bool m_dist_cache_valid = false;
+    RobotState m_dist_cache_state;
+    double m_dist_cache_start = 0.0;
+    double m_dist_cache_goal = 0.0;
+
+    std::vector<Action> m_amp_actions;
+
     ForwardKinematicsInterface* m_fk_iface = nullptr;
     InverseKinematicsInterface* m_ik_iface = nullptr;
 
@@ -132,6 +170,22 @@ protected:
 
     auto getStartGoalDistances(const RobotState& state)
         -> std::pair<double, double>;
+
+private:
+
+    void compileTemplates();
+
+    bool needDistances() const;
+
+    void getCachedStartGoalDistances(
+        const RobotState& state,
+        double& start_dist,
+        double& goal_dist);
+
+    bool applyActions(
+        const RobotState& parent,
+        std::vector<Action>& actions,
+        std::size_t& count);
 };
 
 } // namespace smpl
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_MULTI_RES_MANIP_LATTICE_H
+#define SMPL_MULTI_RES_MANIP_LATTICE_H
+
+// standard includes
+#include <vector>
+
+// project includes
+#include <smpl/graph/manip_lattice.h>
+
+namespace smpl {
+
+class OccupancyGrid;
+
+/// \brief A ManipLattice that expands states at a coarse resolution far from
+///     the goal and from obstacles, and at its own, fine, resolution elsewhere
+///
+/// The coarse lattice is the subset of the fine lattice whose coordinates
+/// differ from those of the start state by multiples of a common factor, so
+/// coarse and fine states that coincide are the same state. States on the
+/// coarse lattice are expanded with the actions of a separate coarse action
+/// space, typically the fine primitives scaled by the same factor, when the
+/// planning link is both farther than fineGoalDistance from the goal, as
+/// estimated by the first heuristic, and farther than fineObstacleDistance
+/// from obstacles in the occupancy grid. All other states are expanded with
+/// the fine action space. The cost of a coarse action is that of a fine action
+/// scaled by the coarse factor.
+class MultiResManipLattice : public ManipLattice
+{
+public:
+
+    struct Params
+    {
+        /// ratio of the coarse resolution to the fine resolution of every
+        /// variable
+        int coarse_factor = 4;
+
+        /// distance, in meters, of the planning link to the goal within which
+        /// states are expanded at the fine resolution
+        double fine_goal_distance = 0.2;
+
+        /// distance, in meters, of the planning link to the nearest obstacle
+        /// within which states are expanded at the fine resolution
+        double fine_obstacle_distance = 0.1;
+    };
+
+    bool init(
+        RobotModel* robot,
+        CollisionChecker* checker,
+        const std::vector<double>& resolutions,
+        ActionSpace* fine_actions,
+        ActionSpace* coarse_actions,
+        const OccupancyGrid* grid,
+        const Params& params);
+
+    auto params() const -> const Params& { return m_params; }
+
+    auto coarseActionSpace() -> ActionSpace* { return m_coarse_actions; }
+    auto coarseActionSpace() const -> const ActionSpace* { return m_coarse_actions; }
+
+    /// \brief Return whether a state lies on the coarse lattice
+    ///
+    /// The coordinates of continuous variables wrap around at a full turn.
+    /// Unless the number of discrete values of a continuous variable is a
+    /// multiple of the coarse factor, a coarse action that wraps the variable
+    /// leaves the coarse lattice. The state it reaches is not coarse, and it
+    /// and its successors are expanded with fine actions until one of them
+    /// returns to the coarse lattice.
+    bool isCoarseState(int state_id) const;
+
+    /// \brief Return whether a state is expanded with coarse actions
+    bool useCoarseActions(int state_id);
+
+    /// \name Reimplemented Public Functions from ManipLattice
+    ///@{
+    bool setStart(const RobotState& state) override;
+    bool setGoal(const GoalConstraint& goal) override;
+    ///@}
+
+protected:
+
+    /// \name Reimplemented Protected Functions from ManipLattice
+    ///@{
+    bool applyActions(
+        int state_id,
+        std::vector<Action>& actions,
+        std::size_t& count,
+        int& cost_scale) override;
+    ///@}
+
+private:
+
+    ActionSpace* m_coarse_actions = nullptr;
+    const OccupancyGrid* m_grid = nullptr;
+    ForwardKinematicsInterface* m_fk_iface = nullptr;
+    Params m_params;
+
+    // coordinate of the start state, through which the coarse lattice passes
+    RobotCoord m_coarse_origin;
+};
+
+} // namespace smpl
+
+#endif
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_PRIMITIVE_COLLISION_TABLE_H
+#define SMPL_PRIMITIVE_COLLISION_TABLE_H
+
+// standard includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// project includes
+#include <smpl/types.h>
+
+namespace smpl {
+
+class SelfCollisionCheckerExtension;
+
+/// \brief A table of the regions of joint space in which motion primitives are
+///     known to be free of self collisions, or known to be in self collision
+///
+/// Joint space is divided into a coarse grid, with an independent number of
+/// cells along each planning variable; variables with a single cell do not
+/// affect the lookup. For each primitive, stored as the deltas of its
+/// waypoints from the source state, the table stores whether every motion
+/// starting in a cell is free of self collisions, every motion starting in a
+/// cell is in self collision, or neither is known.
+///
+/// Tables are built offline by BuildPrimitiveCollisionTable(), which classifies
+/// each cell by sampling, and are only valid for the collision model, allowed
+/// collisions, and padding they were built with.
+class PrimitiveCollisionTable
+{
+public:
+
+    enum Status : std::uint8_t { Unknown = 0, Free, Colliding };
+
+    /// \brief Initialize an empty table with no primitives
+    ///
+    /// The range of each variable, [min_positions[i], max_positions[i]], is
+    /// divided into cell_counts[i] cells. Continuous variables are normalized
+    /// to [-pi, pi) before lookup.
+    bool init(
+        const std::vector<double>& min_positions,
+        const std::vector<double>& max_positions,
+        const std::vector<bool>& continuous,
+        const std::vector<int>& cell_counts);
+
+    /// \brief Add a primitive, given by the deltas of its waypoints, and
+    ///     return its index. The status of the primitive is Unknown in every
+    ///     cell.
+    int addPrimitive(const Action& deltas);
+
+    int variableCount() const { return (int)m_cell_counts.size(); }
+    int cellCount() const { return m_cell_count; }
+    int primitiveCount() const { return (int)m_prims.size(); }
+
+    auto primitive(int pidx) const -> const Action& { return m_prims[pidx]; }
+
+    /// \brief Return the index of the cell containing a state, or -1 if the
+    ///     state is outside the table
+    int cellIndex(const RobotState& state) const;
+
+    /// \brief Return the bounds of a cell
+    void cellBounds(int cidx, RobotState& min, RobotState& max) const;
+
+    /// \brief Return the index of the primitive that produced an action from a
+    ///     state, or -1 if no primitive in the table did
+    int findPrimitive(const RobotState& state, const Action& action) const;
+
+    Status status(int pidx, int cidx) const
+    {
+        auto bit = 2 * ((std::size_t)pidx * m_cell_count + cidx);
+        return (Status)((m_bits[bit >> 6] >> (bit & 63)) & 3);
+    }
+
+    void setStatus(int pidx, int cidx, Status status);
+
+    /// \brief Return the status of an action applied to a state
+    Status status(const RobotState& state, const Action& action) const;
+
+    /// \brief Return the number of (primitive, cell) entries with a status
+    int statusCount(Status status) const;
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+
+    std::vector<double> m_min_positions;
+    std::vector<double> m_max_positions;
+    std::vector<bool> m_continuous;
+    std::vector<int> m_cell_counts;
+    int m_cell_count = 0;
+
+    std::vector<Action> m_prims;
+
+    // two bits per (primitive, cell) entry, ordered by primitive, then cell
+    std::vector<std::uint64_t> m_bits;
+};
+
+/// \brief Classify every cell of a table for each of its primitives
+///
+/// Each primitive is applied to \p samples_per_cell states within each cell,
+/// including the center of the cell, and checked for self collisions. A
+/// primitive is marked Free in a cell if every sampled motion is free, and
+/// Colliding if every sampled motion is in collision. The classification is
+/// therefore only as reliable as the sampling is dense with respect to the
+/// size of the cells.
+bool BuildPrimitiveCollisionTable(
+    PrimitiveCollisionTable& table,
+    SelfCollisionCheckerExtension* checker,
+    int samples_per_cell,
+    unsigned int seed = 0);
+
+} // namespace smpl
+
+#endif
@@ -33,6 +33,7 @@
 #define SMPL_ROBOT_PLANNING_SPACE_H
 
 // standard includes
+#include <memory>
 #include <vector>
 
 // system includes
@@ -182,6 +183,26 @@ public:
     virtual const RobotState& extractState(int state_id) = 0;
 };
 
+/// Extension for planning spaces that can project states through a context
+/// private to the caller, such as a heuristic evaluated on its own thread.
+///
+/// A context only reads the state table of its space and owns any other state
+/// required to answer queries (e.g. a copy of the forward kinematics solver),
+/// so contexts may be queried concurrently with one another and with the
+/// space's own projections. They may not be queried while the space is being
+/// modified, e.g. while it generates successors or its goal is being updated.
+class ProjectionContextExtension : public virtual Extension
+{
+public:
+
+    virtual ~ProjectionContextExtension() { }
+
+    /// Return a new projection context for the states of this space, or null
+    /// if one could not be made.
+    virtual auto createProjectionContext()
+        -> std::unique_ptr<PoseProjectionExtension> = 0;
+};
+
 inline
 size_t RobotPlanningSpace::numHeuristics() const
 {
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_WORKSPACE_IK_CACHE_H
+#define SMPL_WORKSPACE_IK_CACHE_H
+
+// standard includes
+#include <cstddef>
+#include <list>
+
+// project includes
+#include <smpl/types.h>
+#include <smpl/graph/workspace_lattice_types.h>
+
+namespace smpl {
+
+/// A bounded cache of inverse kinematics results for the waypoints of a
+/// WorkspaceLattice, keyed on the discrete workspace coordinate (including the
+/// discretized free angles) of each waypoint. Failed solutions are cached
+/// alongside successful ones. Once the cache holds capacity() entries, the
+/// least recently used entry is evicted to make room for a new one.
+///
+/// Each entry also stores the continuous workspace state it was computed for,
+/// and lookups only succeed when the query state matches it, so that the cache
+/// never returns a solution for a different pose that happens to fall in the
+/// same cell.
+class WorkspaceIKCache
+{
+public:
+
+    static const std::size_t DefaultCapacity = 32768;
+
+    struct Entry
+    {
+        WorkspaceCoord coord;
+        WorkspaceState state;
+        RobotState solution;
+        bool valid;
+    };
+
+    WorkspaceIKCache(std::size_t capacity = DefaultCapacity);
+
+    auto capacity() const -> std::size_t { return m_capacity; }
+    void setCapacity(std::size_t capacity);
+
+    auto size() const -> std::size_t { return m_entries.size(); }
+
+    auto lookup(const WorkspaceCoord& coord, const WorkspaceState& state)
+        -> const Entry*;
+
+    bool contains(const WorkspaceCoord& coord, const WorkspaceState& state) const;
+
+    void insert(
+        const WorkspaceCoord& coord,
+        const WorkspaceState& state,
+        const RobotState* solution);
+
+    void clear();
+
+    auto hitCount() const -> std::size_t { return m_hit_count; }
+    auto missCount() const -> std::size_t { return m_miss_count; }
+    void resetCounts();
+
+private:
+
+    using EntryList = std::list<Entry>;
+
+    std::size_t m_capacity;
+
+    // entries in order from most- to least-recently used
+    EntryList m_entries;
+
+    hash_map<WorkspaceCoord, EntryList::iterator, VectorHash<int>> m_index;
+
+    std::size_t m_hit_count = 0;
+    std::size_t m_miss_count = 0;
+
+    void evict(std::size_t count);
+};
+
+} // namespace smpl
+
+#endif
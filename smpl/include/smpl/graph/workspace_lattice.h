@@ -47,6 +47,7 @@
 #include <smpl/types.h>
 #include <smpl/graph/motion_primitive.h>
 #include <smpl/graph/robot_planning_space.h>
+#include <smpl/graph/workspace_ik_cache.h>
 #include <smpl/graph/workspace_lattice_base.h>
 #include <smpl/graph/workspace_lattice_types.h>
 
@@ -81,6 +82,13 @@ struct WorkspaceLattice :
 
     WorkspaceLatticeActionSpace* m_actions = NULL;
 
+    // optional, used to solve ik for all waypoints of an expansion at once
+    BatchRedundantManipulatorInterface* m_batch_ik_iface = NULL;
+
+    // ik solutions for waypoints, retained across searches since they only
+    // depend on the robot's kinematics
+    WorkspaceIKCache m_ik_cache;
+
     std::string m_viz_frame_id;
 
     ~WorkspaceLattice();
@@ -88,6 +96,9 @@ struct WorkspaceLattice :
     void setVisualizationFrameId(const std::string& frame_id);
     auto visualizationFrameId() const -> const std::string&;
 
+    void setIKCacheCapacity(size_t capacity);
+    auto ikCache() const -> const WorkspaceIKCache& { return m_ik_cache; }
+
     /// \name Reimplemented Public Functions from WorkspaceLatticeBase
     ///@{
     bool init(
@@ -162,6 +173,15 @@ struct WorkspaceLattice :
     auto getState(int state_id) const -> WorkspaceLatticeState*;
     int getOrCreateState(const WorkspaceCoord& coord, const RobotState& state);
 
+    bool computeWaypointIK(
+        const RobotState& state,
+        const WorkspaceState& waypoint,
+        RobotState& solution);
+
+    void prefetchIK(
+        const RobotState& state,
+        const std::vector<WorkspaceAction>& actions);
+
     bool checkAction(
         const RobotState& state,
         const WorkspaceAction& action,
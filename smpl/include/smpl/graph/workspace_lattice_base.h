@@ -33,6 +33,7 @@
 #define SMPL_WORKSPACE_LATTICE_BASE_H
 
 // project includes
+#include <smpl/geometry/so3_grid.h>
 #include <smpl/graph/robot_planning_space.h>
 #include <smpl/graph/workspace_lattice_types.h>
 
@@ -60,6 +61,15 @@ public:
     std::vector<bool> m_fangle_continuous;
     std::vector<bool> m_fangle_bounded;
 
+    // uniform discretization of the orientation of the end effector, used in
+    // place of roll, pitch, and yaw bins when m_uniform_rot is set. The
+    // rotation coordinate of a state is then the index of its cell, followed
+    // by two zeros, and m_rot_euler stores the roll, pitch, and yaw of each
+    // cell's center.
+    bool m_uniform_rot = false;
+    geometry::SO3Grid m_rot_grid;
+    std::vector<double> m_rot_euler;
+
     struct Params
     {
         double res_x;
@@ -70,6 +80,11 @@ public:
         int P_count;
         int Y_count;
 
+        // if non-zero, discretize orientations uniformly with this spacing,
+        // in radians, between adjacent cells, and ignore R_count, P_count,
+        // and Y_count
+        double rot_res = 0.0;
+
         std::vector<double> free_angle_res;
     };
 
@@ -85,6 +100,9 @@ public:
 
     size_t freeAngleCount() const { return m_fangle_indices.size(); }
 
+    bool uniformRotations() const { return m_uniform_rot; }
+    auto rotationGrid() const -> const geometry::SO3Grid& { return m_rot_grid; }
+
     // conversions between robot states, workspace states, and workspace coords
     void stateRobotToWorkspace(const RobotState& state, WorkspaceState& ostate) const;
     void stateRobotToCoord(const RobotState& state, WorkspaceCoord& coord) const;
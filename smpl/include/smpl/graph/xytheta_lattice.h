@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_XYTHETA_LATTICE_H
+#define SMPL_XYTHETA_LATTICE_H
+
+// standard includes
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// system includes
+#include <Eigen/Core>
+
+// project includes
+#include <smpl/spatial.h>
+#include <smpl/types.h>
+#include <smpl/graph/robot_planning_space.h>
+#include <smpl/unicycle/pose_2d.h>
+
+namespace smpl {
+
+class OccupancyGrid;
+
+/// A motion primitive for an XYThetaLattice, stored relative to the cell and
+/// heading it starts from.
+struct XYThetaPrimitive
+{
+    int start_heading = 0;
+    int end_heading = 0;
+
+    // change in cell coordinates
+    int dx = 0;
+    int dy = 0;
+
+    int cost = 0;
+
+    // poses along the motion, relative to the center of the start cell, not
+    // including the start pose but including the final pose
+    std::vector<Pose2D> poses;
+
+    // cells covered by the footprint over the course of the motion, relative
+    // to the start cell, and the bounding box of those cells
+    std::vector<Eigen::Vector2i> cells;
+    Eigen::Vector2i min_cell = Eigen::Vector2i::Zero();
+    Eigen::Vector2i max_cell = Eigen::Vector2i::Zero();
+};
+
+struct XYThetaLatticeState
+{
+    int x;
+    int y;
+    int heading;
+    RobotState state;
+};
+
+/// A planning space for mobile bases moving in the plane. States are the cells
+/// of one layer of an OccupancyGrid paired with one of a fixed set of headings,
+/// and the robot is described by a polygonal footprint.
+///
+/// Motion primitives are generated once, in init(), for every heading: short
+/// and long straight motions along the lattice direction of the heading, arcs
+/// to the neighboring headings from MakeUnicycleMotion(), and optionally
+/// turn-in-place and reverse motions. Headings point along lattice directions,
+/// e.g. (1, 0), (2, 1), (1, 1), ... for 16 headings, so that straight motions
+/// end exactly at cell centers. Each primitive stores the cells swept by the
+/// footprint, so checking a motion for collisions requires only a lookup per
+/// cell. The occupancy of each cell is read from the grid the first time it is
+/// needed after setStart() and cached until the next call to setStart().
+///
+/// Planning variables are (x, y, theta), in that order.
+class XYThetaLattice :
+    public RobotPlanningSpace,
+    public PoseProjectionExtension,
+    public ExtractRobotStateExtension
+{
+public:
+
+    struct Params
+    {
+        /// number of discrete headings; must be 4, 8, or 16
+        int num_headings = 16;
+
+        /// vertices of the footprint polygon in the robot frame; the robot is
+        /// treated as a point if the footprint is empty
+        std::vector<Vector2> footprint;
+
+        /// minimum turning radius of arc primitives, in meters
+        double min_turning_radius = 0.0;
+
+        /// length, in cells, of the long straight primitives; no long
+        /// primitives are generated if this is less than 2
+        int long_primitive_cells = 4;
+
+        bool allow_turn_in_place = true;
+        bool allow_reverse = false;
+
+        int cost_per_meter = 1000;
+        int cost_per_radian = 1000;
+        double reverse_cost_multiplier = 5.0;
+
+        /// cells closer than this distance to an obstacle are considered
+        /// occupied by the collision check. Distances are those of the grid's
+        /// distance field, which also measures distance to the top and bottom
+        /// of the grid, so the grid must extend far enough above and below
+        /// the planning layer for padding to be meaningful.
+        double padding = 0.0;
+
+        /// z index of the layer of the occupancy grid to plan in
+        int grid_z = 0;
+    };
+
+    ~XYThetaLattice();
+
+    bool init(
+        RobotModel* robot,
+        CollisionChecker* checker,
+        const OccupancyGrid* grid,
+        const Params& params);
+
+    auto params() const -> const Params& { return m_params; }
+    auto grid() const -> const OccupancyGrid* { return m_grid; }
+
+    int numHeadings() const { return (int)m_headings.size(); }
+    double headingAngle(int heading) const { return m_headings[heading]; }
+    int headingIndex(double theta) const;
+
+    /// Return the primitives available from states with the given heading.
+    auto primitives(int heading) const -> const std::vector<XYThetaPrimitive>&
+    { return m_prims[heading]; }
+
+    /// Return the cells covered by the footprint at the given heading,
+    /// relative to the cell of the robot.
+    auto footprintCells(int heading) const -> const std::vector<Eigen::Vector2i>&
+    { return m_footprint_cells[heading]; }
+
+    auto getDiscreteCenter(const RobotState& state) const -> RobotState;
+
+    bool isStateValid(int x, int y, int heading);
+
+    void clearStates();
+
+    /// \name Required Public Functions from ExtractRobotStateExtension
+    ///@{
+    auto extractState(int state_id) -> const RobotState& override;
+    ///@}
+
+    /// \name Required Public Functions from PoseProjectionExtension
+    ///@{
+    bool projectToPose(int state_id, Affine3& pose) override;
+    ///@}
+
+    /// \name Required Public Functions from RobotPlanningSpace
+    ///@{
+    bool setStart(const RobotState& state) override;
+    bool setGoal(const GoalConstraint& goal) override;
+    int getStartStateID() const override;
+    int getGoalStateID() const override;
+    bool extractPath(
+        const std::vector<int>& ids,
+        std::vector<RobotState>& path) override;
+    ///@}
+
+    /// \name Required Public Functions from Extension
+    ///@{
+    auto getExtension(size_t class_code) -> Extension* override;
+    ///@}
+
+    /// \name Required Public Functions from DiscreteSpaceInformation
+    ///@{
+    void GetSuccs(
+        int state_id,
+        std::vector<int>* succs,
+        std::vector<int>* costs) override;
+    void GetPreds(
+        int state_id,
+        std::vector<int>* preds,
+        std::vector<int>* costs) override;
+    void PrintState(int state_id, bool verbose, FILE* fout = nullptr) override;
+    ///@}
+
+private:
+
+    enum CellStatus : std::uint8_t { Unknown = 0, Free, Blocked };
+
+    const OccupancyGrid* m_grid = nullptr;
+    Params m_params;
+
+    int m_num_cells_x = 0;
+    int m_num_cells_y = 0;
+
+    std::vector<double> m_headings;
+    std::vector<std::vector<XYThetaPrimitive>> m_prims;
+    std::vector<std::vector<Eigen::Vector2i>> m_footprint_cells;
+
+    // swept cells of each primitive, as offsets into m_cell_status from the
+    // start cell, in the same order as m_prims
+    std::vector<std::vector<std::vector<int>>> m_prim_offsets;
+
+    std::vector<CellStatus> m_cell_status;
+
+    int m_start_state_id = -1;
+    int m_goal_state_id = -1;
+
+    // goal pose and tolerance, in (x, y, theta)
+    Pose2D m_goal_pose;
+    Pose2D m_goal_tolerance;
+
+    // states are keyed by (cell index * heading count + heading)
+    std::unordered_map<std::int64_t, int> m_state_to_id;
+    std::deque<XYThetaLatticeState> m_states;
+
+    void generatePrimitives();
+
+    bool isCellFree(int index);
+    bool checkPrimitive(int x, int y, const XYThetaPrimitive& prim, int pidx);
+
+    bool isGoal(int x, int y, int heading) const;
+
+    auto stateKey(int x, int y, int heading) const -> std::int64_t;
+    int getOrCreateState(int x, int y, int heading);
+    int reserveState();
+
+    void cellToWorld(int x, int y, double& wx, double& wy) const;
+    void worldToCell(double wx, double wy, int& x, int& y) const;
+
+    auto findPrimitive(int from_id, int to_id) -> const XYThetaPrimitive*;
+};
+
+} // namespace smpl
+
+#endif
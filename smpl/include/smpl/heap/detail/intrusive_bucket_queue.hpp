@@ -0,0 +1,464 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_INTRUSIVE_BUCKET_QUEUE_HPP
+#define SMPL_INTRUSIVE_BUCKET_QUEUE_HPP
+
+#include "../intrusive_bucket_queue.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <limits>
+
+namespace smpl {
+
+template <class T, class Key>
+const typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::default_bucket_limit;
+
+template <class T, class Key>
+intrusive_bucket_queue<T, Key>::intrusive_bucket_queue(
+    const key_function& key,
+    size_type bucket_limit)
+:
+    m_buckets(),
+    m_size(0),
+    m_bucket_limit(std::max(bucket_limit, size_type(1))),
+    m_window_size(0),
+    m_base(0),
+    m_min(0),
+    m_key(key)
+{
+    // the overflow bucket is at index m_bucket_limit
+    assert(m_bucket_limit < (size_type(1) << 32));
+}
+
+template <class T, class Key>
+intrusive_bucket_queue<T, Key>::intrusive_bucket_queue(
+    intrusive_bucket_queue&& o)
+:
+    m_buckets(std::move(o.m_buckets)),
+    m_size(o.m_size),
+    m_bucket_limit(o.m_bucket_limit),
+    m_window_size(o.m_window_size),
+    m_base(o.m_base),
+    m_min(o.m_min),
+    m_key(std::move(o.m_key))
+{
+    o.m_buckets.clear();
+    o.m_size = 0;
+    o.m_window_size = 0;
+    o.m_base = 0;
+    o.m_min = 0;
+}
+
+template <class T, class Key>
+intrusive_bucket_queue<T, Key>&
+intrusive_bucket_queue<T, Key>::operator=(intrusive_bucket_queue&& rhs)
+{
+    if (this != &rhs) {
+        m_buckets = std::move(rhs.m_buckets);
+        m_size = rhs.m_size;
+        m_bucket_limit = rhs.m_bucket_limit;
+        m_window_size = rhs.m_window_size;
+        m_base = rhs.m_base;
+        m_min = rhs.m_min;
+        m_key = std::move(rhs.m_key);
+        rhs.m_buckets.clear();
+        rhs.m_size = 0;
+        rhs.m_window_size = 0;
+        rhs.m_base = 0;
+        rhs.m_min = 0;
+    }
+    return *this;
+}
+
+template <class T, class Key>
+T* intrusive_bucket_queue<T, Key>::min() const
+{
+    assert(!empty());
+
+    // the window is never empty while the queue is not, and every element in
+    // the overflow bucket has a priority beyond the window
+    assert(m_window_size > 0);
+    while (m_buckets[bucket_of(m_min)].empty()) {
+        ++m_min;
+    }
+    return m_buckets[bucket_of(m_min)].back();
+}
+
+template <class T, class Key>
+bool intrusive_bucket_queue<T, Key>::empty() const
+{
+    return m_size == 0;
+}
+
+template <class T, class Key>
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::size() const
+{
+    return m_size;
+}
+
+template <class T, class Key>
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::max_size() const
+{
+    return std::numeric_limits<size_type>::max();
+}
+
+template <class T, class Key>
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::bucket_limit() const
+{
+    return m_bucket_limit;
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::clear()
+{
+    // NOTE: buckets are cleared rather than released so that their storage
+    // may be reused by subsequent searches
+    for (auto& bucket : m_buckets) {
+        for (T* e : bucket) {
+            e->m_heap_index = 0;
+        }
+        bucket.clear();
+    }
+    m_size = 0;
+    m_window_size = 0;
+    m_base = 0;
+    m_min = 0;
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::push(T* e)
+{
+    assert(e);
+    insert(e);
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::pop()
+{
+    assert(!empty());
+    remove(min());
+}
+
+template <class T, class Key>
+bool intrusive_bucket_queue<T, Key>::contains(T* e)
+{
+    assert(e);
+    return e->m_heap_index != 0;
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::update(T* e)
+{
+    assert(e && contains(e));
+    size_type p = priority_of(e);
+    if (p < m_base || bucket_of(p) != bucket_index(e->m_heap_index)) {
+        remove(e);
+        insert(e);
+    }
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::increase(T* e)
+{
+    update(e);
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::decrease(T* e)
+{
+    update(e);
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::erase(T* e)
+{
+    assert(e && contains(e));
+    remove(e);
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::make()
+{
+    // the priorities of any elements may have changed, so place every element
+    // again within a window starting at the new minimum priority
+    std::vector<T*> elements;
+    elements.reserve(m_size);
+    size_type min_priority = std::numeric_limits<size_type>::max();
+    for (auto& bucket : m_buckets) {
+        for (T* e : bucket) {
+            elements.push_back(e);
+            min_priority = std::min(min_priority, priority_of(e));
+        }
+    }
+    clear();
+    m_base = m_min = min_priority;
+    for (T* e : elements) {
+        place(e, priority_of(e));
+    }
+}
+
+template <class T, class Key>
+template <class UnaryFunction>
+void intrusive_bucket_queue<T, Key>::for_each(UnaryFunction f) const
+{
+    if (empty()) {
+        return;
+    }
+    for (size_type p = m_min; p - m_base < m_bucket_limit; ++p) {
+        auto& bucket = m_buckets[bucket_of(p)];
+        for (auto it = bucket.rbegin(); it != bucket.rend(); ++it) {
+            f(*it);
+        }
+    }
+    auto& overflow = m_buckets[m_bucket_limit];
+    for (auto it = overflow.rbegin(); it != overflow.rend(); ++it) {
+        f(*it);
+    }
+}
+
+template <class T, class Key>
+template <class UnaryPredicate>
+T* intrusive_bucket_queue<T, Key>::find_if(UnaryPredicate p) const
+{
+    if (empty()) {
+        return nullptr;
+    }
+
+    T* m = min();
+    if (p(m)) {
+        return m;
+    }
+
+    for (size_type q = m_min; q - m_base < m_bucket_limit; ++q) {
+        auto& bucket = m_buckets[bucket_of(q)];
+        for (auto it = bucket.rbegin(); it != bucket.rend(); ++it) {
+            if (*it != m && p(*it)) {
+                return *it;
+            }
+        }
+    }
+    auto& overflow = m_buckets[m_bucket_limit];
+    for (auto it = overflow.rbegin(); it != overflow.rend(); ++it) {
+        if (p(*it)) {
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::swap(intrusive_bucket_queue& o)
+{
+    if (this != &o) {
+        using std::swap;
+        swap(m_buckets, o.m_buckets);
+        swap(m_size, o.m_size);
+        swap(m_bucket_limit, o.m_bucket_limit);
+        swap(m_window_size, o.m_window_size);
+        swap(m_base, o.m_base);
+        swap(m_min, o.m_min);
+        swap(m_key, o.m_key);
+    }
+}
+
+template <class T, class Key>
+inline
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::priority_of(const T* e) const
+{
+    key_type k = m_key(*e);
+    assert(k >= 0);
+    if (k <= 0) {
+        return 0;
+    }
+    return (size_type)k;
+}
+
+template <class T, class Key>
+inline
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::bucket_of(size_type priority) const
+{
+    if (priority < m_base || priority - m_base >= m_bucket_limit) {
+        return m_bucket_limit;
+    }
+    return priority % m_bucket_limit;
+}
+
+template <class T, class Key>
+inline
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::bucket_index(size_type heap_index)
+{
+    return heap_index >> 32;
+}
+
+template <class T, class Key>
+inline
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::slot_index(size_type heap_index)
+{
+    return (heap_index & 0xFFFFFFFF) - 1;
+}
+
+template <class T, class Key>
+inline
+typename intrusive_bucket_queue<T, Key>::size_type
+intrusive_bucket_queue<T, Key>::heap_index(size_type bucket, size_type slot)
+{
+    return (bucket << 32) | (slot + 1);
+}
+
+template <class T, class Key>
+inline
+void intrusive_bucket_queue<T, Key>::insert(T* e)
+{
+    size_type p = priority_of(e);
+    if (m_size == 0) {
+        m_base = m_min = p;
+    } else if (p < m_base) {
+        lower_window(p);
+    }
+    place(e, p);
+}
+
+// Add an element to the bucket for its priority, relative to the current
+// window
+template <class T, class Key>
+inline
+void intrusive_bucket_queue<T, Key>::place(T* e, size_type priority)
+{
+    if (m_buckets.empty()) {
+        m_buckets.resize(m_bucket_limit + 1);
+    }
+    size_type b = bucket_of(priority);
+    auto& bucket = m_buckets[b];
+    e->m_heap_index = heap_index(b, bucket.size());
+    bucket.push_back(e);
+    if (b != m_bucket_limit) {
+        m_min = std::min(m_min, priority);
+        ++m_window_size;
+    }
+    ++m_size;
+}
+
+template <class T, class Key>
+inline
+void intrusive_bucket_queue<T, Key>::remove(T* e)
+{
+    size_type b = bucket_index(e->m_heap_index);
+    size_type s = slot_index(e->m_heap_index);
+    auto& bucket = m_buckets[b];
+    T* last = bucket.back();
+    bucket[s] = last;
+    last->m_heap_index = heap_index(b, s);
+    bucket.pop_back();
+    e->m_heap_index = 0;
+    --m_size;
+    if (b != m_bucket_limit) {
+        --m_window_size;
+        if (m_window_size == 0 && m_size != 0) {
+            refill_window();
+        }
+    }
+}
+
+// Move the window down to start at the given priority, moving the elements
+// with priorities beyond the new window into the overflow bucket.
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::lower_window(size_type priority)
+{
+    assert(priority < m_base);
+    auto& overflow = m_buckets[m_bucket_limit];
+    size_type first = std::max(priority + m_bucket_limit, m_base);
+    for (size_type p = first; p - m_base < m_bucket_limit; ++p) {
+        auto& bucket = m_buckets[p % m_bucket_limit];
+        for (T* e : bucket) {
+            e->m_heap_index = heap_index(m_bucket_limit, overflow.size());
+            overflow.push_back(e);
+        }
+        m_window_size -= bucket.size();
+        bucket.clear();
+    }
+    m_base = m_min = priority;
+}
+
+// Move the emptied window up to start at the minimum priority in the overflow
+// bucket, and move the elements that fall within it into their buckets.
+template <class T, class Key>
+void intrusive_bucket_queue<T, Key>::refill_window()
+{
+    assert(m_window_size == 0);
+    auto& overflow = m_buckets[m_bucket_limit];
+    assert(!overflow.empty());
+
+    size_type min_priority = priority_of(overflow.front());
+    for (T* e : overflow) {
+        min_priority = std::min(min_priority, priority_of(e));
+    }
+    m_base = m_min = min_priority;
+
+    for (size_type s = 0; s < overflow.size(); ) {
+        T* e = overflow[s];
+        size_type b = bucket_of(priority_of(e));
+        if (b == m_bucket_limit) {
+            ++s;
+            continue;
+        }
+        T* last = overflow.back();
+        overflow[s] = last;
+        last->m_heap_index = heap_index(m_bucket_limit, s);
+        overflow.pop_back();
+
+        auto& bucket = m_buckets[b];
+        e->m_heap_index = heap_index(b, bucket.size());
+        bucket.push_back(e);
+        ++m_window_size;
+    }
+}
+
+template <class T, class Key>
+void swap(
+    intrusive_bucket_queue<T, Key>& lhs,
+    intrusive_bucket_queue<T, Key>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace smpl
+
+#endif
@@ -0,0 +1,319 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_INTRUSIVE_DARY_HEAP_HPP
+#define SMPL_INTRUSIVE_DARY_HEAP_HPP
+
+#include "../intrusive_dary_heap.h"
+
+#include <assert.h>
+#include <algorithm>
+
+namespace smpl {
+
+// NOTE: elements are stored from index 0, and the heap index of each element
+// is its position in the container plus one, so that a heap index of 0 still
+// denotes an element that is not contained in any heap
+
+template <class T, class Key, std::size_t D>
+intrusive_dary_heap<T, Key, D>::intrusive_dary_heap(const key_function& key) :
+    m_data(),
+    m_key(key)
+{
+}
+
+template <class T, class Key, std::size_t D>
+intrusive_dary_heap<T, Key, D>::intrusive_dary_heap(intrusive_dary_heap&& o) :
+    m_data(std::move(o.m_data)),
+    m_key(std::move(o.m_key))
+{
+}
+
+template <class T, class Key, std::size_t D>
+intrusive_dary_heap<T, Key, D>&
+intrusive_dary_heap<T, Key, D>::operator=(intrusive_dary_heap&& rhs)
+{
+    if (this != &rhs) {
+        m_data = std::move(rhs.m_data);
+        m_key = std::move(rhs.m_key);
+    }
+    return *this;
+}
+
+template <class T, class Key, std::size_t D>
+T* intrusive_dary_heap<T, Key, D>::min() const
+{
+    assert(!m_data.empty());
+    return m_data[0].elem;
+}
+
+template <class T, class Key, std::size_t D>
+typename intrusive_dary_heap<T, Key, D>::key_type
+intrusive_dary_heap<T, Key, D>::min_key() const
+{
+    assert(!m_data.empty());
+    return m_data[0].key;
+}
+
+template <class T, class Key, std::size_t D>
+bool intrusive_dary_heap<T, Key, D>::empty() const
+{
+    return m_data.empty();
+}
+
+template <class T, class Key, std::size_t D>
+typename intrusive_dary_heap<T, Key, D>::size_type
+intrusive_dary_heap<T, Key, D>::size() const
+{
+    return m_data.size();
+}
+
+template <class T, class Key, std::size_t D>
+typename intrusive_dary_heap<T, Key, D>::size_type
+intrusive_dary_heap<T, Key, D>::max_size() const
+{
+    return m_data.max_size();
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::reserve(size_type new_cap)
+{
+    m_data.reserve(new_cap);
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::clear()
+{
+    for (auto& v : m_data) {
+        v.elem->m_heap_index = 0;
+    }
+    m_data.clear();
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::push(T* e)
+{
+    assert(e);
+    m_data.push_back(value_type{ m_key(*e), e });
+    percolate_up(m_data.size() - 1, m_data.back());
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::pop()
+{
+    assert(!empty());
+    m_data[0].elem->m_heap_index = 0;
+    value_type last = m_data.back();
+    m_data.pop_back();
+    if (!m_data.empty()) {
+        percolate_down(0, last);
+    }
+}
+
+template <class T, class Key, std::size_t D>
+bool intrusive_dary_heap<T, Key, D>::contains(T* e)
+{
+    assert(e);
+    return e->m_heap_index != 0;
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::update(T* e)
+{
+    assert(e && contains(e));
+    size_type pos = e->m_heap_index - 1;
+    value_type v = { m_key(*e), e };
+    if (pos != 0 && v.key < m_data[parent(pos)].key) {
+        percolate_up(pos, v);
+    } else {
+        percolate_down(pos, v);
+    }
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::increase(T* e)
+{
+    assert(e && contains(e));
+    percolate_down(e->m_heap_index - 1, value_type{ m_key(*e), e });
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::decrease(T* e)
+{
+    assert(e && contains(e));
+    percolate_up(e->m_heap_index - 1, value_type{ m_key(*e), e });
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::erase(T* e)
+{
+    assert(e && contains(e));
+    size_type pos = e->m_heap_index - 1;
+    e->m_heap_index = 0;
+    value_type last = m_data.back();
+    m_data.pop_back();
+    if (pos == m_data.size()) {
+        return; // erased the last element
+    }
+    if (pos != 0 && last.key < m_data[parent(pos)].key) {
+        percolate_up(pos, last);
+    } else {
+        percolate_down(pos, last);
+    }
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::make()
+{
+    for (auto& v : m_data) {
+        v.key = m_key(*v.elem);
+    }
+    if (m_data.size() < 2) {
+        return;
+    }
+    for (size_type i = parent(m_data.size() - 1) + 1; i-- > 0; ) {
+        percolate_down(i, m_data[i]);
+    }
+}
+
+template <class T, class Key, std::size_t D>
+template <class UnaryFunction>
+void intrusive_dary_heap<T, Key, D>::for_each(UnaryFunction f) const
+{
+    for (auto& v : m_data) {
+        f(v.elem);
+    }
+}
+
+template <class T, class Key, std::size_t D>
+template <class UnaryPredicate>
+T* intrusive_dary_heap<T, Key, D>::find_if(UnaryPredicate p) const
+{
+    for (auto& v : m_data) {
+        if (p(v.elem)) {
+            return v.elem;
+        }
+    }
+    return nullptr;
+}
+
+template <class T, class Key, std::size_t D>
+void intrusive_dary_heap<T, Key, D>::swap(intrusive_dary_heap& o)
+{
+    if (this != &o) {
+        using std::swap;
+        swap(m_data, o.m_data);
+        swap(m_key, o.m_key);
+    }
+}
+
+template <class T, class Key, std::size_t D>
+inline
+typename intrusive_dary_heap<T, Key, D>::size_type
+intrusive_dary_heap<T, Key, D>::parent(size_type index) const
+{
+    return (index - 1) / D;
+}
+
+template <class T, class Key, std::size_t D>
+inline
+typename intrusive_dary_heap<T, Key, D>::size_type
+intrusive_dary_heap<T, Key, D>::first_child(size_type index) const
+{
+    return D * index + 1;
+}
+
+// Sift the value \p v, which is to be placed at index \p pivot, down the heap
+template <class T, class Key, std::size_t D>
+inline
+void intrusive_dary_heap<T, Key, D>::percolate_down(
+    size_type pivot,
+    value_type v)
+{
+    const size_type n = m_data.size();
+    for (;;) {
+        size_type c = first_child(pivot);
+        if (c >= n) {
+            break;
+        }
+
+        // find the minimum child
+        size_type last = std::min(c + D, n);
+        size_type s = c;
+        for (++c; c < last; ++c) {
+            if (m_data[c].key < m_data[s].key) {
+                s = c;
+            }
+        }
+
+        if (!(m_data[s].key < v.key)) {
+            break;
+        }
+
+        m_data[pivot] = m_data[s];
+        m_data[pivot].elem->m_heap_index = pivot + 1;
+        pivot = s;
+    }
+    m_data[pivot] = v;
+    v.elem->m_heap_index = pivot + 1;
+}
+
+// Sift the value \p v, which is to be placed at index \p pivot, up the heap
+template <class T, class Key, std::size_t D>
+inline
+void intrusive_dary_heap<T, Key, D>::percolate_up(
+    size_type pivot,
+    value_type v)
+{
+    while (pivot != 0) {
+        size_type p = parent(pivot);
+        if (!(v.key < m_data[p].key)) {
+            break;
+        }
+        m_data[pivot] = m_data[p];
+        m_data[pivot].elem->m_heap_index = pivot + 1;
+        pivot = p;
+    }
+    m_data[pivot] = v;
+    v.elem->m_heap_index = pivot + 1;
+}
+
+template <class T, class Key, std::size_t D>
+void swap(
+    intrusive_dary_heap<T, Key, D>& lhs,
+    intrusive_dary_heap<T, Key, D>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace smpl
+
+#endif
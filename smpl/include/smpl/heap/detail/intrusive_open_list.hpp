@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_INTRUSIVE_OPEN_LIST_HPP
+#define SMPL_INTRUSIVE_OPEN_LIST_HPP
+
+#include "../intrusive_open_list.h"
+
+#include <vector>
+
+namespace smpl {
+
+#define SMPL_OPEN_LIST_DISPATCH(call) \
+    switch (m_type) { \
+    case OpenListType::BinaryHeap: return m_binary.call; \
+    case OpenListType::QuaternaryHeap: return m_quaternary.call; \
+    case OpenListType::BucketQueue: default: return m_buckets.call; \
+    }
+
+template <class T, class Key>
+intrusive_open_list<T, Key>::intrusive_open_list(
+    OpenListType type,
+    const key_function& key)
+:
+    m_type(type),
+    m_binary(key_compare(key)),
+    m_quaternary(key),
+    m_buckets(key)
+{
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::set_type(OpenListType type)
+{
+    if (type == m_type) {
+        return;
+    }
+
+    std::vector<T*> elements;
+    elements.reserve(size());
+    for_each([&](T* e) { elements.push_back(e); });
+    clear();
+
+    m_type = type;
+    for (T* e : elements) {
+        push(e);
+    }
+}
+
+template <class T, class Key>
+T* intrusive_open_list<T, Key>::min() const
+{
+    SMPL_OPEN_LIST_DISPATCH(min());
+}
+
+template <class T, class Key>
+bool intrusive_open_list<T, Key>::empty() const
+{
+    SMPL_OPEN_LIST_DISPATCH(empty());
+}
+
+template <class T, class Key>
+typename intrusive_open_list<T, Key>::size_type
+intrusive_open_list<T, Key>::size() const
+{
+    SMPL_OPEN_LIST_DISPATCH(size());
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::clear()
+{
+    SMPL_OPEN_LIST_DISPATCH(clear());
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::push(T* e)
+{
+    SMPL_OPEN_LIST_DISPATCH(push(e));
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::pop()
+{
+    SMPL_OPEN_LIST_DISPATCH(pop());
+}
+
+template <class T, class Key>
+bool intrusive_open_list<T, Key>::contains(T* e)
+{
+    SMPL_OPEN_LIST_DISPATCH(contains(e));
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::update(T* e)
+{
+    SMPL_OPEN_LIST_DISPATCH(update(e));
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::increase(T* e)
+{
+    SMPL_OPEN_LIST_DISPATCH(increase(e));
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::decrease(T* e)
+{
+    SMPL_OPEN_LIST_DISPATCH(decrease(e));
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::erase(T* e)
+{
+    SMPL_OPEN_LIST_DISPATCH(erase(e));
+}
+
+template <class T, class Key>
+void intrusive_open_list<T, Key>::make()
+{
+    SMPL_OPEN_LIST_DISPATCH(make());
+}
+
+template <class T, class Key>
+template <class UnaryFunction>
+void intrusive_open_list<T, Key>::for_each(UnaryFunction f) const
+{
+    switch (m_type) {
+    case OpenListType::BinaryHeap:
+        for (T* e : m_binary) {
+            f(e);
+        }
+        break;
+    case OpenListType::QuaternaryHeap:
+        m_quaternary.for_each(f);
+        break;
+    case OpenListType::BucketQueue:
+        m_buckets.for_each(f);
+        break;
+    }
+}
+
+template <class T, class Key>
+template <class UnaryPredicate>
+T* intrusive_open_list<T, Key>::find_if(UnaryPredicate p) const
+{
+    switch (m_type) {
+    case OpenListType::BinaryHeap:
+        for (T* e : m_binary) {
+            if (p(e)) {
+                return e;
+            }
+        }
+        return nullptr;
+    case OpenListType::QuaternaryHeap:
+        return m_quaternary.find_if(p);
+    case OpenListType::BucketQueue:
+    default:
+        return m_buckets.find_if(p);
+    }
+}
+
+#undef SMPL_OPEN_LIST_DISPATCH
+
+} // namespace smpl
+
+#endif
@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_INTRUSIVE_BUCKET_QUEUE_H
+#define SMPL_INTRUSIVE_BUCKET_QUEUE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#include <smpl/heap/intrusive_heap.h>
+
+namespace smpl {
+
+/// Provides an intrusive bucket queue for elements with small, non-negative
+/// integer priorities, such as the f-values of a search with integer edge
+/// costs. Objects inserted into the queue must derive from the \p heap_element
+/// class and must remain valid throughout the lifetime of the queue.
+///
+/// The queue maintains one bucket per priority value within a window of
+/// \p bucket_limit consecutive priorities, starting at or below the minimum
+/// priority in the queue, and a cursor to the lowest non-empty bucket. The
+/// buckets are arranged in a ring, indexed by priority modulo the window size,
+/// so the window may move without moving the elements inside it. Insertion,
+/// erasure, and priority updates take constant time; finding the minimum
+/// element takes time proportional to the distance the cursor must advance,
+/// which is amortized constant for the nearly-monotone priorities seen during
+/// a search. Ties between elements with equal priority are broken
+/// approximately in favor of the most recently inserted element.
+///
+/// The priority of an element is the result of calling the \p Key function
+/// object on it, which must return an integral type. Elements with priorities
+/// beyond the window are stored, unordered, in a single overflow bucket. Once
+/// all buckets in the window are empty, the window moves to the minimum
+/// priority in the overflow bucket, and the elements that now fall inside it
+/// are moved into their buckets. Inserting an element with a priority below
+/// the window moves the window down, moving the elements that fall outside
+/// it into the overflow bucket. At most \p bucket_limit + 1 buckets are ever
+/// allocated.
+///
+/// The position of each element is encoded into its heap index as its bucket
+/// index in the upper 32 bits and its position within that bucket in the
+/// lower 32 bits.
+template <class T, class Key>
+class intrusive_bucket_queue
+{
+public:
+
+    static_assert(std::is_base_of<heap_element, T>::value, "T must extend heap_element");
+    static_assert(sizeof(std::size_t) >= sizeof(std::uint64_t), "intrusive_bucket_queue requires 64-bit heap indices");
+
+    typedef Key key_function;
+    typedef typename std::decay<
+            typename std::result_of<const Key(const T&)>::type>::type
+    key_type;
+
+    static_assert(std::is_integral<key_type>::value, "Key must return an integral type");
+
+    typedef std::vector<T*> bucket_type;
+    typedef std::vector<bucket_type> container_type;
+    typedef std::size_t size_type;
+
+    static const size_type default_bucket_limit = size_type(1) << 14;
+
+    intrusive_bucket_queue(
+        const key_function& key = key_function(),
+        size_type bucket_limit = default_bucket_limit);
+
+    intrusive_bucket_queue(const intrusive_bucket_queue&) = delete;
+    intrusive_bucket_queue(intrusive_bucket_queue&& o);
+
+    intrusive_bucket_queue& operator=(const intrusive_bucket_queue&) = delete;
+    intrusive_bucket_queue& operator=(intrusive_bucket_queue&& rhs);
+
+    T* min() const;
+
+    bool empty() const;
+    size_type size() const;
+    size_type max_size() const;
+    size_type bucket_limit() const;
+
+    void clear();
+    void push(T* e);
+    void pop();
+    bool contains(T* e);
+    void update(T* e);
+    void increase(T* e);
+    void decrease(T* e);
+    void erase(T* e);
+
+    void make();
+
+    /// Call \p f on every element in the queue, in order of increasing
+    /// priority, except within the overflow bucket.
+    template <class UnaryFunction>
+    void for_each(UnaryFunction f) const;
+
+    /// Return the first element, in order of increasing priority, that
+    /// satisfies \p p, or nullptr if no such element exists. The minimum
+    /// element is always visited first.
+    template <class UnaryPredicate>
+    T* find_if(UnaryPredicate p) const;
+
+    void swap(intrusive_bucket_queue& o);
+
+private:
+
+    // one bucket per priority in the window, followed by the overflow bucket
+    container_type m_buckets;
+    size_type m_size;
+    size_type m_bucket_limit;
+
+    // number of elements in buckets within the window
+    size_type m_window_size;
+
+    // lowest priority within the window
+    size_type m_base;
+
+    // all buckets for priorities in [m_base, m_min) are empty
+    mutable size_type m_min;
+
+    Key m_key;
+
+    size_type priority_of(const T* e) const;
+    size_type bucket_of(size_type priority) const;
+
+    static size_type bucket_index(size_type heap_index);
+    static size_type slot_index(size_type heap_index);
+    static size_type heap_index(size_type bucket, size_type slot);
+
+    void insert(T* e);
+    void place(T* e, size_type priority);
+    void remove(T* e);
+    void lower_window(size_type priority);
+    void refill_window();
+};
+
+template <class T, class Key>
+void swap(
+    intrusive_bucket_queue<T, Key>& lhs,
+    intrusive_bucket_queue<T, Key>& rhs);
+
+} // namespace smpl
+
+#include "detail/intrusive_bucket_queue.hpp"
+
+#endif
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_INTRUSIVE_DARY_HEAP_H
+#define SMPL_INTRUSIVE_DARY_HEAP_H
+
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <smpl/heap/intrusive_heap.h>
+
+namespace smpl {
+
+/// Provides an intrusive d-ary heap implementation. As with \p intrusive_heap,
+/// objects inserted into the heap must derive from the \p heap_element class
+/// and must remain valid throughout the lifetime of the heap.
+///
+/// Unlike \p intrusive_heap, the priority of each element is stored inline,
+/// alongside the element pointer, as the result of calling the \p Key function
+/// object on the element at the time it is inserted or updated. Comparisons
+/// made while sifting elements through the heap therefore never dereference
+/// element pointers, and the wider fan-out of the heap (4 children per node by
+/// default) halves its depth and keeps all children of a node within a single
+/// cache line.
+///
+/// Since priorities are cached, they must be refreshed by calling update(),
+/// increase(), or decrease() on any element whose priority has changed, or
+/// make() if the priorities of multiple elements have changed.
+template <class T, class Key, std::size_t D = 4>
+class intrusive_dary_heap
+{
+public:
+
+    static_assert(std::is_base_of<heap_element, T>::value, "T must extend heap_element");
+    static_assert(D >= 2, "D must be at least 2");
+
+    typedef Key key_function;
+    typedef typename std::decay<
+            typename std::result_of<const Key(const T&)>::type>::type
+    key_type;
+
+    struct value_type
+    {
+        key_type key;
+        T* elem;
+    };
+
+    typedef std::vector<value_type> container_type;
+    typedef typename container_type::size_type size_type;
+
+    intrusive_dary_heap(const key_function& key = key_function());
+
+    intrusive_dary_heap(const intrusive_dary_heap&) = delete;
+    intrusive_dary_heap(intrusive_dary_heap&& o);
+
+    intrusive_dary_heap& operator=(const intrusive_dary_heap&) = delete;
+    intrusive_dary_heap& operator=(intrusive_dary_heap&& rhs);
+
+    T* min() const;
+    key_type min_key() const;
+
+    bool empty() const;
+    size_type size() const;
+    size_type max_size() const;
+    void reserve(size_type new_cap);
+
+    void clear();
+    void push(T* e);
+    void pop();
+    bool contains(T* e);
+    void update(T* e);
+    void increase(T* e);
+    void decrease(T* e);
+    void erase(T* e);
+
+    void make();
+
+    /// Call \p f on every element in the heap, in heap order.
+    template <class UnaryFunction>
+    void for_each(UnaryFunction f) const;
+
+    /// Return the first element, in heap order, that satisfies \p p, or
+    /// nullptr if no such element exists. The minimum element is always
+    /// visited first.
+    template <class UnaryPredicate>
+    T* find_if(UnaryPredicate p) const;
+
+    void swap(intrusive_dary_heap& o);
+
+private:
+
+    container_type m_data;
+    Key m_key;
+
+    size_type parent(size_type index) const;
+    size_type first_child(size_type index) const;
+
+    void percolate_down(size_type pivot, value_type v);
+    void percolate_up(size_type pivot, value_type v);
+};
+
+template <class T, class Key, std::size_t D>
+void swap(
+    intrusive_dary_heap<T, Key, D>& lhs,
+    intrusive_dary_heap<T, Key, D>& rhs);
+
+} // namespace smpl
+
+#include "detail/intrusive_dary_heap.hpp"
+
+#endif
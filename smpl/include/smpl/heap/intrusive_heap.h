@@ -40,6 +40,12 @@ namespace smpl {
 template <class T, class Compare>
 class intrusive_heap;
 
+template <class T, class Key, std::size_t D>
+class intrusive_dary_heap;
+
+template <class T, class Key>
+class intrusive_bucket_queue;
+
 struct heap_element
 {
 
@@ -51,6 +57,12 @@ private:
 
     template <class T, class Compare>
     friend class intrusive_heap;
+
+    template <class T, class Key, std::size_t D>
+    friend class intrusive_dary_heap;
+
+    template <class T, class Key>
+    friend class intrusive_bucket_queue;
 };
 
 /// Provides an intrusive binary heap implementation. Objects inserted into the
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_INTRUSIVE_OPEN_LIST_H
+#define SMPL_INTRUSIVE_OPEN_LIST_H
+
+#include <cstdlib>
+
+#include <smpl/heap/intrusive_bucket_queue.h>
+#include <smpl/heap/intrusive_dary_heap.h>
+#include <smpl/heap/intrusive_heap.h>
+
+namespace smpl {
+
+enum class OpenListType
+{
+    BinaryHeap,     ///< intrusive_heap
+    QuaternaryHeap, ///< intrusive_dary_heap with keys stored inline
+    BucketQueue     ///< intrusive_bucket_queue
+};
+
+inline auto to_cstring(OpenListType type) -> const char* {
+    switch (type) {
+    case OpenListType::BinaryHeap:
+        return "BinaryHeap";
+    case OpenListType::QuaternaryHeap:
+        return "QuaternaryHeap";
+    case OpenListType::BucketQueue:
+        return "BucketQueue";
+    default:
+        return "";
+    }
+}
+
+/// An intrusive priority queue for search states whose underlying data
+/// structure may be selected at runtime. Elements are ordered by the integer
+/// priority returned by calling the \p Key function object on them.
+///
+/// All implementations share the interface of \p intrusive_heap, except that
+/// iteration is provided through for_each() and find_if() rather than
+/// iterators. The implementation may be changed at any time via set_type(),
+/// which migrates all contained elements into the new data structure.
+template <class T, class Key>
+class intrusive_open_list
+{
+public:
+
+    typedef Key key_function;
+    typedef std::size_t size_type;
+
+    intrusive_open_list(
+        OpenListType type = OpenListType::BinaryHeap,
+        const key_function& key = key_function());
+
+    intrusive_open_list(const intrusive_open_list&) = delete;
+    intrusive_open_list& operator=(const intrusive_open_list&) = delete;
+
+    OpenListType type() const { return m_type; }
+    void set_type(OpenListType type);
+
+    T* min() const;
+
+    bool empty() const;
+    size_type size() const;
+
+    void clear();
+    void push(T* e);
+    void pop();
+    bool contains(T* e);
+    void update(T* e);
+    void increase(T* e);
+    void decrease(T* e);
+    void erase(T* e);
+
+    void make();
+
+    /// Call \p f on every element in the open list.
+    template <class UnaryFunction>
+    void for_each(UnaryFunction f) const;
+
+    /// Return an element that satisfies \p p, or nullptr if no such element
+    /// exists. The minimum element is always visited first.
+    template <class UnaryPredicate>
+    T* find_if(UnaryPredicate p) const;
+
+private:
+
+    struct key_compare
+    {
+        Key key;
+        key_compare(const Key& key) : key(key) { }
+        bool operator()(const T& a, const T& b) const {
+            return key(a) < key(b);
+        }
+    };
+
+    OpenListType m_type;
+    intrusive_heap<T, key_compare> m_binary;
+    intrusive_dary_heap<T, Key, 4> m_quaternary;
+    intrusive_bucket_queue<T, Key> m_buckets;
+};
+
+} // namespace smpl
+
+#include "detail/intrusive_open_list.hpp"
+
+#endif
@@ -43,7 +43,9 @@
 
 namespace smpl {
 
-class BfsHeuristic : public RobotHeuristic
+class BfsHeuristic :
+    public RobotHeuristic,
+    public ConcurrentHeuristicExtension
 {
 public:
 
@@ -56,6 +58,19 @@ public:
     int costPerCell() const { return m_cost_per_cell; }
     void setCostPerCell(int cost);
 
+    /// \brief Evaluate the BFS on demand rather than flooding the entire grid.
+    ///
+    /// \see BFS_3D::setLazy
+    bool lazyEvaluation() const { return m_lazy; }
+    void setLazyEvaluation(bool lazy);
+
+    /// \brief Set the number of cells expanded when the goal is updated, when
+    ///     lazy evaluation is enabled.
+    ///
+    /// \see BFS_3D::setPrecomputeBudget
+    int precomputeBudget() const { return m_precompute_budget; }
+    void setPrecomputeBudget(int expansions);
+
     auto grid() const -> const OccupancyGrid* { return m_grid; }
 
     auto getWallsVisualization() const -> visual::Marker;
@@ -91,8 +106,13 @@ private:
     std::unique_ptr<BFS_3D> m_bfs;
     PointProjectionExtension* m_pp = nullptr;
 
+    // private projection context, when the planning space provides one
+    std::unique_ptr<PoseProjectionExtension> m_projection;
+
     double m_inflation_radius = 0.0;
     int m_cost_per_cell = 1;
+    bool m_lazy = false;
+    int m_precompute_budget = 0;
 
     struct CellCoord
     {
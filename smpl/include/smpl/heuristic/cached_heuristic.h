@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_CACHED_HEURISTIC_H
+#define SMPL_CACHED_HEURISTIC_H
+
+// standard includes
+#include <cstdint>
+#include <vector>
+
+// project includes
+#include <smpl/heuristic/robot_heuristic.h>
+
+namespace smpl {
+
+/// A RobotHeuristic decorator that memoizes the goal and start heuristic
+/// values of another RobotHeuristic.
+///
+/// Values are stored in dense arrays indexed by state id, so the underlying
+/// heuristic is only queried once per state between changes to the goal or
+/// start. The goal values are invalidated by updateGoal() and the start values
+/// by updateStart(), both of which are forwarded to the underlying heuristic.
+/// Extensions other than RobotHeuristic are forwarded as well, so the decorator
+/// may be substituted wherever the underlying heuristic is used.
+///
+/// GetFromToHeuristic() is not cached.
+class CachedHeuristic : public RobotHeuristic
+{
+public:
+
+    bool init(RobotPlanningSpace* space, RobotHeuristic* h);
+
+    auto heuristic() -> RobotHeuristic* { return m_orig_h; }
+    auto heuristic() const -> const RobotHeuristic* { return m_orig_h; }
+
+    /// \brief Discard all cached values.
+    void invalidate();
+
+    /// \name Cache Statistics
+    ///@{
+    auto hits() const -> std::uint64_t { return m_hits; }
+    auto misses() const -> std::uint64_t { return m_misses; }
+    double hitRate() const;
+    void resetStats();
+    ///@}
+
+    /// \name Required Public Functions from RobotHeuristic
+    ///@{
+    double getMetricStartDistance(double x, double y, double z) override;
+    double getMetricGoalDistance(double x, double y, double z) override;
+    ///@}
+
+    /// \name Required Public Functions from Extension
+    ///@{
+    Extension* getExtension(size_t class_code) override;
+    ///@}
+
+    /// \name Reimplemented Public Functions from RobotPlanningSpaceObserver
+    ///@{
+    void updateStart(const RobotState& state) override;
+    void updateGoal(const GoalConstraint& goal) override;
+    ///@}
+
+    /// \name Required Public Functions from Heuristic
+    ///@{
+    int GetGoalHeuristic(int state_id) override;
+    int GetStartHeuristic(int state_id) override;
+    int GetFromToHeuristic(int from_id, int to_id) override;
+    ///@}
+
+private:
+
+    static const int Unknown = -1;
+
+    RobotHeuristic* m_orig_h = nullptr;
+
+    std::vector<int> m_goal_values;
+    std::vector<int> m_start_values;
+
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+};
+
+} // namespace smpl
+
+#endif
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_DIJKSTRA_2D_HEURISTIC_H
+#define SMPL_DIJKSTRA_2D_HEURISTIC_H
+
+// standard includes
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// project includes
+#include <smpl/heuristic/robot_heuristic.h>
+
+namespace smpl {
+
+class OccupancyGrid;
+
+/// A heuristic for planar planning spaces, such as XYThetaLattice, that
+/// returns the cost of the shortest path from a state's (x, y) position to the
+/// goal through one layer of an OccupancyGrid, ignoring heading.
+///
+/// Costs are computed by a Dijkstra search outward from the goal region over a
+/// 16-connected grid, whose edges include the (1, 2) and (2, 1) lattice
+/// directions, so that the costs of straight motions along any of the
+/// XYThetaLattice headings are matched exactly. The search is resumed only as
+/// far as is necessary to answer each query, so the work done is proportional
+/// to the region the planner explores. Arcs may be shorter than the
+/// corresponding grid path by a few percent, so the heuristic is only nearly
+/// admissible for lattices with arc motions.
+class Dijkstra2DHeuristic : public RobotHeuristic
+{
+public:
+
+    bool init(RobotPlanningSpace* space, const OccupancyGrid* grid);
+
+    auto grid() const -> const OccupancyGrid* { return m_grid; }
+
+    /// Cells within this distance of an obstacle are treated as walls. This
+    /// is typically the inscribed radius of the robot's footprint. As with
+    /// XYThetaLattice::Params::padding, the distance field also measures
+    /// distance to the top and bottom of the grid.
+    double inflationRadius() const { return m_inflation_radius; }
+    void setInflationRadius(double radius);
+
+    /// The cost of moving one meter, which should match the cost of motions
+    /// in the planning space.
+    int costPerMeter() const { return m_cost_per_meter; }
+    void setCostPerMeter(int cost);
+
+    /// Return the number of cells whose cost to the goal has been finalized.
+    size_t expandedCellCount() const { return m_expanded_count; }
+
+    /// \name Required Public Functions from RobotHeuristic
+    ///@{
+    double getMetricStartDistance(double x, double y, double z) override;
+    double getMetricGoalDistance(double x, double y, double z) override;
+    ///@}
+
+    /// \name Required Public Functions from Extension
+    ///@{
+    Extension* getExtension(size_t class_code) override;
+    ///@}
+
+    /// \name Reimplemented Public Functions from RobotPlanningSpaceObserver
+    ///@{
+    void updateGoal(const GoalConstraint& goal) override;
+    ///@}
+
+    /// \name Required Public Functions from Heuristic
+    ///@{
+    int GetGoalHeuristic(int state_id) override;
+    int GetStartHeuristic(int state_id) override;
+    int GetFromToHeuristic(int from_id, int to_id) override;
+    ///@}
+
+private:
+
+    enum CellStatus : std::uint8_t { Unknown = 0, Open, Closed, Wall };
+
+    const OccupancyGrid* m_grid = nullptr;
+
+    PointProjectionExtension* m_pp = nullptr;
+
+    double m_inflation_radius = 0.0;
+    int m_cost_per_meter = 1000;
+
+    int m_num_cells_x = 0;
+    int m_num_cells_y = 0;
+    int m_layer = 0;
+
+    // cost to the goal and search status of each cell in the layer
+    std::vector<int> m_costs;
+    std::vector<CellStatus> m_status;
+
+    typedef std::pair<int, int> OpenEntry; // (cost, cell index)
+    std::priority_queue<
+            OpenEntry,
+            std::vector<OpenEntry>,
+            std::greater<OpenEntry>> m_open;
+
+    struct Move
+    {
+        int dx;
+        int dy;
+        int cost;
+    };
+    std::vector<Move> m_moves;
+
+    size_t m_expanded_count = 0;
+
+    void updateMoves();
+    int getCellCost(int x, int y);
+};
+
+} // namespace smpl
+
+#endif
@@ -32,13 +32,18 @@
 #ifndef SMPL_EUCLID_DIST_HEURISTIC_H
 #define SMPL_EUCLID_DIST_HEURISTIC_H
 
+// standard includes
+#include <memory>
+
 // project includes
 #include <smpl/heuristic/robot_heuristic.h>
 #include <smpl/spatial.h>
 
 namespace smpl {
 
-class EuclidDistHeuristic : public RobotHeuristic
+class EuclidDistHeuristic :
+    public RobotHeuristic,
+    public ConcurrentHeuristicExtension
 {
 public:
 
@@ -74,6 +79,9 @@ private:
     PoseProjectionExtension* m_pose_ext = nullptr;
     PointProjectionExtension* m_point_ext = nullptr;
 
+    // private projection context, when the planning space provides one
+    std::unique_ptr<PoseProjectionExtension> m_projection;
+
     double m_x_coeff = 1.0;
     double m_y_coeff = 1.0;
     double m_z_coeff = 1.0;
@@ -35,6 +35,7 @@
 // standard includes
 #include <stdint.h>
 #include <limits>
+#include <vector>
 
 // system includes
 #include <sbpl/heuristics/heuristic.h>
@@ -87,6 +88,27 @@ private:
     RobotPlanningSpace* m_space = nullptr;
 };
 
+/// Extension for heuristics that may be evaluated concurrently with the other
+/// heuristics of a search, e.g. while computing the heuristics of a batch of
+/// successors. Such a heuristic only reads from its planning space and owns
+/// any other mutable state it uses, such as a private projection context (see
+/// ProjectionContextExtension). A single heuristic is still only queried from
+/// one thread at a time.
+class ConcurrentHeuristicExtension : public virtual Extension
+{
+};
+
+/// Partition a set of heuristics into groups that may be evaluated
+/// concurrently with one another. Each heuristic that reports
+/// ConcurrentHeuristicExtension forms its own group, along with any repeated
+/// entries for the same heuristic. All other heuristics share the first group
+/// and must be evaluated one after another on a single thread. Groups store
+/// indices into \p heuristics; empty groups are omitted.
+void PartitionConcurrentHeuristics(
+    Heuristic* const* heuristics,
+    int count,
+    std::vector<std::vector<int>>& groups);
+
 } // namespace smpl
 
 #endif
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_SPARSE_BFS_HEURISTIC_H
+#define SMPL_SPARSE_BFS_HEURISTIC_H
+
+// standard includes
+#include <deque>
+#include <limits>
+#include <vector>
+
+// system includes
+#include <Eigen/Core>
+
+// project includes
+#include <smpl/debug/marker.h>
+#include <smpl/grid/sparse_grid.h>
+#include <smpl/heuristic/robot_heuristic.h>
+
+namespace smpl {
+
+class OccupancyGrid;
+
+/// A BFS heuristic over the cells of an OccupancyGrid that does not require
+/// dense storage for the entire grid. Distances are stored in a SparseGrid,
+/// which remains compressed in regions the search never visits, and walls are
+/// determined on demand from the occupancy grid's distance field rather than
+/// copied up front.
+///
+/// The wavefront is seeded from the goal cells in updateGoal() and is only
+/// advanced when the distance to a cell that has not yet been discovered is
+/// requested, so the work done is proportional to the region of the workspace
+/// the search actually visits.
+class SparseBfsHeuristic : public RobotHeuristic
+{
+public:
+
+    bool init(RobotPlanningSpace* space, const OccupancyGrid* grid);
+
+    double inflationRadius() const { return m_inflation_radius; }
+    void setInflationRadius(double radius);
+    int costPerCell() const { return m_cost_per_cell; }
+    void setCostPerCell(int cost);
+
+    auto grid() const -> const OccupancyGrid* { return m_grid; }
+
+    /// \brief Return the number of cells whose distance has been computed.
+    size_t discoveredCellCount() const { return m_discovered_count; }
+
+    auto getWallsVisualization() -> visual::Marker;
+    auto getValuesVisualization() -> visual::Marker;
+
+    /// \name Required Public Functions from RobotHeuristic
+    ///@{
+    double getMetricStartDistance(double x, double y, double z) override;
+    double getMetricGoalDistance(double x, double y, double z) override;
+    ///@}
+
+    /// \name Required Public Functions from Extension
+    ///@{
+    Extension* getExtension(size_t class_code) override;
+    ///@}
+
+    /// \name Reimplemented Public Functions from RobotPlanningSpaceObserver
+    ///@{
+    void updateGoal(const GoalConstraint& goal) override;
+    ///@}
+
+    /// \name Required Public Functions from Heuristic
+    ///@{
+    int GetGoalHeuristic(int state_id) override;
+    int GetStartHeuristic(int state_id) override;
+    int GetFromToHeuristic(int from_id, int to_id) override;
+    ///@}
+
+private:
+
+    // cell values, stored as the number of cells to the nearest goal cell
+    static const int Unknown = std::numeric_limits<int>::max() >> 1;
+    static const int Wall = std::numeric_limits<int>::max();
+
+    const OccupancyGrid* m_grid = nullptr;
+
+    PointProjectionExtension* m_pp = nullptr;
+
+    double m_inflation_radius = 0.0;
+    int m_cost_per_cell = 1;
+
+    SparseGrid<int> m_dist_grid;
+
+    // the bfs wavefront; the distance of each cell is assigned when it is
+    // discovered so only the cell coordinates need to be retained
+    std::deque<Eigen::Vector3i> m_open;
+
+    std::vector<Eigen::Vector3i> m_goal_cells;
+
+    size_t m_discovered_count = 0;
+
+    bool isWallCell(int x, int y, int z) const;
+    int getCellDistance(int x, int y, int z);
+    void expandWavefrontCell();
+    int getBfsCostToGoal(int x, int y, int z);
+};
+
+} // namespace smpl
+
+#endif
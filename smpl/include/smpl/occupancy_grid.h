@@ -166,6 +166,11 @@ private:
     int m_y_stride;
     std::vector<int> m_counts;
 
+    // points whose reference counts change to or from zero during an update,
+    // retained between updates to avoid reallocating them
+    std::vector<Vector3> m_rem_pts;
+    std::vector<Vector3> m_add_pts;
+
     void initRefCounts();
 
     int coordToIndex(int x, int y, int z) const;
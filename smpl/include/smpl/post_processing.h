@@ -51,6 +51,20 @@ void ShortcutPath(
     std::vector<RobotState>& pout,
     ShortcutType type);
 
+/// \brief Shortcut a path, checking candidate shortcuts on multiple threads.
+///
+/// One thread is used per collision checker, and each checker is only ever
+/// used by one thread at a time. The resulting path is identical to the one
+/// returned by the single-checker version. Euclidean shortcutting requires
+/// inverse kinematics from the robot model, which is not assumed to be safe to
+/// call concurrently, and so is always performed on a single thread.
+void ShortcutPath(
+    RobotModel* rm,
+    const std::vector<CollisionChecker*>& checkers,
+    const std::vector<RobotState>& pin,
+    std::vector<RobotState>& pout,
+    ShortcutType type);
+
 bool InterpolatePath(
     CollisionChecker& cc,
     std::vector<RobotState>& path);
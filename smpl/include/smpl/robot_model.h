@@ -157,6 +157,44 @@ public:
         RobotState& solution) = 0;
 };
 
+/// \brief Extension for solving several restricted inverse kinematics problems
+///     of a RedundantManipulatorInterface at once
+class BatchRedundantManipulatorInterface : public virtual RobotModel
+{
+public:
+
+    /// \brief Compute inverse kinematics solutions for \p count poses while
+    ///     restricting the redundant joint variables of each solution to those
+    ///     of the corresponding seed state.
+    ///
+    /// On return, solved[i] is set to indicate whether a solution was found
+    /// for poses[i], and, if so, the solution is stored in solutions[i].
+    virtual void computeFastIKBatch(
+        const Affine3* poses,
+        const RobotState* seeds,
+        std::size_t count,
+        RobotState* solutions,
+        bool* solved) = 0;
+};
+
+/// \brief Extension for robot models that can produce independent copies of
+///     their forward kinematics solver for use by concurrent callers
+///
+/// The copy shares the immutable kinematic description of the robot with its
+/// source but owns the mutable state used to compute forward kinematics, so
+/// the copy and the source may be queried from different threads at the same
+/// time. The source must not be reconfigured (planning joints, planning link,
+/// reference state) while any of its copies are in use.
+class CloneableForwardKinematicsInterface : public virtual RobotModel
+{
+public:
+
+    /// Return a new forward kinematics solver, equivalent to this one.
+    /// Returns null if a copy could not be made.
+    virtual auto cloneForwardKinematics()
+        -> std::unique_ptr<ForwardKinematicsInterface> = 0;
+};
+
 /// \brief Convenience class allowing a component to implement all root
 ///     interface methods via an existing extension
 class RobotModelChild : public virtual RobotModel
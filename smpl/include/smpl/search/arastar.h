@@ -42,7 +42,8 @@
 #include <sbpl/planners/planner.h>
 
 // project includes
-#include <smpl/heap/intrusive_heap.h>
+#include <smpl/arena.h>
+#include <smpl/heap/intrusive_open_list.h>
 #include <smpl/time.h>
 
 namespace smpl {
@@ -71,12 +72,18 @@ namespace smpl {
 ///   Often, many graph representations that support multiple or underdefined
 ///   goal states will represent the goal state given to the planner using a
 ///   single goal state ID. If this is the case, the caller will have to assert
-///   whether or not the goal has changed, and force the planner to reinitialize
-///   by calls for force_planning_from_scratch (TODO: shouldn't require full
-///   reinitialization)
+///   whether or not the goal has changed, either by notifying the search via
+///   costs_changed(), listing the goal state and the states that satisfy the
+///   new goal as successors, or by forcing the planner to reinitialize by
+///   calls to force_planning_from_scratch.
 ///
 /// * The heuristics for any encountered states remain constant, unless the goal
-///   state ID has changed.
+///   state ID has changed or the goal state is listed in a call to
+///   costs_changed().
+///
+/// * The start state is the root of the search tree. Changes to the start
+///   state reinitialize the search, so the search tree is only repaired, rather
+///   than discarded, when the goal or the edge costs change.
 class ARAStar : public SBPLPlanner
 {
 public:
@@ -134,6 +141,11 @@ public:
     void setBoundExpansions(bool bound) { m_time_params.bounded = bound; }
     bool boundExpansions() const { return m_time_params.bounded; }
 
+    /// Select the data structure used to store OPEN. Takes effect immediately,
+    /// but is typically set before the first call to replan().
+    void setOpenListType(OpenListType type) { m_open.set_type(type); }
+    OpenListType openListType() const { return m_open.type(); }
+
     int replan(
         const TimeParameters &params,
         std::vector<int>* solution,
@@ -179,13 +191,12 @@ private:
         unsigned short call_number;
         SearchState* bp;
         bool incons;
+        bool goal_pred;     // whether the goal state is among the successors
     };
 
-    struct SearchStateCompare
+    struct SearchStateKey
     {
-        bool operator()(const SearchState& s1, const SearchState& s2) const {
-            return s1.f < s2.f;
-        }
+        unsigned int operator()(const SearchState& s) const { return s.f; }
     };
 
     DiscreteSpaceInformation* m_space;
@@ -199,6 +210,7 @@ private:
 
     bool m_allow_partial_solutions;
 
+    Arena m_state_arena;
     std::vector<SearchState*> m_states;
 
     int m_start_state_id;   // graph state id for the start state
@@ -206,8 +218,9 @@ private:
 
     // search state (not including the values of g, f, back pointers, and
     // closed list from m_stats)
-    intrusive_heap<SearchState, SearchStateCompare> m_open;
+    intrusive_open_list<SearchState, SearchStateKey> m_open;
     std::vector<SearchState*> m_incons;
+    std::vector<SearchState*> m_goal_preds; // expanded states that reached the goal
     double m_curr_eps;
     int m_iteration;
 
@@ -245,6 +258,10 @@ private:
 
     void expand(SearchState* s);
 
+    void reopenState(SearchState* s);
+    void resetGoalState(SearchState* goal_state);
+    void clearGoalPreds();
+
     void recomputeHeuristics();
     void reorderOpen();
     int computeKey(SearchState* s) const;
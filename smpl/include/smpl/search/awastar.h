@@ -37,7 +37,8 @@
 #include <sbpl/planners/planner.h>
 
 // project includes
-#include <smpl/heap/intrusive_heap.h>
+#include <smpl/arena.h>
+#include <smpl/heap/intrusive_open_list.h>
 #include <smpl/time.h>
 
 namespace smpl {
@@ -78,6 +79,9 @@ struct AWAStar : public SBPLPlanner
     AWAStar(DiscreteSpaceInformation* space, Heuristic* heuristic);
     ~AWAStar();
 
+    void set_open_list_type(OpenListType type) { m_open.set_type(type); }
+    OpenListType open_list_type() const { return m_open.type(); }
+
     /// \name Required Functions from SBPLPlanner
     ///@{
     int replan(double allowed_time_secs, std::vector<int>* solution) override {
@@ -125,18 +129,17 @@ struct AWAStar : public SBPLPlanner
         std::uint8_t flags;
     };
 
-    struct SearchStateCompare
+    struct SearchStateKey
     {
-        bool operator()(const SearchState& s1, const SearchState& s2) const {
-            return s1.f < s2.f;
-        }
+        int operator()(const SearchState& s) const { return s.f; }
     };
 
-    using OpenList = intrusive_heap<SearchState, SearchStateCompare>;
+    using OpenList = intrusive_open_list<SearchState, SearchStateKey>;
 
     DiscreteSpaceInformation*   m_space = nullptr;
     Heuristic*                  m_heur = nullptr;
 
+    Arena                       m_state_arena;
     std::vector<SearchState*>   m_states;
     OpenList                    m_open;
     std::vector<SearchState*>   m_suspended;
@@ -43,6 +43,7 @@
 // project includes
 #include <smpl/time.h>
 #include <smpl/console/console.h>
+#include <smpl/heuristic/robot_heuristic.h>
 
 namespace smpl {
 
@@ -66,6 +67,9 @@ MHAStarBase<Derived>::MHAStarBase(
     m_call_number(0), // uninitialized
     m_start_state(nullptr),
     m_goal_state(nullptr),
+    m_state_arena(
+            sizeof(MHASearchState) +
+            sizeof(MHASearchState::HeapData) * hcount),
     m_search_states(),
     m_open(nullptr)
 {
@@ -175,6 +179,8 @@ int MHAStarBase<Derived>::replan(
     // reinitializations
     reinit_search();
 
+    update_heuristic_groups();
+
     m_eps = m_params.initial_eps;
     m_eps_satisfied = (double)INFINITECOST;
 
@@ -382,6 +388,40 @@ double MHAStarBase<Derived>::get_max_time() const
     return m_params.max_time;
 }
 
+template <typename Derived>
+void MHAStarBase<Derived>::set_num_threads(int num_threads)
+{
+    if (num_threads == get_num_threads()) {
+        return;
+    }
+
+    if (num_threads > 1) {
+        m_pool.reset(new ThreadPool(num_threads));
+    } else {
+        m_pool.reset();
+    }
+}
+
+template <typename Derived>
+int MHAStarBase<Derived>::get_num_threads() const
+{
+    return m_pool ? m_pool->size() : 1;
+}
+
+template <typename Derived>
+void MHAStarBase<Derived>::set_open_list_type(OpenListType type)
+{
+    for (int i = 0; i < num_heuristics(); ++i) {
+        m_open[i].set_type(type);
+    }
+}
+
+template <typename Derived>
+OpenListType MHAStarBase<Derived>::get_open_list_type() const
+{
+    return m_open[0].type();
+}
+
 template <typename Derived>
 bool MHAStarBase<Derived>::check_params(const ReplanParams& params)
 {
@@ -433,14 +473,9 @@ MHASearchState* MHAStarBase<Derived>::get_state(int state_id)
     }
 
     if (m_graph_to_search_state[state_id] == -1) {
-        // overallocate search state for appropriate heuristic information
-        const size_t state_size =
-                sizeof(MHASearchState) +
-                sizeof(MHASearchState::HeapData) * (m_hcount);
-        MHASearchState* s = (MHASearchState*)malloc(state_size);
-
+        // arena blocks are overallocated for appropriate heuristic information;
         // force construction to correctly initialize heap position to null
-        new (s) MHASearchState;
+        MHASearchState* s = m_state_arena.create<MHASearchState>();
         for (int i = 1; i < num_heuristics(); ++i) {
             new (&s->od[i]) MHASearchState::HeapData;
         }
@@ -464,17 +499,9 @@ void MHAStarBase<Derived>::clear()
 {
     clear_open_lists();
 
-    // free states
-    for (size_t i = 0; i < m_search_states.size(); ++i) {
-        // unmap graph to search state
-        MHASearchState* search_state = m_search_states[i];
-
-        // free search state
-        free(m_search_states[i]);
-    }
-
-    // empty state table
+    // empty state table and free states
     m_search_states.clear();
+    m_state_arena.reset();
 
     m_start_state = nullptr;
     m_goal_state = nullptr;
@@ -489,9 +516,12 @@ void MHAStarBase<Derived>::init_state(
     state->state_id = state_id;
     state->closed_in_anc = false;
     state->closed_in_add = false;
+    // heuristics are computed when the state is first reinitialized for a
+    // search
     for (int i = 0; i < num_heuristics(); ++i) {
-        state->od[i].f = compute_heuristic(state->state_id, i);
         state->od[i].me = state;
+        state->od[i].h = 0;
+        state->od[i].f = INFINITECOST;
     }
 
     SMPL_DEBUG_STREAM("Initialized state: " << *state);
@@ -509,27 +539,77 @@ template <typename Derived>
 void MHAStarBase<Derived>::reinit_state(MHASearchState* state)
 {
     if (state->call_number != m_call_number) {
-        state->call_number = m_call_number;
-        state->g = INFINITECOST;
-        state->bp = nullptr;
+        reset_state(state);
+        compute_heuristics(&state, 1);
+    }
+}
+
+// Reinitialize the search data for a state, leaving its heuristic values to be
+// recomputed by the caller via compute_heuristics().
+template <typename Derived>
+void MHAStarBase<Derived>::reset_state(MHASearchState* state)
+{
+    state->call_number = m_call_number;
+    state->g = INFINITECOST;
+    state->bp = nullptr;
 
-        state->closed_in_anc = false;
-        state->closed_in_add = false;
+    state->closed_in_anc = false;
+    state->closed_in_add = false;
 
-        for (int i = 0; i < num_heuristics(); ++i) {
-            state->od[i].h = compute_heuristic(state->state_id, i);
-            state->od[i].f = INFINITECOST;
+    for (int i = 0; i < num_heuristics(); ++i) {
+        state->od[i].f = INFINITECOST;
+    }
+}
+
+// Compute all heuristic values for a batch of states. With a thread pool, each
+// group of heuristics is evaluated as one task, so that heuristics that may
+// share mutable state are never queried concurrently.
+template <typename Derived>
+void MHAStarBase<Derived>::compute_heuristics(
+    MHASearchState** states,
+    size_t count)
+{
+    if (m_pool && count > 0 && m_heuristic_groups.size() > 1) {
+        m_pool->parallelFor((int)m_heuristic_groups.size(), [&](int gidx)
+        {
+            for (int hidx : m_heuristic_groups[gidx]) {
+                for (size_t i = 0; i < count; ++i) {
+                    states[i]->od[hidx].h =
+                            compute_heuristic(states[i]->state_id, hidx);
+                }
+            }
+        });
+    } else {
+        for (int hidx = 0; hidx < num_heuristics(); ++hidx) {
+            for (size_t i = 0; i < count; ++i) {
+                states[i]->od[hidx].h =
+                        compute_heuristic(states[i]->state_id, hidx);
+            }
         }
+    }
 
-        SMPL_DEBUG_STREAM("Reinitialized state: " << *state);
-        for (int i = 0; i < num_heuristics(); ++i) {
-            SMPL_DEBUG("  me[%d]: %p", i, state->od[i].me);
-            SMPL_DEBUG("  h[%d]: %d", i, state->od[i].h);
-            SMPL_DEBUG("  f[%d]: %d", i, state->od[i].f);
+    for (size_t i = 0; i < count; ++i) {
+        SMPL_DEBUG_STREAM("Reinitialized state: " << *states[i]);
+        for (int hidx = 0; hidx < num_heuristics(); ++hidx) {
+            SMPL_DEBUG("  me[%d]: %p", hidx, states[i]->od[hidx].me);
+            SMPL_DEBUG("  h[%d]: %d", hidx, states[i]->od[hidx].h);
+            SMPL_DEBUG("  f[%d]: %d", hidx, states[i]->od[hidx].f);
         }
     }
 }
 
+// Heuristics may only report ConcurrentHeuristicExtension once they have been
+// initialized, so the groups are recomputed at the start of each search.
+template <typename Derived>
+void MHAStarBase<Derived>::update_heuristic_groups()
+{
+    std::vector<Heuristic*> heuristics;
+    heuristics.push_back(m_hanchor);
+    heuristics.insert(heuristics.end(), m_heurs, m_heurs + m_hcount);
+    PartitionConcurrentHeuristics(
+            heuristics.data(), (int)heuristics.size(), m_heuristic_groups);
+}
+
 template <typename Derived>
 void MHAStarBase<Derived>::reinit_search()
 {
@@ -570,17 +650,30 @@ void MHAStarBase<Derived>::expand(MHASearchState* state, int hidx)
         }
     }
 
-    std::vector<int> succ_ids;
-    std::vector<int> costs;
-    environment_->GetSuccs(state->state_id, &succ_ids, &costs);
-    assert(succ_ids.size() == costs.size());
+    m_succ_ids.clear();
+    m_succ_costs.clear();
+    environment_->GetSuccs(state->state_id, &m_succ_ids, &m_succ_costs);
+    assert(m_succ_ids.size() == m_succ_costs.size());
+
+    // reinitialize all successors up front so that the heuristics for states
+    // generated for the first time in this search are computed in one batch
+    m_succ_states.clear();
+    m_new_states.clear();
+    for (size_t sidx = 0; sidx < m_succ_ids.size(); ++sidx) {
+        MHASearchState* succ_state = get_state(m_succ_ids[sidx]);
+        if (succ_state->call_number != m_call_number) {
+            reset_state(succ_state);
+            m_new_states.push_back(succ_state);
+        }
+        m_succ_states.push_back(succ_state);
+    }
+
+    compute_heuristics(m_new_states.data(), m_new_states.size());
 
-    for (size_t sidx = 0; sidx < succ_ids.size(); ++sidx)  {
-        const int cost = costs[sidx];
-        MHASearchState* succ_state = get_state(succ_ids[sidx]);
-        reinit_state(succ_state);
+    for (size_t sidx = 0; sidx < m_succ_states.size(); ++sidx)  {
+        MHASearchState* succ_state = m_succ_states[sidx];
 
-        int new_g = state->g + costs[sidx];
+        int new_g = state->g + m_succ_costs[sidx];
         if (new_g < succ_state->g) {
             succ_state->g = new_g;
             succ_state->bp = state;
@@ -639,21 +732,13 @@ void MHAStarBase<Derived>::insert_or_update(MHASearchState* state, int hidx)
 template <typename Derived>
 MHASearchState* MHAStarBase<Derived>::select_state(int hidx)
 {
-    MHASearchState* state = state_from_open_state(m_open[hidx].min());
-    MHASearchState::HeapData* min_open = m_open[0].min();
     Derived* derived = static_cast<Derived*>(this);
-    if (derived->satisfies_p_criterion(state)) {
-        return state;
-    }
-
-    for (auto it = std::next(m_open[hidx].begin()); it != m_open[hidx].end(); ++it) {
-        state = state_from_open_state(*it);
-        if (derived->satisfies_p_criterion(state)) {
-            return state;
-        }
-    }
-
-    return nullptr;
+    MHASearchState::HeapData* open_state = m_open[hidx].find_if(
+            [&](MHASearchState::HeapData* s)
+            {
+                return derived->satisfies_p_criterion(state_from_open_state(s));
+            });
+    return open_state ? state_from_open_state(open_state) : nullptr;
 }
 
 template <typename Derived>
@@ -39,6 +39,7 @@
 #include <sbpl/planners/planner.h>
 
 // project includes
+#include <smpl/arena.h>
 #include <smpl/graph/experience_graph_extension.h>
 #include <smpl/graph/robot_planning_space.h>
 #include <smpl/heap/intrusive_heap.h>
@@ -109,6 +110,7 @@ private:
     RobotHeuristic* m_heur;
     ExperienceGraphHeuristicExtension* m_egh;
 
+    Arena m_state_arena;
     std::vector<SearchState*> m_states;
     SearchState* m_start_state;
     SearchState* m_goal_state;
@@ -32,6 +32,7 @@
 #include <stdlib.h>
 #include <vector>
 
+#include <smpl/arena.h>
 #include <smpl/heap/intrusive_heap.h>
 #include <smpl/heuristic/robot_heuristic.h>
 
@@ -91,6 +92,7 @@ struct LazyARAStar
     ILazySuccFun*           succ_fun_ = nullptr;
     RobotHeuristic* heuristic_ = nullptr;
 
+    Arena                   state_arena_;
     std::vector<State*>     states_;
     State*                  start_state_ = nullptr;
     State*                  goal_state_ = nullptr;
@@ -105,7 +107,7 @@ struct LazyARAStar
     std::vector<int> costs_;
     std::vector<bool> true_costs_;
 
-    LazyARAStar() : open_(StateCompare{this}) { }
+    LazyARAStar() : state_arena_(sizeof(State)), open_(StateCompare{this}) { }
 };
 
 } // namespace smpl
@@ -32,6 +32,7 @@
 #include <stdlib.h>
 #include <vector>
 
+#include <smpl/arena.h>
 #include <smpl/heap/intrusive_heap.h>
 #include <smpl/heuristic/robot_heuristic.h>
 #include <smpl/search/lazy_search_interface.h>
@@ -102,6 +103,7 @@ struct LazySMHAStar
     RobotHeuristic**            h_others_       = nullptr;
     size_t                      h_count_        = 0; // the number of additional heuristics
 
+    Arena                   state_arena_;
     std::vector<State*>     states_;
     State*                  start_state_    = nullptr;
     State*                  goal_state_     = nullptr;
@@ -42,6 +42,7 @@
 #include <sbpl/planners/planner.h>
 
 // project includes
+#include <smpl/arena.h>
 #include <smpl/heap/intrusive_heap.h>
 #include <smpl/search/mhastar_base.h> // for MHASearchState declaration
 #include <smpl/time.h>
@@ -146,6 +147,7 @@ private:
     MHASearchState* m_start_state;
     MHASearchState* m_goal_state;
 
+    Arena m_state_arena;
     std::vector<MHASearchState*> m_search_states;
     std::vector<int> m_graph_to_search_state;
 
@@ -35,6 +35,8 @@
 // standard includes
 #include <ostream>
 #include <iomanip>
+#include <memory>
+#include <vector>
 
 // system includes
 #include <boost/tti/has_member_function.hpp>
@@ -43,7 +45,9 @@
 #include <sbpl/heuristics/heuristic.h>
 
 // project includes
-#include <smpl/heap/intrusive_heap.h>
+#include <smpl/arena.h>
+#include <smpl/heap/intrusive_open_list.h>
+#include <smpl/thread_pool.h>
 
 namespace smpl {
 
@@ -154,6 +158,23 @@ public:
 
     ///@}
 
+    /// \brief Set the number of threads used to evaluate heuristics.
+    ///
+    /// The heuristics for the successors generated by an expansion are
+    /// evaluated in a single batch. Heuristics that report
+    /// ConcurrentHeuristicExtension are each evaluated as a separate task;
+    /// all other heuristics, which may share mutable state such as the robot
+    /// model of the planning space, are evaluated together on one thread. No
+    /// heuristic is ever queried from more than one thread at a time, and the
+    /// planning space is not modified while a batch is evaluated. Defaults to
+    /// 1, which evaluates every heuristic on the searching thread.
+    void    set_num_threads(int num_threads);
+    int     get_num_threads() const;
+
+    /// \brief Select the data structure used for OPEN and each of the PSETs.
+    void            set_open_list_type(OpenListType type);
+    OpenListType    get_open_list_type() const;
+
     friend Derived;
 
 private:
@@ -179,20 +200,16 @@ private:
     MHASearchState* m_start_state;
     MHASearchState* m_goal_state;
 
+    Arena m_state_arena;
     std::vector<MHASearchState*> m_search_states;
     std::vector<int> m_graph_to_search_state;
 
-    struct HeapCompare
+    struct HeapKey
     {
-        bool operator()(
-            const MHASearchState::HeapData& s,
-            const MHASearchState::HeapData& t) const
-        {
-            return s.f < t.f;
-        }
+        int operator()(const MHASearchState::HeapData& s) const { return s.f; }
     };
 
-    typedef intrusive_heap<MHASearchState::HeapData, HeapCompare> rank_pq;
+    typedef intrusive_open_list<MHASearchState::HeapData, HeapKey> rank_pq;
 
     // m_open[0] contain the actual OPEN list sorted by g(s) + h(s)
     // m_open[i], i > 0, maintains a copy of the PSET for each additional
@@ -201,6 +218,18 @@ private:
     // and satisfy the P-CRITERION
     rank_pq* m_open;
 
+    // evaluates heuristics for newly-generated states when num_threads > 1
+    std::unique_ptr<ThreadPool> m_pool;
+
+    // indices of heuristics evaluated together as one task on the pool
+    std::vector<std::vector<int>> m_heuristic_groups;
+
+    // successors of the most recent expansion
+    std::vector<int> m_succ_ids;
+    std::vector<int> m_succ_costs;
+    std::vector<MHASearchState*> m_succ_states;
+    std::vector<MHASearchState*> m_new_states;
+
     bool check_params(const ReplanParams& params);
 
     bool time_limit_reached() const;
@@ -209,6 +238,9 @@ private:
     MHASearchState* get_state(int state_id);
     void init_state(MHASearchState* state, int state_id);
     void reinit_state(MHASearchState* state);
+    void reset_state(MHASearchState* state);
+    void compute_heuristics(MHASearchState** states, size_t count);
+    void update_heuristic_groups();
     void reinit_search();
     void clear_open_lists();
     void clear();
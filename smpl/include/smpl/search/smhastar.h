@@ -32,11 +32,16 @@
 #ifndef SMPL_SMHASTAR_H
 #define SMPL_SMHASTAR_H
 
+#include <memory>
+#include <vector>
+
 #include <sbpl/heuristics/heuristic.h>
 #include <sbpl/planners/planner.h>
 #include <sbpl/utils/heap.h>
 
+#include <smpl/arena.h>
 #include <smpl/heap/intrusive_heap.h>
+#include <smpl/thread_pool.h>
 
 class DiscreteSpaceInformation;
 class Heuristic;
@@ -174,6 +179,12 @@ public:
 
     ///@}
 
+    /// \brief Set the number of threads used to evaluate heuristics.
+    ///
+    /// \sa MHAStarBase::set_num_threads(int)
+    void    set_num_threads(int num_threads);
+    int     get_num_threads() const;
+
 private:
 
     // Related objects
@@ -199,6 +210,7 @@ private:
     SMHAState* m_start_state = NULL;
     SMHAState* m_goal_state = NULL;
 
+    Arena m_state_arena;
     std::vector<SMHAState*> m_search_states;
 
     struct HeapCompare
@@ -213,6 +225,18 @@ private:
     using OpenList = intrusive_heap<SMHAState::HeapData, HeapCompare>;
     OpenList* m_open = NULL; ///< sequence of (m_heur_count + 1) open lists
 
+    /// evaluates heuristics for newly-generated states when num_threads > 1
+    std::unique_ptr<ThreadPool> m_pool;
+
+    /// indices of heuristics evaluated together as one task on the pool
+    std::vector<std::vector<int>> m_heuristic_groups;
+
+    // successors of the most recent expansion
+    std::vector<int> m_succ_ids;
+    std::vector<int> m_succ_costs;
+    std::vector<SMHAState*> m_succ_states;
+    std::vector<SMHAState*> m_new_states;
+
     bool check_params(const ReplanParams& params);
 
     bool time_limit_reached() const;
@@ -221,6 +245,9 @@ private:
     SMHAState* get_state(int state_id);
     void init_state(SMHAState* state, size_t mha_state_idx, int state_id);
     void reinit_state(SMHAState* state);
+    void reset_state(SMHAState* state);
+    void compute_heuristics(SMHAState** states, size_t count);
+    void update_heuristic_groups();
     void reinit_search();
     void clear_open_lists();
     void clear();
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#ifndef SMPL_THREAD_POOL_H
+#define SMPL_THREAD_POOL_H
+
+// standard includes
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smpl {
+
+/// A fixed-size pool of worker threads for fork-join style data parallelism.
+///
+/// The workers are created once, when the pool is constructed, and sleep
+/// between calls to parallelFor(), so the pool is cheap enough to use for the
+/// short batches of work that arise inside a search's inner loop. The calling
+/// thread participates in each batch, so a pool of size 1 has no workers and
+/// runs every task inline.
+///
+/// parallelFor() is not reentrant and must only be called from one thread at
+/// a time.
+class ThreadPool
+{
+public:
+
+    /// Construct a pool with a total concurrency of \p num_threads, including
+    /// the calling thread. A value <= 0 selects the hardware concurrency.
+    explicit ThreadPool(int num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// \brief Return the total number of threads that execute tasks.
+    int size() const { return (int)m_workers.size() + 1; }
+
+    /// \brief Invoke fn(i) for each i in [0, count) and return when all
+    ///     invocations have completed.
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+private:
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+
+    // the current batch
+    const std::function<void(int)>* m_fn = nullptr;
+    int m_count = 0;
+    std::atomic<int> m_next;
+    int m_busy = 0;
+    unsigned int m_generation = 0;
+
+    bool m_shutdown = false;
+
+    void workerLoop();
+    void runTasks();
+};
+
+} // namespace smpl
+
+#endif
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/arena.h>
+
+namespace smpl {
+
+// round the block size up so that every block in a chunk is suitably aligned
+static
+size_t AlignBlockSize(size_t size)
+{
+    const size_t align = alignof(std::max_align_t);
+    return (size + align - 1) / align * align;
+}
+
+Arena::Arena(size_t block_size, size_t blocks_per_chunk) :
+    m_block_size(AlignBlockSize(block_size)),
+    m_blocks_per_chunk(blocks_per_chunk > 0 ? blocks_per_chunk : 1),
+    m_chunks(),
+    m_chunks_used(0),
+    m_next(nullptr),
+    m_end(nullptr),
+    m_size(0)
+{
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+void Arena::setBlockSize(size_t block_size)
+{
+    block_size = AlignBlockSize(block_size);
+    if (block_size != m_block_size) {
+        release();
+        m_block_size = block_size;
+    }
+}
+
+void* Arena::allocate()
+{
+    assert(m_block_size > 0);
+
+    if (m_next == m_end) {
+        if (m_chunks_used == m_chunks.size()) {
+            m_chunks.push_back((char*)::operator new(m_block_size * m_blocks_per_chunk));
+        }
+        m_next = m_chunks[m_chunks_used++];
+        m_end = m_next + m_block_size * m_blocks_per_chunk;
+    }
+
+    void* block = m_next;
+    m_next += m_block_size;
+    ++m_size;
+    return block;
+}
+
+void Arena::reset()
+{
+    m_chunks_used = 0;
+    m_next = nullptr;
+    m_end = nullptr;
+    m_size = 0;
+}
+
+void Arena::release()
+{
+    for (char* chunk : m_chunks) {
+        ::operator delete(chunk);
+    }
+    m_chunks.clear();
+    reset();
+}
+
+} // namespace smpl
@@ -46,6 +46,8 @@ BFS_3D::BFS_3D(int width, int height, int length) :
     m_queue_head(),
     m_queue_tail(),
     m_running(false),
+    m_lazy(false),
+    m_precompute_budget(0),
     m_neighbor_offsets(),
     m_closed(),
     m_distances()
@@ -130,6 +132,21 @@ void BFS_3D::getDimensions(int* width, int* height, int* length)
     *length = m_dim_z - 2;
 }
 
+void BFS_3D::setLazy(bool lazy)
+{
+    if (m_running) {
+        //error "Cannot change evaluation mode while search is running"
+        return;
+    }
+
+    m_lazy = lazy;
+}
+
+void BFS_3D::setPrecomputeBudget(int expansions)
+{
+    m_precompute_budget = expansions;
+}
+
 void BFS_3D::setWall(int x, int y, int z)
 {
     if (m_running) {
@@ -150,6 +167,9 @@ bool BFS_3D::isWall(int x, int y, int z) const
 bool BFS_3D::isUndiscovered(int x, int y, int z) const
 {
     int node = getNode(x, y, z);
+    if (m_lazy) {
+        resume(node, -1);
+    }
     while (m_running && m_distance_grid[node] < 0);
     return m_distance_grid[node] == UNDISCOVERED;
 }
@@ -177,6 +197,11 @@ void BFS_3D::run(int x, int y, int z)
     // initialize starting distance
     m_distance_grid[origin] = 0;
 
+    if (m_lazy) {
+        resume(-1, m_precompute_budget);
+        return;
+    }
+
     // fire off background thread to compute bfs
     m_search_thread = std::thread([&]()
     {
@@ -359,6 +384,9 @@ void BFS_3D::visit_free_cells(int node, const Visitor& visitor)
 int BFS_3D::getDistance(int x, int y, int z) const
 {
     int node = getNode(x, y, z);
+    if (m_lazy) {
+        resume(node, -1);
+    }
     while (m_running && m_distance_grid[node] < 0);
     return m_distance_grid[node];
 }
@@ -484,6 +512,40 @@ int BFS_3D::countDiscovered() const
     return count;
 }
 
+// Advance the wavefront of a lazy search until the given node has been
+// discovered, the wavefront is exhausted, or max_expansions cells have been
+// expanded. A node of -1 advances the wavefront without a target, and a
+// negative max_expansions places no limit on the number of expansions.
+void BFS_3D::resume(int node, int max_expansions) const
+{
+    if (node >= 0 && m_distance_grid[node] >= 0) {
+        return;
+    }
+
+    int expansions = 0;
+    while (m_queue_head < m_queue_tail) {
+        if (max_expansions >= 0 && expansions >= max_expansions) {
+            break;
+        }
+
+        int currentNode = m_queue[m_queue_head++];
+        int currentCost = m_distance_grid[currentNode] + 1;
+        ++expansions;
+
+        for (int i = 0; i < 26; ++i) {
+            int n = currentNode + m_neighbor_offsets[i];
+            if (m_distance_grid[n] < 0) {
+                m_queue[m_queue_tail++] = n;
+                m_distance_grid[n] = currentCost;
+            }
+        }
+
+        if (node >= 0 && m_distance_grid[node] >= 0) {
+            break;
+        }
+    }
+}
+
 #define EXPAND_NEIGHBOR(offset)                            \
     if (distance_grid[currentNode + offset] < 0) {         \
         queue[queue_tail++] = currentNode + offset;        \
@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/geometry/so3_grid.h>
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace smpl {
+namespace geometry {
+
+// cells whose centers are within this multiple of the grid resolution of each
+// other are adjacent
+static const double kNeighborDistanceFactor = 1.25;
+
+static int isqrt(int v)
+{
+    return (int)std::sqrt((double)v + 0.5);
+}
+
+static double NormalizeAnglePositive(double a)
+{
+    a = std::fmod(a, 2.0 * M_PI);
+    if (a < 0.0) {
+        a += 2.0 * M_PI;
+    }
+    return a;
+}
+
+int HealpixAngleToPixel(int nside, double theta, double phi)
+{
+    auto z = std::cos(theta);
+    auto za = std::fabs(z);
+    auto tt = NormalizeAnglePositive(phi) / (0.5 * M_PI); // in [0, 4)
+
+    auto ncap = 2 * nside * (nside - 1);
+    auto npix = 12 * nside * nside;
+
+    if (za <= 2.0 / 3.0) {
+        // equatorial region
+        auto temp1 = nside * (0.5 + tt);
+        auto temp2 = nside * z * 0.75;
+        auto jp = (int)(temp1 - temp2); // index of ascending edge line
+        auto jm = (int)(temp1 + temp2); // index of descending edge line
+        auto ir = nside + 1 + jp - jm;  // ring number counted from z = 2/3
+        auto kshift = 1 - (ir & 1);
+        auto ip = (jp + jm - nside + kshift + 1) / 2;
+        ip = ip % (4 * nside);
+        return ncap + (ir - 1) * 4 * nside + ip;
+    } else {
+        // polar caps
+        auto tp = tt - (int)tt;
+        auto tmp = nside * std::sqrt(3.0 * (1.0 - za));
+        auto jp = (int)(tp * tmp);
+        auto jm = (int)((1.0 - tp) * tmp);
+        auto ir = jp + jm + 1; // ring number counted from the closest pole
+        auto ip = (int)(tt * ir);
+        ip = ip % (4 * ir);
+        if (z > 0.0) {
+            return 2 * ir * (ir - 1) + ip;
+        } else {
+            return npix - 2 * ir * (ir + 1) + ip;
+        }
+    }
+}
+
+void HealpixPixelToAngle(int nside, int pix, double* theta, double* phi)
+{
+    auto ncap = 2 * nside * (nside - 1);
+    auto npix = 12 * nside * nside;
+    auto fact2 = 4.0 / (double)npix;
+
+    double z;
+    if (pix < ncap) {
+        // north polar cap
+        auto iring = (1 + isqrt(1 + 2 * pix)) >> 1;
+        auto iphi = pix + 1 - 2 * iring * (iring - 1);
+        z = 1.0 - iring * iring * fact2;
+        *phi = (iphi - 0.5) * 0.5 * M_PI / iring;
+    } else if (pix < npix - ncap) {
+        // equatorial region
+        auto ip = pix - ncap;
+        auto iring = ip / (4 * nside) + nside;
+        auto iphi = ip % (4 * nside) + 1;
+        auto fodd = ((iring + nside) & 1) ? 1.0 : 0.5;
+        z = (2 * nside - iring) * 2.0 / (3.0 * nside);
+        *phi = (iphi - fodd) * 0.5 * M_PI / nside;
+    } else {
+        // south polar cap
+        auto ip = npix - pix;
+        auto iring = (1 + isqrt(2 * ip - 1)) >> 1;
+        auto iphi = 4 * iring + 1 - (ip - 2 * iring * (iring - 1));
+        z = -1.0 + iring * iring * fact2;
+        *phi = (iphi - 0.5) * 0.5 * M_PI / iring;
+    }
+    *theta = std::acos(std::max(-1.0, std::min(1.0, z)));
+}
+
+// Hopf coordinates of a unit quaternion: theta in [0, pi] and phi in [0, 2pi)
+// locate the base point on the 2-sphere and psi in [0, 2pi) locates the
+// rotation along the fiber
+static void QuaternionToHopf(
+    const Quaternion& q,
+    double* theta,
+    double* phi,
+    double* psi)
+{
+    auto psi_raw = 2.0 * std::atan2(q.x(), q.w());
+    *theta = 2.0 * std::atan2(
+            std::sqrt(q.y() * q.y() + q.z() * q.z()),
+            std::sqrt(q.w() * q.w() + q.x() * q.x()));
+    *phi = NormalizeAnglePositive(std::atan2(q.z(), q.y()) - 0.5 * psi_raw);
+    // psi and psi + 2pi select q and -q, the same rotation
+    *psi = NormalizeAnglePositive(psi_raw);
+}
+
+// The fiber coordinate psi is singular at theta = pi, where all rotations over
+// the base point are distinguished by phi + psi / 2 instead. Cells over the
+// southern hemisphere are measured along their fibers by chi = psi + 2 phi,
+// which is well-behaved there.
+static bool IsSouthPixel(int nside, int pix)
+{
+    // the rings below the equator, ring 2 * nside, start after the polar cap
+    // and the nside + 1 equatorial rings down to and including the equator
+    auto ncap = 2 * nside * (nside - 1);
+    return pix >= ncap + (nside + 1) * 4 * nside;
+}
+
+static double FiberCoordinate(double phi, double psi, bool south)
+{
+    return south ? NormalizeAnglePositive(psi + 2.0 * phi) : psi;
+}
+
+static double FiberCoordinateToPsi(double phi, double chi, bool south)
+{
+    return south ? NormalizeAnglePositive(chi - 2.0 * phi) : chi;
+}
+
+static auto HopfToQuaternion(double theta, double phi, double psi) -> Quaternion
+{
+    return Quaternion(
+            std::cos(0.5 * theta) * std::cos(0.5 * psi),
+            std::cos(0.5 * theta) * std::sin(0.5 * psi),
+            std::sin(0.5 * theta) * std::cos(phi + 0.5 * psi),
+            std::sin(0.5 * theta) * std::sin(phi + 0.5 * psi));
+}
+
+// angle of the rotation between two rotations
+static double RotationDistance(const Quaternion& a, const Quaternion& b)
+{
+    auto dot = std::min(1.0, std::fabs(a.dot(b)));
+    return 2.0 * std::acos(dot);
+}
+
+void SO3Grid::init(double res)
+{
+    // the volume of SO(3) under the angle metric is pi^2 (half that of the
+    // unit 3-sphere, measured in rotation angle / 2), shared among
+    // 72 * nside^3 cells
+    auto base_res = 2.0 * std::cbrt(M_PI * M_PI / 72.0);
+    initNSide(std::max(1, (int)std::ceil(base_res / res - 1e-9)));
+}
+
+void SO3Grid::initNSide(int nside)
+{
+    m_nside = nside;
+    m_fiber_count = 6 * nside;
+
+    auto pix_count = 12 * nside * nside;
+    auto cell_count = pix_count * m_fiber_count;
+    m_res = 2.0 * std::cbrt(M_PI * M_PI / (double)cell_count);
+
+    m_centers.resize(cell_count);
+    auto fiber_res = 2.0 * M_PI / m_fiber_count;
+    for (int pix = 0; pix < pix_count; ++pix) {
+        double theta, phi;
+        HealpixPixelToAngle(nside, pix, &theta, &phi);
+        auto south = IsSouthPixel(nside, pix);
+        for (int k = 0; k < m_fiber_count; ++k) {
+            auto psi = FiberCoordinateToPsi(phi, (k + 0.5) * fiber_res, south);
+            m_centers[pix * m_fiber_count + k] = HopfToQuaternion(theta, phi, psi);
+        }
+    }
+
+    computeNeighbors();
+}
+
+int SO3Grid::cellIndex(const Quaternion& q) const
+{
+    double theta, phi, psi;
+    QuaternionToHopf(q, &theta, &phi, &psi);
+    auto pix = HealpixAngleToPixel(m_nside, theta, phi);
+    auto chi = FiberCoordinate(phi, psi, IsSouthPixel(m_nside, pix));
+    auto k = (int)(chi * m_fiber_count / (2.0 * M_PI));
+    if (k >= m_fiber_count) {
+        k = m_fiber_count - 1;
+    }
+
+    // The cells of the Hopf grid are sheared, so the cell containing the
+    // rotation in Hopf coordinates may not have the nearest center. Descend
+    // to the nearest center through the neighbor table.
+    auto cidx = pix * m_fiber_count + k;
+    auto best_dot = std::fabs(q.dot(m_centers[cidx]));
+    for (;;) {
+        auto best = cidx;
+        for (auto* n = neighborsBegin(cidx); n != neighborsEnd(cidx); ++n) {
+            auto dot = std::fabs(q.dot(m_centers[*n]));
+            if (dot > best_dot) {
+                best_dot = dot;
+                best = *n;
+            }
+        }
+        if (best == cidx) {
+            return cidx;
+        }
+        cidx = best;
+    }
+}
+
+void SO3Grid::computeNeighbors()
+{
+    auto pix_count = 12 * m_nside * m_nside;
+    auto max_dist = kNeighborDistanceFactor * m_res;
+    auto fiber_res = 2.0 * M_PI / m_fiber_count;
+
+    std::vector<double> thetas(pix_count);
+    std::vector<double> phis(pix_count);
+    std::vector<Vector3> dirs(pix_count);
+    for (int pix = 0; pix < pix_count; ++pix) {
+        HealpixPixelToAngle(m_nside, pix, &thetas[pix], &phis[pix]);
+        dirs[pix] = Vector3(
+                std::sin(thetas[pix]) * std::cos(phis[pix]),
+                std::sin(thetas[pix]) * std::sin(phis[pix]),
+                std::cos(thetas[pix]));
+    }
+
+    // The Hopf map takes the distance between two fibers to the angle between
+    // their base points, so only fibers over nearby base points can contain
+    // neighbors.
+    std::vector<std::vector<int>> pix_neighbors(pix_count);
+    auto min_dot = std::cos(std::min(M_PI, max_dist));
+    for (int i = 0; i < pix_count; ++i) {
+        for (int j = 0; j < pix_count; ++j) {
+            if (dirs[i].dot(dirs[j]) >= min_dot) {
+                pix_neighbors[i].push_back(j);
+            }
+        }
+    }
+
+    m_neighbor_offsets.assign(1, 0);
+    m_neighbors.clear();
+    std::vector<int> candidates;
+    for (int pix = 0; pix < pix_count; ++pix) {
+        auto c1 = std::cos(0.5 * thetas[pix]);
+        auto s1 = std::sin(0.5 * thetas[pix]);
+        auto south = IsSouthPixel(m_nside, pix);
+        for (int k = 0; k < m_fiber_count; ++k) {
+            auto cidx = pix * m_fiber_count + k;
+            auto psi = FiberCoordinateToPsi(phis[pix], (k + 0.5) * fiber_res, south);
+            auto& center = m_centers[cidx];
+
+            candidates.clear();
+            for (auto npix : pix_neighbors[pix]) {
+                // the point on the neighboring fiber nearest this cell's
+                // center maximizes c1 c2 cos(d) + s1 s2 cos(phi1 - phi2 + d),
+                // for d = (psi1 - psi2) / 2
+                auto c2 = std::cos(0.5 * thetas[npix]);
+                auto s2 = std::sin(0.5 * thetas[npix]);
+                auto z = std::complex<double>(c1 * c2, 0.0) +
+                        std::polar(s1 * s2, phis[pix] - phis[npix]);
+                auto nearest_psi = NormalizeAnglePositive(psi + 2.0 * std::arg(z));
+                auto nearest_chi = FiberCoordinate(
+                        phis[npix], nearest_psi, IsSouthPixel(m_nside, npix));
+                auto nk = (int)std::floor(nearest_chi / fiber_res);
+                for (int dk = -2; dk <= 2; ++dk) {
+                    auto kk = ((nk + dk) % m_fiber_count + m_fiber_count) % m_fiber_count;
+                    auto ncidx = npix * m_fiber_count + kk;
+                    if (ncidx == cidx) {
+                        continue;
+                    }
+                    if (RotationDistance(center, m_centers[ncidx]) <= max_dist) {
+                        candidates.push_back(ncidx);
+                    }
+                }
+            }
+
+            std::sort(begin(candidates), end(candidates));
+            candidates.erase(
+                    std::unique(begin(candidates), end(candidates)),
+                    end(candidates));
+            m_neighbors.insert(end(m_neighbors), begin(candidates), end(candidates));
+            m_neighbor_offsets.push_back((int)m_neighbors.size());
+        }
+    }
+}
+
+} // namespace geometry
+} // namespace smpl
@@ -33,10 +33,13 @@
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 // project includes
 #include <smpl/console/console.h>
+#include <smpl/thread_pool.h>
 #include <smpl/geometry/intersect.h>
 #include <smpl/geometry/mesh_utils.h>
 #include <smpl/geometry/triangle.h>
@@ -67,6 +70,9 @@ void VoxelizeMeshNaive(
     const std::vector<std::uint32_t>& triangles,
     VoxelGrid<Discretizer>& vg);
 
+static auto AcquireVoxelizePool(std::unique_lock<std::mutex>& lock)
+    -> ThreadPool*;
+
 template <typename Discretizer>
 void ExtractVoxels(
     const VoxelGrid<Discretizer>& vg,
@@ -81,6 +87,9 @@ static bool IsInDiscreteBoundingBox(
 template <typename Discretizer>
 static void ScanFill(VoxelGrid<Discretizer>& vg);
 
+template <typename Discretizer>
+static void ScanFill(VoxelGrid<Discretizer>& vg, int min_x, int max_x);
+
 static void TransformVertices(
     const Affine3& transform,
     std::vector<Vector3>& vertices);
@@ -121,18 +130,95 @@ static void VoxelizeMesh(
     }
 }
 
+// Minimum number of triangles, and of x-slices of the voxel grid, for which
+// voxelization is spread across multiple threads
+static const size_t ParallelVoxelizeMinTriangles = 256;
+static const int ParallelVoxelizeMinSlices = 8;
+
+/// Return the pool shared by all voxelization calls, or null if the pool is
+/// in use by another thread or there is no concurrency to be had. The pool is
+/// held for as long as the lock is held.
+auto AcquireVoxelizePool(std::unique_lock<std::mutex>& lock) -> ThreadPool*
+{
+    static std::mutex pool_mutex;
+    static std::unique_ptr<ThreadPool> pool;
+
+    lock = std::unique_lock<std::mutex>(pool_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return nullptr;
+    }
+    if (!pool) {
+        pool.reset(new ThreadPool);
+    }
+    if (pool->size() < 2) {
+        lock.unlock();
+        return nullptr;
+    }
+    return pool.get();
+}
+
+/// Voxelize the surface of a mesh. Large meshes are rasterized on multiple
+/// threads, each filling a disjoint slab of x-slices of the voxel grid with
+/// every triangle that overlaps it.
 template <typename Discretizer>
 void VoxelizeMeshAwesome(
     const std::vector<Vector3>& vertices,
     const std::vector<std::uint32_t>& indices,
     VoxelGrid<Discretizer>& vg)
 {
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        auto& a = vertices[indices[i + 0]];
-        auto& b = vertices[indices[i + 1]];
-        auto& c = vertices[indices[i + 2]];
-        VoxelizeTriangle(a, b, c, vg);
+    const int min_gx = vg.memoryToGrid(MemoryCoord(0, 0, 0)).x;
+    const int max_gx = vg.memoryToGrid(MemoryCoord(vg.sizeX() - 1, 0, 0)).x;
+
+    std::unique_lock<std::mutex> lock;
+    ThreadPool* pool = nullptr;
+    if (indices.size() / 3 >= ParallelVoxelizeMinTriangles &&
+        vg.sizeX() >= ParallelVoxelizeMinSlices)
+    {
+        pool = AcquireVoxelizePool(lock);
+    }
+
+    if (!pool) {
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            auto& a = vertices[indices[i + 0]];
+            auto& b = vertices[indices[i + 1]];
+            auto& c = vertices[indices[i + 2]];
+            VoxelizeTriangle(a, b, c, min_gx, max_gx, vg);
+        }
+        return;
+    }
+
+    // compute the range of x-slices overlapped by each triangle once, up front
+    const size_t tri_count = indices.size() / 3;
+    std::vector<std::pair<int, int>> tri_gx(tri_count);
+    for (size_t t = 0; t < tri_count; ++t) {
+        auto& a = vertices[indices[3 * t + 0]];
+        auto& b = vertices[indices[3 * t + 1]];
+        auto& c = vertices[indices[3 * t + 2]];
+        const double lo = std::min(a.x(), std::min(b.x(), c.x()));
+        const double hi = std::max(a.x(), std::max(b.x(), c.x()));
+        tri_gx[t].first = vg.worldToGrid(WorldCoord(lo, a.y(), a.z())).x;
+        tri_gx[t].second = vg.worldToGrid(WorldCoord(hi, a.y(), a.z())).x;
     }
+
+    const int slice_count = max_gx - min_gx + 1;
+    const int slab_count = std::min(slice_count, 4 * pool->size());
+    pool->parallelFor(slab_count, [&](int slab)
+    {
+        const int slab_min_gx = min_gx + (slab * slice_count) / slab_count;
+        const int slab_max_gx =
+                min_gx + ((slab + 1) * slice_count) / slab_count - 1;
+        for (size_t t = 0; t < tri_count; ++t) {
+            if (tri_gx[t].second < slab_min_gx ||
+                tri_gx[t].first > slab_max_gx)
+            {
+                continue;
+            }
+            auto& a = vertices[indices[3 * t + 0]];
+            auto& b = vertices[indices[3 * t + 1]];
+            auto& c = vertices[indices[3 * t + 2]];
+            VoxelizeTriangle(a, b, c, slab_min_gx, slab_max_gx, vg);
+        }
+    });
 }
 
 template <typename Discretizer>
@@ -198,6 +284,14 @@ void ExtractVoxels(
     const VoxelGrid<Discretizer>& vg,
     std::vector<Vector3>& voxels)
 {
+    // count first so the output is grown at most once
+    size_t count = 0;
+    const int cell_count = vg.sizeX() * vg.sizeY() * vg.sizeZ();
+    for (int i = 0; i < cell_count; ++i) {
+        count += vg[MemoryIndex(i)] ? 1 : 0;
+    }
+    voxels.reserve(voxels.size() + count);
+
     for (int x = 0; x < vg.sizeX(); x++) {
     for (int y = 0; y < vg.sizeY(); y++) {
     for (int z = 0; z < vg.sizeZ(); z++) {
@@ -261,10 +355,37 @@ bool IsInDiscreteBoundingBox(
 }
 
 
+/// Fill the interior of a voxel grid. Columns of voxels are filled
+/// independently, so large grids are filled on multiple threads.
 template <typename Discretizer>
 void ScanFill(VoxelGrid<Discretizer>& vg)
 {
-    for (int x = 0; x < vg.sizeX(); x++) {
+    std::unique_lock<std::mutex> lock;
+    ThreadPool* pool = nullptr;
+    if (vg.sizeX() >= ParallelVoxelizeMinSlices) {
+        pool = AcquireVoxelizePool(lock);
+    }
+
+    if (!pool) {
+        ScanFill(vg, 0, vg.sizeX() - 1);
+        return;
+    }
+
+    const int slab_count = std::min(vg.sizeX(), 4 * pool->size());
+    pool->parallelFor(slab_count, [&](int slab)
+    {
+        const int min_x = (slab * vg.sizeX()) / slab_count;
+        const int max_x = ((slab + 1) * vg.sizeX()) / slab_count - 1;
+        ScanFill(vg, min_x, max_x);
+    });
+}
+
+/// Fill the interior of the voxel grid within a range of x-slices, in memory
+/// coordinates
+template <typename Discretizer>
+void ScanFill(VoxelGrid<Discretizer>& vg, int min_x, int max_x)
+{
+    for (int x = min_x; x <= max_x; x++) {
         for (int y = 0; y < vg.sizeY(); y++) {
             const int OUTSIDE = 0;
             const int ON_BOUNDARY_FROM_OUTSIDE = 1;
@@ -811,10 +932,7 @@ void VoxelizeSphereList(
 
         TransformVertices(poses[i], vertices);
 
-        std::vector<Vector3> sphere_voxels;
-        VoxelizeMesh(vertices, indices, res, sphere_voxels, fill);
-
-        voxels.insert(voxels.end(), sphere_voxels.begin(), sphere_voxels.end());
+        VoxelizeMesh(vertices, indices, res, voxels, fill);
     }
 
     int duplicateIdx = (int)voxels.size();
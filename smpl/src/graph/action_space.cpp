@@ -50,4 +50,25 @@ bool ActionSpace::init(RobotPlanningSpace* space)
     return true;
 }
 
+bool ActionSpace::applyBuffered(
+    const RobotState& parent,
+    std::vector<Action>& actions,
+    std::size_t& count)
+{
+    std::vector<Action> tmp;
+    if (!apply(parent, tmp)) {
+        count = 0;
+        return false;
+    }
+
+    if (actions.size() < tmp.size()) {
+        actions.resize(tmp.size());
+    }
+    for (std::size_t i = 0; i < tmp.size(); ++i) {
+        actions[i] = std::move(tmp[i]);
+    }
+    count = tmp.size();
+    return true;
+}
+
 } // namespace smpl
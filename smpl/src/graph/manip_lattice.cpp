@@ -33,6 +33,8 @@
 #include <smpl/graph/manip_lattice.h>
 
 // standard includes
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 
@@ -53,6 +55,7 @@ auto std::hash<smpl::ManipLatticeState>::operator()(
 {
     size_t seed = 0;
     boost::hash_combine(seed, boost::hash_range(s.coord.begin(), s.coord.end()));
+    boost::hash_combine(seed, s.step);
     return seed;
 }
 
@@ -92,6 +95,8 @@ bool ManipLattice::init(
     }
 
     m_fk_iface = _robot->getExtension<ForwardKinematicsInterface>();
+    m_timed_checker = checker->getExtension<TimedCollisionCheckerExtension>();
+    m_self_checker = checker->getExtension<SelfCollisionCheckerExtension>();
 
     m_min_limits.resize(_robot->jointVariableCount());
     m_max_limits.resize(_robot->jointVariableCount());
@@ -224,23 +229,23 @@ void ManipLattice::GetSuccs(
 
     int goal_succ_count = 0;
 
-    std::vector<Action> actions;
-    if (!m_actions->apply(parent_entry->state, actions)) {
+    int cost_scale;
+    if (!applyActions(state_id, m_action_buffer, m_action_count, cost_scale)) {
         SMPL_WARN("Failed to get actions");
         return;
     }
 
-    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  actions: %zu", actions.size());
+    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  actions: %zu", m_action_count);
 
     // check actions for validity
     RobotCoord succ_coord(robot()->jointVariableCount(), 0);
-    for (size_t i = 0; i < actions.size(); ++i) {
-        auto& action = actions[i];
+    for (size_t i = 0; i < m_action_count; ++i) {
+        auto& action = m_action_buffer[i];
 
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "    action %zu:", i);
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "      waypoints: %zu", action.size());
 
-        if (!checkAction(parent_entry->state, action)) {
+        if (!checkAction(parent_entry->state, action, stateTime(parent_entry))) {
             continue;
         }
 
@@ -250,7 +255,8 @@ void ManipLattice::GetSuccs(
         // get the successor
 
         // check if hash entry already exists, if not then create one
-        int succ_state_id = getOrCreateState(succ_coord, action.back());
+        int succ_state_id = getOrCreateState(
+                succ_coord, action.back(), successorStep(parent_entry));
         ManipLatticeState* succ_entry = getHashEntry(succ_state_id);
 
         // check if this state meets the goal criteria
@@ -266,14 +272,14 @@ void ManipLattice::GetSuccs(
         } else {
             succs->push_back(succ_state_id);
         }
-        costs->push_back(cost(parent_entry, succ_entry, is_goal_succ));
+        costs->push_back(cost_scale * cost(parent_entry, succ_entry, is_goal_succ));
 
         // log successor details
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "      succ: %zu", i);
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        id: %5i", succ_state_id);
         SMPL_DEBUG_STREAM_NAMED(G_EXPANSIONS_LOG, "        coord: " << succ_coord);
         SMPL_DEBUG_STREAM_NAMED(G_EXPANSIONS_LOG, "        state: " << succ_entry->state);
-        SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        cost: %5d", cost(parent_entry, succ_entry, is_goal_succ));
+        SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        cost: %5d", cost_scale * cost(parent_entry, succ_entry, is_goal_succ));
     }
 
     if (goal_succ_count > 0) {
@@ -314,18 +320,18 @@ void ManipLattice::GetLazySuccs(
     auto* vis_name = "expansion";
     SV_SHOW_DEBUG_NAMED(vis_name, getStateVisualization(source_angles, vis_name));
 
-    std::vector<Action> actions;
-    if (!m_actions->apply(source_angles, actions)) {
+    int cost_scale;
+    if (!applyActions(state_id, m_action_buffer, m_action_count, cost_scale)) {
         SMPL_WARN("Failed to get successors");
         return;
     }
 
-    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  actions: %zu", actions.size());
+    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  actions: %zu", m_action_count);
 
     int goal_succ_count = 0;
     RobotCoord succ_coord(robot()->jointVariableCount());
-    for (size_t i = 0; i < actions.size(); ++i) {
-        auto& action = actions[i];
+    for (size_t i = 0; i < m_action_count; ++i) {
+        auto& action = m_action_buffer[i];
 
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "    action %zu:", i);
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "      waypoints: %zu", action.size());
@@ -337,7 +343,8 @@ void ManipLattice::GetLazySuccs(
             ++goal_succ_count;
         }
 
-        int succ_state_id = getOrCreateState(succ_coord, action.back());
+        int succ_state_id = getOrCreateState(
+                succ_coord, action.back(), successorStep(state_entry));
         ManipLatticeState* succ_entry = getHashEntry(succ_state_id);
 
         if (succ_is_goal_state) {
@@ -345,7 +352,7 @@ void ManipLattice::GetLazySuccs(
         } else {
             succs->push_back(succ_state_id);
         }
-        costs->push_back(cost(state_entry, succ_entry, succ_is_goal_state));
+        costs->push_back(cost_scale * cost(state_entry, succ_entry, succ_is_goal_state));
         true_costs->push_back(false);
 
         // log successor details
@@ -353,7 +360,7 @@ void ManipLattice::GetLazySuccs(
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        id: %5i", succ_state_id);
         SMPL_DEBUG_STREAM_NAMED(G_EXPANSIONS_LOG, "        coord: " << succ_coord);
         SMPL_DEBUG_STREAM_NAMED(G_EXPANSIONS_LOG, "        state: " << succ_entry->state);
-        SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        cost: %5d", cost(state_entry, succ_entry, succ_is_goal_state));
+        SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        cost: %5d", cost_scale * cost(state_entry, succ_entry, succ_is_goal_state));
     }
 
     if (goal_succ_count > 0) {
@@ -382,8 +389,8 @@ int ManipLattice::GetTrueCost(int parentID, int childID)
     auto* vis_name = "expansion";
     SV_SHOW_DEBUG_NAMED(vis_name, getStateVisualization(parent_angles, vis_name));
 
-    std::vector<Action> actions;
-    if (!m_actions->apply(parent_angles, actions)) {
+    int cost_scale;
+    if (!applyActions(parentID, m_action_buffer, m_action_count, cost_scale)) {
         SMPL_WARN("Failed to get actions");
         return -1;
     }
@@ -395,8 +402,8 @@ int ManipLattice::GetTrueCost(int parentID, int childID)
     // check actions for validity and find the valid action with the least cost
     RobotCoord succ_coord(robot()->jointVariableCount());
     int best_cost = std::numeric_limits<int>::max();
-    for (size_t aidx = 0; aidx < actions.size(); ++aidx) {
-        auto& action = actions[aidx];
+    for (size_t aidx = 0; aidx < m_action_count; ++aidx) {
+        auto& action = m_action_buffer[aidx];
 
         stateToCoord(action.back(), succ_coord);
 
@@ -416,16 +423,18 @@ int ManipLattice::GetTrueCost(int parentID, int childID)
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "    action %zu:", num_actions++);
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "      waypoints %zu:", action.size());
 
-        if (!checkAction(parent_angles, action)) {
+        if (!checkAction(parent_angles, action, stateTime(parent_entry))) {
             continue;
         }
 
         // get the unique state
-        int succ_state_id = goal_edge ? getHashEntry(succ_coord) : childID;
+        int succ_state_id = goal_edge ?
+                getHashEntry(succ_coord, successorStep(parent_entry)) :
+                childID;
         ManipLatticeState* succ_entry = getHashEntry(succ_state_id);
         assert(succ_entry);
 
-        auto edge_cost = cost(parent_entry, succ_entry, goal_edge);
+        auto edge_cost = cost_scale * cost(parent_entry, succ_entry, goal_edge);
         if (edge_cost < best_cost) {
             best_cost = edge_cost;
         }
@@ -454,6 +463,71 @@ bool ManipLattice::projectToPose(int state_id, Affine3& pose)
     return true;
 }
 
+namespace {
+
+// Projects the states of a ManipLattice using a private copy of its forward
+// kinematics solver
+class ManipLatticeProjectionContext : public PoseProjectionExtension
+{
+public:
+
+    ManipLatticeProjectionContext(
+        ManipLattice* space,
+        std::unique_ptr<ForwardKinematicsInterface> fk_iface)
+    :
+        m_space(space),
+        m_fk_iface(std::move(fk_iface))
+    { }
+
+    bool projectToPose(int state_id, Affine3& pose) override
+    {
+        if (state_id == m_space->getGoalStateID()) {
+            pose = m_space->goal().pose;
+            return true;
+        }
+
+        pose = m_fk_iface->computeFK(m_space->extractState(state_id));
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == GetClassCode<PointProjectionExtension>() ||
+            class_code == GetClassCode<PoseProjectionExtension>())
+        {
+            return this;
+        }
+        return nullptr;
+    }
+
+private:
+
+    ManipLattice* m_space;
+    std::unique_ptr<ForwardKinematicsInterface> m_fk_iface;
+};
+
+} // namespace
+
+// Contexts are only available when the robot model can copy its forward
+// kinematics solver; the projection of the goal and the state table are shared
+// with this space.
+auto ManipLattice::createProjectionContext()
+    -> std::unique_ptr<PoseProjectionExtension>
+{
+    auto* cloneable = robot()->getExtension<CloneableForwardKinematicsInterface>();
+    if (cloneable == nullptr) {
+        return nullptr;
+    }
+
+    auto fk_iface = cloneable->cloneForwardKinematics();
+    if (!fk_iface) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<PoseProjectionExtension>(
+            new ManipLatticeProjectionContext(this, std::move(fk_iface)));
+}
+
 void ManipLattice::GetPreds(
     int state_id,
     std::vector<int>* preds,
@@ -519,12 +593,13 @@ ManipLatticeState* ManipLattice::getHashEntry(int state_id) const
     return m_states[state_id];
 }
 
-/// Return the state id of the state with the given coordinate or -1 if the
-/// state has not yet been allocated.
-int ManipLattice::getHashEntry(const RobotCoord& coord)
+/// Return the state id of the state with the given coordinate, reached after
+/// the given number of actions, or -1 if the state has not yet been allocated.
+int ManipLattice::getHashEntry(const RobotCoord& coord, int step)
 {
     ManipLatticeState state;
     state.coord = coord;
+    state.step = step;
     auto sit = m_state_to_id.find(&state);
     if (sit == m_state_to_id.end()) {
         return -1;
@@ -534,13 +609,15 @@ int ManipLattice::getHashEntry(const RobotCoord& coord)
 
 int ManipLattice::createHashEntry(
     const RobotCoord& coord,
-    const RobotState& state)
+    const RobotState& state,
+    int step)
 {
     int state_id = reserveHashEntry();
     ManipLatticeState* entry = getHashEntry(state_id);
 
     entry->coord = coord;
     entry->state = state;
+    entry->step = step;
 
     // map state -> state id
     m_state_to_id[entry] = state_id;
@@ -550,15 +627,30 @@ int ManipLattice::createHashEntry(
 
 int ManipLattice::getOrCreateState(
     const RobotCoord& coord,
-    const RobotState& state)
+    const RobotState& state,
+    int step)
 {
-    int state_id = getHashEntry(coord);
+    int state_id = getHashEntry(coord, step);
     if (state_id < 0) {
-        state_id = createHashEntry(coord, state);
+        state_id = createHashEntry(coord, state, step);
     }
     return state_id;
 }
 
+/// Return the step of the states reached by applying an action to a state.
+/// States are only distinguished by step while there are obstacles with known
+/// motion, so that each has a single arrival time.
+int ManipLattice::successorStep(const ManipLatticeState* entry)
+{
+    return hasTimedObstacles() ? entry->step + 1 : 0;
+}
+
+/// Return the time, in seconds from the start, at which a state is reached.
+double ManipLattice::stateTime(const ManipLatticeState* entry) const
+{
+    return (double)entry->step * m_action_duration;
+}
+
 int ManipLattice::reserveHashEntry()
 {
     ManipLatticeState* entry = new ManipLatticeState;
@@ -595,7 +687,23 @@ int ManipLattice::cost(
     return DefaultCostMultiplier;
 }
 
-bool ManipLattice::checkAction(const RobotState& state, const Action& action)
+void ManipLattice::setPrimitiveCollisionTable(
+    const PrimitiveCollisionTable* table)
+{
+    if (table && !m_self_checker) {
+        SMPL_WARN_NAMED(G_LOG, "Primitive collision table requires a collision checker with Self Collision Checker Extension");
+    }
+    m_prim_table = table;
+}
+
+/// Check an action for joint limit violations and collisions. If the collision
+/// checker supports obstacles with known motion, the action is checked as if
+/// it starts at the given time, taking actionDuration() seconds and passing
+/// through its waypoints at a uniform rate.
+bool ManipLattice::checkAction(
+    const RobotState& state,
+    const Action& action,
+    double time)
 {
     std::uint32_t violation_mask = 0x00000000;
 
@@ -631,8 +739,46 @@ bool ManipLattice::checkAction(const RobotState& state, const Action& action)
         return false;
     }
 
+    if (hasTimedObstacles()) {
+        return checkTimedAction(state, action, time);
+    }
+
+    // the table is built by sampling, so its classifications are only hints.
+    // Motions in a cell certified free of self collisions are checked against
+    // the environment here, and the extracted path is checked in full. Motions
+    // in a cell believed to be in self collision are checked for self
+    // collisions first, since that check is likely to reject them, and then
+    // against the environment.
+    auto self_status = PrimitiveCollisionTable::Unknown;
+    if (m_prim_table && m_self_checker) {
+        self_status = m_prim_table->status(state, action);
+        if (self_status == PrimitiveCollisionTable::Colliding) {
+            if (!m_self_checker->isStateToStateSelfValid(state, action[0])) {
+                SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        -> path to first waypoint in self collision");
+                return false;
+            }
+            for (size_t j = 1; j < action.size(); ++j) {
+                if (!m_self_checker->isStateToStateSelfValid(action[j - 1], action[j])) {
+                    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        -> path between waypoints %zu and %zu in self collision", j - 1, j);
+                    return false;
+                }
+            }
+        }
+    }
+
+    // skip self collision checks when the action is known to be free of them,
+    // or has already been checked for them
+    auto is_motion_valid = [&](const RobotState& a, const RobotState& b)
+    {
+        if (self_status != PrimitiveCollisionTable::Unknown) {
+            return m_self_checker->isStateToStateWorldValid(a, b);
+        } else {
+            return collisionChecker()->isStateToStateValid(a, b);
+        }
+    };
+
     // check for collisions along path from parent to first waypoint
-    if (!collisionChecker()->isStateToStateValid(state, action[0])) {
+    if (!is_motion_valid(state, action[0])) {
         SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        -> path to first waypoint in collision");
         violation_mask |= 0x00000004;
     }
@@ -645,8 +791,7 @@ bool ManipLattice::checkAction(const RobotState& state, const Action& action)
     for (size_t j = 1; j < action.size(); ++j) {
         auto& prev_istate = action[j - 1];
         auto& curr_istate = action[j];
-        if (!collisionChecker()->isStateToStateValid(prev_istate, curr_istate))
-        {
+        if (!is_motion_valid(prev_istate, curr_istate)) {
             SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        -> path between waypoints %zu and %zu in collision", j - 1, j);
             violation_mask |= 0x00000008;
             break;
@@ -660,6 +805,79 @@ bool ManipLattice::checkAction(const RobotState& state, const Action& action)
     return true;
 }
 
+bool ManipLattice::checkTimedAction(
+    const RobotState& state,
+    const Action& action,
+    double time)
+{
+    const double dt = m_action_duration / (double)action.size();
+
+    // check for collisions along path from parent to first waypoint
+    if (!m_timed_checker->isStateToStateValidAtTime(
+            state, time, action[0], time + dt))
+    {
+        SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        -> path to first waypoint in collision at time %0.3f", time);
+        return false;
+    }
+
+    // check for collisions between waypoints
+    for (size_t j = 1; j < action.size(); ++j) {
+        auto& prev_istate = action[j - 1];
+        auto& curr_istate = action[j];
+        const double t0 = time + dt * (double)j;
+        if (!m_timed_checker->isStateToStateValidAtTime(
+                prev_istate, t0, curr_istate, t0 + dt))
+        {
+            SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "        -> path between waypoints %zu and %zu in collision at time %0.3f", j - 1, j, t0);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Check whether any valid action leads from one state to another, starting at
+// the given time.
+bool ManipLattice::checkTimedTransition(
+    int parent_id,
+    int child_id,
+    double time)
+{
+    auto* parent_entry = getHashEntry(parent_id);
+    auto* child_entry = getHashEntry(child_id);
+    if (!parent_entry || !child_entry) {
+        return false;
+    }
+
+    std::vector<Action> actions;
+    std::size_t action_count;
+    int cost_scale;
+    if (!applyActions(parent_id, actions, action_count, cost_scale)) {
+        return false;
+    }
+
+    RobotCoord succ_coord(robot()->jointVariableCount());
+    for (size_t aidx = 0; aidx < action_count; ++aidx) {
+        auto& action = actions[aidx];
+        stateToCoord(action.back(), succ_coord);
+        if (succ_coord != child_entry->coord) {
+            continue;
+        }
+        if (checkAction(parent_entry->state, action, time)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Return whether actions must be checked at the times they are executed,
+// against obstacles with known motion
+bool ManipLattice::hasTimedObstacles()
+{
+    return m_timed_checker && m_timed_checker->hasTimedObstacles();
+}
+
 static
 bool WithinPositionTolerance(
     const Affine3& A,
@@ -762,6 +980,16 @@ bool ManipLattice::isGoal(const RobotState& state)
     return false;
 }
 
+bool ManipLattice::applyActions(
+    int state_id,
+    std::vector<Action>& actions,
+    std::size_t& count,
+    int& cost_scale)
+{
+    cost_scale = 1;
+    return m_actions->applyBuffered(m_states[state_id]->state, actions, count);
+}
+
 auto ManipLattice::getStateVisualization(
     const RobotState& state,
     const std::string& ns)
@@ -875,6 +1103,15 @@ void ManipLattice::clearStates()
     m_goal_state_id = reserveHashEntry();
 }
 
+void ManipLattice::getGoalSatisfyingStates(std::vector<int>& state_ids)
+{
+    for (size_t i = 0; i < m_states.size(); ++i) {
+        if ((int)i != m_goal_state_id && isGoal(m_states[i]->state)) {
+            state_ids.push_back((int)i);
+        }
+    }
+}
+
 bool ManipLattice::extractPath(
     const std::vector<int>& idpath,
     std::vector<RobotState>& path)
@@ -937,6 +1174,10 @@ bool ManipLattice::extractPath(
             return false;
         }
 
+        // motions are checked against obstacles with known motion at the time
+        // they were checked during the search
+        const double time = stateTime(m_states[prev_id]);
+
         if (curr_id == getGoalStateID()) {
             SMPL_DEBUG_NAMED(G_LOG, "Search for transition to goal state");
 
@@ -944,7 +1185,9 @@ bool ManipLattice::extractPath(
             auto& prev_state = prev_entry->state;
 
             std::vector<Action> actions;
-            if (!m_actions->apply(prev_state, actions)) {
+            std::size_t action_count;
+            int cost_scale;
+            if (!applyActions(prev_id, actions, action_count, cost_scale)) {
                 SMPL_ERROR_NAMED(G_LOG, "Failed to get actions while extracting the path");
                 return false;
             }
@@ -953,7 +1196,7 @@ bool ManipLattice::extractPath(
             ManipLatticeState* best_goal_state = nullptr;
             RobotCoord succ_coord(robot()->jointVariableCount());
             int best_cost = std::numeric_limits<int>::max();
-            for (size_t aidx = 0; aidx < actions.size(); ++aidx) {
+            for (size_t aidx = 0; aidx < action_count; ++aidx) {
                 auto& action = actions[aidx];
 
                 // skip non-goal states
@@ -962,16 +1205,17 @@ bool ManipLattice::extractPath(
                 }
 
                 // check the validity of this transition
-                if (!checkAction(prev_state, action)) {
+                if (!checkAction(prev_state, action, time)) {
                     continue;
                 }
 
                 stateToCoord(action.back(), succ_coord);
-                int succ_state_id = getHashEntry(succ_coord);
+                int succ_state_id = getHashEntry(
+                        succ_coord, successorStep(prev_entry));
                 ManipLatticeState* succ_entry = getHashEntry(succ_state_id);
                 assert(succ_entry);
 
-                auto edge_cost = cost(prev_entry, succ_entry, true);
+                auto edge_cost = cost_scale * cost(prev_entry, succ_entry, true);
                 if (edge_cost < best_cost) {
                     best_cost = edge_cost;
                     best_goal_state = succ_entry;
@@ -991,11 +1235,28 @@ bool ManipLattice::extractPath(
                 return false;
             }
 
+            if (hasTimedObstacles() && !checkTimedTransition(prev_id, curr_id, time)) {
+                SMPL_ERROR_NAMED(G_LOG, "Motion from state %d to state %d is in collision at time %0.3f during path extraction", prev_id, curr_id, time);
+                return false;
+            }
+
             SMPL_DEBUG_STREAM_NAMED(G_LOG, "Extract successor state " << entry->state);
             opath.push_back(entry->state);
         }
     }
 
+    // the primitive collision table classifies cells from a finite number of
+    // sampled motions, so motions it certified free of self collisions may
+    // still be in collision; check the full path before returning it
+    if (m_prim_table && m_self_checker && !hasTimedObstacles()) {
+        for (size_t i = 1; i < opath.size(); ++i) {
+            if (!collisionChecker()->isStateToStateValid(opath[i - 1], opath[i])) {
+                SMPL_ERROR_NAMED(G_LOG, "Motion from waypoint %zu to waypoint %zu is in collision during path extraction", i - 1, i);
+                return false;
+            }
+        }
+    }
+
     // we made it!
     path = std::move(opath);
     auto* vis_name = "goal_config";
@@ -1019,6 +1280,14 @@ Extension* ManipLattice::getExtension(size_t class_code)
         }
     }
 
+    if (class_code == GetClassCode<ProjectionContextExtension>()) {
+        if (m_fk_iface &&
+            robot()->getExtension<CloneableForwardKinematicsInterface>())
+        {
+            return this;
+        }
+    }
+
     return nullptr;
 }
 
@@ -198,6 +198,7 @@ void ManipLatticeActionSpace::addMotionPrim(
 
     m.action.push_back(mprim);
     m_mprims.push_back(m);
+    m_templates_dirty = true;
 
     if (add_converse) {
         for (RobotState& state : m.action) {
@@ -234,6 +235,8 @@ void ManipLatticeActionSpace::clear()
     for (int i = 0; i < MotionPrimitive::NUMBER_OF_MPRIM_TYPES; ++i) {
         m_mprim_enabled[i] = (i == MotionPrimitive::Type::LONG_DISTANCE);
     }
+
+    m_templates_dirty = true;
 }
 
 int ManipLatticeActionSpace::longDistCount() const
@@ -331,14 +334,155 @@ bool ManipLatticeActionSpace::apply(
     const RobotState& parent,
     std::vector<Action>& actions)
 {
+    auto count = actions.size();
+    return applyActions(parent, actions, count);
+}
+
+/// Actions are written into \p actions, reusing the storage of the actions
+/// and waypoints left in the buffer by previous calls.
+bool ManipLatticeActionSpace::applyBuffered(
+    const RobotState& parent,
+    std::vector<Action>& actions,
+    std::size_t& count)
+{
+    count = 0;
+    return applyActions(parent, actions, count);
+}
+
+void ManipLatticeActionSpace::updateStart(const RobotState& state)
+{
+    m_dist_cache_valid = false;
+}
+
+void ManipLatticeActionSpace::updateGoal(const GoalConstraint& goal)
+{
+    m_dist_cache_valid = false;
+}
+
+void ManipLatticeActionSpace::compileTemplates()
+{
+    m_templates.clear();
+    m_template_deltas.clear();
+    for (auto& prim : m_mprims) {
+        if (prim.type != MotionPrimitive::LONG_DISTANCE &&
+            prim.type != MotionPrimitive::SHORT_DISTANCE)
+        {
+            continue;
+        }
+
+        PrimitiveTemplate t;
+        t.type = prim.type;
+        t.offset = m_template_deltas.size();
+        t.waypoint_count = (int)prim.action.size();
+        t.var_count = prim.action.empty() ? 0 : (int)prim.action.front().size();
+        for (auto& waypoint : prim.action) {
+            if ((int)waypoint.size() != t.var_count) {
+                t.var_count = -1;
+            }
+            m_template_deltas.insert(
+                    m_template_deltas.end(), waypoint.begin(), waypoint.end());
+        }
+        m_templates.push_back(t);
+    }
+    m_templates_dirty = false;
+}
+
+/// Return whether any enabled motion primitive depends on the distance to the
+/// start or goal.
+bool ManipLatticeActionSpace::needDistances() const
+{
+    return (m_mprim_enabled[MotionPrimitive::SHORT_DISTANCE] &&
+            !m_use_long_and_short_dist_mprims) ||
+            m_mprim_enabled[MotionPrimitive::SNAP_TO_RPY] ||
+            m_mprim_enabled[MotionPrimitive::SNAP_TO_XYZ] ||
+            m_mprim_enabled[MotionPrimitive::SNAP_TO_XYZ_RPY];
+}
+
+void ManipLatticeActionSpace::getCachedStartGoalDistances(
+    const RobotState& state,
+    double& start_dist,
+    double& goal_dist)
+{
+    if (!needDistances()) {
+        start_dist = std::numeric_limits<double>::infinity();
+        goal_dist = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    if (!m_dist_cache_valid || m_dist_cache_state != state) {
+        std::tie(m_dist_cache_start, m_dist_cache_goal) =
+                getStartGoalDistances(state);
+        m_dist_cache_state = state;
+        m_dist_cache_valid = true;
+    }
+
+    start_dist = m_dist_cache_start;
+    goal_dist = m_dist_cache_goal;
+}
+
+// Return the next unused action in the buffer, growing the buffer if every
+// action is in use.
+static auto NextAction(std::vector<Action>& actions, std::size_t& count)
+    -> Action&
+{
+    if (count == actions.size()) {
+        actions.emplace_back();
+    }
+    return actions[count++];
+}
+
+bool ManipLatticeActionSpace::applyActions(
+    const RobotState& parent,
+    std::vector<Action>& actions,
+    std::size_t& count)
+{
+    if (m_templates_dirty) {
+        compileTemplates();
+    }
+
+    auto first = count;
+
     double goal_dist, start_dist;
-    std::tie(start_dist, goal_dist) = getStartGoalDistances(parent);
+    getCachedStartGoalDistances(parent, start_dist, goal_dist);
 
+    // adaptive motion primitives are stored before all other primitives
+    m_amp_actions.clear();
     for (auto& prim : m_mprims) {
-        (void)getAction(parent, goal_dist, start_dist, prim, actions);
+        if (prim.type != MotionPrimitive::LONG_DISTANCE &&
+            prim.type != MotionPrimitive::SHORT_DISTANCE)
+        {
+            (void)getAction(parent, goal_dist, start_dist, prim, m_amp_actions);
+        }
+    }
+    for (auto& action : m_amp_actions) {
+        NextAction(actions, count) = std::move(action);
+    }
+
+    bool active[2];
+    active[MotionPrimitive::LONG_DISTANCE] =
+            mprimActive(start_dist, goal_dist, MotionPrimitive::LONG_DISTANCE);
+    active[MotionPrimitive::SHORT_DISTANCE] =
+            mprimActive(start_dist, goal_dist, MotionPrimitive::SHORT_DISTANCE);
+
+    auto var_count = (int)parent.size();
+    for (auto& t : m_templates) {
+        if (!active[t.type] || t.var_count != var_count) {
+            continue;
+        }
+
+        auto& action = NextAction(actions, count);
+        action.resize(t.waypoint_count);
+        auto* d = &m_template_deltas[t.offset];
+        for (auto& waypoint : action) {
+            waypoint.resize(var_count);
+            for (int i = 0; i < var_count; ++i) {
+                waypoint[i] = parent[i] + d[i];
+            }
+            d += var_count;
+        }
     }
 
-    if (actions.empty()) {
+    if (count == first) {
         SMPL_WARN_ONCE("No motion primitives specified");
     }
 
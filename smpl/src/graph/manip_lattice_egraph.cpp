@@ -130,7 +130,7 @@ bool ManipLatticeEgraph::extractPath(
         int best_cost = std::numeric_limits<int>::max();
         for (const Action& action : actions) {
             // check the validity of this transition
-            if (!checkAction(prev_state, action)) {
+            if (!checkAction(prev_state, action, stateTime(prev_entry))) {
                 continue;
             }
 
@@ -143,7 +143,8 @@ bool ManipLatticeEgraph::extractPath(
                 }
 
                 stateToCoord(action.back(), succ_coord);
-                int succ_state_id = getHashEntry(succ_coord);
+                int succ_state_id = getHashEntry(
+                        succ_coord, successorStep(prev_entry));
                 ManipLatticeState* succ_entry = getHashEntry(succ_state_id);
                 assert(succ_entry);
 
@@ -154,7 +155,8 @@ bool ManipLatticeEgraph::extractPath(
                 }
             } else {
                 stateToCoord(action.back(), succ_coord);
-                int succ_state_id = getHashEntry(succ_coord);
+                int succ_state_id = getHashEntry(
+                        succ_coord, successorStep(prev_entry));
                 ManipLatticeState* succ_entry = getHashEntry(succ_state_id);
                 assert(succ_entry);
                 if (succ_state_id != curr_id) {
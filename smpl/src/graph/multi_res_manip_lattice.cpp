@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/graph/multi_res_manip_lattice.h>
+
+// project includes
+#include <smpl/console/console.h>
+#include <smpl/heuristic/robot_heuristic.h>
+#include <smpl/occupancy_grid.h>
+
+namespace smpl {
+
+bool MultiResManipLattice::init(
+    RobotModel* robot,
+    CollisionChecker* checker,
+    const std::vector<double>& resolutions,
+    ActionSpace* fine_actions,
+    ActionSpace* coarse_actions,
+    const OccupancyGrid* grid,
+    const Params& params)
+{
+    if (!coarse_actions) {
+        SMPL_ERROR_NAMED(G_LOG, "Coarse Action Space is null");
+        return false;
+    }
+
+    if (params.coarse_factor < 1) {
+        SMPL_ERROR_NAMED(G_LOG, "Coarse factor must be positive");
+        return false;
+    }
+
+    // the distance to the goal and to obstacles are measured at the planning
+    // link
+    auto* fk_iface = robot->getExtension<ForwardKinematicsInterface>();
+    if (!fk_iface) {
+        SMPL_ERROR_NAMED(G_LOG, "Multi-Resolution Manip Lattice requires Forward Kinematics Interface");
+        return false;
+    }
+
+    if (!ManipLattice::init(robot, checker, resolutions, fine_actions)) {
+        return false;
+    }
+
+    m_coarse_actions = coarse_actions;
+    m_grid = grid;
+    m_fk_iface = fk_iface;
+    m_params = params;
+    return true;
+}
+
+bool MultiResManipLattice::isCoarseState(int state_id) const
+{
+    auto* entry = getHashEntry(state_id);
+    if (!entry || entry->coord.empty()) {
+        return false;
+    }
+
+    if (m_coarse_origin.size() != entry->coord.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < entry->coord.size(); ++i) {
+        if ((entry->coord[i] - m_coarse_origin[i]) % m_params.coarse_factor != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MultiResManipLattice::useCoarseActions(int state_id)
+{
+    if (m_params.coarse_factor == 1 ||
+        state_id == getGoalStateID() ||
+        !isCoarseState(state_id))
+    {
+        return false;
+    }
+
+    auto pose = computePlanningFrameFK(getHashEntry(state_id)->state);
+    Vector3 pos(pose.translation());
+
+    if (m_grid != nullptr &&
+        m_grid->getDistanceFromPoint(pos.x(), pos.y(), pos.z()) <
+                m_params.fine_obstacle_distance)
+    {
+        return false;
+    }
+
+    // without an estimate of the distance to the goal, only the fine
+    // resolution is guaranteed to reach it
+    if (numHeuristics() == 0) {
+        return false;
+    }
+
+    auto goal_dist = heuristic(0)->getMetricGoalDistance(pos.x(), pos.y(), pos.z());
+    return goal_dist >= m_params.fine_goal_distance;
+}
+
+bool MultiResManipLattice::setStart(const RobotState& state)
+{
+    if (!ManipLattice::setStart(state)) {
+        return false;
+    }
+    m_coarse_origin = getHashEntry(getStartStateID())->coord;
+    m_coarse_actions->updateStart(state);
+    return true;
+}
+
+bool MultiResManipLattice::setGoal(const GoalConstraint& goal)
+{
+    if (!ManipLattice::setGoal(goal)) {
+        return false;
+    }
+    m_coarse_actions->updateGoal(goal);
+    return true;
+}
+
+bool MultiResManipLattice::applyActions(
+    int state_id,
+    std::vector<Action>& actions,
+    std::size_t& count,
+    int& cost_scale)
+{
+    if (!useCoarseActions(state_id)) {
+        return ManipLattice::applyActions(state_id, actions, count, cost_scale);
+    }
+
+    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  apply coarse actions");
+    cost_scale = m_params.coarse_factor;
+    auto* entry = getHashEntry(state_id);
+    return m_coarse_actions->applyBuffered(entry->state, actions, count);
+}
+
+} // namespace smpl
@@ -0,0 +1,444 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/graph/primitive_collision_table.h>
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+
+// project includes
+#include <smpl/angles.h>
+#include <smpl/collision_checker.h>
+#include <smpl/console/console.h>
+
+namespace smpl {
+
+static const char* LOG = "primitive_collision_table";
+
+// waypoints of an action match the waypoints of a primitive when they are
+// within this distance in every variable
+static const double kDeltaTolerance = 1e-6;
+
+static const char kFileMagic[8] = { 'S', 'M', 'P', 'L', 'P', 'C', 'T', '1' };
+
+static std::size_t WordCount(std::size_t entry_count)
+{
+    return (2 * entry_count + 63) / 64;
+}
+
+bool PrimitiveCollisionTable::init(
+    const std::vector<double>& min_positions,
+    const std::vector<double>& max_positions,
+    const std::vector<bool>& continuous,
+    const std::vector<int>& cell_counts)
+{
+    if (min_positions.size() != cell_counts.size() ||
+        max_positions.size() != cell_counts.size() ||
+        continuous.size() != cell_counts.size())
+    {
+        SMPL_ERROR_NAMED(LOG, "Mismatched variable counts for primitive collision table");
+        return false;
+    }
+
+    std::size_t cell_count = 1;
+    for (size_t i = 0; i < cell_counts.size(); ++i) {
+        if (cell_counts[i] < 1) {
+            SMPL_ERROR_NAMED(LOG, "Variable %zu must have at least one cell", i);
+            return false;
+        }
+        if (cell_counts[i] > 1 &&
+            !(std::isfinite(min_positions[i]) &&
+                std::isfinite(max_positions[i]) &&
+                min_positions[i] < max_positions[i]))
+        {
+            SMPL_ERROR_NAMED(LOG, "Variable %zu must have a finite range to be divided into cells", i);
+            return false;
+        }
+        cell_count *= cell_counts[i];
+        if (cell_count > (std::size_t)std::numeric_limits<int>::max()) {
+            SMPL_ERROR_NAMED(LOG, "Too many cells in primitive collision table");
+            return false;
+        }
+    }
+
+    m_min_positions = min_positions;
+    m_max_positions = max_positions;
+    m_continuous = continuous;
+    m_cell_counts = cell_counts;
+    m_cell_count = (int)cell_count;
+    m_prims.clear();
+    m_bits.clear();
+    return true;
+}
+
+int PrimitiveCollisionTable::addPrimitive(const Action& deltas)
+{
+    m_prims.push_back(deltas);
+    m_bits.resize(WordCount(m_prims.size() * (std::size_t)m_cell_count), 0);
+    return (int)m_prims.size() - 1;
+}
+
+int PrimitiveCollisionTable::cellIndex(const RobotState& state) const
+{
+    if (state.size() != m_cell_counts.size()) {
+        return -1;
+    }
+
+    int cidx = 0;
+    for (size_t i = 0; i < m_cell_counts.size(); ++i) {
+        auto count = m_cell_counts[i];
+        if (count == 1) {
+            continue;
+        }
+
+        auto pos = state[i];
+        if (m_continuous[i]) {
+            pos = angles::normalize_angle(pos);
+        }
+        if (pos < m_min_positions[i] || pos > m_max_positions[i]) {
+            return -1;
+        }
+
+        auto span = m_max_positions[i] - m_min_positions[i];
+        auto c = (int)((pos - m_min_positions[i]) / span * count);
+        if (c >= count) {
+            c = count - 1;
+        }
+        cidx = cidx * count + c;
+    }
+    return cidx;
+}
+
+void PrimitiveCollisionTable::cellBounds(
+    int cidx,
+    RobotState& min,
+    RobotState& max) const
+{
+    min.resize(m_cell_counts.size());
+    max.resize(m_cell_counts.size());
+    for (int i = (int)m_cell_counts.size() - 1; i >= 0; --i) {
+        auto count = m_cell_counts[i];
+        if (count == 1) {
+            min[i] = m_min_positions[i];
+            max[i] = m_max_positions[i];
+            continue;
+        }
+        auto c = cidx % count;
+        cidx /= count;
+        auto size = (m_max_positions[i] - m_min_positions[i]) / count;
+        min[i] = m_min_positions[i] + c * size;
+        max[i] = min[i] + size;
+    }
+}
+
+int PrimitiveCollisionTable::findPrimitive(
+    const RobotState& state,
+    const Action& action) const
+{
+    for (size_t pidx = 0; pidx < m_prims.size(); ++pidx) {
+        auto& prim = m_prims[pidx];
+        if (prim.size() != action.size()) {
+            continue;
+        }
+
+        auto match = true;
+        for (size_t w = 0; match && w < prim.size(); ++w) {
+            if (prim[w].size() != state.size() ||
+                action[w].size() != state.size())
+            {
+                match = false;
+                break;
+            }
+            for (size_t i = 0; i < state.size(); ++i) {
+                auto d = action[w][i] - state[i];
+                if (std::fabs(d - prim[w][i]) > kDeltaTolerance) {
+                    match = false;
+                    break;
+                }
+            }
+        }
+
+        if (match) {
+            return (int)pidx;
+        }
+    }
+    return -1;
+}
+
+void PrimitiveCollisionTable::setStatus(int pidx, int cidx, Status status)
+{
+    auto bit = 2 * ((std::size_t)pidx * m_cell_count + cidx);
+    auto& word = m_bits[bit >> 6];
+    word &= ~(std::uint64_t(3) << (bit & 63));
+    word |= std::uint64_t(status) << (bit & 63);
+}
+
+auto PrimitiveCollisionTable::status(
+    const RobotState& state,
+    const Action& action) const
+    -> Status
+{
+    auto cidx = cellIndex(state);
+    if (cidx < 0) {
+        return Unknown;
+    }
+    auto pidx = findPrimitive(state, action);
+    if (pidx < 0) {
+        return Unknown;
+    }
+    return status(pidx, cidx);
+}
+
+int PrimitiveCollisionTable::statusCount(Status s) const
+{
+    int count = 0;
+    for (int pidx = 0; pidx < primitiveCount(); ++pidx) {
+        for (int cidx = 0; cidx < m_cell_count; ++cidx) {
+            if (status(pidx, cidx) == s) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+template <typename T>
+static void Write(std::ostream& os, const T& value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static bool Read(std::istream& is, T& value)
+{
+    return (bool)is.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+/// The table is written in a binary format, in the byte order of the host.
+bool PrimitiveCollisionTable::save(const std::string& path) const
+{
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open()) {
+        SMPL_ERROR_NAMED(LOG, "Failed to open '%s' for writing", path.c_str());
+        return false;
+    }
+
+    ofs.write(kFileMagic, sizeof(kFileMagic));
+
+    Write(ofs, (std::int32_t)m_cell_counts.size());
+    for (size_t i = 0; i < m_cell_counts.size(); ++i) {
+        Write(ofs, m_min_positions[i]);
+        Write(ofs, m_max_positions[i]);
+        Write(ofs, (std::int32_t)m_continuous[i]);
+        Write(ofs, (std::int32_t)m_cell_counts[i]);
+    }
+
+    Write(ofs, (std::int32_t)m_prims.size());
+    for (auto& prim : m_prims) {
+        Write(ofs, (std::int32_t)prim.size());
+        for (auto& waypoint : prim) {
+            for (size_t i = 0; i < m_cell_counts.size(); ++i) {
+                Write(ofs, waypoint[i]);
+            }
+        }
+    }
+
+    for (auto word : m_bits) {
+        Write(ofs, word);
+    }
+
+    return (bool)ofs;
+}
+
+bool PrimitiveCollisionTable::load(const std::string& path)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) {
+        SMPL_ERROR_NAMED(LOG, "Failed to open '%s' for reading", path.c_str());
+        return false;
+    }
+
+    char magic[sizeof(kFileMagic)];
+    if (!ifs.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, kFileMagic, sizeof(magic)) != 0)
+    {
+        SMPL_ERROR_NAMED(LOG, "'%s' is not a primitive collision table", path.c_str());
+        return false;
+    }
+
+    std::int32_t var_count;
+    if (!Read(ifs, var_count) || var_count < 0) {
+        SMPL_ERROR_NAMED(LOG, "Failed to read primitive collision table");
+        return false;
+    }
+
+    std::vector<double> min_positions(var_count);
+    std::vector<double> max_positions(var_count);
+    std::vector<bool> continuous(var_count);
+    std::vector<int> cell_counts(var_count);
+    for (int i = 0; i < var_count; ++i) {
+        std::int32_t c, count;
+        if (!Read(ifs, min_positions[i]) ||
+            !Read(ifs, max_positions[i]) ||
+            !Read(ifs, c) ||
+            !Read(ifs, count))
+        {
+            SMPL_ERROR_NAMED(LOG, "Failed to read primitive collision table");
+            return false;
+        }
+        continuous[i] = c != 0;
+        cell_counts[i] = count;
+    }
+
+    if (!init(min_positions, max_positions, continuous, cell_counts)) {
+        return false;
+    }
+
+    std::int32_t prim_count;
+    if (!Read(ifs, prim_count) || prim_count < 0) {
+        SMPL_ERROR_NAMED(LOG, "Failed to read primitive collision table");
+        return false;
+    }
+
+    for (int p = 0; p < prim_count; ++p) {
+        std::int32_t waypoint_count;
+        if (!Read(ifs, waypoint_count) || waypoint_count < 0) {
+            SMPL_ERROR_NAMED(LOG, "Failed to read primitive collision table");
+            return false;
+        }
+        Action prim(waypoint_count, RobotState(var_count));
+        for (auto& waypoint : prim) {
+            for (auto& d : waypoint) {
+                if (!Read(ifs, d)) {
+                    SMPL_ERROR_NAMED(LOG, "Failed to read primitive collision table");
+                    return false;
+                }
+            }
+        }
+        addPrimitive(prim);
+    }
+
+    for (auto& word : m_bits) {
+        if (!Read(ifs, word)) {
+            SMPL_ERROR_NAMED(LOG, "Failed to read primitive collision table");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BuildPrimitiveCollisionTable(
+    PrimitiveCollisionTable& table,
+    SelfCollisionCheckerExtension* checker,
+    int samples_per_cell,
+    unsigned int seed)
+{
+    if (!checker || samples_per_cell < 1) {
+        return false;
+    }
+
+    // sources are sampled from the full range of variables with one cell
+    RobotState cell_min, cell_max;
+    table.cellBounds(0, cell_min, cell_max);
+    for (size_t i = 0; i < cell_min.size(); ++i) {
+        if (!std::isfinite(cell_min[i]) || !std::isfinite(cell_max[i])) {
+            SMPL_ERROR_NAMED(LOG, "Variable %zu must have a finite range to build a primitive collision table", i);
+            return false;
+        }
+    }
+
+    auto progress_interval = std::max(1, table.cellCount() / 20);
+
+    std::default_random_engine rng(seed);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+
+    std::vector<RobotState> samples(samples_per_cell);
+    RobotState prev, curr;
+    for (int cidx = 0; cidx < table.cellCount(); ++cidx) {
+        table.cellBounds(cidx, cell_min, cell_max);
+
+        // the same sources are used for every primitive; the first is the
+        // center of the cell
+        for (int s = 0; s < samples_per_cell; ++s) {
+            auto& sample = samples[s];
+            sample.resize(cell_min.size());
+            for (size_t i = 0; i < sample.size(); ++i) {
+                auto t = (s == 0) ? 0.5 : u(rng);
+                sample[i] = cell_min[i] + t * (cell_max[i] - cell_min[i]);
+            }
+        }
+
+        for (int pidx = 0; pidx < table.primitiveCount(); ++pidx) {
+            auto& prim = table.primitive(pidx);
+            auto free_count = 0;
+            for (auto& sample : samples) {
+                auto valid = true;
+                prev = sample;
+                for (auto& delta : prim) {
+                    curr = sample;
+                    for (size_t i = 0; i < curr.size(); ++i) {
+                        curr[i] += delta[i];
+                    }
+                    if (!checker->isStateToStateSelfValid(prev, curr)) {
+                        valid = false;
+                        break;
+                    }
+                    prev = curr;
+                }
+                if (valid) {
+                    ++free_count;
+                }
+            }
+
+            if (free_count == samples_per_cell) {
+                table.setStatus(pidx, cidx, PrimitiveCollisionTable::Free);
+            } else if (free_count == 0) {
+                table.setStatus(pidx, cidx, PrimitiveCollisionTable::Colliding);
+            } else {
+                table.setStatus(pidx, cidx, PrimitiveCollisionTable::Unknown);
+            }
+        }
+
+        if ((cidx + 1) % progress_interval == 0) {
+            SMPL_INFO_NAMED(LOG, "Classified %d/%d cells", cidx + 1, table.cellCount());
+        }
+    }
+
+    return true;
+}
+
+} // namespace smpl
@@ -54,8 +54,11 @@ bool InitSimpleWorkspaceLatticeActions(
     add_xyz_prim(0, 0, 1);
     add_xyz_prim(0, 0, -1);
 
-    // create 2-connected motions for rotation and free angle motions
-    for (int a = 3; a < space->dofCount(); ++a) {
+    // create 2-connected motions for rotation and free angle motions. Motions
+    // between uniformly discretized rotations are generated from the
+    // neighbors of each rotation cell instead.
+    auto first = space->uniformRotations() ? 6 : 3;
+    for (int a = first; a < space->dofCount(); ++a) {
         std::vector<double> d(space->dofCount(), 0.0);
 
         d[a] = space->resolution()[a] * -1;
@@ -106,6 +109,17 @@ void SimpleWorkspaceLatticeActionSpace::apply(
         actions.push_back(std::move(action));
     }
 
+    if (space->uniformRotations()) {
+        auto& grid = space->rotationGrid();
+        auto cidx = state.coord[3];
+        for (auto* n = grid.neighborsBegin(cidx); n != grid.neighborsEnd(cidx); ++n) {
+            auto final_state = cont_state;
+            int rot_coord[3] = { *n, 0, 0 };
+            space->rotCoordToWorkspace(rot_coord, &final_state[3]);
+            actions.push_back(WorkspaceAction(1, std::move(final_state)));
+        }
+    }
+
     if (m_ik_amp_enabled && space->numHeuristics() > 0) {
         auto* h = space->heuristic(0);
         auto goal_dist = h->getMetricGoalDistance(
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/graph/workspace_ik_cache.h>
+
+// standard includes
+#include <cmath>
+#include <iterator>
+
+namespace smpl {
+
+// workspace states that round to the same coordinate are considered equal when
+// they are within this distance in every dimension
+static const double kStateTolerance = 1e-6;
+
+static bool SameState(const WorkspaceState& a, const WorkspaceState& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::fabs(a[i] - b[i]) > kStateTolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::size_t WorkspaceIKCache::DefaultCapacity;
+
+WorkspaceIKCache::WorkspaceIKCache(std::size_t capacity) :
+    m_capacity(capacity)
+{
+}
+
+/// Set the maximum number of entries stored in the cache. If the cache
+/// currently stores more than \p capacity entries, the least recently used
+/// entries are evicted. A capacity of 0 disables caching.
+void WorkspaceIKCache::setCapacity(std::size_t capacity)
+{
+    m_capacity = capacity;
+    if (m_entries.size() > m_capacity) {
+        evict(m_entries.size() - m_capacity);
+    }
+}
+
+/// Return the entry stored for the workspace coordinate \p coord, or nullptr
+/// if no entry exists or the stored entry was computed for a workspace state
+/// other than \p state. A successful lookup marks the entry as most recently
+/// used. The returned pointer is invalidated by the next call to insert().
+auto WorkspaceIKCache::lookup(
+    const WorkspaceCoord& coord,
+    const WorkspaceState& state)
+    -> const Entry*
+{
+    auto it = m_index.find(coord);
+    if (it == end(m_index) || !SameState(it->second->state, state)) {
+        ++m_miss_count;
+        return nullptr;
+    }
+
+    ++m_hit_count;
+    m_entries.splice(begin(m_entries), m_entries, it->second);
+    return &m_entries.front();
+}
+
+/// Return whether an entry exists for \p coord and \p state, without counting
+/// the query as a hit or miss or marking the entry as recently used.
+bool WorkspaceIKCache::contains(
+    const WorkspaceCoord& coord,
+    const WorkspaceState& state) const
+{
+    auto it = m_index.find(coord);
+    return it != end(m_index) && SameState(it->second->state, state);
+}
+
+/// Store the result of computing inverse kinematics for the workspace state
+/// \p state, whose discrete coordinate is \p coord. \p solution points to the
+/// solution found, or is nullptr if no solution exists. Replaces any existing
+/// entry for \p coord.
+void WorkspaceIKCache::insert(
+    const WorkspaceCoord& coord,
+    const WorkspaceState& state,
+    const RobotState* solution)
+{
+    if (m_capacity == 0) {
+        return;
+    }
+
+    auto it = m_index.find(coord);
+    if (it != end(m_index)) {
+        m_entries.splice(begin(m_entries), m_entries, it->second);
+    } else {
+        if (m_entries.size() >= m_capacity) {
+            // reuse the least recently used entry, and its storage, for the
+            // new entry
+            evict(m_entries.size() - m_capacity);
+            m_index.erase(m_entries.back().coord);
+            m_entries.splice(begin(m_entries), m_entries, std::prev(end(m_entries)));
+        } else {
+            m_entries.emplace_front();
+        }
+        m_entries.front().coord = coord;
+        m_index.emplace(coord, begin(m_entries));
+    }
+
+    auto& entry = m_entries.front();
+    entry.state = state;
+    if (solution != nullptr) {
+        entry.solution = *solution;
+        entry.valid = true;
+    } else {
+        entry.solution.clear();
+        entry.valid = false;
+    }
+}
+
+void WorkspaceIKCache::clear()
+{
+    m_index.clear();
+    m_entries.clear();
+}
+
+void WorkspaceIKCache::resetCounts()
+{
+    m_hit_count = 0;
+    m_miss_count = 0;
+}
+
+void WorkspaceIKCache::evict(std::size_t count)
+{
+    for (std::size_t i = 0; i < count && !m_entries.empty(); ++i) {
+        m_index.erase(m_entries.back().coord);
+        m_entries.pop_back();
+    }
+}
+
+} // namespace smpl
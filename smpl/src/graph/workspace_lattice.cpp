@@ -32,6 +32,10 @@
 
 #include <smpl/graph/workspace_lattice.h>
 
+// standard includes
+#include <memory>
+#include <unordered_set>
+
 // system includes
 #include <boost/functional/hash.hpp>
 
@@ -92,6 +96,13 @@ const std::string& WorkspaceLattice::visualizationFrameId() const
     return m_viz_frame_id;
 }
 
+/// Set the maximum number of waypoint ik solutions retained between
+/// expansions. A capacity of 0 disables the cache.
+void WorkspaceLattice::setIKCacheCapacity(size_t capacity)
+{
+    m_ik_cache.setCapacity(capacity);
+}
+
 bool WorkspaceLattice::init(
     RobotModel* _robot,
     CollisionChecker* checker,
@@ -112,6 +123,14 @@ bool WorkspaceLattice::init(
     SMPL_DEBUG_NAMED(G_LOG, "initialize environment");
 
     m_actions = actions;
+
+    m_batch_ik_iface = _robot->getExtension<BatchRedundantManipulatorInterface>();
+    if (m_batch_ik_iface) {
+        SMPL_DEBUG_NAMED(G_LOG, "  solve waypoint ik in batches");
+    }
+
+    m_ik_cache.clear();
+    m_ik_cache.resetCounts();
     return true;
 }
 
@@ -360,6 +379,8 @@ void WorkspaceLattice::GetSuccs(
 
     SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  actions: %zu", actions.size());
 
+    prefetchIK(parent_entry->state, actions);
+
     // iterate through successors of source state
     for (size_t i = 0; i < actions.size(); ++i) {
         auto& action = actions[i];
@@ -462,6 +483,8 @@ void WorkspaceLattice::GetLazySuccs(
 
     SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  actions: %zu", actions.size());
 
+    prefetchIK(state_entry->state, actions);
+
     for (size_t i = 0; i < actions.size(); ++i) {
         auto& action = actions[i];
 
@@ -770,14 +793,8 @@ bool WorkspaceLattice::checkAction(
 
         SMPL_DEBUG_STREAM_NAMED(G_SUCCESSORS_LOG, "        " << widx << ": " << waypoint);
 
-        RobotState seed = state;
-        // copy over seed angles from the intermediate state
-        for (int i = 0; i < this->freeAngleCount(); ++i) {
-            seed[this->m_fangle_indices[i]] = waypoint[6 + i];
-        }
-
         RobotState irstate;
-        if (!stateWorkspaceToRobot(waypoint, seed, irstate)) {
+        if (!computeWaypointIK(state, waypoint, irstate)) {
             SMPL_DEBUG_NAMED(G_SUCCESSORS_LOG, "         -> failed to find ik solution");
             return false;
         }
@@ -814,6 +831,103 @@ bool WorkspaceLattice::checkAction(
     return true;
 }
 
+/// Compute the inverse kinematics solution for a waypoint of an action applied
+/// to the robot state \p state. The redundant variables of the solution are
+/// restricted to the free angles of the waypoint. Results, including failures,
+/// are looked up in and stored to the ik cache.
+bool WorkspaceLattice::computeWaypointIK(
+    const RobotState& state,
+    const WorkspaceState& waypoint,
+    RobotState& solution)
+{
+    WorkspaceCoord coord;
+    stateWorkspaceToCoord(waypoint, coord);
+
+    auto* entry = m_ik_cache.lookup(coord, waypoint);
+    if (entry != NULL) {
+        if (entry->valid) {
+            solution = entry->solution;
+        }
+        return entry->valid;
+    }
+
+    RobotState seed = state;
+    // copy over seed angles from the intermediate state
+    for (size_t i = 0; i < this->freeAngleCount(); ++i) {
+        seed[this->m_fangle_indices[i]] = waypoint[6 + i];
+    }
+
+    if (!stateWorkspaceToRobot(waypoint, seed, solution)) {
+        m_ik_cache.insert(coord, waypoint, NULL);
+        return false;
+    }
+
+    m_ik_cache.insert(coord, waypoint, &solution);
+    return true;
+}
+
+/// Solve inverse kinematics, in a single batch, for all waypoints of \p actions
+/// that are not already in the ik cache, and store the results in the cache.
+/// Does nothing if the robot model does not support batched ik or the cache is
+/// disabled.
+void WorkspaceLattice::prefetchIK(
+    const RobotState& state,
+    const std::vector<WorkspaceAction>& actions)
+{
+    if (!m_batch_ik_iface || m_ik_cache.capacity() == 0) {
+        return;
+    }
+
+    std::vector<WorkspaceCoord> coords;
+    std::vector<const WorkspaceState*> waypoints;
+    std::vector<Affine3, Eigen::aligned_allocator<Affine3>> poses;
+    std::vector<RobotState> seeds;
+
+    std::unordered_set<WorkspaceCoord, VectorHash<int>> pending;
+    WorkspaceCoord coord;
+    for (auto& action : actions) {
+        for (auto& waypoint : action) {
+            stateWorkspaceToCoord(waypoint, coord);
+            if (m_ik_cache.contains(coord, waypoint) ||
+                !pending.insert(coord).second)
+            {
+                continue;
+            }
+
+            RobotState seed = state;
+            for (size_t i = 0; i < this->freeAngleCount(); ++i) {
+                seed[this->m_fangle_indices[i]] = waypoint[6 + i];
+            }
+
+            coords.push_back(coord);
+            waypoints.push_back(&waypoint);
+            poses.push_back(
+                    Translation3(waypoint[0], waypoint[1], waypoint[2]) *
+                    AngleAxis(waypoint[5], Vector3::UnitZ()) *
+                    AngleAxis(waypoint[4], Vector3::UnitY()) *
+                    AngleAxis(waypoint[3], Vector3::UnitX()));
+            seeds.push_back(std::move(seed));
+        }
+    }
+
+    if (poses.empty()) {
+        return;
+    }
+
+    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "  solve ik for %zu waypoints", poses.size());
+
+    std::vector<RobotState> solutions(poses.size());
+    std::unique_ptr<bool[]> solved(new bool[poses.size()]);
+    m_batch_ik_iface->computeFastIKBatch(
+            poses.data(), seeds.data(), poses.size(),
+            solutions.data(), solved.get());
+
+    for (size_t i = 0; i < poses.size(); ++i) {
+        m_ik_cache.insert(
+                coords[i], *waypoints[i], solved[i] ? &solutions[i] : NULL);
+    }
+}
+
 int WorkspaceLattice::computeCost(
     const WorkspaceLatticeState& src,
     const WorkspaceLatticeState& dst)
@@ -836,7 +950,7 @@ bool WorkspaceLattice::checkLazyAction(
         SMPL_DEBUG_STREAM_NAMED(G_EXPANSIONS_LOG, "        " << widx << ": " << istate);
 
         RobotState irstate;
-        if (!stateWorkspaceToRobot(istate, state, irstate)) {
+        if (!computeWaypointIK(state, istate, irstate)) {
             SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "         -> failed to find ik solution");
             return false;
         }
@@ -95,9 +95,27 @@ bool WorkspaceLatticeBase::init(
     m_val_count[0] = std::numeric_limits<int>::max();
     m_val_count[1] = std::numeric_limits<int>::max();
     m_val_count[2] = std::numeric_limits<int>::max();
-    m_val_count[3] = _params.R_count;
-    m_val_count[4] = _params.P_count;
-    m_val_count[5] = _params.Y_count;
+    m_uniform_rot = _params.rot_res > 0.0;
+    if (m_uniform_rot) {
+        m_rot_grid.init(_params.rot_res);
+        m_rot_euler.resize(3 * m_rot_grid.cellCount());
+        for (int i = 0; i < m_rot_grid.cellCount(); ++i) {
+            get_euler_zyx(
+                    m_rot_grid.cellCenter(i),
+                    m_rot_euler[3 * i + 2],
+                    m_rot_euler[3 * i + 1],
+                    m_rot_euler[3 * i + 0]);
+        }
+        m_val_count[3] = m_rot_grid.cellCount();
+        m_val_count[4] = 1;
+        m_val_count[5] = 1;
+    } else {
+        m_rot_grid = geometry::SO3Grid();
+        m_rot_euler.clear();
+        m_val_count[3] = _params.R_count;
+        m_val_count[4] = _params.P_count;
+        m_val_count[5] = _params.Y_count;
+    }
     for (int i = 0; i < m_fangle_indices.size(); ++i) {
         if (m_fangle_continuous[i]) {
             m_val_count[6 + i] = (int)std::round((2.0 * M_PI) / _params.free_angle_res[i]);
@@ -112,10 +130,16 @@ bool WorkspaceLatticeBase::init(
     m_res[0] = _params.res_x;
     m_res[1] = _params.res_y;
     m_res[2] = _params.res_z;
-    // TODO: limit these ranges and handle discretization appropriately
-    m_res[3] = 2.0 * M_PI / _params.R_count;
-    m_res[4] = M_PI       / (_params.P_count - 1);
-    m_res[5] = 2.0 * M_PI / _params.Y_count;
+    if (m_uniform_rot) {
+        m_res[3] = m_rot_grid.resolution();
+        m_res[4] = m_rot_grid.resolution();
+        m_res[5] = m_rot_grid.resolution();
+    } else {
+        // TODO: limit these ranges and handle discretization appropriately
+        m_res[3] = 2.0 * M_PI / _params.R_count;
+        m_res[4] = M_PI       / (_params.P_count - 1);
+        m_res[5] = 2.0 * M_PI / _params.Y_count;
+    }
 
     for (int i = 0; i < m_fangle_indices.size(); ++i) {
         if (m_fangle_continuous[i]) {
@@ -132,9 +156,13 @@ bool WorkspaceLatticeBase::init(
     SMPL_DEBUG_NAMED(G_LOG, "  x: { res: %f, count: %d }", m_res[0], m_val_count[0]);
     SMPL_DEBUG_NAMED(G_LOG, "  y: { res: %f, count: %d }", m_res[1], m_val_count[1]);
     SMPL_DEBUG_NAMED(G_LOG, "  z: { res: %f, count: %d }", m_res[2], m_val_count[2]);
-    SMPL_DEBUG_NAMED(G_LOG, "  R: { res: %f, count: %d }", m_res[3], m_val_count[3]);
-    SMPL_DEBUG_NAMED(G_LOG, "  P: { res: %f, count: %d }", m_res[4], m_val_count[4]);
-    SMPL_DEBUG_NAMED(G_LOG, "  Y: { res: %f, count: %d }", m_res[5], m_val_count[5]);
+    if (m_uniform_rot) {
+        SMPL_DEBUG_NAMED(G_LOG, "  SO(3): { res: %f, count: %d, nside: %d }", m_res[3], m_val_count[3], m_rot_grid.nside());
+    } else {
+        SMPL_DEBUG_NAMED(G_LOG, "  R: { res: %f, count: %d }", m_res[3], m_val_count[3]);
+        SMPL_DEBUG_NAMED(G_LOG, "  P: { res: %f, count: %d }", m_res[4], m_val_count[4]);
+        SMPL_DEBUG_NAMED(G_LOG, "  Y: { res: %f, count: %d }", m_res[5], m_val_count[5]);
+    }
     for (int i = 0; i < m_fangle_indices.size(); ++i) {
         SMPL_DEBUG_NAMED(G_LOG, "  J%d: { res: %f, count: %d }", i, m_res[6 + i], m_val_count[6 + i]);
     }
@@ -264,6 +292,15 @@ void WorkspaceLatticeBase::posCoordToWorkspace(const int* gp, double* wp) const
 
 void WorkspaceLatticeBase::rotWorkspaceToCoord(const double* wr, int* gr) const
 {
+    if (m_uniform_rot) {
+        Quaternion q;
+        from_euler_zyx(wr[2], wr[1], wr[0], q);
+        gr[0] = m_rot_grid.cellIndex(q);
+        gr[1] = 0;
+        gr[2] = 0;
+        return;
+    }
+
     gr[0] = (int)((angles::normalize_angle_positive(wr[0]) + m_res[3] * 0.5) / m_res[3]) % m_val_count[3];
     gr[1] = (int)((angles::normalize_angle(wr[1]) + (0.5 * M_PI) + m_res[4] * 0.5) / m_res[4]) % m_val_count[4];
     gr[2] = (int)((angles::normalize_angle_positive(wr[2]) + m_res[5] * 0.5) / m_res[5]) % m_val_count[5];
@@ -271,6 +308,13 @@ void WorkspaceLatticeBase::rotWorkspaceToCoord(const double* wr, int* gr) const
 
 void WorkspaceLatticeBase::rotCoordToWorkspace(const int* gr, double* wr) const
 {
+    if (m_uniform_rot) {
+        wr[0] = m_rot_euler[3 * gr[0] + 0];
+        wr[1] = m_rot_euler[3 * gr[0] + 1];
+        wr[2] = m_rot_euler[3 * gr[0] + 2];
+        return;
+    }
+
     // TODO: this normalize is probably not necessary
     wr[0] = angles::normalize_angle((double)gr[0] * m_res[3]);
     wr[1] = angles::normalize_angle(-0.5 * M_PI + (double)gr[1] * m_res[4]);
@@ -0,0 +1,827 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/graph/xytheta_lattice.h>
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+// system includes
+#include <sbpl/planners/planner.h>
+
+// project includes
+#include <smpl/angles.h>
+#include <smpl/console/console.h>
+#include <smpl/occupancy_grid.h>
+#include <smpl/planning_params.h>
+#include <smpl/unicycle/unicycle.h>
+
+namespace smpl {
+
+// lattice directions of 16 headings, counterclockwise from the +x axis. The
+// 8- and 4-heading lattices use every second and every fourth direction.
+static const int kHeadingDirs[16][2] =
+{
+    {  1,  0 }, {  2,  1 }, {  1,  1 }, {  1,  2 },
+    {  0,  1 }, { -1,  2 }, { -1,  1 }, { -2,  1 },
+    { -1,  0 }, { -2, -1 }, { -1, -1 }, { -1, -2 },
+    {  0, -1 }, {  1, -2 }, {  1, -1 }, {  2, -1 },
+};
+
+static
+bool PointInPolygon(const std::vector<Vector2>& poly, const Vector2& p)
+{
+    auto inside = false;
+    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+        auto& a = poly[i];
+        auto& b = poly[j];
+        if ((a.y() > p.y()) != (b.y() > p.y()) &&
+            p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x())
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+// Append the cells covered by the footprint at a pose, relative to the cell
+// whose center is the origin. Cells whose centers lie inside the footprint are
+// covered, as are cells crossed by its boundary, so that footprints thinner
+// than a cell are not missed.
+static
+void RasterizeFootprint(
+    const std::vector<Vector2>& footprint,
+    const Pose2D& pose,
+    double res,
+    std::vector<Eigen::Vector2i>& cells)
+{
+    auto to_cell = [&](double v) { return (int)std::floor(v / res + 0.5); };
+
+    if (footprint.empty()) {
+        cells.emplace_back(to_cell(pose.x), to_cell(pose.y));
+        return;
+    }
+
+    auto c = std::cos(pose.theta);
+    auto s = std::sin(pose.theta);
+    std::vector<Vector2> poly;
+    poly.reserve(footprint.size());
+    Vector2 min(std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+    Vector2 max = -min;
+    for (auto& v : footprint) {
+        Vector2 p(pose.x + c * v.x() - s * v.y(), pose.y + s * v.x() + c * v.y());
+        min = min.cwiseMin(p);
+        max = max.cwiseMax(p);
+        poly.push_back(p);
+    }
+
+    for (int cx = to_cell(min.x()); cx <= to_cell(max.x()); ++cx) {
+    for (int cy = to_cell(min.y()); cy <= to_cell(max.y()); ++cy) {
+        if (PointInPolygon(poly, Vector2(cx * res, cy * res))) {
+            cells.emplace_back(cx, cy);
+        }
+    }
+    }
+
+    for (size_t i = 0; i < poly.size(); ++i) {
+        auto& a = poly[i];
+        auto& b = poly[(i + 1) % poly.size()];
+        auto samples = std::max(1, (int)std::ceil((b - a).norm() / (0.5 * res)));
+        for (int j = 0; j <= samples; ++j) {
+            Vector2 p = a + (b - a) * ((double)j / (double)samples);
+            cells.emplace_back(to_cell(p.x()), to_cell(p.y()));
+        }
+    }
+}
+
+static
+bool CellLess(const Eigen::Vector2i& a, const Eigen::Vector2i& b)
+{
+    return a.y() < b.y() || (a.y() == b.y() && a.x() < b.x());
+}
+
+// Fill in the swept cells of a primitive whose poses have been assigned.
+static
+void SweepPrimitive(
+    const std::vector<Vector2>& footprint,
+    double start_theta,
+    double res,
+    XYThetaPrimitive& prim)
+{
+    prim.cells.clear();
+    RasterizeFootprint(footprint, Pose2D(0.0, 0.0, start_theta), res, prim.cells);
+    for (auto& pose : prim.poses) {
+        RasterizeFootprint(footprint, pose, res, prim.cells);
+    }
+
+    // sort by row so that checks walk memory in order
+    std::sort(begin(prim.cells), end(prim.cells), CellLess);
+    prim.cells.erase(
+            std::unique(begin(prim.cells), end(prim.cells)),
+            end(prim.cells));
+
+    prim.min_cell = prim.cells.front();
+    prim.max_cell = prim.cells.front();
+    for (auto& cell : prim.cells) {
+        prim.min_cell = prim.min_cell.cwiseMin(cell);
+        prim.max_cell = prim.max_cell.cwiseMax(cell);
+    }
+}
+
+XYThetaLattice::~XYThetaLattice()
+{
+    m_states.clear();
+    m_state_to_id.clear();
+}
+
+bool XYThetaLattice::init(
+    RobotModel* robot,
+    CollisionChecker* checker,
+    const OccupancyGrid* grid,
+    const Params& params)
+{
+    SMPL_DEBUG_NAMED(G_LOG, "Initialize XYTheta Lattice");
+
+    if (grid == NULL) {
+        SMPL_ERROR_NAMED(G_LOG, "Occupancy grid is null");
+        return false;
+    }
+
+    if (robot->jointVariableCount() != 3) {
+        SMPL_ERROR_NAMED(G_LOG, "XYTheta Lattice requires a robot model with (x, y, theta) variables");
+        return false;
+    }
+
+    if (params.num_headings != 4 &&
+        params.num_headings != 8 &&
+        params.num_headings != 16)
+    {
+        SMPL_ERROR_NAMED(G_LOG, "Number of headings must be 4, 8, or 16");
+        return false;
+    }
+
+    if (params.grid_z < 0 || params.grid_z >= grid->numCellsZ()) {
+        SMPL_ERROR_NAMED(G_LOG, "Grid layer %d is out of bounds", params.grid_z);
+        return false;
+    }
+
+    if (!RobotPlanningSpace::init(robot, checker)) {
+        SMPL_ERROR_NAMED(G_LOG, "Failed to initialize Robot Planning Space");
+        return false;
+    }
+
+    m_grid = grid;
+    m_params = params;
+    m_num_cells_x = grid->numCellsX();
+    m_num_cells_y = grid->numCellsY();
+
+    auto stride = 16 / params.num_headings;
+    m_headings.resize(params.num_headings);
+    for (int h = 0; h < params.num_headings; ++h) {
+        auto* dir = kHeadingDirs[h * stride];
+        m_headings[h] = std::atan2((double)dir[1], (double)dir[0]);
+    }
+
+    generatePrimitives();
+
+    m_cell_status.assign((size_t)m_num_cells_x * (size_t)m_num_cells_y, Unknown);
+
+    clearStates();
+
+    return true;
+}
+
+int XYThetaLattice::headingIndex(double theta) const
+{
+    auto best = 0;
+    auto best_dist = std::numeric_limits<double>::infinity();
+    for (int h = 0; h < numHeadings(); ++h) {
+        auto dist = shortest_angle_dist(theta, m_headings[h]);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = h;
+        }
+    }
+    return best;
+}
+
+auto XYThetaLattice::getDiscreteCenter(const RobotState& state) const
+    -> RobotState
+{
+    int x, y;
+    worldToCell(state[0], state[1], x, y);
+    RobotState center(3);
+    cellToWorld(x, y, center[0], center[1]);
+    center[2] = m_headings[headingIndex(state[2])];
+    return center;
+}
+
+bool XYThetaLattice::isStateValid(int x, int y, int heading)
+{
+    for (auto& cell : m_footprint_cells[heading]) {
+        auto cx = x + cell.x();
+        auto cy = y + cell.y();
+        if (cx < 0 || cx >= m_num_cells_x || cy < 0 || cy >= m_num_cells_y) {
+            return false;
+        }
+        if (!isCellFree(cy * m_num_cells_x + cx)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void XYThetaLattice::clearStates()
+{
+    m_states.clear();
+    m_state_to_id.clear();
+    for (auto* indices : StateID2IndexMapping) {
+        delete[] indices;
+    }
+    StateID2IndexMapping.clear();
+
+    m_start_state_id = -1;
+    m_goal_state_id = reserveState();
+}
+
+auto XYThetaLattice::extractState(int state_id) -> const RobotState&
+{
+    return m_states[state_id].state;
+}
+
+bool XYThetaLattice::projectToPose(int state_id, Affine3& pose)
+{
+    if (state_id == m_goal_state_id) {
+        pose = goal().pose;
+        return true;
+    }
+
+    auto& entry = m_states[state_id];
+    double wx, wy, wz;
+    m_grid->gridToWorld(entry.x, entry.y, m_params.grid_z, wx, wy, wz);
+    pose = MakeAffine(wx, wy, wz, m_headings[entry.heading]);
+    return true;
+}
+
+bool XYThetaLattice::setStart(const RobotState& state)
+{
+    SMPL_DEBUG_NAMED(G_LOG, "set the start state");
+
+    if (state.size() < 3) {
+        SMPL_ERROR_NAMED(G_LOG, "start state does not contain (x, y, theta)");
+        return false;
+    }
+
+    // the grid may have changed since the last query
+    std::fill(begin(m_cell_status), end(m_cell_status), Unknown);
+
+    int x, y;
+    worldToCell(state[0], state[1], x, y);
+    auto heading = headingIndex(state[2]);
+    SMPL_DEBUG_NAMED(G_LOG, "  coord: (%d, %d, %d)", x, y, heading);
+
+    if (x < 0 || x >= m_num_cells_x || y < 0 || y >= m_num_cells_y) {
+        SMPL_WARN(" -> out of bounds");
+        return false;
+    }
+
+    if (!isStateValid(x, y, heading)) {
+        SMPL_WARN(" -> in collision");
+        return false;
+    }
+
+    m_start_state_id = getOrCreateState(x, y, heading);
+
+    return RobotPlanningSpace::setStart(state);
+}
+
+bool XYThetaLattice::setGoal(const GoalConstraint& goal)
+{
+    double wx, wy, wz;
+    m_grid->gridToWorld(0, 0, m_params.grid_z, wx, wy, wz);
+
+    auto g = goal;
+    switch (goal.type) {
+    case GoalType::JOINT_STATE_GOAL:
+    {
+        if (goal.angles.size() < 3 || goal.angle_tolerances.size() < 3) {
+            SMPL_ERROR_NAMED(G_LOG, "goal state does not contain (x, y, theta)");
+            return false;
+        }
+        m_goal_pose = Pose2D(goal.angles[0], goal.angles[1], goal.angles[2]);
+        m_goal_tolerance = Pose2D(
+                goal.angle_tolerances[0],
+                goal.angle_tolerances[1],
+                goal.angle_tolerances[2]);
+
+        // heuristics locate the goal from its pose
+        g.pose = MakeAffine(
+                m_goal_pose.x, m_goal_pose.y, wz, m_goal_pose.theta);
+        break;
+    }
+    case GoalType::XYZ_GOAL:
+    case GoalType::XYZ_RPY_GOAL:
+    {
+        double yaw, pitch, roll;
+        get_euler_zyx(goal.pose.rotation(), yaw, pitch, roll);
+        m_goal_pose = Pose2D(
+                goal.pose.translation().x(), goal.pose.translation().y(), yaw);
+        m_goal_tolerance = Pose2D(
+                goal.xyz_tolerance[0],
+                goal.xyz_tolerance[1],
+                goal.type == GoalType::XYZ_GOAL ?
+                        std::numeric_limits<double>::infinity() :
+                        goal.rpy_tolerance[2]);
+        break;
+    }
+    default:
+        SMPL_ERROR_NAMED(G_LOG, "Unsupported goal type for XYTheta Lattice");
+        return false;
+    }
+
+    return RobotPlanningSpace::setGoal(g);
+}
+
+int XYThetaLattice::getStartStateID() const
+{
+    return m_start_state_id;
+}
+
+int XYThetaLattice::getGoalStateID() const
+{
+    return m_goal_state_id;
+}
+
+bool XYThetaLattice::extractPath(
+    const std::vector<int>& ids,
+    std::vector<RobotState>& path)
+{
+    if (ids.empty()) {
+        return true;
+    }
+
+    std::vector<RobotState> opath;
+
+    auto push_state = [&](int state_id)
+    {
+        if (state_id == m_goal_state_id) {
+            state_id = m_start_state_id;
+        }
+        opath.push_back(m_states[state_id].state);
+    };
+
+    push_state(ids[0]);
+
+    for (size_t i = 1; i < ids.size(); ++i) {
+        auto prev_id = ids[i - 1];
+        auto curr_id = ids[i];
+
+        if (prev_id == m_goal_state_id) {
+            SMPL_ERROR_NAMED(G_LOG, "Cannot determine goal state predecessor state during path extraction");
+            return false;
+        }
+
+        auto* prim = findPrimitive(prev_id, curr_id);
+        if (prim == NULL) {
+            SMPL_ERROR_NAMED(G_LOG, "Failed to find valid motion from state %d to state %d during path extraction", prev_id, curr_id);
+            return false;
+        }
+
+        auto& prev = m_states[prev_id];
+        double wx, wy;
+        cellToWorld(prev.x, prev.y, wx, wy);
+        for (auto& pose : prim->poses) {
+            opath.push_back(RobotState{
+                    wx + pose.x, wy + pose.y, normalize_angle(pose.theta) });
+        }
+    }
+
+    path = std::move(opath);
+    return true;
+}
+
+auto XYThetaLattice::getExtension(size_t class_code) -> Extension*
+{
+    if (class_code == GetClassCode<RobotPlanningSpace>() ||
+        class_code == GetClassCode<PointProjectionExtension>() ||
+        class_code == GetClassCode<PoseProjectionExtension>() ||
+        class_code == GetClassCode<ExtractRobotStateExtension>())
+    {
+        return this;
+    }
+    return nullptr;
+}
+
+void XYThetaLattice::GetSuccs(
+    int state_id,
+    std::vector<int>* succs,
+    std::vector<int>* costs)
+{
+    assert(state_id >= 0 && state_id < (int)m_states.size());
+
+    SMPL_DEBUG_NAMED(G_EXPANSIONS_LOG, "expanding state %d", state_id);
+
+    // goal state should be absorbing
+    if (state_id == m_goal_state_id) {
+        return;
+    }
+
+    // copy the coordinates; creating successors may grow the state table
+    auto x = m_states[state_id].x;
+    auto y = m_states[state_id].y;
+    auto heading = m_states[state_id].heading;
+
+    auto& prims = m_prims[heading];
+    for (size_t pidx = 0; pidx < prims.size(); ++pidx) {
+        auto& prim = prims[pidx];
+        if (!checkPrimitive(x, y, prim, (int)pidx)) {
+            continue;
+        }
+
+        auto sx = x + prim.dx;
+        auto sy = y + prim.dy;
+        if (isGoal(sx, sy, prim.end_heading)) {
+            succs->push_back(m_goal_state_id);
+        } else {
+            succs->push_back(getOrCreateState(sx, sy, prim.end_heading));
+        }
+        costs->push_back(prim.cost);
+    }
+}
+
+void XYThetaLattice::GetPreds(
+    int state_id,
+    std::vector<int>* preds,
+    std::vector<int>* costs)
+{
+    SMPL_WARN("GetPreds unimplemented");
+}
+
+void XYThetaLattice::PrintState(int state_id, bool verbose, FILE* fout)
+{
+    assert(state_id >= 0 && state_id < (int)m_states.size());
+
+    if (!fout) {
+        fout = stdout;
+    }
+
+    std::stringstream ss;
+    if (state_id == m_goal_state_id) {
+        ss << "<goal state: { " <<
+                m_goal_pose.x << ", " <<
+                m_goal_pose.y << ", " <<
+                m_goal_pose.theta << " }>";
+    } else {
+        auto& entry = m_states[state_id];
+        ss << "{ " << entry.state[0] << ", " << entry.state[1] << ", " <<
+                entry.state[2] << " }";
+    }
+
+    if (fout == stdout) {
+        SMPL_DEBUG_NAMED(G_LOG, "%s", ss.str().c_str());
+    } else if (fout == stderr) {
+        SMPL_WARN("%s", ss.str().c_str());
+    } else {
+        fprintf(fout, "%s\n", ss.str().c_str());
+    }
+}
+
+void XYThetaLattice::generatePrimitives()
+{
+    auto res = m_grid->resolution();
+    auto& footprint = m_params.footprint;
+
+    // distance from the origin to the farthest point on the footprint, used to
+    // sample turns in place finely enough
+    auto radius = res;
+    for (auto& v : footprint) {
+        radius = std::max(radius, v.norm());
+    }
+
+    auto num_headings = numHeadings();
+    auto stride = 16 / num_headings;
+
+    m_prims.assign(num_headings, std::vector<XYThetaPrimitive>());
+    m_footprint_cells.assign(num_headings, std::vector<Eigen::Vector2i>());
+
+    for (int h = 0; h < num_headings; ++h) {
+        auto theta = m_headings[h];
+        auto* dir = kHeadingDirs[h * stride];
+
+        auto& fcells = m_footprint_cells[h];
+        RasterizeFootprint(footprint, Pose2D(0.0, 0.0, theta), res, fcells);
+        std::sort(begin(fcells), end(fcells), CellLess);
+        fcells.erase(std::unique(begin(fcells), end(fcells)), end(fcells));
+
+        auto add_straight = [&](int k)
+        {
+            XYThetaPrimitive prim;
+            prim.start_heading = h;
+            prim.end_heading = h;
+            prim.dx = k * dir[0];
+            prim.dy = k * dir[1];
+            auto length = res * std::sqrt((double)(prim.dx * prim.dx + prim.dy * prim.dy));
+            auto samples = std::max(1, (int)std::ceil(length / (0.5 * res)));
+            for (int i = 1; i <= samples; ++i) {
+                auto alpha = (double)i / (double)samples;
+                prim.poses.emplace_back(
+                        alpha * res * prim.dx, alpha * res * prim.dy, theta);
+            }
+            auto cost = (double)m_params.cost_per_meter * length;
+            if (k < 0) {
+                cost *= m_params.reverse_cost_multiplier;
+            }
+            prim.cost = std::max(1, (int)std::round(cost));
+            SweepPrimitive(footprint, theta, res, prim);
+            m_prims[h].push_back(std::move(prim));
+        };
+
+        auto add_turn_in_place = [&](int dh)
+        {
+            XYThetaPrimitive prim;
+            prim.start_heading = h;
+            prim.end_heading = (h + dh + num_headings) % num_headings;
+            auto dtheta = shortest_angle_diff(m_headings[prim.end_heading], theta);
+            auto samples = std::max(1, (int)std::ceil(std::fabs(dtheta) * radius / (0.5 * res)));
+            for (int i = 1; i <= samples; ++i) {
+                auto alpha = (double)i / (double)samples;
+                prim.poses.emplace_back(0.0, 0.0, theta + alpha * dtheta);
+            }
+            prim.cost = std::max(1, (int)std::round(
+                    (double)m_params.cost_per_radian * std::fabs(dtheta)));
+            SweepPrimitive(footprint, theta, res, prim);
+            m_prims[h].push_back(std::move(prim));
+        };
+
+        // Find the shortest forward motion, composed of a straight segment
+        // and an arc no tighter than the minimum turning radius, that ends at
+        // a cell center with the neighboring heading.
+        auto add_arc = [&](int dh)
+        {
+            auto end_heading = (h + dh + num_headings) % num_headings;
+            auto end_theta = theta + shortest_angle_diff(m_headings[end_heading], theta);
+            auto start = Pose2D(0.0, 0.0, theta);
+
+            auto r = std::max(3, (int)std::ceil(2.0 * m_params.min_turning_radius / res) + 3);
+
+            UnicycleMotion best;
+            auto best_length = std::numeric_limits<double>::infinity();
+            auto best_dx = 0, best_dy = 0;
+            for (int dx = -r; dx <= r; ++dx) {
+            for (int dy = -r; dy <= r; ++dy) {
+                if (dx == 0 && dy == 0) {
+                    continue;
+                }
+                auto goal = Pose2D(res * dx, res * dy, end_theta);
+                auto motion = MakeUnicycleMotion(start, goal);
+                if (!motion.is_valid() ||
+                    motion.r == 0.0 ||
+                    std::fabs(motion.r) < m_params.min_turning_radius ||
+                    motion.l < 0.0 ||
+                    motion.v <= 0.0)
+                {
+                    continue;
+                }
+
+                // reject motions that do not arrive at the goal, e.g. those
+                // that loop around
+                auto end = motion(1.0);
+                if (std::fabs(end.x - goal.x) > 1e-6 ||
+                    std::fabs(end.y - goal.y) > 1e-6 ||
+                    std::fabs(end.theta - goal.theta) > 1e-6)
+                {
+                    continue;
+                }
+
+                auto length = motion.length();
+                if (length < best_length) {
+                    best_length = length;
+                    best = motion;
+                    best_dx = dx;
+                    best_dy = dy;
+                }
+            }
+            }
+
+            if (best_length == std::numeric_limits<double>::infinity()) {
+                SMPL_WARN_NAMED(G_LOG, "No arc primitive from heading %d to heading %d", h, end_heading);
+                return;
+            }
+
+            XYThetaPrimitive prim;
+            prim.start_heading = h;
+            prim.end_heading = end_heading;
+            prim.dx = best_dx;
+            prim.dy = best_dy;
+            auto samples = std::max(1, (int)std::ceil(best_length / (0.5 * res)));
+            for (int i = 1; i < samples; ++i) {
+                prim.poses.push_back(best((double)i / (double)samples));
+            }
+            prim.poses.emplace_back(res * best_dx, res * best_dy, end_theta);
+            prim.cost = std::max(1, (int)std::round(
+                    (double)m_params.cost_per_meter * best_length));
+            SweepPrimitive(footprint, theta, res, prim);
+            m_prims[h].push_back(std::move(prim));
+        };
+
+        add_straight(1);
+        if (m_params.long_primitive_cells > 1) {
+            auto dir_len = std::sqrt((double)(dir[0] * dir[0] + dir[1] * dir[1]));
+            auto k = (int)std::round((double)m_params.long_primitive_cells / dir_len);
+            if (k > 1) {
+                add_straight(k);
+            }
+        }
+        if (m_params.allow_reverse) {
+            add_straight(-1);
+        }
+        add_arc(1);
+        add_arc(-1);
+        if (m_params.allow_turn_in_place) {
+            add_turn_in_place(1);
+            add_turn_in_place(-1);
+        }
+    }
+
+    m_prim_offsets.assign(num_headings, std::vector<std::vector<int>>());
+    auto count = 0;
+    for (int h = 0; h < num_headings; ++h) {
+        for (auto& prim : m_prims[h]) {
+            std::vector<int> offsets;
+            offsets.reserve(prim.cells.size());
+            for (auto& cell : prim.cells) {
+                offsets.push_back(cell.y() * m_num_cells_x + cell.x());
+            }
+            m_prim_offsets[h].push_back(std::move(offsets));
+            ++count;
+        }
+    }
+
+    SMPL_DEBUG_NAMED(G_LOG, "Generated %d primitives for %d headings", count, num_headings);
+}
+
+bool XYThetaLattice::isCellFree(int index)
+{
+    auto status = m_cell_status[index];
+    if (status == Unknown) {
+        auto x = index % m_num_cells_x;
+        auto y = index / m_num_cells_x;
+        auto d = m_grid->getDistance(x, y, m_params.grid_z);
+        status = d > m_params.padding ? Free : Blocked;
+        m_cell_status[index] = status;
+    }
+    return status == Free;
+}
+
+bool XYThetaLattice::checkPrimitive(
+    int x, int y,
+    const XYThetaPrimitive& prim,
+    int pidx)
+{
+    if (x + prim.min_cell.x() < 0 || x + prim.max_cell.x() >= m_num_cells_x ||
+        y + prim.min_cell.y() < 0 || y + prim.max_cell.y() >= m_num_cells_y)
+    {
+        return false;
+    }
+
+    auto base = y * m_num_cells_x + x;
+    for (auto offset : m_prim_offsets[prim.start_heading][pidx]) {
+        if (!isCellFree(base + offset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool XYThetaLattice::isGoal(int x, int y, int heading) const
+{
+    double wx, wy;
+    cellToWorld(x, y, wx, wy);
+    return std::fabs(wx - m_goal_pose.x) <= m_goal_tolerance.x &&
+            std::fabs(wy - m_goal_pose.y) <= m_goal_tolerance.y &&
+            shortest_angle_dist(m_headings[heading], m_goal_pose.theta) <=
+                    m_goal_tolerance.theta;
+}
+
+auto XYThetaLattice::stateKey(int x, int y, int heading) const -> std::int64_t
+{
+    auto cell = (std::int64_t)y * m_num_cells_x + x;
+    return cell * numHeadings() + heading;
+}
+
+int XYThetaLattice::getOrCreateState(int x, int y, int heading)
+{
+    auto key = stateKey(x, y, heading);
+    auto it = m_state_to_id.find(key);
+    if (it != m_state_to_id.end()) {
+        return it->second;
+    }
+
+    auto state_id = reserveState();
+    auto& entry = m_states[state_id];
+    entry.x = x;
+    entry.y = y;
+    entry.heading = heading;
+    entry.state.resize(3);
+    cellToWorld(x, y, entry.state[0], entry.state[1]);
+    entry.state[2] = m_headings[heading];
+
+    m_state_to_id[key] = state_id;
+    return state_id;
+}
+
+int XYThetaLattice::reserveState()
+{
+    auto state_id = (int)m_states.size();
+    m_states.emplace_back();
+
+    auto* pinds = new int[NUMOFINDICES_STATEID2IND];
+    std::fill(pinds, pinds + NUMOFINDICES_STATEID2IND, -1);
+    StateID2IndexMapping.push_back(pinds);
+
+    return state_id;
+}
+
+void XYThetaLattice::cellToWorld(int x, int y, double& wx, double& wy) const
+{
+    double wz;
+    m_grid->gridToWorld(x, y, m_params.grid_z, wx, wy, wz);
+}
+
+void XYThetaLattice::worldToCell(double wx, double wy, int& x, int& y) const
+{
+    int z;
+    m_grid->worldToGrid(wx, wy, 0.0, x, y, z);
+}
+
+// Return the least-cost valid primitive that takes one state to another, or to
+// any goal state if to_id is the goal state.
+auto XYThetaLattice::findPrimitive(int from_id, int to_id)
+    -> const XYThetaPrimitive*
+{
+    auto& from = m_states[from_id];
+    auto goal_edge = (to_id == m_goal_state_id);
+
+    const XYThetaPrimitive* best = NULL;
+    auto& prims = m_prims[from.heading];
+    for (size_t pidx = 0; pidx < prims.size(); ++pidx) {
+        auto& prim = prims[pidx];
+        auto sx = from.x + prim.dx;
+        auto sy = from.y + prim.dy;
+        if (goal_edge) {
+            if (!isGoal(sx, sy, prim.end_heading)) {
+                continue;
+            }
+        } else {
+            auto& to = m_states[to_id];
+            if (to.x != sx || to.y != sy || to.heading != prim.end_heading) {
+                continue;
+            }
+        }
+
+        if (best != NULL && best->cost <= prim.cost) {
+            continue;
+        }
+
+        if (!checkPrimitive(from.x, from.y, prim, (int)pidx)) {
+            continue;
+        }
+
+        best = &prim;
+    }
+
+    return best;
+}
+
+} // namespace smpl
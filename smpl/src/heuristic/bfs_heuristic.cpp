@@ -64,6 +64,18 @@ bool BfsHeuristic::init(RobotPlanningSpace* space, const OccupancyGrid* grid)
     if (m_pp != NULL) {
         SMPL_INFO_NAMED(LOG, "Got Point Projection Extension!");
     }
+
+    // project through a private context so that this heuristic may be
+    // evaluated concurrently with others that share the planning space
+    m_projection.reset();
+    auto* contexts = space->getExtension<ProjectionContextExtension>();
+    if (contexts != NULL) {
+        m_projection = contexts->createProjectionContext();
+        if (m_projection) {
+            SMPL_INFO_NAMED(LOG, "Got Projection Context!");
+            m_pp = m_projection.get();
+        }
+    }
     syncGridAndBfs();
 
     return true;
@@ -79,6 +91,22 @@ void BfsHeuristic::setCostPerCell(int cost_per_cell)
     m_cost_per_cell = cost_per_cell;
 }
 
+void BfsHeuristic::setLazyEvaluation(bool lazy)
+{
+    m_lazy = lazy;
+    if (m_bfs) {
+        m_bfs->setLazy(lazy);
+    }
+}
+
+void BfsHeuristic::setPrecomputeBudget(int expansions)
+{
+    m_precompute_budget = expansions;
+    if (m_bfs) {
+        m_bfs->setPrecomputeBudget(expansions);
+    }
+}
+
 void BfsHeuristic::updateGoal(const GoalConstraint& goal)
 {
     switch (goal.type) {
@@ -185,6 +213,11 @@ Extension* BfsHeuristic::getExtension(size_t class_code)
     if (class_code == GetClassCode<RobotHeuristic>()) {
         return this;
     }
+    if (class_code == GetClassCode<ConcurrentHeuristicExtension>() &&
+        m_projection)
+    {
+        return this;
+    }
     return nullptr;
 }
 
@@ -391,6 +424,8 @@ void BfsHeuristic::syncGridAndBfs()
     const int zc = grid()->numCellsZ();
 //    SMPL_DEBUG_NAMED(LOG, "Initializing BFS of size %d x %d x %d = %d", xc, yc, zc, xc * yc * zc);
     m_bfs.reset(new BFS_3D(xc, yc, zc));
+    m_bfs->setLazy(m_lazy);
+    m_bfs->setPrecomputeBudget(m_precompute_budget);
     const int cell_count = xc * yc * zc;
     int wall_count = 0;
     for (int x = 0; x < xc; ++x) {
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/heuristic/cached_heuristic.h>
+
+// project includes
+#include <smpl/console/console.h>
+
+namespace smpl {
+
+static const char* LOG = "heuristic.cached";
+
+const int CachedHeuristic::Unknown;
+
+bool CachedHeuristic::init(RobotPlanningSpace* space, RobotHeuristic* h)
+{
+    if (!h) {
+        return false;
+    }
+
+    if (!RobotHeuristic::init(space)) {
+        return false;
+    }
+
+    m_orig_h = h;
+    invalidate();
+    resetStats();
+    return true;
+}
+
+void CachedHeuristic::invalidate()
+{
+    m_goal_values.clear();
+    m_start_values.clear();
+}
+
+double CachedHeuristic::hitRate() const
+{
+    auto lookups = m_hits + m_misses;
+    if (lookups == 0) {
+        return 0.0;
+    }
+    return (double)m_hits / (double)lookups;
+}
+
+void CachedHeuristic::resetStats()
+{
+    m_hits = 0;
+    m_misses = 0;
+}
+
+double CachedHeuristic::getMetricStartDistance(double x, double y, double z)
+{
+    return m_orig_h->getMetricStartDistance(x, y, z);
+}
+
+double CachedHeuristic::getMetricGoalDistance(double x, double y, double z)
+{
+    return m_orig_h->getMetricGoalDistance(x, y, z);
+}
+
+Extension* CachedHeuristic::getExtension(size_t class_code)
+{
+    if (class_code == GetClassCode<RobotHeuristic>()) {
+        return this;
+    }
+    return m_orig_h->getExtension(class_code);
+}
+
+void CachedHeuristic::updateStart(const RobotState& state)
+{
+    m_orig_h->updateStart(state);
+    m_start_values.clear();
+}
+
+void CachedHeuristic::updateGoal(const GoalConstraint& goal)
+{
+    SMPL_DEBUG_NAMED(LOG, "Invalidate cached goal heuristics (%zu states, hit rate = %0.3f)", m_goal_values.size(), hitRate());
+    m_orig_h->updateGoal(goal);
+    m_goal_values.clear();
+    resetStats();
+}
+
+int CachedHeuristic::GetGoalHeuristic(int state_id)
+{
+    if (state_id < 0) {
+        ++m_misses;
+        return m_orig_h->GetGoalHeuristic(state_id);
+    }
+
+    if (state_id >= (int)m_goal_values.size()) {
+        m_goal_values.resize(state_id + 1, Unknown);
+    }
+
+    if (m_goal_values[state_id] == Unknown) {
+        ++m_misses;
+        m_goal_values[state_id] = m_orig_h->GetGoalHeuristic(state_id);
+    } else {
+        ++m_hits;
+    }
+    return m_goal_values[state_id];
+}
+
+int CachedHeuristic::GetStartHeuristic(int state_id)
+{
+    if (state_id < 0) {
+        ++m_misses;
+        return m_orig_h->GetStartHeuristic(state_id);
+    }
+
+    if (state_id >= (int)m_start_values.size()) {
+        m_start_values.resize(state_id + 1, Unknown);
+    }
+
+    if (m_start_values[state_id] == Unknown) {
+        ++m_misses;
+        m_start_values[state_id] = m_orig_h->GetStartHeuristic(state_id);
+    } else {
+        ++m_hits;
+    }
+    return m_start_values[state_id];
+}
+
+int CachedHeuristic::GetFromToHeuristic(int from_id, int to_id)
+{
+    return m_orig_h->GetFromToHeuristic(from_id, to_id);
+}
+
+} // namespace smpl
@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/heuristic/dijkstra_2d_heuristic.h>
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// project includes
+#include <smpl/console/console.h>
+#include <smpl/occupancy_grid.h>
+
+namespace smpl {
+
+static const char* LOG = "heuristic.dijkstra_2d";
+
+bool Dijkstra2DHeuristic::init(
+    RobotPlanningSpace* space,
+    const OccupancyGrid* grid)
+{
+    if (!RobotHeuristic::init(space)) {
+        return false;
+    }
+
+    if (grid == NULL) {
+        return false;
+    }
+
+    m_grid = grid;
+
+    m_pp = space->getExtension<PointProjectionExtension>();
+    if (m_pp != NULL) {
+        SMPL_INFO_NAMED(LOG, "Got Point Projection Extension!");
+    }
+
+    m_num_cells_x = grid->numCellsX();
+    m_num_cells_y = grid->numCellsY();
+
+    auto num_cells = (size_t)m_num_cells_x * (size_t)m_num_cells_y;
+    m_costs.assign(num_cells, std::numeric_limits<int>::max());
+    m_status.assign(num_cells, Unknown);
+    m_open = decltype(m_open)();
+    m_expanded_count = 0;
+
+    updateMoves();
+
+    return true;
+}
+
+void Dijkstra2DHeuristic::setInflationRadius(double radius)
+{
+    m_inflation_radius = radius;
+}
+
+void Dijkstra2DHeuristic::setCostPerMeter(int cost)
+{
+    m_cost_per_meter = cost;
+    updateMoves();
+}
+
+void Dijkstra2DHeuristic::updateGoal(const GoalConstraint& goal)
+{
+    std::fill(begin(m_costs), end(m_costs), std::numeric_limits<int>::max());
+    std::fill(begin(m_status), end(m_status), Unknown);
+    m_open = decltype(m_open)();
+    m_expanded_count = 0;
+
+    double tol_x, tol_y;
+    switch (goal.type) {
+    case GoalType::XYZ_GOAL:
+    case GoalType::XYZ_RPY_GOAL:
+        tol_x = goal.xyz_tolerance[0];
+        tol_y = goal.xyz_tolerance[1];
+        break;
+    case GoalType::JOINT_STATE_GOAL:
+        // assumes the planning space has initialized the goal pose, as
+        // XYThetaLattice does
+        tol_x = goal.angle_tolerances.size() > 0 ? goal.angle_tolerances[0] : 0.0;
+        tol_y = goal.angle_tolerances.size() > 1 ? goal.angle_tolerances[1] : 0.0;
+        break;
+    default:
+        SMPL_ERROR_NAMED(LOG, "Unsupported goal type in Dijkstra 2D Heuristic");
+        return;
+    }
+
+    // seed the search with every cell in the goal region
+    auto& p = goal.pose.translation();
+    int min_x, min_y, max_x, max_y, z;
+    grid()->worldToGrid(p.x() - tol_x, p.y() - tol_y, p.z(), min_x, min_y, z);
+    grid()->worldToGrid(p.x() + tol_x, p.y() + tol_y, p.z(), max_x, max_y, z);
+    m_layer = z;
+
+    min_x = std::max(min_x, 0);
+    min_y = std::max(min_y, 0);
+    max_x = std::min(max_x, m_num_cells_x - 1);
+    max_y = std::min(max_y, m_num_cells_y - 1);
+    if (min_x > max_x || min_y > max_y || !grid()->isInBounds(0, 0, m_layer)) {
+        SMPL_ERROR_NAMED(LOG, "Heuristic goal is out of bounds");
+        return;
+    }
+
+    for (int y = min_y; y <= max_y; ++y) {
+    for (int x = min_x; x <= max_x; ++x) {
+        auto index = y * m_num_cells_x + x;
+        m_costs[index] = 0;
+        m_status[index] = Open;
+        m_open.push(OpenEntry(0, index));
+    }
+    }
+
+    SMPL_DEBUG_NAMED(LOG, "Seeded Dijkstra with %zu goal cells", m_open.size());
+}
+
+double Dijkstra2DHeuristic::getMetricStartDistance(double x, double y, double z)
+{
+    if (!m_pp) {
+        return 0.0;
+    }
+
+    Vector3 p;
+    if (!m_pp->projectToPoint(planningSpace()->getStartStateID(), p)) {
+        return 0.0;
+    }
+
+    return std::sqrt((p.x() - x) * (p.x() - x) + (p.y() - y) * (p.y() - y));
+}
+
+double Dijkstra2DHeuristic::getMetricGoalDistance(double x, double y, double z)
+{
+    int gx, gy, gz;
+    grid()->worldToGrid(x, y, z, gx, gy, gz);
+    auto cost = getCellCost(gx, gy);
+    if (cost == Infinity) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return (double)cost / (double)m_cost_per_meter;
+}
+
+Extension* Dijkstra2DHeuristic::getExtension(size_t class_code)
+{
+    if (class_code == GetClassCode<RobotHeuristic>()) {
+        return this;
+    }
+    return nullptr;
+}
+
+int Dijkstra2DHeuristic::GetGoalHeuristic(int state_id)
+{
+    if (state_id == planningSpace()->getGoalStateID()) {
+        return 0;
+    }
+
+    if (m_pp == NULL) {
+        return 0;
+    }
+
+    Vector3 p;
+    if (!m_pp->projectToPoint(state_id, p)) {
+        return 0;
+    }
+
+    int gx, gy, gz;
+    grid()->worldToGrid(p.x(), p.y(), p.z(), gx, gy, gz);
+    return getCellCost(gx, gy);
+}
+
+int Dijkstra2DHeuristic::GetStartHeuristic(int state_id)
+{
+    SMPL_WARN_ONCE("Dijkstra2DHeuristic::GetStartHeuristic unimplemented");
+    return 0;
+}
+
+int Dijkstra2DHeuristic::GetFromToHeuristic(int from_id, int to_id)
+{
+    if (to_id == planningSpace()->getGoalStateID()) {
+        return GetGoalHeuristic(from_id);
+    } else {
+        SMPL_WARN_ONCE("Dijkstra2DHeuristic::GetFromToHeuristic unimplemented for arbitrary state pair");
+        return 0;
+    }
+}
+
+void Dijkstra2DHeuristic::updateMoves()
+{
+    auto res = m_grid != NULL ? m_grid->resolution() : 1.0;
+    m_moves.clear();
+    for (int dx = -2; dx <= 2; ++dx) {
+    for (int dy = -2; dy <= 2; ++dy) {
+        auto adx = std::abs(dx);
+        auto ady = std::abs(dy);
+        // the 8 neighbors and the 8 (1, 2) and (2, 1) moves
+        if ((adx | ady) == 0 || (adx == 2 && ady != 1) || (ady == 2 && adx != 1)) {
+            continue;
+        }
+        auto length = res * std::sqrt((double)(dx * dx + dy * dy));
+        auto cost = std::max(1, (int)std::round((double)m_cost_per_meter * length));
+        m_moves.push_back(Move{ dx, dy, cost });
+    }
+    }
+}
+
+// Return the cost from a cell to the goal, advancing the search until the
+// cell's cost is final or the search is exhausted.
+int Dijkstra2DHeuristic::getCellCost(int x, int y)
+{
+    if (x < 0 || x >= m_num_cells_x || y < 0 || y >= m_num_cells_y) {
+        return Infinity;
+    }
+
+    auto target = y * m_num_cells_x + x;
+
+    while (m_status[target] != Closed && !m_open.empty()) {
+        auto top = m_open.top();
+        m_open.pop();
+
+        auto index = top.second;
+        if (m_status[index] == Closed || top.first > m_costs[index]) {
+            continue; // stale entry
+        }
+        m_status[index] = Closed;
+        ++m_expanded_count;
+
+        auto cx = index % m_num_cells_x;
+        auto cy = index / m_num_cells_x;
+        for (auto& move : m_moves) {
+            auto nx = cx + move.dx;
+            auto ny = cy + move.dy;
+            if (nx < 0 || nx >= m_num_cells_x || ny < 0 || ny >= m_num_cells_y) {
+                continue;
+            }
+
+            auto nindex = ny * m_num_cells_x + nx;
+            auto status = m_status[nindex];
+            if (status == Closed || status == Wall) {
+                continue;
+            }
+
+            // test cells against the distance field once, when first reached
+            if (status == Unknown &&
+                grid()->getDistance(nx, ny, m_layer) <= m_inflation_radius)
+            {
+                m_status[nindex] = Wall;
+                continue;
+            }
+
+            auto cost = top.first + move.cost;
+            if (cost < m_costs[nindex]) {
+                m_costs[nindex] = cost;
+                m_status[nindex] = Open;
+                m_open.push(OpenEntry(cost, nindex));
+            }
+        }
+    }
+
+    if (m_status[target] != Closed) {
+        return Infinity;
+    }
+    return m_costs[target];
+}
+
+} // namespace smpl
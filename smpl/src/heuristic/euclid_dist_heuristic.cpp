@@ -71,6 +71,19 @@ bool EuclidDistHeuristic::init(RobotPlanningSpace* space)
         SMPL_WARN_NAMED(LOG, "EuclidDistHeuristic recommends PointProjectionExtension or PoseProjectionExtension");
     }
 
+    // project through a private context so that this heuristic may be
+    // evaluated concurrently with others that share the planning space
+    m_projection.reset();
+    auto* contexts = space->getExtension<ProjectionContextExtension>();
+    if (contexts) {
+        m_projection = contexts->createProjectionContext();
+        if (m_projection) {
+            SMPL_INFO_NAMED(LOG, "Got Projection Context!");
+            m_pose_ext = m_projection.get();
+            m_point_ext = m_projection.get();
+        }
+    }
+
     return true;
 }
 
@@ -115,6 +128,11 @@ Extension* EuclidDistHeuristic::getExtension(size_t class_code)
     if (class_code == GetClassCode<RobotHeuristic>()) {
         return this;
     }
+    if (class_code == GetClassCode<ConcurrentHeuristicExtension>() &&
+        m_projection)
+    {
+        return this;
+    }
     return nullptr;
 }
 
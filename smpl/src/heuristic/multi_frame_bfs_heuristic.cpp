@@ -96,6 +96,24 @@ void MultiFrameBfsHeuristic::setCostPerCell(int cost)
     m_cost_per_cell = cost;
 }
 
+void MultiFrameBfsHeuristic::setLazyEvaluation(bool lazy)
+{
+    m_lazy = lazy;
+    if (m_bfs) {
+        m_bfs->setLazy(lazy);
+        m_ee_bfs->setLazy(lazy);
+    }
+}
+
+void MultiFrameBfsHeuristic::setPrecomputeBudget(int expansions)
+{
+    m_precompute_budget = expansions;
+    if (m_bfs) {
+        m_bfs->setPrecomputeBudget(expansions);
+        m_ee_bfs->setPrecomputeBudget(expansions);
+    }
+}
+
 Extension* MultiFrameBfsHeuristic::getExtension(size_t class_code)
 {
     if (class_code == GetClassCode<RobotHeuristic>()) {
@@ -340,6 +358,10 @@ void MultiFrameBfsHeuristic::syncGridAndBfs()
     const int zc = grid()->numCellsZ();
     m_bfs.reset(new BFS_3D(xc, yc, zc));
     m_ee_bfs.reset(new BFS_3D(xc, yc, zc));
+    m_bfs->setLazy(m_lazy);
+    m_ee_bfs->setLazy(m_lazy);
+    m_bfs->setPrecomputeBudget(m_precompute_budget);
+    m_ee_bfs->setPrecomputeBudget(m_precompute_budget);
     const int cell_count = xc * yc * zc;
     int wall_count = 0;
     for (int z = 0; z < zc; ++z) {
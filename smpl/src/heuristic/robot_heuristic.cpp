@@ -31,6 +31,8 @@
 
 #include <smpl/heuristic/robot_heuristic.h>
 
+#include <algorithm>
+
 #include <smpl/console/console.h>
 
 namespace smpl {
@@ -50,4 +52,38 @@ RobotHeuristic::~RobotHeuristic()
 {
 }
 
+void PartitionConcurrentHeuristics(
+    Heuristic* const* heuristics,
+    int count,
+    std::vector<std::vector<int>>& groups)
+{
+    groups.clear();
+
+    std::vector<int> serial;
+    std::vector<Heuristic*> grouped; // first heuristic of each group
+    for (int i = 0; i < count; ++i) {
+        auto* ext = dynamic_cast<Extension*>(heuristics[i]);
+        if (ext == nullptr ||
+            ext->getExtension<ConcurrentHeuristicExtension>() == nullptr)
+        {
+            serial.push_back(i);
+            continue;
+        }
+
+        // the same heuristic may be passed more than once, e.g. as both the
+        // anchor and an inadmissible heuristic, and must stay on one thread
+        auto it = std::find(grouped.begin(), grouped.end(), heuristics[i]);
+        if (it != grouped.end()) {
+            groups[it - grouped.begin()].push_back(i);
+        } else {
+            grouped.push_back(heuristics[i]);
+            groups.push_back(std::vector<int>(1, i));
+        }
+    }
+
+    if (!serial.empty()) {
+        groups.insert(groups.begin(), std::move(serial));
+    }
+}
+
 } // namespace smpl
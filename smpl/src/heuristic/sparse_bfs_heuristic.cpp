@@ -0,0 +1,507 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+#include <smpl/heuristic/sparse_bfs_heuristic.h>
+
+// standard includes
+#include <unordered_set>
+
+// project includes
+#include <smpl/console/console.h>
+#include <smpl/debug/colors.h>
+#include <smpl/debug/marker_utils.h>
+#include <smpl/occupancy_grid.h>
+
+namespace smpl {
+
+static const char* LOG = "heuristic.sparse_bfs";
+
+const int SparseBfsHeuristic::Unknown;
+const int SparseBfsHeuristic::Wall;
+
+bool SparseBfsHeuristic::init(
+    RobotPlanningSpace* space,
+    const OccupancyGrid* grid)
+{
+    if (!RobotHeuristic::init(space)) {
+        return false;
+    }
+
+    if (grid == NULL) {
+        return false;
+    }
+
+    m_grid = grid;
+
+    m_pp = space->getExtension<PointProjectionExtension>();
+    if (m_pp != NULL) {
+        SMPL_INFO_NAMED(LOG, "Got Point Projection Extension!");
+    }
+
+    m_dist_grid.resize(
+            grid->numCellsX(), grid->numCellsY(), grid->numCellsZ(), Unknown);
+    m_open.clear();
+    m_goal_cells.clear();
+    m_discovered_count = 0;
+
+    SMPL_DEBUG_NAMED(LOG, "Create sparse bfs grid of size %d x %d x %d", grid->numCellsX(), grid->numCellsY(), grid->numCellsZ());
+
+    return true;
+}
+
+void SparseBfsHeuristic::setInflationRadius(double radius)
+{
+    m_inflation_radius = radius;
+}
+
+void SparseBfsHeuristic::setCostPerCell(int cost_per_cell)
+{
+    m_cost_per_cell = cost_per_cell;
+}
+
+void SparseBfsHeuristic::updateGoal(const GoalConstraint& goal)
+{
+    // discard the previous wavefront; cells are recomputed as they are
+    // requested by the search
+    m_dist_grid.reset(Unknown);
+    m_open.clear();
+    m_goal_cells.clear();
+    m_discovered_count = 0;
+
+    auto add_goal_cell = [&](const Vector3& p)
+    {
+        Eigen::Vector3i gp;
+        grid()->worldToGrid(p.x(), p.y(), p.z(), gp.x(), gp.y(), gp.z());
+
+        SMPL_DEBUG_NAMED(LOG, "Setting the sparse BFS heuristic goal (%d, %d, %d)", gp.x(), gp.y(), gp.z());
+
+        if (!grid()->isInBounds(gp.x(), gp.y(), gp.z())) {
+            SMPL_ERROR_NAMED(LOG, "Heuristic goal is out of BFS bounds");
+            return;
+        }
+
+        if (m_dist_grid.get(gp.x(), gp.y(), gp.z()) == 0) {
+            return; // duplicate goal cell
+        }
+
+        m_dist_grid.set(gp.x(), gp.y(), gp.z(), 0);
+        m_open.push_back(gp);
+        m_goal_cells.push_back(gp);
+        ++m_discovered_count;
+    };
+
+    switch (goal.type) {
+    case GoalType::XYZ_GOAL:
+    case GoalType::XYZ_RPY_GOAL:
+    case GoalType::JOINT_STATE_GOAL:
+        // TODO: as with BfsHeuristic, this assumes goal.pose is initialized
+        // for joint state goals
+        add_goal_cell(goal.pose.translation());
+        break;
+    case GoalType::MULTIPLE_POSE_GOAL:
+        for (auto& goal_pose : goal.poses) {
+            add_goal_cell(goal_pose.translation());
+        }
+        break;
+    case GoalType::USER_GOAL_CONSTRAINT_FN:
+    default:
+        SMPL_ERROR_NAMED(LOG, "Unsupported goal type in Sparse BFS Heuristic");
+        break;
+    }
+}
+
+double SparseBfsHeuristic::getMetricStartDistance(double x, double y, double z)
+{
+    if (!m_pp) {
+        return 0.0;
+    }
+
+    Vector3 p;
+    if (!m_pp->projectToPoint(planningSpace()->getStartStateID(), p)) {
+        return 0.0;
+    }
+
+    int sx, sy, sz;
+    grid()->worldToGrid(p.x(), p.y(), p.z(), sx, sy, sz);
+
+    int gx, gy, gz;
+    grid()->worldToGrid(x, y, z, gx, gy, gz);
+
+    // compute the manhattan distance to the start cell
+    const int dx = sx - gx;
+    const int dy = sy - gy;
+    const int dz = sz - gz;
+    return grid()->resolution() * (abs(dx) + abs(dy) + abs(dz));
+}
+
+double SparseBfsHeuristic::getMetricGoalDistance(double x, double y, double z)
+{
+    int gx, gy, gz;
+    grid()->worldToGrid(x, y, z, gx, gy, gz);
+    const int d = getCellDistance(gx, gy, gz);
+    if (d == Wall) {
+        return (double)Wall * grid()->resolution();
+    } else {
+        return (double)d * grid()->resolution();
+    }
+}
+
+Extension* SparseBfsHeuristic::getExtension(size_t class_code)
+{
+    if (class_code == GetClassCode<RobotHeuristic>()) {
+        return this;
+    }
+    return nullptr;
+}
+
+int SparseBfsHeuristic::GetGoalHeuristic(int state_id)
+{
+    if (m_pp == NULL) {
+        return 0;
+    }
+
+    Vector3 p;
+    if (!m_pp->projectToPoint(state_id, p)) {
+        return 0;
+    }
+
+    Eigen::Vector3i dp;
+    grid()->worldToGrid(p.x(), p.y(), p.z(), dp.x(), dp.y(), dp.z());
+
+    return getBfsCostToGoal(dp.x(), dp.y(), dp.z());
+}
+
+int SparseBfsHeuristic::GetStartHeuristic(int state_id)
+{
+    SMPL_WARN_ONCE("SparseBfsHeuristic::GetStartHeuristic unimplemented");
+    return 0;
+}
+
+int SparseBfsHeuristic::GetFromToHeuristic(int from_id, int to_id)
+{
+    if (to_id == planningSpace()->getGoalStateID()) {
+        return GetGoalHeuristic(from_id);
+    } else {
+        SMPL_WARN_ONCE("SparseBfsHeuristic::GetFromToHeuristic unimplemented for arbitrary state pair");
+        return 0;
+    }
+}
+
+auto SparseBfsHeuristic::getWallsVisualization() -> visual::Marker
+{
+    // Only walls encountered by the wavefront are recorded in the distance
+    // grid. Visualizing every wall in the grid would require a pass over the
+    // entire workspace, which this heuristic exists to avoid.
+    std::vector<Vector3> centers;
+    auto collect_walls = [&](
+        int value,
+        size_t xfirst, size_t yfirst, size_t zfirst,
+        size_t xlast, size_t ylast, size_t zlast)
+    {
+        if (value != Wall) {
+            return;
+        }
+        xlast = std::min(xlast, (size_t)grid()->numCellsX());
+        ylast = std::min(ylast, (size_t)grid()->numCellsY());
+        zlast = std::min(zlast, (size_t)grid()->numCellsZ());
+        for (size_t x = xfirst; x < xlast; ++x) {
+        for (size_t y = yfirst; y < ylast; ++y) {
+        for (size_t z = zfirst; z < zlast; ++z) {
+            Vector3 p;
+            grid()->gridToWorld(x, y, z, p.x(), p.y(), p.z());
+            centers.push_back(p);
+        }
+        }
+        }
+    };
+    m_dist_grid.accept_coords(collect_walls);
+
+    SMPL_DEBUG_NAMED(LOG, "BFS Visualization contains %zu points", centers.size());
+
+    visual::Color color;
+    color.r = 100.0f / 255.0f;
+    color.g = 149.0f / 255.0f;
+    color.b = 238.0f / 255.0f;
+    color.a = 1.0f;
+
+    return visual::MakeCubesMarker(
+            centers,
+            grid()->resolution(),
+            color,
+            grid()->getReferenceFrame(),
+            "bfs_walls");
+}
+
+auto SparseBfsHeuristic::getValuesVisualization() -> visual::Marker
+{
+    if (m_goal_cells.empty()) {
+        return visual::MakeEmptyMarker();
+    }
+
+    // this will flush the bfs to a little past the start, but this would be
+    // done by the search hereafter anyway
+    int start_heur = GetGoalHeuristic(planningSpace()->getStartStateID());
+    if (start_heur == Infinity) {
+        return visual::MakeEmptyMarker();
+    }
+
+    const int max_cost = (int)(1.1 * start_heur);
+
+    SMPL_INFO_NAMED(LOG, "Get visualization of cells up to cost %d", max_cost);
+
+    std::vector<Vector3> points;
+    std::vector<visual::Color> colors;
+
+    auto clamp = [](double d, double lo, double hi) {
+        if (d < lo) {
+            return lo;
+        } else if (d > hi) {
+            return hi;
+        } else {
+            return d;
+        }
+    };
+
+    // only visualize cells the wavefront has already reached
+    auto collect_values = [&](
+        int value,
+        size_t xfirst, size_t yfirst, size_t zfirst,
+        size_t xlast, size_t ylast, size_t zlast)
+    {
+        if (value == Wall || value == Unknown) {
+            return;
+        }
+
+        const int cost = m_cost_per_cell * value;
+        if (cost > max_cost) {
+            return;
+        }
+
+        double cost_pct = (double)cost / (double)max_cost;
+        visual::Color color = visual::MakeColorHSV(300.0 - 300.0 * cost_pct);
+        color.r = clamp(color.r, 0.0f, 1.0f);
+        color.g = clamp(color.g, 0.0f, 1.0f);
+        color.b = clamp(color.b, 0.0f, 1.0f);
+        color.a = 1.0f;
+
+        xlast = std::min(xlast, (size_t)grid()->numCellsX());
+        ylast = std::min(ylast, (size_t)grid()->numCellsY());
+        zlast = std::min(zlast, (size_t)grid()->numCellsZ());
+        for (size_t x = xfirst; x < xlast; ++x) {
+        for (size_t y = yfirst; y < ylast; ++y) {
+        for (size_t z = zfirst; z < zlast; ++z) {
+            Vector3 p;
+            grid()->gridToWorld(x, y, z, p.x(), p.y(), p.z());
+            points.push_back(p);
+            colors.push_back(color);
+        }
+        }
+        }
+    };
+    m_dist_grid.accept_coords(collect_values);
+
+    return visual::MakeCubesMarker(
+            std::move(points),
+            0.5 * grid()->resolution(),
+            std::move(colors),
+            grid()->getReferenceFrame(),
+            "bfs_values");
+}
+
+bool SparseBfsHeuristic::isWallCell(int x, int y, int z) const
+{
+    return !grid()->isInBounds(x, y, z) ||
+            grid()->getDistance(x, y, z) <= m_inflation_radius;
+}
+
+// Return the distance, in cells, from the nearest goal cell, advancing the
+// wavefront until the cell has been discovered or is found to be unreachable.
+int SparseBfsHeuristic::getCellDistance(int x, int y, int z)
+{
+    if (!grid()->isInBounds(x, y, z)) {
+        return Wall;
+    }
+
+    int d = m_dist_grid.get(x, y, z);
+    if (d != Unknown) {
+        return d;
+    }
+
+    if (isWallCell(x, y, z)) {
+        m_dist_grid.set(x, y, z, Wall);
+        return Wall;
+    }
+
+    // Flood fill the free region around the cell, one cell for every cell
+    // expanded by the wavefront. If the region is exhausted before it touches
+    // a discovered cell, the cell is unreachable, and is found so after
+    // visiting only its own region rather than the entire wavefront.
+    std::deque<Eigen::Vector3i> region_open;
+    std::vector<Eigen::Vector3i> region;
+    std::unordered_set<int> region_cells;
+    auto connected = false;
+
+    auto cell_index = [&](int cx, int cy, int cz) {
+        return (cz * grid()->numCellsY() + cy) * grid()->numCellsX() + cx;
+    };
+
+    region_open.push_back(Eigen::Vector3i(x, y, z));
+    region.push_back(Eigen::Vector3i(x, y, z));
+    region_cells.insert(cell_index(x, y, z));
+
+    int expand_count = 0;
+    while (!m_open.empty()) {
+        expandWavefrontCell();
+        ++expand_count;
+
+        d = m_dist_grid.get(x, y, z);
+        if (d != Unknown) {
+            break;
+        }
+
+        if (connected) {
+            continue;
+        }
+
+        if (region_open.empty()) {
+            SMPL_DEBUG_NAMED(LOG, "Cell (%d, %d, %d) is disconnected from the goal by a region of %zu cells", x, y, z, region.size());
+            for (auto& c : region) {
+                m_dist_grid.set(c.x(), c.y(), c.z(), Wall);
+            }
+            return Wall;
+        }
+
+        Eigen::Vector3i c = region_open.front();
+        region_open.pop_front();
+        for (int dx = -1; dx <= 1 && !connected; ++dx) {
+        for (int dy = -1; dy <= 1 && !connected; ++dy) {
+        for (int dz = -1; dz <= 1 && !connected; ++dz) {
+            if (!(dx | dy | dz)) {
+                continue;
+            }
+
+            const int nx = c.x() + dx;
+            const int ny = c.y() + dy;
+            const int nz = c.z() + dz;
+
+            if (!grid()->isInBounds(nx, ny, nz)) {
+                continue;
+            }
+
+            const int value = m_dist_grid.get(nx, ny, nz);
+            if (value == Wall) {
+                continue;
+            }
+            if (value != Unknown) {
+                // the wavefront will reach the cell through this one
+                connected = true;
+                continue;
+            }
+
+            if (isWallCell(nx, ny, nz)) {
+                m_dist_grid.set(nx, ny, nz, Wall);
+                continue;
+            }
+
+            if (region_cells.insert(cell_index(nx, ny, nz)).second) {
+                region_open.push_back(Eigen::Vector3i(nx, ny, nz));
+                region.push_back(Eigen::Vector3i(nx, ny, nz));
+            }
+        }
+        }
+        }
+    }
+
+    SMPL_DEBUG_NAMED(LOG, "Expanded %d cells to discover cell (%d, %d, %d)", expand_count, x, y, z);
+
+    if (d == Unknown) {
+        // the wavefront is exhausted and the cell was never reached; remember
+        // the cell as unreachable to avoid the lookup next time
+        m_dist_grid.set(x, y, z, Wall);
+        return Wall;
+    }
+
+    return d;
+}
+
+// Expand the next cell in the wavefront, discovering its neighbors.
+void SparseBfsHeuristic::expandWavefrontCell()
+{
+    Eigen::Vector3i c = m_open.front();
+    m_open.pop_front();
+
+    const int cost = m_dist_grid.get(c.x(), c.y(), c.z()) + 1;
+
+    for (int dx = -1; dx <= 1; ++dx) {
+    for (int dy = -1; dy <= 1; ++dy) {
+    for (int dz = -1; dz <= 1; ++dz) {
+        if (!(dx | dy | dz)) {
+            continue;
+        }
+
+        const int nx = c.x() + dx;
+        const int ny = c.y() + dy;
+        const int nz = c.z() + dz;
+
+        if (!grid()->isInBounds(nx, ny, nz)) {
+            continue;
+        }
+
+        if (m_dist_grid.get(nx, ny, nz) != Unknown) {
+            continue;
+        }
+
+        // mark walls as they are encountered so that they are only tested
+        // against the distance field once
+        if (isWallCell(nx, ny, nz)) {
+            m_dist_grid.set(nx, ny, nz, Wall);
+            continue;
+        }
+
+        m_dist_grid.set(nx, ny, nz, cost);
+        m_open.push_back(Eigen::Vector3i(nx, ny, nz));
+        ++m_discovered_count;
+    }
+    }
+    }
+}
+
+int SparseBfsHeuristic::getBfsCostToGoal(int x, int y, int z)
+{
+    const int d = getCellDistance(x, y, z);
+    if (d == Wall) {
+        return Infinity;
+    } else {
+        return m_cost_per_cell * d;
+    }
+}
+
+} // namespace smpl
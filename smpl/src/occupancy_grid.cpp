@@ -362,8 +362,8 @@ void OccupancyGrid::addPointsToField(
     const std::vector<Vector3>& points)
 {
     if (m_ref_counted) {
-        std::vector<Vector3> pts;
-        pts.reserve(points.size());
+        auto& pts = m_add_pts;
+        pts.clear();
         int gx, gy, gz;
         for (const Vector3& v : points) {
             worldToGrid(v.x(), v.y(), v.z(), gx, gy, gz);
@@ -390,8 +390,8 @@ void OccupancyGrid::removePointsFromField(
     const std::vector<Vector3>& points)
 {
     if (m_ref_counted) {
-        std::vector<Vector3> pts;
-        pts.reserve(points.size());
+        auto& pts = m_rem_pts;
+        pts.clear();
         int gx, gy, gz;
         for (const Vector3& v : points) {
             worldToGrid(v.x(), v.y(), v.z(), gx, gy, gz);
@@ -421,8 +421,46 @@ void OccupancyGrid::updatePointsInField(
     const std::vector<Vector3>& old_points,
     const std::vector<Vector3>& new_points)
 {
-    // TODO: ref counting
-    m_grid->updatePointsInMap(old_points, new_points);
+    if (m_ref_counted) {
+        // A cell whose count drops to zero and is then raised again appears
+        // in both sets and is left alone by the distance map.
+        auto& rem_pts = m_rem_pts;
+        auto& add_pts = m_add_pts;
+        rem_pts.clear();
+        add_pts.clear();
+        int gx, gy, gz;
+        for (const Vector3& v : old_points) {
+            worldToGrid(v.x(), v.y(), v.z(), gx, gy, gz);
+
+            if (isInBounds(gx, gy, gz)) {
+                int idx = coordToIndex(gx, gy, gz);
+
+                if (m_counts[idx] > 0) {
+                    --m_counts[idx];
+                    if (m_counts[idx] == 0) {
+                        rem_pts.emplace_back(v.x(), v.y(), v.z());
+                    }
+                }
+            }
+        }
+        for (const Vector3& v : new_points) {
+            worldToGrid(v.x(), v.y(), v.z(), gx, gy, gz);
+
+            if (isInBounds(gx, gy, gz)) {
+                const int idx = coordToIndex(gx, gy, gz);
+
+                if (m_counts[idx] == 0) {
+                    add_pts.emplace_back(v.x(), v.y(), v.z());
+                }
+
+                ++m_counts[idx];
+            }
+        }
+        m_grid->updatePointsInMap(rem_pts, add_pts);
+    }
+    else {
+        m_grid->updatePointsInMap(old_points, new_points);
+    }
 }
 
 void OccupancyGrid::initRefCounts()
@@ -34,6 +34,7 @@
 
 // standard includes
 #include <chrono>
+#include <memory>
 #include <numeric>
 
 // project includes
@@ -43,6 +44,7 @@
 #include <smpl/console/nonstd.h>
 #include <smpl/geometry/shortcut.h>
 #include <smpl/spatial.h>
+#include <smpl/thread_pool.h>
 
 namespace smpl {
 
@@ -263,26 +265,92 @@ void ShortcutPath(
     std::vector<RobotState>& pout,
     ShortcutType type)
 {
-    if (pin.size() < 2) {
+    std::vector<CollisionChecker*> checkers(1, cc);
+    ShortcutPath(rm, checkers, pin, pout, type);
+}
+
+// Run iterative shortcutting with one copy of the path generator per thread,
+// or sequentially with the first generator if there is only one thread
+template <class PathGenerator, class CostIt, class OutputIt>
+static void RunShortcutPath(
+    ThreadPool* pool,
+    const std::vector<PathGenerator>& generators,
+    const std::vector<RobotState>& points,
+    CostIt cfirst, CostIt clast,
+    OutputIt ofirst)
+{
+    if (pool) {
+        shortcut::ParallelShortcutPath(
+                *pool,
+                points.begin(), points.end(),
+                cfirst, clast,
+                generators.begin(), generators.end(), 1,
+                ofirst);
+    } else {
+        shortcut::ShortcutPath(
+                points.begin(), points.end(),
+                cfirst, clast,
+                generators.begin(), generators.begin() + 1,
+                ofirst);
+    }
+}
+
+template <class PathGenerator, class CostIt, class OutputIt>
+static void RunDivideAndConquerShortcutPath(
+    ThreadPool* pool,
+    const std::vector<PathGenerator>& generators,
+    const std::vector<RobotState>& points,
+    CostIt cfirst, CostIt clast,
+    OutputIt ofirst)
+{
+    if (pool) {
+        shortcut::ParallelDivideAndConquerShortcutPath(
+                *pool,
+                points.begin(), points.end(),
+                cfirst, clast,
+                generators.begin(), generators.end(), 1,
+                ofirst);
+    } else {
+        shortcut::DivideAndConquerShortcutPath(
+                points.begin(), points.end(),
+                cfirst, clast,
+                generators.begin(), generators.begin() + 1,
+                ofirst);
+    }
+}
+
+void ShortcutPath(
+    RobotModel* rm,
+    const std::vector<CollisionChecker*>& checkers,
+    const std::vector<RobotState>& pin,
+    std::vector<RobotState>& pout,
+    ShortcutType type)
+{
+    if (pin.size() < 2 || checkers.empty()) {
         pout = pin;
         return;
     }
 
     auto then = clock::now();
+
+    std::unique_ptr<ThreadPool> pool;
+    if (checkers.size() > 1 && type != ShortcutType::EUCLID_SPACE) {
+        pool.reset(new ThreadPool((int)checkers.size()));
+    }
+
     double prev_cost = 0.0, next_cost = 0.0;
     switch (type) {
     case ShortcutType::JOINT_SPACE:
     {
         std::vector<double> costs;
         ComputePositionPathCosts(rm, pin, costs);
-        JointPositionShortcutPathGenerator generators[] =
-        {
-            JointPositionShortcutPathGenerator(rm, cc)
-        };
-        shortcut::ShortcutPath(
-                pin.begin(), pin.end(),
+        std::vector<JointPositionShortcutPathGenerator> generators;
+        for (auto* cc : checkers) {
+            generators.push_back(JointPositionShortcutPathGenerator(rm, cc));
+        }
+        RunShortcutPath(
+                pool.get(), generators, pin,
                 costs.begin(), costs.end(),
-                generators, generators + 1,
                 std::back_inserter(pout));
     }   break;
     case ShortcutType::EUCLID_SPACE:
@@ -292,7 +360,7 @@ void ShortcutPath(
 
         EuclidShortcutPathGenerator generators[] =
         {
-            EuclidShortcutPathGenerator(rm, cc)
+            EuclidShortcutPathGenerator(rm, checkers.front())
         };
 
         shortcut::ShortcutPath(
@@ -310,23 +378,22 @@ void ShortcutPath(
         ComputePositionVelocityPathCosts(rm, pv_path, costs);
         prev_cost = std::accumulate(costs.begin(), costs.end(), 0.0);
 
-        JointPositionVelocityShortcutPathGenerator generators[] =
-        {
-            JointPositionVelocityShortcutPathGenerator(rm, cc)
-        };
+        std::vector<JointPositionVelocityShortcutPathGenerator> generators;
+        for (auto* cc : checkers) {
+            generators.push_back(
+                    JointPositionVelocityShortcutPathGenerator(rm, cc));
+        }
 
         std::vector<RobotState> opvpath;
-        shortcut::ShortcutPath(
-                pv_path.begin(), pv_path.end(),
+        RunShortcutPath(
+                pool.get(), generators, pv_path,
                 costs.begin(), costs.end(),
-                generators, generators + 1,
                 std::back_inserter(opvpath));
 
         std::vector<RobotState> opvpath_dnc;
-        shortcut::DivideAndConquerShortcutPath(
-                pv_path.begin(), pv_path.end(),
+        RunDivideAndConquerShortcutPath(
+                pool.get(), generators, pv_path,
                 costs.begin(), costs.end(),
-                generators, generators + 1,
                 std::back_inserter(opvpath_dnc));
 
         std::vector<double> new_costs;
@@ -349,7 +416,7 @@ void ShortcutPath(
     }
 
     auto now = clock::now();
-    SMPL_INFO("Path shortcutting took %0.3f seconds", std::chrono::duration<double>(now - then).count());
+    SMPL_INFO("Path shortcutting took %0.3f seconds (%d threads)", std::chrono::duration<double>(now - then).count(), pool ? pool->size() : 1);
 
     SMPL_INFO("Original path: waypoint count: %zu, cost: %0.3f", pin.size(), prev_cost);
     SMPL_INFO("Shortcutted path: waypount_count: %zu, cost: %0.3f", pout.size(), next_cost);
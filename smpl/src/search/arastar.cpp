@@ -32,6 +32,7 @@
 #include <smpl/search/arastar.h>
 
 #include <algorithm>
+#include <unordered_set>
 
 // system includes
 #include <sbpl/utils/key.h>
@@ -57,11 +58,13 @@ ARAStar::ARAStar(
     m_final_eps(1.0),
     m_delta_eps(1.0),
     m_allow_partial_solutions(false),
+    m_state_arena(sizeof(SearchState)),
     m_states(),
     m_start_state_id(-1),
     m_goal_state_id(-1),
     m_open(),
     m_incons(),
+    m_goal_preds(),
     m_curr_eps(1.0),
     m_iteration(1),
     m_call_number(0),
@@ -87,11 +90,6 @@ ARAStar::ARAStar(
 
 ARAStar::~ARAStar()
 {
-    for (SearchState* s : m_states) {
-        if (s != NULL) {
-            delete s;
-        }
-    }
 }
 
 enum ReplanResultCode
@@ -129,6 +127,7 @@ int ARAStar::replan(
         SMPL_DEBUG_NAMED(SLOG, "Reinitialize search");
         m_open.clear();
         m_incons.clear();
+        m_goal_preds.clear();
         ++m_call_number; // trigger state reinitializations
 
         reinitSearchState(start_state);
@@ -157,6 +156,7 @@ int ARAStar::replan(
         SMPL_DEBUG_NAMED(SLOG, "Refresh heuristics, keys, and reorder open list");
         recomputeHeuristics();
         reorderOpen();
+        clearGoalPreds();
 
         m_last_goal_state_id = m_goal_state_id;
     }
@@ -289,13 +289,9 @@ int ARAStar::force_planning_from_scratch_and_free_memory()
 {
     force_planning_from_scratch();
     m_open.clear();
-    for (SearchState* s : m_states) {
-        if (s != NULL) {
-            delete s;
-        }
-    }
     m_states.clear();
     m_states.shrink_to_fit();
+    m_state_arena.release();
     return 0;
 }
 
@@ -389,9 +385,153 @@ int ARAStar::set_search_mode(bool first_solution_unbounded)
 }
 
 /// Notify the search of changes to edge costs in the graph.
+///
+/// The search tree is repaired, rather than discarded, so that the next call
+/// to replan() only expands the states affected by the changes. The
+/// predecessors of \p changes are the states whose outgoing edges have
+/// changed, and are reopened if they have been reached by the search, so that
+/// edges that were added, or whose costs decreased, are relaxed. The
+/// successors are the states whose incoming edges have changed, and their
+/// parents in the search tree are reopened.
+///
+/// When the goal moves, without a change to the goal state ID, the goal state
+/// and the states that satisfy the new goal should be listed as successors.
+/// The goal state is then reset, the states from which it was reached are
+/// reopened, and the heuristics of all states are recomputed. The heuristic
+/// must have been updated for the new goal beforehand.
+///
+/// The cost-to-come of states reached through edges whose costs increased can
+/// not be repaired without knowing all of their predecessors in the graph. If
+/// the best edge into any listed successor leaves a listed predecessor, the
+/// search starts from scratch instead.
 void ARAStar::costs_changed(const StateChangeQuery& changes)
 {
-    force_planning_from_scratch();
+    // the search tree will be reinitialized by the next call to replan()
+    if (m_last_start_state_id < 0 || m_start_state_id != m_last_start_state_id) {
+        return;
+    }
+
+    auto* preds = changes.getPredecessors();
+    auto* succs = changes.getSuccessors();
+
+    auto reached = [&](int state_id) -> SearchState* {
+        if (state_id < 0 || (size_t)state_id >= m_states.size()) {
+            return nullptr;
+        }
+        auto* s = m_states[state_id];
+        if (s == NULL || s->call_number != m_call_number || s->g == INFINITECOST) {
+            return nullptr;
+        }
+        return s;
+    };
+
+    if (preds != NULL && succs != NULL && !preds->empty()) {
+        std::unordered_set<int> changed(preds->begin(), preds->end());
+        for (int state_id : *succs) {
+            auto* s = reached(state_id);
+            if (s != NULL && state_id != m_goal_state_id &&
+                s->bp != NULL && changed.count(s->bp->state_id))
+            {
+                SMPL_DEBUG_NAMED(SLOG, "Cost-to-come of state %d may have increased", state_id);
+                force_planning_from_scratch();
+                return;
+            }
+        }
+    }
+
+    // begin a new search iteration, from the initial suboptimality bound, so
+    // that states closed during previous iterations may be reopened
+    ++m_iteration;
+    m_curr_eps = m_initial_eps;
+    m_satisfied_eps = std::numeric_limits<double>::infinity();
+    for (SearchState* s : m_incons) {
+        s->incons = false;
+        if (!m_open.contains(s)) {
+            m_open.push(s);
+        }
+    }
+    m_incons.clear();
+
+    m_expand_count_init = 0;
+    m_search_time_init = clock::duration::zero();
+    m_expand_count = 0;
+    m_search_time = clock::duration::zero();
+
+    auto goal_changed = false;
+    if (succs != NULL) {
+        for (int state_id : *succs) {
+            if (state_id == m_goal_state_id) {
+                goal_changed = true;
+                continue;
+            }
+            auto* s = reached(state_id);
+            if (s != NULL && s->bp != NULL) {
+                reopenState(s->bp);
+            }
+        }
+    }
+
+    if (goal_changed &&
+        m_goal_state_id >= 0 && (size_t)m_goal_state_id < m_states.size() &&
+        m_states[m_goal_state_id] != NULL)
+    {
+        SMPL_DEBUG_NAMED(SLOG, "Repair search tree for the new goal");
+        resetGoalState(m_states[m_goal_state_id]);
+        for (SearchState* s : m_goal_preds) {
+            s->goal_pred = false;
+            reopenState(s);
+        }
+        m_goal_preds.clear();
+        recomputeHeuristics();
+    }
+
+    if (preds != NULL) {
+        for (int state_id : *preds) {
+            auto* s = reached(state_id);
+            if (s != NULL) {
+                reopenState(s);
+            }
+        }
+    }
+
+    reorderOpen();
+}
+
+// Place a state, reached by the search, back into OPEN so that its successors
+// are updated when it is expanded again.
+void ARAStar::reopenState(SearchState* s)
+{
+    if (s->g == INFINITECOST || m_open.contains(s)) {
+        return;
+    }
+    s->iteration_closed = 0;
+    s->f = computeKey(s);
+    m_open.push(s);
+}
+
+// Forget the cost-to-come of the goal state.
+void ARAStar::resetGoalState(SearchState* goal_state)
+{
+    if (goal_state->call_number != m_call_number) {
+        return;
+    }
+    if (m_open.contains(goal_state)) {
+        m_open.erase(goal_state);
+    }
+    goal_state->g = INFINITECOST;
+    goal_state->f = INFINITECOST;
+    goal_state->eg = INFINITECOST;
+    goal_state->iteration_closed = 0;
+    goal_state->bp = nullptr;
+    goal_state->incons = false;
+}
+
+void ARAStar::clearGoalPreds()
+{
+    for (SearchState* s : m_goal_preds) {
+        s->goal_pred = false;
+    }
+    m_goal_preds.clear();
 }
 
 // Recompute heuristics for all states.
@@ -535,6 +675,11 @@ void ARAStar::expand(SearchState* s)
         int succ_state_id = m_succs[sidx];
         int cost = m_costs[sidx];
 
+        if (succ_state_id == m_goal_state_id && !s->goal_pred) {
+            s->goal_pred = true;
+            m_goal_preds.push_back(s);
+        }
+
         SearchState* succ_state = getSearchState(succ_state_id);
         reinitSearchState(succ_state);
 
@@ -560,9 +705,7 @@ void ARAStar::expand(SearchState* s)
 // Recompute the f-values of all states in OPEN and reorder OPEN.
 void ARAStar::reorderOpen()
 {
-    for (auto it = m_open.begin(); it != m_open.end(); ++it) {
-        (*it)->f = computeKey(*it);
-    }
+    m_open.for_each([&](SearchState* s) { s->f = computeKey(s); });
     m_open.make();
 }
 
@@ -592,7 +735,7 @@ ARAStar::SearchState* ARAStar::createState(int state_id)
 {
     assert(state_id < m_states.size());
 
-    SearchState* ss = new SearchState;
+    SearchState* ss = m_state_arena.create<SearchState>();
     ss->state_id = state_id;
     ss->call_number = 0;
 
@@ -612,6 +755,7 @@ void ARAStar::reinitSearchState(SearchState* state)
         state->call_number = m_call_number;
         state->bp = nullptr;
         state->incons = false;
+        state->goal_pred = false;
     }
 }
 
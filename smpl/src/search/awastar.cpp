@@ -48,6 +48,7 @@ static const char* SELOG = "search.expansions";
 AWAStar::AWAStar(DiscreteSpaceInformation* space, Heuristic* heur)
 {
     environment_ = space;
+    m_state_arena.setBlockSize(sizeof(SearchState));
     m_space = space;
     m_heur = heur;
     m_start_state_id = -1;
@@ -57,9 +58,6 @@ AWAStar::AWAStar(DiscreteSpaceInformation* space, Heuristic* heur)
 
 AWAStar::~AWAStar()
 {
-    for (SearchState* s : m_states) {
-        delete s;
-    }
 }
 
 enum ReplanResultCode
@@ -383,7 +381,7 @@ AWAStar::SearchState* AWAStar::getSearchState(int state_id)
     }
 
     if (m_states[state_id] == nullptr) {
-        m_states[state_id] = new SearchState;
+        m_states[state_id] = m_state_arena.create<SearchState>();
         m_states[state_id]->call_number = 0;
         m_states[state_id]->state_id = state_id;
     }
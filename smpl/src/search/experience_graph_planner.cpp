@@ -23,6 +23,7 @@ ExperienceGraphPlanner::ExperienceGraphPlanner(
     m_ege(nullptr),
     m_heur(heur),
     m_egh(nullptr),
+    m_state_arena(sizeof(SearchState)),
     m_states(),
     m_start_state(nullptr),
     m_goal_state(nullptr),
@@ -47,9 +48,6 @@ ExperienceGraphPlanner::ExperienceGraphPlanner(
 
 ExperienceGraphPlanner::~ExperienceGraphPlanner()
 {
-    for (SearchState* s : m_states) {
-        delete s;
-    }
 }
 
 int ExperienceGraphPlanner::replan(
@@ -335,7 +333,7 @@ auto ExperienceGraphPlanner::createState(int state_id) -> SearchState*
 
     m_graph_to_search_map[state_id] = (int)m_states.size();
 
-    SearchState* ss = new SearchState;
+    SearchState* ss = m_state_arena.create<SearchState>();
     ss->state_id = state_id;
     ss->call_number = 0;
     m_states.push_back(ss);
@@ -21,7 +21,7 @@ static auto GetState(LazyARAStar& search, int state_id) -> State*
         return search.states_[state_id];
     }
 
-    State* new_state = new State;
+    State* new_state = search.state_arena_.create<State>();
     new_state->cands.clear();
     new_state->graph_state = state_id;
     new_state->h = g_infinite;
@@ -200,11 +200,16 @@ static int ComputeFVal(
 static void Clear(LazyARAStar& search) {
     search.open_.clear();
 
+    // states are allocated from the arena, which only needs to destroy their
+    // candidate lists before the storage is reused
     for (auto* state : search.states_) {
-        delete state;
+        if (state) {
+            state->~State();
+        }
     }
 
     search.states_.clear();
+    search.state_arena_.reset();
 
     search.start_state_ = nullptr;
     search.goal_state_ = nullptr;
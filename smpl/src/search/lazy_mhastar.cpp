@@ -44,16 +44,10 @@ static auto GetState(LazySMHAStar& search, int state_id) -> State*
         return search.states_[state_id];
     }
 
-    // size of the state, overallocated to store information for n additional
-    // heuristics
-    size_t state_size =
-            sizeof(State) +
-            sizeof(State::HeapData) * search.h_count_;
-
-    State* state = (State*)malloc(state_size);
-
-    // default construct the State since there are non-pod types in State
-    new (state) State;
+    // the arena's blocks are overallocated to store information for n
+    // additional heuristics; default construct the State since there are
+    // non-pod types in State
+    State* state = search.state_arena_.create<State>();
 
     // we only need to initialize these variables, as their values are
     // meaningful between searches, the rest will be initialized in ReinitState
@@ -280,10 +274,13 @@ static void Clear(LazySMHAStar& search)
     }
 
     for (auto* state : search.states_) {
-        delete state;
+        if (state) {
+            state->~State();
+        }
     }
 
     search.states_.clear();
+    search.state_arena_.reset();
 
     search.start_state_ = nullptr;
     search.goal_state_ = nullptr;
@@ -313,6 +310,11 @@ bool Init(
     search.h_others_ = h_others;
     search.h_count_ = h_count;
 
+    // size of the state, overallocated to store information for n additional
+    // heuristics
+    search.state_arena_.setBlockSize(
+            sizeof(State) + sizeof(State::HeapData) * h_count);
+
     search.open_lists_.reserve(h_count + 1);
     for (size_t i = 0; i < h_count + 1; ++i) {
         search.open_lists_.emplace_back(StateCompare{&search});
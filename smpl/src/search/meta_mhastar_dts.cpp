@@ -67,9 +67,12 @@ MetaMHAstarDTS::MetaMHAstarDTS(
     m_call_number(0), // uninitialized
     m_start_state(nullptr),
     m_goal_state(nullptr),
+    m_state_arena(
+            sizeof(MHASearchState) +
+            sizeof(MHASearchState::HeapData) * hcount),
+    m_search_states(),
     m_rng(),
     m_uniform(0.0, 1.0),
-    m_search_states(),
     m_open(nullptr)
 {
     SMPL_INFO("Construct Focal MHA* Search with %d heuristics", hcount);
@@ -416,14 +419,9 @@ MHASearchState* MetaMHAstarDTS::get_state(int state_id)
     }
 
     if (m_graph_to_search_state[state_id] == -1) {
-        // overallocate search state for appropriate heuristic information
-        const size_t state_size =
-                sizeof(MHASearchState) +
-                sizeof(MHASearchState::HeapData) * (m_hcount);
-        MHASearchState* s = (MHASearchState*)malloc(state_size);
-
+        // arena blocks are overallocated for appropriate heuristic information;
         // force construction to correctly initialize heap position to null
-        new (s) MHASearchState;
+        MHASearchState* s = m_state_arena.create<MHASearchState>();
         for (int i = 1; i < num_heuristics(); ++i) {
             new (&s->od[i]) MHASearchState::HeapData;
         }
@@ -446,17 +444,9 @@ void MetaMHAstarDTS::clear()
 {
     clear_open_lists();
 
-    // free states
-    for (size_t i = 0; i < m_search_states.size(); ++i) {
-        // unmap graph to search state
-        MHASearchState* search_state = m_search_states[i];
-
-        // free search state
-        free(m_search_states[i]);
-    }
-
-    // empty state table
+    // empty state table and free states
     m_search_states.clear();
+    m_state_arena.reset();
 
     m_start_state = nullptr;
     m_goal_state = nullptr;
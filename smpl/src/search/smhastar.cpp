@@ -41,6 +41,7 @@
 
 #include <smpl/console/console.h>
 #include <smpl/time.h>
+#include <smpl/heuristic/robot_heuristic.h>
 
 namespace smpl {
 
@@ -85,6 +86,10 @@ bool SMHAStar::Init(
     m_heurs = heurs;
     m_heur_count = heur_count;
     m_open = new OpenList[heur_count + 1];
+
+    // overallocate search states for appropriate heuristic information
+    m_state_arena.setBlockSize(
+            sizeof(SMHAState) + sizeof(SMHAState::HeapData) * heur_count);
     return true;
 }
 
@@ -156,6 +161,8 @@ int SMHAStar::replan(std::vector<int>* solution, ReplanParams params, int* solco
     // reinitializations
     reinit_search();
 
+    update_heuristic_groups();
+
     m_eps = m_params.initial_eps;
     m_eps_mha = m_initial_eps_mha;
     m_eps_satisfied = (double)INFINITECOST;
@@ -360,6 +367,24 @@ double SMHAStar::get_max_time() const
     return m_params.max_time;
 }
 
+void SMHAStar::set_num_threads(int num_threads)
+{
+    if (num_threads == get_num_threads()) {
+        return;
+    }
+
+    if (num_threads > 1) {
+        m_pool.reset(new ThreadPool(num_threads));
+    } else {
+        m_pool.reset();
+    }
+}
+
+int SMHAStar::get_num_threads() const
+{
+    return m_pool ? m_pool->size() : 1;
+}
+
 bool SMHAStar::check_params(const ReplanParams& params)
 {
     if (params.initial_eps < 1.0) {
@@ -411,13 +436,7 @@ SMHAState* SMHAStar::get_state(int state_id)
     assert(state_id >= 0 && state_id < environment_->StateID2IndexMapping.size());
     int* idxs = environment_->StateID2IndexMapping[state_id];
     if (idxs[MHAMDP_STATEID2IND] == -1) {
-        // overallocate search state for appropriate heuristic information
-        size_t state_size =
-                sizeof(SMHAState) +
-                sizeof(SMHAState::HeapData) * (m_heur_count);
-        SMHAState* s = (SMHAState*)malloc(state_size);
-
-        new (s) SMHAState;
+        SMHAState* s = m_state_arena.create<SMHAState>();
         for (int i = 0; i < m_heur_count; ++i) {
             new (&s->od[1 + i]) SMHAState::HeapData;
         }
@@ -440,19 +459,16 @@ void SMHAStar::clear()
 {
     clear_open_lists();
 
-    // free states
+    // unmap graph to search states
     for (size_t i = 0; i < m_search_states.size(); ++i) {
-        // unmap graph to search state
         int state_id = m_search_states[i]->state_id;
         int* idxs = environment_->StateID2IndexMapping[state_id];
         idxs[MHAMDP_STATEID2IND] = -1;
-
-        // free search state
-        free(m_search_states[i]);
     }
 
-    // empty state table
+    // empty state table and free states
     m_search_states.clear();
+    m_state_arena.reset();
 
     m_start_state = NULL;
     m_goal_state = NULL;
@@ -464,29 +480,70 @@ void SMHAStar::init_state(SMHAState* state, size_t mha_state_idx, int state_id)
     state->state_id = state_id;
     state->closed_in_anc = false;
     state->closed_in_add = false;
+    // heuristics are computed when the state is first reinitialized for a
+    // search
     for (int i = 0; i < num_heuristics(); ++i) {
         state->od[i].me = state;
-        state->od[i].h = compute_heuristic(state->state_id, i);
+        state->od[i].h = 0;
+        state->od[i].f = INFINITECOST;
     }
 }
 
 void SMHAStar::reinit_state(SMHAState* state)
 {
     if (state->call_number != m_call_number) {
-        state->call_number = m_call_number;
-        state->g = INFINITECOST;
-        state->bp = NULL;
+        reset_state(state);
+        compute_heuristics(&state, 1);
+    }
+}
+
+void SMHAStar::reset_state(SMHAState* state)
+{
+    state->call_number = m_call_number;
+    state->g = INFINITECOST;
+    state->bp = NULL;
 
-        state->closed_in_anc = false;
-        state->closed_in_add = false;
+    state->closed_in_anc = false;
+    state->closed_in_add = false;
 
-        for (int i = 0; i < num_heuristics(); ++i) {
-            state->od[i].h = compute_heuristic(state->state_id, i);
-            state->od[i].f = INFINITECOST;
+    for (int i = 0; i < num_heuristics(); ++i) {
+        state->od[i].f = INFINITECOST;
+    }
+}
+
+// Compute all heuristic values for a batch of states, one group of heuristics
+// per task. \sa MHAStarBase::compute_heuristics
+void SMHAStar::compute_heuristics(SMHAState** states, size_t count)
+{
+    if (m_pool && count > 0 && m_heuristic_groups.size() > 1) {
+        m_pool->parallelFor((int)m_heuristic_groups.size(), [&](int gidx)
+        {
+            for (int hidx : m_heuristic_groups[gidx]) {
+                for (size_t i = 0; i < count; ++i) {
+                    states[i]->od[hidx].h =
+                            compute_heuristic(states[i]->state_id, hidx);
+                }
+            }
+        });
+    } else {
+        for (int hidx = 0; hidx < num_heuristics(); ++hidx) {
+            for (size_t i = 0; i < count; ++i) {
+                states[i]->od[hidx].h =
+                        compute_heuristic(states[i]->state_id, hidx);
+            }
         }
     }
 }
 
+void SMHAStar::update_heuristic_groups()
+{
+    std::vector<Heuristic*> heuristics;
+    heuristics.push_back(m_anchor);
+    heuristics.insert(heuristics.end(), m_heurs, m_heurs + m_heur_count);
+    PartitionConcurrentHeuristics(
+            heuristics.data(), (int)heuristics.size(), m_heuristic_groups);
+}
+
 void SMHAStar::reinit_search()
 {
     clear_open_lists();
@@ -524,19 +581,32 @@ void SMHAStar::expand(SMHAState* state, int hidx)
         }
     }
 
-    std::vector<int> succ_ids;
-    std::vector<int> costs;
-    environment_->GetSuccs(state->state_id, &succ_ids, &costs);
-    assert(succ_ids.size() == costs.size());
+    m_succ_ids.clear();
+    m_succ_costs.clear();
+    environment_->GetSuccs(state->state_id, &m_succ_ids, &m_succ_costs);
+    assert(m_succ_ids.size() == m_succ_costs.size());
+
+    // reinitialize all successors up front so that the heuristics for states
+    // generated for the first time in this search are computed in one batch
+    m_succ_states.clear();
+    m_new_states.clear();
+    for (size_t sidx = 0; sidx < m_succ_ids.size(); ++sidx) {
+        SMHAState* succ_state = get_state(m_succ_ids[sidx]);
+        if (succ_state->call_number != m_call_number) {
+            reset_state(succ_state);
+            m_new_states.push_back(succ_state);
+        }
+        m_succ_states.push_back(succ_state);
+    }
+
+    compute_heuristics(m_new_states.data(), m_new_states.size());
 
-    for (size_t sidx = 0; sidx < succ_ids.size(); ++sidx)  {
-        int cost = costs[sidx];
-        SMHAState* succ_state = get_state(succ_ids[sidx]);
-        reinit_state(succ_state);
+    for (size_t sidx = 0; sidx < m_succ_states.size(); ++sidx)  {
+        SMHAState* succ_state = m_succ_states[sidx];
 
         SMPL_DEBUG_NAMED(LOG, " Successor %d", succ_state->state_id);
 
-        int new_g = state->g + costs[sidx];
+        int new_g = state->g + m_succ_costs[sidx];
         if (new_g < succ_state->g) {
             succ_state->g = new_g;
             succ_state->bp = state;
@@ -668,7 +668,7 @@ void CollisionWorldSBPL::checkRobotCollisionMutable(
 
     auto startvars = gm->getVariablesFor(state1);
     auto goalvars = gm->getVariablesFor(state2);
-    bool valid = wcd.checkMotionCollision(
+    bool valid = wcd.checkSweptMotionCollision(
         *gm->collisionState(),
         *gm->attachedBodiesCollisionState(),
         *rmcm,
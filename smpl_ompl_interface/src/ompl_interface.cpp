@@ -82,6 +82,15 @@ struct RobotModel :
     ompl::base::SpaceInformation* si = NULL;
     ompl::base::ProjectionEvaluator* projection = NULL;
 
+    // scratch storage for computeFK, allocated on first use
+    ompl::base::State* fk_state = NULL;
+    OMPLProjection fk_projection;
+
+    RobotModel() = default;
+    RobotModel(const RobotModel&) = delete;
+    RobotModel& operator=(const RobotModel&) = delete;
+    ~RobotModel();
+
     double minPosLimit(int vidx) const override;
     double maxPosLimit(int vidx) const override;
     bool hasPosLimit(int vidx) const override;
@@ -95,6 +104,13 @@ struct RobotModel :
     auto getExtension(size_t class_code) -> smpl::Extension* override;
 };
 
+RobotModel::~RobotModel()
+{
+    if (this->fk_state != NULL) {
+        this->si->freeState(this->fk_state);
+    }
+}
+
 double RobotModel::minPosLimit(int vidx) const
 {
     return variables[vidx].min_position;
@@ -133,9 +149,12 @@ bool RobotModel::checkJointLimits(const smpl::RobotState& state, bool verbose)
 
 auto RobotModel::computeFK(const smpl::RobotState& state) -> Eigen::Affine3d
 {
-    auto s = MakeStateOMPL(this->si->getStateSpace(), state);
-    OMPLProjection projected;
-    this->projection->project(s.get(), projected);
+    if (this->fk_state == NULL) {
+        this->fk_state = this->si->allocState();
+    }
+    this->si->getStateSpace()->copyFromReals(this->fk_state, state);
+    auto& projected = this->fk_projection;
+    this->projection->project(this->fk_state, projected);
     return Eigen::Translation3d(projected[0], projected[1], projected[2]) *
             Eigen::AngleAxisd(projected[3], Eigen::Vector3d::UnitZ()) *
             Eigen::AngleAxisd(projected[4], Eigen::Vector3d::UnitY()) *
@@ -164,11 +183,25 @@ auto RobotModel::getExtension(size_t class_code) -> smpl::Extension*
 
 struct CollisionChecker : public smpl::CollisionChecker
 {
-    ompl::base::StateSpace* space;
-    ompl::base::StateValidityChecker* checker;
-    ompl::base::MotionValidator* validator;
+    ompl::base::StateSpace* space = NULL;
+    ompl::base::StateValidityChecker* checker = NULL;
+    ompl::base::MotionValidator* validator = NULL;
     OMPLPlanner::VisualizerFun visualizer;
 
+    // OMPL states allocated once and reused by every query, so that
+    // converting from smpl::RobotState does not allocate
+    std::vector<ompl::base::State*> state_pool;
+
+    CollisionChecker() = default;
+    CollisionChecker(const CollisionChecker&) = delete;
+    CollisionChecker& operator=(const CollisionChecker&) = delete;
+    ~CollisionChecker();
+
+    void init(const ompl::base::SpaceInformation* si);
+
+    auto scratchState(size_t i, const smpl::RobotState& state)
+        -> ompl::base::State*;
+
     /// \name smpl::CollisionChecker Interface
     ///@{
     bool isStateValid(
@@ -195,13 +228,41 @@ struct CollisionChecker : public smpl::CollisionChecker
     ///@}
 };
 
+CollisionChecker::~CollisionChecker()
+{
+    for (auto* s : this->state_pool) {
+        this->space->freeState(s);
+    }
+}
+
+void CollisionChecker::init(const ompl::base::SpaceInformation* si)
+{
+    this->space = si->getStateSpace().get();
+    this->checker = si->getStateValidityChecker().get();
+    this->validator = si->getMotionValidator().get();
+
+    // one state for each end of a motion
+    for (auto* s : this->state_pool) {
+        this->space->freeState(s);
+    }
+    this->state_pool.clear();
+    this->state_pool.push_back(this->space->allocState());
+    this->state_pool.push_back(this->space->allocState());
+}
+
+auto CollisionChecker::scratchState(size_t i, const smpl::RobotState& state)
+    -> ompl::base::State*
+{
+    auto* s = this->state_pool[i];
+    this->space->copyFromReals(s, state);
+    return s;
+}
+
 bool CollisionChecker::isStateValid(
     const smpl::RobotState& state,
     bool verbose)
 {
-    auto* s = MakeStateOMPL(this->space, state);
-    DEFER(this->space->freeState(s));
-    return this->checker->isValid(s);
+    return this->checker->isValid(scratchState(0, state));
 }
 
 bool CollisionChecker::isStateToStateValid(
@@ -209,10 +270,8 @@ bool CollisionChecker::isStateToStateValid(
     const smpl::RobotState& finish,
     bool verbose)
 {
-    auto* s = MakeStateOMPL(this->space, start);
-    auto* f = MakeStateOMPL(this->space, finish);
-    DEFER(this->space->freeState(s));
-    DEFER(this->space->freeState(f));
+    auto* s = scratchState(0, start);
+    auto* f = scratchState(1, finish);
     return this->validator->checkMotion(s, f);
 }
 
@@ -452,9 +511,7 @@ PlannerImpl::PlannerImpl(
     // Initialize Collision Checker Interface //
     ////////////////////////////////////////////
 
-    this->checker.space = planner->getSpaceInformation()->getStateSpace().get();
-    this->checker.checker = planner->getSpaceInformation()->getStateValidityChecker().get();
-    this->checker.validator = planner->getSpaceInformation()->getMotionValidator().get();
+    this->checker.init(planner->getSpaceInformation().get());
 
     //////////////////////////////
     // Initialize Manip Lattice //
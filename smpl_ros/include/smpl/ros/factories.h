@@ -32,6 +32,13 @@ auto MakeManipLattice(
     const OccupancyGrid* grid)
     -> std::unique_ptr<RobotPlanningSpace>;
 
+auto MakeMultiResManipLattice(
+    RobotModel* robot,
+    CollisionChecker* checker,
+    const PlanningParams& params,
+    const OccupancyGrid* grid)
+    -> std::unique_ptr<RobotPlanningSpace>;
+
 auto MakeManipLatticeEGraph(
     RobotModel* robot,
     CollisionChecker* checker,
@@ -76,6 +83,12 @@ auto MakeBFSHeuristic(
     const OccupancyGrid* grid)
     -> std::unique_ptr<RobotHeuristic>;
 
+auto MakeSparseBFSHeuristic(
+    RobotPlanningSpace* space,
+    const PlanningParams& param,
+    const OccupancyGrid* grid)
+    -> std::unique_ptr<RobotHeuristic>;
+
 auto MakeEuclidDistHeuristic(
     RobotPlanningSpace* space,
     const PlanningParams& params)
@@ -97,10 +110,20 @@ auto MakeJointDistEGraphHeuristic(
     const PlanningParams& params)
     -> std::unique_ptr<RobotHeuristic>;
 
+/// Wrap a heuristic in a CachedHeuristic that takes ownership of it.
+auto MakeCachedHeuristic(
+    RobotPlanningSpace* space,
+    std::unique_ptr<RobotHeuristic> heuristic)
+    -> std::unique_ptr<RobotHeuristic>;
+
 //////////////////////
 // Search Factories //
 //////////////////////
 
+// The "open_list" parameter, which selects the open list implementation, is
+// only read by MakeARAStar and MakeAWAStar. The other searches always use
+// their own open lists.
+
 auto MakeARAStar(
     RobotPlanningSpace* space,
     RobotHeuristic* heuristic,
@@ -7,16 +7,20 @@
 #include <smpl/graph/manip_lattice.h>
 #include <smpl/graph/manip_lattice_action_space.h>
 #include <smpl/graph/manip_lattice_egraph.h>
+#include <smpl/graph/multi_res_manip_lattice.h>
+#include <smpl/graph/primitive_collision_table.h>
 #include <smpl/graph/simple_workspace_lattice_action_space.h>
 #include <smpl/graph/workspace_lattice.h>
 #include <smpl/graph/workspace_lattice_action_space.h>
 #include <smpl/graph/workspace_lattice_egraph.h>
 #include <smpl/heuristic/bfs_heuristic.h>
+#include <smpl/heuristic/cached_heuristic.h>
 #include <smpl/heuristic/egraph_bfs_heuristic.h>
 #include <smpl/heuristic/euclid_dist_heuristic.h>
 #include <smpl/heuristic/generic_egraph_heuristic.h>
 #include <smpl/heuristic/joint_dist_heuristic.h>
 #include <smpl/heuristic/multi_frame_bfs_heuristic.h>
+#include <smpl/heuristic/sparse_bfs_heuristic.h>
 #include <smpl/planning_params.h>
 #include <smpl/robot_model.h>
 #include <smpl/search/adaptive_planner.h>
@@ -104,23 +108,20 @@ bool IsMultiDOFJointVariable(
     }
 }
 
-auto MakeManipLattice(
+// Lookup the resolution of each planning variable from the 'discretization'
+// parameter. Return false if the resolution of any variable is not found.
+static
+bool GetManipLatticeResolutions(
     RobotModel* robot,
-    CollisionChecker* checker,
     const PlanningParams& params,
-    const OccupancyGrid* grid)
-    -> std::unique_ptr<RobotPlanningSpace>
+    std::vector<double>& resolutions)
 {
-    ////////////////
-    // Parameters //
-    ////////////////
-
-    auto resolutions = std::vector<double>(robot->jointVariableCount());
+    resolutions.resize(robot->jointVariableCount());
 
     std::string disc_string;
     if (!params.getParam("discretization", disc_string)) {
         SMPL_ERROR_NAMED(PI_LOGGER, "Parameter 'discretization' not found in planning params");
-        return nullptr;
+        return false;
     }
 
     auto disc = ParseMapFromString<double>(disc_string);
@@ -135,14 +136,14 @@ auto MakeManipLattice(
             auto dit = disc.find(mdof_vname);
             if (dit == end(disc)) {
                 SMPL_ERROR_NAMED(PI_LOGGER, "Discretization for variable '%s' not found in planning parameters", vname.c_str());
-                return nullptr;
+                return false;
             }
             resolutions[vidx] = dit->second;
         } else {
             auto dit = disc.find(vname);
             if (dit == end(disc)) {
                 SMPL_ERROR_NAMED(PI_LOGGER, "Discretization for variable '%s' not found in planning parameters", vname.c_str());
-                return nullptr;
+                return false;
             }
             resolutions[vidx] = dit->second;
         }
@@ -150,6 +151,25 @@ auto MakeManipLattice(
         SMPL_DEBUG_NAMED(PI_LOGGER, "resolution(%s) = %0.3f", vname.c_str(), resolutions[vidx]);
     }
 
+    return true;
+}
+
+auto MakeManipLattice(
+    RobotModel* robot,
+    CollisionChecker* checker,
+    const PlanningParams& params,
+    const OccupancyGrid* grid)
+    -> std::unique_ptr<RobotPlanningSpace>
+{
+    ////////////////
+    // Parameters //
+    ////////////////
+
+    std::vector<double> resolutions;
+    if (!GetManipLatticeResolutions(robot, params, resolutions)) {
+        return nullptr;
+    }
+
     ManipLatticeActionSpaceParams action_params;
     if (!GetManipLatticeActionSpaceParams(action_params, params)) {
         return nullptr;
@@ -163,6 +183,7 @@ auto MakeManipLattice(
     // ManipLatticeActionSpace
     struct SimpleManipLattice : public ManipLattice {
         ManipLatticeActionSpace actions;
+        PrimitiveCollisionTable prim_table;
     };
 
     auto space = make_unique<SimpleManipLattice>();
@@ -197,6 +218,17 @@ auto MakeManipLattice(
         return nullptr;
     }
 
+    std::string prim_table_filename;
+    if (params.getParam("primitive_collision_table", prim_table_filename) &&
+        !prim_table_filename.empty())
+    {
+        if (!space->prim_table.load(prim_table_filename)) {
+            SMPL_ERROR_NAMED(PI_LOGGER, "Failed to load primitive collision table from file '%s'", prim_table_filename.c_str());
+            return nullptr;
+        }
+        space->setPrimitiveCollisionTable(&space->prim_table);
+    }
+
     SMPL_DEBUG_NAMED(PI_LOGGER, "Action Set:");
     for (auto ait = actions.begin(); ait != actions.end(); ++ait) {
         SMPL_DEBUG_NAMED(PI_LOGGER, "  type: %s", to_cstring(ait->type));
@@ -219,6 +251,103 @@ auto MakeManipLattice(
     return std::move(space);
 }
 
+auto MakeMultiResManipLattice(
+    RobotModel* robot,
+    CollisionChecker* checker,
+    const PlanningParams& params,
+    const OccupancyGrid* grid)
+    -> std::unique_ptr<RobotPlanningSpace>
+{
+    ////////////////
+    // Parameters //
+    ////////////////
+
+    std::vector<double> resolutions;
+    if (!GetManipLatticeResolutions(robot, params, resolutions)) {
+        return nullptr;
+    }
+
+    ManipLatticeActionSpaceParams action_params;
+    if (!GetManipLatticeActionSpaceParams(action_params, params)) {
+        return nullptr;
+    }
+
+    MultiResManipLattice::Params lattice_params;
+    params.param("coarse_factor", lattice_params.coarse_factor, 4);
+    params.param("fine_goal_distance", lattice_params.fine_goal_distance, 0.2);
+    params.param("fine_obstacle_distance", lattice_params.fine_obstacle_distance, 0.1);
+
+    ////////////////////
+    // Initialization //
+    ////////////////////
+
+    struct SimpleMultiResManipLattice : public MultiResManipLattice {
+        ManipLatticeActionSpace actions;
+        ManipLatticeActionSpace coarse_actions;
+    };
+
+    auto space = make_unique<SimpleMultiResManipLattice>();
+
+    if (!space->init(
+            robot,
+            checker,
+            resolutions,
+            &space->actions,
+            &space->coarse_actions,
+            grid,
+            lattice_params))
+    {
+        SMPL_ERROR_NAMED(PI_LOGGER, "Failed to initialize Multi-Resolution Manip Lattice");
+        return nullptr;
+    }
+
+    if (!space->actions.init(space.get()) ||
+        !space->coarse_actions.init(space.get()))
+    {
+        SMPL_ERROR_NAMED(PI_LOGGER, "Failed to initialize Manip Lattice Action Space");
+        return nullptr;
+    }
+
+    if (grid) {
+        space->setVisualizationFrameId(grid->getReferenceFrame());
+    }
+
+    auto& actions = space->actions;
+    actions.useMultipleIkSolutions(action_params.use_multiple_ik_solutions);
+    actions.useAmp(MotionPrimitive::SNAP_TO_XYZ, action_params.use_xyz_snap_mprim);
+    actions.useAmp(MotionPrimitive::SNAP_TO_RPY, action_params.use_rpy_snap_mprim);
+    actions.useAmp(MotionPrimitive::SNAP_TO_XYZ_RPY, action_params.use_xyzrpy_snap_mprim);
+    actions.useAmp(MotionPrimitive::SHORT_DISTANCE, action_params.use_short_dist_mprims);
+    actions.ampThresh(MotionPrimitive::SNAP_TO_XYZ, action_params.xyz_snap_thresh);
+    actions.ampThresh(MotionPrimitive::SNAP_TO_RPY, action_params.rpy_snap_thresh);
+    actions.ampThresh(MotionPrimitive::SNAP_TO_XYZ_RPY, action_params.xyzrpy_snap_thresh);
+    actions.ampThresh(MotionPrimitive::SHORT_DISTANCE, action_params.short_dist_mprims_thresh);
+
+    if (!actions.load(action_params.mprim_filename)) {
+        SMPL_ERROR("Failed to load actions from file '%s'", action_params.mprim_filename.c_str());
+        return nullptr;
+    }
+
+    // coarse actions are the long distance primitives, scaled to the coarse
+    // resolution. Adaptive motions are only applied at the fine resolution.
+    for (auto& prim : actions) {
+        if (prim.type != MotionPrimitive::LONG_DISTANCE) {
+            continue;
+        }
+        for (auto& waypoint : prim.action) {
+            auto delta = waypoint;
+            for (auto& d : delta) {
+                d *= (double)lattice_params.coarse_factor;
+            }
+            space->coarse_actions.addMotionPrim(delta, false, false);
+        }
+    }
+
+    SMPL_DEBUG_NAMED(PI_LOGGER, "Coarse Action Set: %d actions at %dx resolution", space->coarse_actions.longDistCount(), lattice_params.coarse_factor);
+
+    return std::move(space);
+}
+
 auto MakeManipLatticeEGraph(
     RobotModel* robot,
     CollisionChecker* checker,
@@ -331,20 +460,31 @@ bool GetWorkspaceLatticeParams(
         return true;
     };
 
-    double res_R, res_P, res_Y;
     if (!extract_disc("fk_pos_x", &wsp->res_x) ||
         !extract_disc("fk_pos_y", &wsp->res_y) ||
-        !extract_disc("fk_pos_z", &wsp->res_z) ||
-        !extract_disc("fk_rot_r", &res_R) ||
-        !extract_disc("fk_rot_p", &res_P) ||
-        !extract_disc("fk_rot_y", &res_Y))
+        !extract_disc("fk_pos_z", &wsp->res_z))
     {
         return false;
     }
 
-    wsp->R_count = (int)std::round(2.0 * M_PI / res_R);
-    wsp->P_count = (int)std::round(M_PI / res_P) + 1; // TODO: force discrete values at -pi/2, 0, and pi/2
-    wsp->Y_count = (int)std::round(2.0 * M_PI / res_Y);
+    // a single rotation resolution selects a uniform discretization of
+    // orientations in place of roll, pitch, and yaw bins
+    if (disc.find("fk_rot") != end(disc)) {
+        extract_disc("fk_rot", &wsp->rot_res);
+        wsp->R_count = wsp->P_count = wsp->Y_count = 0;
+    } else {
+        double res_R, res_P, res_Y;
+        if (!extract_disc("fk_rot_r", &res_R) ||
+            !extract_disc("fk_rot_p", &res_P) ||
+            !extract_disc("fk_rot_y", &res_Y))
+        {
+            return false;
+        }
+
+        wsp->R_count = (int)std::round(2.0 * M_PI / res_R);
+        wsp->P_count = (int)std::round(M_PI / res_P) + 1; // TODO: force discrete values at -pi/2, 0, and pi/2
+        wsp->Y_count = (int)std::round(2.0 * M_PI / res_Y);
+    }
 
     wsp->free_angle_res.resize(rmi->redundantVariableCount());
     for (int i = 0; i < rmi->redundantVariableCount(); ++i) {
@@ -493,6 +633,12 @@ auto MakeMultiFrameBFSHeuristic(
     double inflation_radius;
     params.param("bfs_inflation_radius", inflation_radius, 0.0);
     h->setInflationRadius(inflation_radius);
+    bool lazy;
+    params.param("bfs_lazy", lazy, false);
+    h->setLazyEvaluation(lazy);
+    int precompute_budget;
+    params.param("bfs_precompute_budget", precompute_budget, 0);
+    h->setPrecomputeBudget(precompute_budget);
     if (!h->init(space, grid)) {
         return nullptr;
     }
@@ -517,6 +663,29 @@ auto MakeBFSHeuristic(
     double inflation_radius;
     params.param("bfs_inflation_radius", inflation_radius, 0.0);
     h->setInflationRadius(inflation_radius);
+    bool lazy;
+    params.param("bfs_lazy", lazy, false);
+    h->setLazyEvaluation(lazy);
+    int precompute_budget;
+    params.param("bfs_precompute_budget", precompute_budget, 0);
+    h->setPrecomputeBudget(precompute_budget);
+    if (!h->init(space, grid)) {
+        return nullptr;
+    }
+    return std::move(h);
+};
+
+auto MakeSparseBFSHeuristic(
+    RobotPlanningSpace* space,
+    const PlanningParams& params,
+    const OccupancyGrid* grid)
+    -> std::unique_ptr<RobotHeuristic>
+{
+    auto h = make_unique<SparseBfsHeuristic>();
+    h->setCostPerCell(params.cost_per_cell);
+    double inflation_radius;
+    params.param("bfs_inflation_radius", inflation_radius, 0.0);
+    h->setInflationRadius(inflation_radius);
     if (!h->init(space, grid)) {
         return nullptr;
     }
@@ -602,6 +771,45 @@ auto MakeJointDistEGraphHeuristic(
     return std::move(h);
 };
 
+auto MakeCachedHeuristic(
+    RobotPlanningSpace* space,
+    std::unique_ptr<RobotHeuristic> heuristic)
+    -> std::unique_ptr<RobotHeuristic>
+{
+    struct OwningCachedHeuristic : public CachedHeuristic {
+        std::unique_ptr<RobotHeuristic> h;
+    };
+
+    auto h = make_unique<OwningCachedHeuristic>();
+    h->h = std::move(heuristic);
+    if (!h->init(space, h->h.get())) {
+        return nullptr;
+    }
+    return std::move(h);
+};
+
+// Lookup the "open_list" parameter, one of "binary_heap", "quaternary_heap", or
+// "bucket_queue". Return false if the parameter names an unrecognized type.
+// Only ARA* and AWA* support a choice of open list; the parameter is ignored
+// by the other searches, including MHA*, which is provided by sbpl.
+static
+bool GetOpenListType(const PlanningParams& params, OpenListType& type)
+{
+    std::string name;
+    params.param("open_list", name, std::string("binary_heap"));
+    if (name == "binary_heap") {
+        type = OpenListType::BinaryHeap;
+    } else if (name == "quaternary_heap") {
+        type = OpenListType::QuaternaryHeap;
+    } else if (name == "bucket_queue") {
+        type = OpenListType::BucketQueue;
+    } else {
+        SMPL_ERROR_NAMED(PI_LOGGER, "Unrecognized open list type '%s'", name.c_str());
+        return false;
+    }
+    return true;
+}
+
 auto MakeARAStar(
     RobotPlanningSpace* space,
     RobotHeuristic* heuristic,
@@ -648,6 +856,12 @@ auto MakeARAStar(
         search->setAllowedRepairTime(repair_time);
     }
 
+    OpenListType open_list_type;
+    if (!GetOpenListType(params, open_list_type)) {
+        return nullptr;
+    }
+    search->setOpenListType(open_list_type);
+
     return std::move(search);
 }
 
@@ -661,6 +875,11 @@ auto MakeAWAStar(
     double epsilon;
     params.param("epsilon", epsilon, 1.0);
     search->set_initialsolution_eps(epsilon);
+    OpenListType open_list_type;
+    if (!GetOpenListType(params, open_list_type)) {
+        return nullptr;
+    }
+    search->set_open_list_type(open_list_type);
     return std::move(search);
 }
 
@@ -51,8 +51,10 @@
 #include <smpl/console/nonstd.h>
 #include <smpl/debug/visualize.h>
 #include <smpl/heuristic/bfs_heuristic.h>
+#include <smpl/heuristic/cached_heuristic.h>
 #include <smpl/heuristic/egraph_bfs_heuristic.h>
 #include <smpl/heuristic/multi_frame_bfs_heuristic.h>
+#include <smpl/heuristic/sparse_bfs_heuristic.h>
 #include <smpl/post_processing.h>
 #include <smpl/stl/memory.h>
 #include <smpl/time.h>
@@ -210,6 +212,14 @@ PlannerInterface::PlannerInterface(
         return MakeManipLattice(r, c, p, m_grid);
     };
 
+    m_space_factories["manip_multi_res"] = [this](
+        RobotModel* r,
+        CollisionChecker* c,
+        const PlanningParams& p)
+    {
+        return MakeMultiResManipLattice(r, c, p, m_grid);
+    };
+
     m_space_factories["manip_lattice_egraph"] = [this](
         RobotModel* r,
         CollisionChecker* c,
@@ -260,6 +270,13 @@ PlannerInterface::PlannerInterface(
         return MakeBFSHeuristic(space, p, m_grid);
     };
 
+    m_heuristic_factories["sparse_bfs"] = [this](
+        RobotPlanningSpace* space,
+        const PlanningParams& p)
+    {
+        return MakeSparseBFSHeuristic(space, p, m_grid);
+    };
+
     m_heuristic_factories["euclid"] = MakeEuclidDistHeuristic;
 
     m_heuristic_factories["joint_distance"] = MakeJointDistHeuristic;
@@ -1191,6 +1208,11 @@ bool PlannerInterface::plan(double allowed_time, std::vector<RobotState>& path)
         SMPL_INFO_NAMED(PI_LOGGER, "  Time (Final): %0.3f", m_planner->get_final_eps_planning_time());
         SMPL_INFO_NAMED(PI_LOGGER, "  Path Length (states): %zu", solution_state_ids.size());
         SMPL_INFO_NAMED(PI_LOGGER, "  Solution Cost: %d", m_sol_cost);
+        for (auto& entry : m_heuristics) {
+            if (auto* hcached = dynamic_cast<CachedHeuristic*>(entry.second.get())) {
+                SMPL_INFO_NAMED(PI_LOGGER, "  Heuristic Cache Hit Rate (%s): %0.3f", entry.first.c_str(), hcached->hitRate());
+            }
+        }
 
         path.clear();
         if (!m_pspace->extractPath(solution_state_ids, path)) {
@@ -1307,14 +1329,19 @@ auto PlannerInterface::getBfsValuesVisualization() const -> visual::Marker
         return visual::Marker{ };
     }
 
-    auto first = m_heuristics.begin();
+    auto* first = m_heuristics.begin()->second.get();
+    if (auto* hcached = dynamic_cast<CachedHeuristic*>(first)) {
+        first = hcached->heuristic();
+    }
 
-    if (auto* hbfs = dynamic_cast<BfsHeuristic*>(first->second.get())) {
+    if (auto* hbfs = dynamic_cast<BfsHeuristic*>(first)) {
         return hbfs->getValuesVisualization();
-    } else if (auto* hmfbfs = dynamic_cast<MultiFrameBfsHeuristic*>(first->second.get())) {
+    } else if (auto* hmfbfs = dynamic_cast<MultiFrameBfsHeuristic*>(first)) {
         return hmfbfs->getValuesVisualization();
-    } else if (auto* debfs = dynamic_cast<DijkstraEgraphHeuristic3D*>(first->second.get())) {
+    } else if (auto* debfs = dynamic_cast<DijkstraEgraphHeuristic3D*>(first)) {
         return debfs->getValuesVisualization();
+    } else if (auto* hsbfs = dynamic_cast<SparseBfsHeuristic*>(first)) {
+        return hsbfs->getValuesVisualization();
     } else {
         return visual::Marker{ };
     }
@@ -1326,14 +1353,19 @@ auto PlannerInterface::getBfsWallsVisualization() const -> visual::Marker
         return visual::Marker{ };
     }
 
-    auto first = m_heuristics.begin();
+    auto* first = m_heuristics.begin()->second.get();
+    if (auto* hcached = dynamic_cast<CachedHeuristic*>(first)) {
+        first = hcached->heuristic();
+    }
 
-    if (auto* hbfs = dynamic_cast<BfsHeuristic*>(first->second.get())) {
+    if (auto* hbfs = dynamic_cast<BfsHeuristic*>(first)) {
         return hbfs->getWallsVisualization();
-    } else if (auto* hmfbfs = dynamic_cast<MultiFrameBfsHeuristic*>(first->second.get())) {
+    } else if (auto* hmfbfs = dynamic_cast<MultiFrameBfsHeuristic*>(first)) {
         return hmfbfs->getWallsVisualization();
-    } else if (auto* debfs = dynamic_cast<DijkstraEgraphHeuristic3D*>(first->second.get())) {
+    } else if (auto* debfs = dynamic_cast<DijkstraEgraphHeuristic3D*>(first)) {
         return debfs->getWallsVisualization();
+    } else if (auto* hsbfs = dynamic_cast<SparseBfsHeuristic*>(first)) {
+        return hsbfs->getWallsVisualization();
     } else {
         return visual::Marker{ };
     }
@@ -1425,6 +1457,16 @@ bool PlannerInterface::reinitPlanner(const std::string& planner_id)
         return false;
     }
 
+    bool cache_heuristic;
+    m_params.param("cache_heuristic", cache_heuristic, false);
+    if (cache_heuristic) {
+        heuristic = MakeCachedHeuristic(m_pspace.get(), std::move(heuristic));
+        if (!heuristic) {
+            SMPL_ERROR("Failed to build cache for heuristic '%s'", heuristic_name.c_str());
+            return false;
+        }
+    }
+
     // initialize heuristics
     m_heuristics.clear();
     m_heuristics.insert(std::make_pair(heuristic_name, std::move(heuristic)));
@@ -1453,15 +1495,38 @@ void PlannerInterface::postProcessPath(std::vector<RobotState>& path) const
 {
     // shortcut path
     if (m_params.shortcut_path) {
+        // check shortcuts on multiple threads when the collision checker can
+        // provide a checker per thread
+        int shortcut_threads;
+        m_params.param("shortcut_threads", shortcut_threads, 1);
+        std::vector<std::unique_ptr<CollisionChecker>> clones;
+        std::vector<CollisionChecker*> checkers = { m_checker };
+        if (shortcut_threads > 1) {
+            auto* cloneable =
+                    m_checker->getExtension<CloneableCollisionCheckerExtension>();
+            if (cloneable) {
+                for (int i = 1; i < shortcut_threads; ++i) {
+                    auto clone = cloneable->clone();
+                    if (!clone) {
+                        break;
+                    }
+                    checkers.push_back(clone.get());
+                    clones.push_back(std::move(clone));
+                }
+            } else {
+                SMPL_WARN_NAMED(PI_LOGGER, "Collision checker is not cloneable. Shortcutting on a single thread.");
+            }
+        }
+
         if (!InterpolatePath(*m_checker, path)) {
             SMPL_WARN_NAMED(PI_LOGGER, "Failed to interpolate planned path with %zu waypoints before shortcutting.", path.size());
             std::vector<RobotState> ipath = path;
             path.clear();
-            ShortcutPath(m_robot, m_checker, ipath, path, m_params.shortcut_type);
+            ShortcutPath(m_robot, checkers, ipath, path, m_params.shortcut_type);
         } else {
             std::vector<RobotState> ipath = path;
             path.clear();
-            ShortcutPath(m_robot, m_checker, ipath, path, m_params.shortcut_type);
+            ShortcutPath(m_robot, checkers, ipath, path, m_params.shortcut_type);
         }
     }
 
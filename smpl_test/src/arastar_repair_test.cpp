@@ -0,0 +1,140 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#define BOOST_TEST_MODULE ARAStarRepairTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/graph/manip_lattice_action_space.h>
+#include <smpl/heuristic/euclid_dist_heuristic.h>
+#include <smpl/search/arastar.h>
+#include <smpl/search/state_change_query.h>
+
+#include "planar_arm.h"
+
+static const int kJointCount = 2;
+static const double kRes = 2.0 * M_PI / 180.0;
+
+// a goal position on a conveyor moving along the x axis
+static auto MakeGoal(double x) -> smpl::GoalConstraint
+{
+    return MakeTipGoal(x, 0.6);
+}
+
+struct Planner
+{
+    smpl::ManipLattice space;
+    smpl::ManipLatticeActionSpace actions;
+    smpl::EuclidDistHeuristic h;
+    smpl::ARAStar search;
+
+    Planner() : search(&space, &h) { }
+
+    bool init(PlanarArmModel* model, PlanarArmChecker* checker)
+    {
+        std::vector<double> res(kJointCount, kRes);
+        if (!space.init(model, checker, res, &actions) ||
+            !actions.init(&space) ||
+            !h.init(&space))
+        {
+            return false;
+        }
+        h.setWeightRot(0.0);
+        space.insertHeuristic(&h);
+        for (int i = 0; i < kJointCount; ++i) {
+            std::vector<double> d(kJointCount, 0.0);
+            d[i] = kRes;
+            actions.addMotionPrim(d, false);
+        }
+        return true;
+    }
+
+    bool setGoal(const smpl::GoalConstraint& goal)
+    {
+        if (!space.setGoal(goal)) {
+            return false;
+        }
+        h.updateGoal(space.goal());
+        return search.set_goal(space.getGoalStateID());
+    }
+
+    bool plan(std::vector<int>& solution, int& cost)
+    {
+        ReplanParams params(10.0);
+        params.initial_eps = 1.0;
+        params.final_eps = 1.0;
+        params.return_first_solution = true;
+        solution.clear();
+        return search.replan(&solution, params, &cost);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(MovingGoalTest)
+{
+    auto grid = MakePostGrid(0.1, 0.75);
+    PlanarArmModel model(kJointCount);
+    PlanarArmChecker checker(&model, &grid, kRes);
+
+    smpl::RobotState start = { 0.0, 0.0 };
+
+    // repairs its search tree as the goal moves
+    Planner repair;
+    BOOST_REQUIRE(repair.init(&model, &checker));
+    BOOST_REQUIRE(repair.space.setStart(start));
+    BOOST_REQUIRE(repair.search.set_start(repair.space.getStartStateID()));
+
+    // searches from scratch for each goal
+    Planner scratch;
+    BOOST_REQUIRE(scratch.init(&model, &checker));
+
+    int repair_expansions = 0;
+    int scratch_expansions = 0;
+    for (int i = 0; i < 10; ++i) {
+        auto goal = MakeGoal(-0.5 + 0.02 * i);
+
+        BOOST_REQUIRE(repair.setGoal(goal));
+        if (i > 0) {
+            smpl::SimpleStateChangeQuery changes;
+            changes.successors.push_back(repair.space.getGoalStateID());
+            repair.space.getGoalSatisfyingStates(changes.successors);
+            repair.search.costs_changed(changes);
+        }
+
+        std::vector<int> repair_solution;
+        int repair_cost;
+        BOOST_REQUIRE(repair.plan(repair_solution, repair_cost));
+        repair_expansions += repair.search.get_n_expands();
+
+        scratch.space.clearStates();
+        scratch.search.force_planning_from_scratch_and_free_memory();
+        BOOST_REQUIRE(scratch.space.setStart(start));
+        BOOST_REQUIRE(scratch.search.set_start(scratch.space.getStartStateID()));
+        BOOST_REQUIRE(scratch.setGoal(goal));
+
+        std::vector<int> scratch_solution;
+        int scratch_cost;
+        BOOST_REQUIRE(scratch.plan(scratch_solution, scratch_cost));
+        scratch_expansions += scratch.search.get_n_expands();
+
+        // both searches find optimal paths to the new goal
+        BOOST_CHECK_EQUAL(repair_cost, scratch_cost);
+
+        std::vector<smpl::RobotState> path;
+        BOOST_REQUIRE(repair.space.extractPath(repair_solution, path));
+        BOOST_REQUIRE(!path.empty());
+        smpl::Vector3 tip = model.computeFK(path.back()).translation();
+        BOOST_CHECK_SMALL(tip.x() - goal.pose.translation().x(), 0.03 + 1e-9);
+        BOOST_CHECK_SMALL(tip.y() - goal.pose.translation().y(), 0.03 + 1e-9);
+        for (auto& state : path) {
+            BOOST_CHECK(checker.isStateValid(state, false));
+        }
+        BOOST_CHECK_EQUAL((int)(path.size() - 1) * 1000, repair_cost);
+    }
+
+    printf("repair:  %6d expansions\n", repair_expansions);
+    printf("scratch: %6d expansions\n", scratch_expansions);
+
+    BOOST_CHECK_LT(repair_expansions, scratch_expansions);
+}
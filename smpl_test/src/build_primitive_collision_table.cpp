@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2017, Andrew Dornbush
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     1. Redistributions of source code must retain the above copyright notice
+//        this list of conditions and the following disclaimer.
+//     2. Redistributions in binary form must reproduce the above copyright
+//        notice, this list of conditions and the following disclaimer in the
+//        documentation and/or other materials provided with the distribution.
+//     3. Neither the name of the copyright holder nor the names of its
+//        contributors may be used to endorse or promote products derived from
+//        this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+/// \author Andrew Dornbush
+
+// Build a table of the regions of joint space in which the motion primitives
+// of a ManipLattice are free of self collisions, for use by planners via the
+// 'primitive_collision_table' planning parameter.
+//
+// usage: build_primitive_collision_table <output file>
+//
+// Reads the same ~robot_model and ~planning parameters as callPlanner, the
+// collision model from ~, and optionally:
+//   ~table_cells       "<variable> <cell count> ..." (default 1 per variable)
+//   ~samples_per_cell  number of states checked per cell (default 8)
+//   ~seed              seed for sampling states within cells (default 0)
+
+// standard includes
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// system includes
+#include <ros/ros.h>
+#include <sbpl_collision_checking/collision_space.h>
+#include <smpl/angles.h>
+#include <smpl/occupancy_grid.h>
+#include <smpl/distance_map/euclid_distance_map.h>
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/graph/manip_lattice_action_space.h>
+#include <smpl/graph/primitive_collision_table.h>
+
+#include "pr2_allowed_collision_pairs.h"
+
+// Robot model whose limits are those of the collision model. The table only
+// depends on joint-space quantities, so no kinematics are required.
+class CollisionModelRobotModel : public smpl::RobotModel
+{
+public:
+
+    CollisionModelRobotModel(
+        const smpl::collision::RobotCollisionModel* rcm,
+        const std::vector<std::string>& planning_joints)
+    :
+        m_rcm(rcm)
+    {
+        setPlanningJoints(planning_joints);
+    }
+
+    double minPosLimit(int vidx) const override {
+        return m_rcm->jointVarMinPosition(planning_joints_[vidx]);
+    }
+    double maxPosLimit(int vidx) const override {
+        return m_rcm->jointVarMaxPosition(planning_joints_[vidx]);
+    }
+    bool hasPosLimit(int vidx) const override {
+        return m_rcm->jointVarHasPositionBounds(planning_joints_[vidx]);
+    }
+    bool isContinuous(int vidx) const override {
+        return m_rcm->jointVarIsContinuous(planning_joints_[vidx]);
+    }
+    double velLimit(int vidx) const override { return 0.0; }
+    double accLimit(int vidx) const override { return 0.0; }
+
+    bool checkJointLimits(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::RobotModel>()) {
+            return this;
+        }
+        return nullptr;
+    }
+
+private:
+
+    const smpl::collision::RobotCollisionModel* m_rcm;
+};
+
+template <class T>
+static auto ParseMapFromString(const std::string& s)
+    -> std::unordered_map<std::string, T>
+{
+    std::unordered_map<std::string, T> map;
+    std::istringstream ss(s);
+    std::string key;
+    T value;
+    while (ss >> key >> value) {
+        map.insert(std::make_pair(key, value));
+    }
+    return map;
+}
+
+static auto ReadPlanningJoints(const ros::NodeHandle& nh)
+    -> std::vector<std::string>
+{
+    std::vector<std::string> joints;
+    std::string planning_joint_list;
+    if (!nh.getParam("planning_joints", planning_joint_list)) {
+        return joints;
+    }
+
+    std::stringstream ss(planning_joint_list);
+    std::string jname;
+    while (ss >> jname) {
+        joints.push_back(jname);
+    }
+    return joints;
+}
+
+int main(int argc, char* argv[])
+{
+    ros::init(argc, argv, "build_primitive_collision_table");
+    ros::NodeHandle nh;
+    ros::NodeHandle ph("~");
+
+    if (argc < 2) {
+        ROS_ERROR("Usage: build_primitive_collision_table <output file>");
+        return 1;
+    }
+
+    std::string robot_description_param;
+    if (!nh.searchParam("robot_description", robot_description_param)) {
+        ROS_ERROR("Failed to find 'robot_description' key on the param server");
+        return 1;
+    }
+
+    std::string robot_description;
+    if (!nh.getParam(robot_description_param, robot_description)) {
+        ROS_ERROR("Failed to retrieve param 'robot_description' from the param server");
+        return 1;
+    }
+
+    ros::NodeHandle rh("~robot_model");
+    std::string group_name;
+    if (!rh.getParam("group_name", group_name)) {
+        ROS_ERROR("Failed to read 'group_name' from the param server");
+        return 1;
+    }
+
+    auto planning_joints = ReadPlanningJoints(rh);
+    if (planning_joints.empty()) {
+        ROS_ERROR("Failed to read 'planning_joints' from the param server");
+        return 1;
+    }
+
+    ros::NodeHandle pp("~planning");
+    std::string discretization;
+    if (!pp.getParam("discretization", discretization)) {
+        ROS_ERROR("Failed to read 'discretization' from the param server");
+        return 1;
+    }
+
+    std::string mprim_filename;
+    if (!pp.getParam("mprim_filename", mprim_filename)) {
+        ROS_ERROR("Failed to read param 'mprim_filename' from the param server");
+        return 1;
+    }
+
+    std::string table_cells;
+    ph.param<std::string>("table_cells", table_cells, "");
+
+    int samples_per_cell;
+    ph.param("samples_per_cell", samples_per_cell, 8);
+
+    int seed;
+    ph.param("seed", seed, 0);
+
+    ///////////////////////
+    // Collision Checker //
+    ///////////////////////
+
+    // Self collisions do not depend on the world, so the collision space only
+    // needs a small, empty grid.
+    auto df = std::make_shared<smpl::EuclidDistanceMap>(
+            -0.5, -0.5, -0.5, 1.0, 1.0, 1.0, 0.1, 0.2);
+    smpl::OccupancyGrid grid(df, false);
+
+    smpl::collision::CollisionModelConfig cc_conf;
+    if (!smpl::collision::CollisionModelConfig::Load(ph, cc_conf)) {
+        ROS_ERROR("Failed to load Collision Model Config");
+        return 1;
+    }
+
+    smpl::collision::CollisionSpace cc;
+    if (!cc.init(&grid, robot_description, cc_conf, group_name, planning_joints)) {
+        ROS_ERROR("Failed to initialize Collision Space");
+        return 1;
+    }
+
+    if (cc.robotCollisionModel()->name() == "pr2") {
+        smpl::collision::AllowedCollisionMatrix acm;
+        for (auto& pair : PR2AllowedCollisionPairs) {
+            acm.setEntry(pair.first, pair.second, true);
+        }
+        cc.setAllowedCollisionMatrix(acm);
+    }
+
+    ///////////////////////
+    // Motion Primitives //
+    ///////////////////////
+
+    CollisionModelRobotModel robot(cc.robotCollisionModel().get(), planning_joints);
+
+    auto disc = ParseMapFromString<double>(discretization);
+    auto cells = ParseMapFromString<int>(table_cells);
+
+    auto variable_count = robot.jointVariableCount();
+    std::vector<double> resolutions(variable_count);
+    std::vector<double> min_positions(variable_count);
+    std::vector<double> max_positions(variable_count);
+    std::vector<bool> continuous(variable_count);
+    std::vector<int> cell_counts(variable_count, 1);
+    for (size_t vidx = 0; vidx < variable_count; ++vidx) {
+        auto& vname = robot.getPlanningJoints()[vidx];
+        auto dit = disc.find(vname);
+        if (dit == end(disc)) {
+            ROS_ERROR("Discretization for variable '%s' not found", vname.c_str());
+            return 1;
+        }
+        resolutions[vidx] = dit->second;
+
+        auto cit = cells.find(vname);
+        if (cit != end(cells)) {
+            cell_counts[vidx] = cit->second;
+        }
+
+        continuous[vidx] = robot.isContinuous(vidx);
+        if (continuous[vidx]) {
+            min_positions[vidx] = -M_PI;
+            max_positions[vidx] = M_PI;
+        } else if (robot.hasPosLimit(vidx)) {
+            min_positions[vidx] = robot.minPosLimit(vidx);
+            max_positions[vidx] = robot.maxPosLimit(vidx);
+        } else {
+            ROS_ERROR("Variable '%s' is unbounded", vname.c_str());
+            return 1;
+        }
+    }
+
+    smpl::ManipLattice lattice;
+    smpl::ManipLatticeActionSpace actions;
+    if (!lattice.init(&robot, &cc, resolutions, &actions) ||
+        !actions.init(&lattice))
+    {
+        ROS_ERROR("Failed to initialize Manip Lattice");
+        return 1;
+    }
+
+    if (!actions.load(mprim_filename)) {
+        ROS_ERROR("Failed to load actions from file '%s'", mprim_filename.c_str());
+        return 1;
+    }
+
+    ///////////
+    // Table //
+    ///////////
+
+    smpl::PrimitiveCollisionTable table;
+    if (!table.init(min_positions, max_positions, continuous, cell_counts)) {
+        ROS_ERROR("Failed to initialize primitive collision table");
+        return 1;
+    }
+
+    // adaptive primitives depend on the goal, and can not be tabulated
+    for (auto& prim : actions) {
+        if (prim.type == smpl::MotionPrimitive::LONG_DISTANCE ||
+            prim.type == smpl::MotionPrimitive::SHORT_DISTANCE)
+        {
+            table.addPrimitive(prim.action);
+        }
+    }
+
+    ROS_INFO("Build table of %d primitives over %d cells", table.primitiveCount(), table.cellCount());
+
+    if (!smpl::BuildPrimitiveCollisionTable(
+            table, &cc, samples_per_cell, (unsigned int)seed))
+    {
+        ROS_ERROR("Failed to build primitive collision table");
+        return 1;
+    }
+
+    ROS_INFO("  free: %d", table.statusCount(smpl::PrimitiveCollisionTable::Free));
+    ROS_INFO("  colliding: %d", table.statusCount(smpl::PrimitiveCollisionTable::Colliding));
+    ROS_INFO("  unknown: %d", table.statusCount(smpl::PrimitiveCollisionTable::Unknown));
+
+    if (!table.save(argv[1])) {
+        ROS_ERROR("Failed to save primitive collision table to '%s'", argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
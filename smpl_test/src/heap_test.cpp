@@ -30,7 +30,12 @@
 /// \author Andrew Dornbush
 
 #include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <set>
 #include <random>
 #include <type_traits>
 #include <utility>
@@ -40,8 +45,12 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 #include <boost/container/stable_vector.hpp>
+#include <boost/mpl/list.hpp>
 
+#include <smpl/heap/intrusive_bucket_queue.h>
+#include <smpl/heap/intrusive_dary_heap.h>
 #include <smpl/heap/intrusive_heap.h>
+#include <smpl/heap/intrusive_open_list.h>
 
 #define LOGDEBUG 0
 #if LOGDEBUG
@@ -66,7 +75,16 @@ struct open_element_compare
     }
 };
 
+struct open_element_key
+{
+    int operator()(const open_element& e) const { return e.priority; }
+};
+
 typedef smpl::intrusive_heap<open_element, open_element_compare> heap_type;
+typedef smpl::intrusive_dary_heap<open_element, open_element_key> dary_heap_type;
+typedef smpl::intrusive_bucket_queue<open_element, open_element_key> bucket_queue_type;
+
+typedef boost::mpl::list<dary_heap_type, bucket_queue_type> keyed_heap_types;
 
 template <typename Iterator>
 class pointer_iterator :
@@ -91,6 +109,12 @@ public:
     pointer_iterator& operator++() { ++m_it; return *this; }
     ///@}
 
+    /// \name Bidirectional Iterator Requirements
+    ///@{}
+    pointer_iterator operator--(int) { pointer_iterator it(m_it); --m_it; return it; }
+    pointer_iterator& operator--() { --m_it; return *this; }
+    ///@}
+
     /// \name Random Access Iterator Requirements
     ///@{}
     pointer_iterator& operator+=(typename Base::difference_type n)
@@ -723,3 +747,317 @@ BOOST_AUTO_TEST_CASE(PushEraseTest)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(KeyedPushPopTest, Heap, keyed_heap_types)
+{
+    std::vector<open_element> elements = { 8, 10, 4, 2, 12, 6, 3, 6, 10 };
+
+    Heap h;
+    BOOST_CHECK(h.empty());
+    for (auto& e : elements) {
+        h.push(&e);
+    }
+    BOOST_CHECK(h.size() == elements.size());
+
+    std::vector<int> popped;
+    while (!h.empty()) {
+        BOOST_CHECK(h.contains(h.min()));
+        popped.push_back(h.min()->priority);
+        h.pop();
+    }
+    BOOST_CHECK(std::is_sorted(popped.begin(), popped.end()));
+    BOOST_CHECK(popped.size() == elements.size());
+    for (auto& e : elements) {
+        BOOST_CHECK(!h.contains(&e));
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(KeyedMutabilityTest, Heap, keyed_heap_types)
+{
+    // Test interleaved pushes, erasures, and updates against a reference set
+    // of the priorities of the elements that should be in the heap
+
+    std::vector<open_element> elements(100);
+    std::vector<bool> inheap(elements.size(), false);
+    std::multiset<int> priorities;
+
+    std::default_random_engine rng;
+    std::uniform_int_distribution<int> dist(0, elements.size() - 1);
+    std::uniform_int_distribution<int> priority_dist(0, 50);
+    std::uniform_int_distribution<int> op_dist(0, 3);
+
+    Heap h;
+
+    int num_trials = 10000;
+    for (int i = 0; i < num_trials; ++i) {
+        int r = dist(rng);
+        open_element& e = elements[r];
+        switch (op_dist(rng)) {
+        case 0: // push or erase
+            if (inheap[r]) {
+                priorities.erase(priorities.find(e.priority));
+                h.erase(&e);
+            } else {
+                e.priority = priority_dist(rng);
+                priorities.insert(e.priority);
+                h.push(&e);
+            }
+            inheap[r] = !inheap[r];
+            break;
+        case 1: // decrease
+            if (inheap[r] && e.priority > 0) {
+                priorities.erase(priorities.find(e.priority));
+                e.priority -= std::uniform_int_distribution<int>(0, e.priority)(rng);
+                priorities.insert(e.priority);
+                h.decrease(&e);
+            }
+            break;
+        case 2: // increase
+            if (inheap[r]) {
+                priorities.erase(priorities.find(e.priority));
+                e.priority += priority_dist(rng);
+                priorities.insert(e.priority);
+                h.increase(&e);
+            }
+            break;
+        case 3: // pop
+            if (!h.empty()) {
+                open_element* m = h.min();
+                BOOST_CHECK(m->priority == *priorities.begin());
+                priorities.erase(priorities.begin());
+                inheap[m - &elements[0]] = false;
+                h.pop();
+                BOOST_CHECK(!h.contains(m));
+            }
+            break;
+        }
+
+        BOOST_CHECK(h.size() == priorities.size());
+        if (!h.empty()) {
+            BOOST_CHECK(h.min()->priority == *priorities.begin());
+        }
+    }
+
+    h.clear();
+    BOOST_CHECK(h.empty());
+    for (auto& e : elements) {
+        BOOST_CHECK(!h.contains(&e));
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(KeyedMakeTest, Heap, keyed_heap_types)
+{
+    std::vector<open_element> elements = { 8, 10, 4, 2, 12 };
+
+    Heap h;
+    for (auto& e : elements) {
+        h.push(&e);
+    }
+
+    // reverse the order of all elements
+    for (auto& e : elements) {
+        e.priority = 20 - e.priority;
+    }
+    h.make();
+
+    BOOST_CHECK(h.min() == &elements[4]);
+    h.pop();
+    BOOST_CHECK(h.min() == &elements[1]);
+    h.pop();
+    BOOST_CHECK(h.min() == &elements[0]);
+    h.pop();
+    BOOST_CHECK(h.min() == &elements[2]);
+    h.pop();
+    BOOST_CHECK(h.min() == &elements[3]);
+    h.pop();
+    BOOST_CHECK(h.empty());
+}
+
+BOOST_AUTO_TEST_CASE(BucketQueueOverflowTest)
+{
+    // priorities beyond the window of 10 buckets share the overflow bucket
+    std::vector<open_element> elements = { 150, 7, 100, 120, 3 };
+
+    bucket_queue_type h(open_element_key(), 10);
+    for (auto& e : elements) {
+        h.push(&e);
+    }
+
+    std::vector<int> popped;
+    while (!h.empty()) {
+        popped.push_back(h.min()->priority);
+        h.pop();
+    }
+    BOOST_CHECK(popped == std::vector<int>({ 3, 7, 100, 120, 150 }));
+}
+
+// Apply random pushes, pops, and priority changes over a range of priorities
+// much wider than the window, and compare the minimum element against the
+// minimum over all elements in the queue
+BOOST_AUTO_TEST_CASE(BucketQueueWindowTest)
+{
+    std::default_random_engine rng;
+    std::uniform_int_distribution<int> op_dist(0, 3);
+    std::uniform_int_distribution<int> priority_dist(0, 1000000);
+
+    std::vector<open_element> elements(200);
+    std::uniform_int_distribution<int> index_dist(0, elements.size() - 1);
+
+    bucket_queue_type buckets(open_element_key(), 16);
+
+    auto min_priority = [&]()
+    {
+        int p = std::numeric_limits<int>::max();
+        for (auto& e : elements) {
+            if (buckets.contains(&e)) {
+                p = std::min(p, e.priority);
+            }
+        }
+        return p;
+    };
+
+    size_t size = 0;
+    for (int i = 0; i < 20000; ++i) {
+        auto& e = elements[index_dist(rng)];
+        switch (op_dist(rng)) {
+        case 0:
+            if (!buckets.contains(&e)) {
+                e.priority = priority_dist(rng);
+                buckets.push(&e);
+                ++size;
+            }
+            break;
+        case 1:
+            if (buckets.contains(&e)) {
+                e.priority = priority_dist(rng);
+                buckets.update(&e);
+            }
+            break;
+        case 2:
+            if (!buckets.empty()) {
+                BOOST_REQUIRE_EQUAL(buckets.min()->priority, min_priority());
+                buckets.pop();
+                --size;
+            }
+            break;
+        case 3:
+            for (auto& other : elements) {
+                if (buckets.contains(&other)) {
+                    other.priority /= 2;
+                }
+            }
+            buckets.make();
+            break;
+        }
+        BOOST_REQUIRE_EQUAL(buckets.size(), size);
+    }
+
+    size_t count = 0;
+    buckets.for_each([&](open_element*) { ++count; });
+    BOOST_CHECK_EQUAL(count, size);
+
+    while (!buckets.empty()) {
+        BOOST_REQUIRE_EQUAL(buckets.min()->priority, min_priority());
+        buckets.pop();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(OpenListSetTypeTest)
+{
+    std::vector<open_element> elements = { 8, 10, 4, 2, 12 };
+
+    smpl::intrusive_open_list<open_element, open_element_key> open;
+    BOOST_CHECK(open.type() == smpl::OpenListType::BinaryHeap);
+    for (auto& e : elements) {
+        open.push(&e);
+    }
+
+    open.set_type(smpl::OpenListType::QuaternaryHeap);
+    BOOST_CHECK(open.size() == elements.size());
+    BOOST_CHECK(open.min() == &elements[3]);
+
+    open.set_type(smpl::OpenListType::BucketQueue);
+    BOOST_CHECK(open.size() == elements.size());
+    BOOST_CHECK(open.min() == &elements[3]);
+
+    auto* e = open.find_if([](open_element* e) { return e->priority > 9; });
+    BOOST_CHECK(e && e->priority > 9);
+
+    int count = 0;
+    open.for_each([&](open_element*) { ++count; });
+    BOOST_CHECK(count == (int)elements.size());
+}
+
+// Simulate the open list traffic of a best-first search: repeatedly remove the
+// minimum element, then generate a few successors with slightly larger
+// priorities, some of which are already in the heap and have their priorities
+// decreased. Returns the sum of the popped priorities.
+template <class Heap>
+long long RunSearchWorkload(Heap& h, std::vector<open_element>& elements)
+{
+    std::default_random_engine rng;
+    std::uniform_int_distribution<int> dist(0, elements.size() - 1);
+    std::uniform_int_distribution<int> cost_dist(10, 200);
+
+    for (auto& e : elements) {
+        e.priority = 0;
+    }
+
+    long long sum = 0;
+    h.push(&elements[0]);
+    for (size_t i = 0; i < elements.size() && !h.empty(); ++i) {
+        open_element* m = h.min();
+        h.pop();
+        sum += m->priority;
+
+        for (int s = 0; s < 8; ++s) {
+            open_element& succ = elements[dist(rng)];
+            int f = m->priority + cost_dist(rng);
+            if (h.contains(&succ)) {
+                if (f < succ.priority) {
+                    succ.priority = f;
+                    h.decrease(&succ);
+                }
+            } else if (succ.priority == 0) {
+                succ.priority = f;
+                h.push(&succ);
+            }
+        }
+    }
+    h.clear();
+    return sum;
+}
+
+BOOST_AUTO_TEST_CASE(HeapBenchmark)
+{
+    const int num_elements = 1000000;
+    std::vector<open_element> elements(num_elements);
+
+    auto time = [&](const char* name, std::function<long long()> fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        long long sum = fn();
+        auto finish = std::chrono::steady_clock::now();
+        printf("%-16s %8.3f ms (checksum %lld)\n", name,
+                std::chrono::duration<double, std::milli>(finish - start).count(),
+                sum);
+    };
+
+    heap_type binary;
+    time("binary heap", [&]() { return RunSearchWorkload(binary, elements); });
+
+    dary_heap_type quaternary;
+    time("4-ary heap", [&]() { return RunSearchWorkload(quaternary, elements); });
+
+    bucket_queue_type buckets;
+    time("bucket queue", [&]() { return RunSearchWorkload(buckets, elements); });
+
+    smpl::intrusive_open_list<open_element, open_element_key> open(
+            smpl::OpenListType::QuaternaryHeap);
+    time("open list", [&]() { return RunSearchWorkload(open, elements); });
+
+    BOOST_CHECK(binary.empty());
+    BOOST_CHECK(quaternary.empty());
+    BOOST_CHECK(buckets.empty());
+    BOOST_CHECK(open.empty());
+}
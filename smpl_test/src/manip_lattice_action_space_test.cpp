@@ -0,0 +1,215 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE ManipLatticeActionSpaceTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/collision_checker.h>
+#include <smpl/robot_model.h>
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/graph/manip_lattice_action_space.h>
+
+static const int kJointCount = 7;
+
+class ArmModel : public smpl::RobotModel
+{
+public:
+
+    ArmModel()
+    {
+        std::vector<std::string> joints;
+        for (int i = 0; i < kJointCount; ++i) {
+            joints.push_back("j" + std::to_string(i));
+        }
+        setPlanningJoints(joints);
+    }
+
+    double minPosLimit(int vidx) const override { return -M_PI; }
+    double maxPosLimit(int vidx) const override { return M_PI; }
+    bool hasPosLimit(int vidx) const override { return true; }
+    bool isContinuous(int vidx) const override { return false; }
+    double velLimit(int vidx) const override { return 0.0; }
+    double accLimit(int vidx) const override { return 0.0; }
+
+    bool checkJointLimits(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::RobotModel>()) {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+class NullChecker : public smpl::CollisionChecker
+{
+public:
+
+    bool isStateValid(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    bool isStateToStateValid(
+        const smpl::RobotState&,
+        const smpl::RobotState&,
+        bool) override
+    {
+        return true;
+    }
+
+    bool interpolatePath(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        std::vector<smpl::RobotState>& path) override
+    {
+        path = { start, finish };
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::CollisionChecker>()) {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+struct TestLattice : public smpl::ManipLattice
+{
+    smpl::ManipLatticeActionSpace actions;
+};
+
+static bool InitLattice(ArmModel* model, NullChecker* checker, TestLattice* space)
+{
+    std::vector<double> res(kJointCount, 2.0 * M_PI / 180.0);
+    if (!space->init(model, checker, res, &space->actions) ||
+        !space->actions.init(space))
+    {
+        return false;
+    }
+
+    // one long and one short distance primitive, and their converses, for
+    // each joint
+    for (int i = 0; i < kJointCount; ++i) {
+        std::vector<double> d(kJointCount, 0.0);
+        d[i] = 8.0 * res[i];
+        space->actions.addMotionPrim(d, false);
+        d[i] = res[i];
+        space->actions.addMotionPrim(d, true);
+    }
+    return true;
+}
+
+static auto MakeState(int i) -> smpl::RobotState
+{
+    smpl::RobotState state(kJointCount);
+    for (int j = 0; j < kJointCount; ++j) {
+        state[j] = 0.01 * (i + j);
+    }
+    return state;
+}
+
+BOOST_AUTO_TEST_CASE(BufferedMatchesApplyTest)
+{
+    ArmModel model;
+    NullChecker checker;
+    TestLattice space;
+    BOOST_REQUIRE(InitLattice(&model, &checker, &space));
+    auto& actions = space.actions;
+
+    std::vector<smpl::Action> buffer;
+    std::size_t count = 0;
+
+    auto check = [&](int i, std::size_t expected_count)
+    {
+        auto state = MakeState(i);
+
+        std::vector<smpl::Action> expected;
+        BOOST_REQUIRE(actions.apply(state, expected));
+        BOOST_REQUIRE(actions.applyBuffered(state, buffer, count));
+
+        BOOST_REQUIRE_EQUAL(expected.size(), expected_count);
+        BOOST_REQUIRE_EQUAL(count, expected.size());
+        BOOST_REQUIRE_GE(buffer.size(), count);
+        for (std::size_t a = 0; a < count; ++a) {
+            BOOST_CHECK(buffer[a] == expected[a]);
+        }
+    };
+
+    // long distance primitives only
+    check(0, 2 * kJointCount);
+
+    // short distance primitives near the start or goal, where the distance
+    // is 0 without a heuristic
+    actions.useAmp(smpl::MotionPrimitive::SHORT_DISTANCE, true);
+    check(1, 2 * kJointCount);
+
+    // a larger set of actions
+    actions.useLongAndShortPrims(true);
+    check(2, 4 * kJointCount);
+
+    // a smaller set of actions reuses the front of the buffer
+    actions.useLongAndShortPrims(false);
+    check(3, 2 * kJointCount);
+    BOOST_CHECK_EQUAL(buffer.size(), 4 * kJointCount);
+
+    // primitives added after the first expansion are applied
+    std::vector<double> d(kJointCount, 0.1);
+    actions.addMotionPrim(d, true, false);
+    check(4, 2 * kJointCount + 1);
+
+    // apply() appends to existing actions
+    std::vector<smpl::Action> appended(1);
+    BOOST_REQUIRE(actions.apply(MakeState(5), appended));
+    BOOST_CHECK_EQUAL(appended.size(), 2 * kJointCount + 2);
+    BOOST_CHECK(appended.front().empty());
+}
+
+BOOST_AUTO_TEST_CASE(ApplyBenchmark)
+{
+    ArmModel model;
+    NullChecker checker;
+    TestLattice space;
+    BOOST_REQUIRE(InitLattice(&model, &checker, &space));
+    auto& actions = space.actions;
+    actions.useAmp(smpl::MotionPrimitive::SHORT_DISTANCE, true);
+    actions.useLongAndShortPrims(true);
+
+    const int num_expansions = 100000;
+
+    std::size_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_expansions; ++i) {
+        std::vector<smpl::Action> fresh;
+        actions.apply(MakeState(i), fresh);
+        sum += fresh.size();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    printf("apply:         %0.3f us/expansion\n",
+            std::chrono::duration<double, std::micro>(finish - start).count() /
+                    num_expansions);
+
+    std::vector<smpl::Action> buffer;
+    std::size_t count;
+    std::size_t buffered_sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_expansions; ++i) {
+        actions.applyBuffered(MakeState(i), buffer, count);
+        buffered_sum += count;
+    }
+    finish = std::chrono::steady_clock::now();
+    printf("applyBuffered: %0.3f us/expansion\n",
+            std::chrono::duration<double, std::micro>(finish - start).count() /
+                    num_expansions);
+
+    BOOST_CHECK_EQUAL(sum, buffered_sum);
+}
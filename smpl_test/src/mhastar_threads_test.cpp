@@ -0,0 +1,264 @@
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE MHAStarThreadsTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/graph/manip_lattice_action_space.h>
+#include <smpl/heuristic/bfs_heuristic.h>
+#include <smpl/heuristic/euclid_dist_heuristic.h>
+#include <smpl/heuristic/robot_heuristic.h>
+#include <smpl/search/smhastar.h>
+#include <smpl/search/umhastar.h>
+
+#include "planar_arm.h"
+
+static const int kJointCount = 3;
+static const double kRes = 2.0 * M_PI / 180.0;
+
+// a planar arm whose forward kinematics may be copied for use by other
+// threads. Records whether any instance, source or copy, was ever queried
+// from two threads at once, and how many queries were made through copies.
+class CloneablePlanarArmModel :
+    public PlanarArmModel,
+    public smpl::CloneableForwardKinematicsInterface
+{
+public:
+
+    explicit CloneablePlanarArmModel(
+        int joint_count,
+        CloneablePlanarArmModel* source = nullptr)
+    :
+        PlanarArmModel(joint_count),
+        m_joint_count(joint_count),
+        m_source(source)
+    { }
+
+    std::atomic<bool> overlapped{false};
+    std::atomic<int> copy_queries{0};
+
+    smpl::Affine3 computeFK(const smpl::RobotState& state) override
+    {
+        auto* source = m_source ? m_source : this;
+        if (m_active.fetch_add(1) != 0) {
+            source->overlapped = true;
+        }
+        if (m_source) {
+            ++m_source->copy_queries;
+        }
+        // widen the window in which a concurrent query would be seen
+        std::this_thread::yield();
+        auto pose = PlanarArmModel::computeFK(state);
+        m_active.fetch_sub(1);
+        return pose;
+    }
+
+    auto cloneForwardKinematics()
+        -> std::unique_ptr<smpl::ForwardKinematicsInterface> override
+    {
+        return std::unique_ptr<smpl::ForwardKinematicsInterface>(
+                new CloneablePlanarArmModel(m_joint_count, this));
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::CloneableForwardKinematicsInterface>()) {
+            return this;
+        }
+        return PlanarArmModel::getExtension(class_code);
+    }
+
+private:
+
+    int m_joint_count;
+    CloneablePlanarArmModel* m_source;
+    std::atomic<int> m_active{0};
+};
+
+// a weighted distance from the tip of the arm to the goal, projected through
+// the planning space's own forward kinematics, and so not safe to evaluate
+// concurrently with other heuristics
+class SharedProjectionHeuristic : public smpl::RobotHeuristic
+{
+public:
+
+    bool init(smpl::RobotPlanningSpace* space)
+    {
+        if (!RobotHeuristic::init(space)) {
+            return false;
+        }
+        m_proj = space->getExtension<smpl::PointProjectionExtension>();
+        return m_proj != nullptr;
+    }
+
+    double getMetricStartDistance(double, double, double) override { return 0.0; }
+    double getMetricGoalDistance(double, double, double) override { return 0.0; }
+
+    int GetGoalHeuristic(int state_id) override
+    {
+        smpl::Vector3 p;
+        if (!m_proj->projectToPoint(state_id, p)) {
+            return 0;
+        }
+        auto& goal = planningSpace()->goal().pose.translation();
+        return (int)(2000.0 * (goal - p).norm());
+    }
+
+    int GetStartHeuristic(int) override { return 0; }
+    int GetFromToHeuristic(int, int) override { return 0; }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::RobotHeuristic>()) {
+            return this;
+        }
+        return nullptr;
+    }
+
+private:
+
+    smpl::PointProjectionExtension* m_proj = nullptr;
+};
+
+template <typename Search>
+static auto MakeSearch(
+    smpl::ManipLattice* space,
+    Heuristic* anchor,
+    Heuristic** heurs,
+    int count)
+    -> std::unique_ptr<Search>
+{
+    return std::unique_ptr<Search>(new Search(space, anchor, heurs, count));
+}
+
+template <>
+auto MakeSearch<smpl::SMHAStar>(
+    smpl::ManipLattice* space,
+    Heuristic* anchor,
+    Heuristic** heurs,
+    int count)
+    -> std::unique_ptr<smpl::SMHAStar>
+{
+    std::unique_ptr<smpl::SMHAStar> search(new smpl::SMHAStar);
+    BOOST_REQUIRE(search->Init(space, anchor, heurs, count));
+    return search;
+}
+
+static bool IsConcurrent(smpl::Extension* h)
+{
+    return h->getExtension<smpl::ConcurrentHeuristicExtension>() != nullptr;
+}
+
+struct PlanResult
+{
+    bool solved = false;
+    int cost = 0;
+    int expansions = 0;
+    std::vector<smpl::RobotState> path;
+};
+
+// Plan around the post with the anchor heuristic repeated as an inadmissible
+// heuristic, a BFS heuristic, and a heuristic that does not report
+// ConcurrentHeuristicExtension
+template <typename Search>
+static auto Plan(int num_threads) -> PlanResult
+{
+    auto grid = MakePostGrid(0.9, 0.9);
+    CloneablePlanarArmModel model(kJointCount);
+    PlanarArmChecker checker(&model, &grid, kRes);
+
+    smpl::ManipLattice space;
+    smpl::ManipLatticeActionSpace actions;
+    std::vector<double> res(kJointCount, kRes);
+    BOOST_REQUIRE(space.init(&model, &checker, res, &actions));
+    BOOST_REQUIRE(actions.init(&space));
+    for (int i = 0; i < kJointCount; ++i) {
+        std::vector<double> d(kJointCount, 0.0);
+        d[i] = kRes;
+        actions.addMotionPrim(d, false);
+    }
+
+    smpl::EuclidDistHeuristic euclid;
+    BOOST_REQUIRE(euclid.init(&space));
+    euclid.setWeightRot(0.0);
+    smpl::BfsHeuristic bfs;
+    BOOST_REQUIRE(bfs.init(&space, &grid));
+    bfs.setCostPerCell(20);
+    SharedProjectionHeuristic shared;
+    BOOST_REQUIRE(shared.init(&space));
+
+    BOOST_REQUIRE(IsConcurrent(&euclid));
+    BOOST_REQUIRE(IsConcurrent(&bfs));
+    BOOST_REQUIRE(!IsConcurrent(&shared));
+
+    space.insertHeuristic(&euclid);
+    space.insertHeuristic(&bfs);
+    space.insertHeuristic(&shared);
+
+    BOOST_REQUIRE(space.setGoal(MakeTipGoal(0.4, 1.2)));
+    BOOST_REQUIRE(space.setStart({ 0.0, 0.0, 0.0 }));
+    euclid.updateGoal(space.goal());
+    bfs.updateGoal(space.goal());
+    shared.updateGoal(space.goal());
+
+    Heuristic* heurs[] = { &euclid, &bfs, &shared };
+    auto search = MakeSearch<Search>(&space, &euclid, heurs, 3);
+    search->set_num_threads(num_threads);
+    BOOST_CHECK_EQUAL(search->get_num_threads(), num_threads);
+    BOOST_REQUIRE(search->set_start(space.getStartStateID()));
+    BOOST_REQUIRE(search->set_goal(space.getGoalStateID()));
+
+    ReplanParams params(10.0);
+    params.initial_eps = 20.0;
+    params.final_eps = 20.0;
+    params.return_first_solution = true;
+
+    PlanResult result;
+    std::vector<int> solution;
+    result.solved = search->replan(&solution, params, &result.cost) &&
+            space.extractPath(solution, result.path);
+    result.expansions = search->get_n_expands();
+
+    BOOST_CHECK(!model.overlapped);
+    if (num_threads > 1) {
+        BOOST_CHECK_GT(model.copy_queries, 0);
+    }
+
+    space.eraseHeuristic(&euclid);
+    space.eraseHeuristic(&bfs);
+    space.eraseHeuristic(&shared);
+    return result;
+}
+
+// Evaluating heuristics on a pool must not change the search
+template <typename Search>
+static void CheckThreadsAgree(const char* name)
+{
+    auto serial = Plan<Search>(1);
+    auto parallel = Plan<Search>(4);
+
+    printf("%s: %d expansions, %zu waypoints\n",
+            name, serial.expansions, serial.path.size());
+
+    BOOST_REQUIRE(serial.solved);
+    BOOST_REQUIRE(parallel.solved);
+    BOOST_CHECK_EQUAL(serial.cost, parallel.cost);
+    BOOST_CHECK_EQUAL(serial.expansions, parallel.expansions);
+    BOOST_CHECK(serial.path == parallel.path);
+}
+
+BOOST_AUTO_TEST_CASE(UMHAStarThreadsTest)
+{
+    CheckThreadsAgree<smpl::UMHAStar>("UMHA*");
+}
+
+BOOST_AUTO_TEST_CASE(SMHAStarThreadsTest)
+{
+    CheckThreadsAgree<smpl::SMHAStar>("SMHA*");
+}
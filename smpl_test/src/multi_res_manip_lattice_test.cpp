@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE MultiResManipLatticeTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/graph/manip_lattice_action_space.h>
+#include <smpl/graph/multi_res_manip_lattice.h>
+#include <smpl/heuristic/euclid_dist_heuristic.h>
+#include <smpl/search/arastar.h>
+
+#include "planar_arm.h"
+
+static const int kJointCount = 3;
+static const double kRes = 2.0 * M_PI / 180.0;
+
+static void AddFinePrims(smpl::ManipLatticeActionSpace& actions)
+{
+    for (int i = 0; i < kJointCount; ++i) {
+        std::vector<double> d(kJointCount, 0.0);
+        d[i] = kRes;
+        actions.addMotionPrim(d, false);
+    }
+}
+
+static void AddCoarsePrims(smpl::ManipLatticeActionSpace& actions, int factor)
+{
+    for (int i = 0; i < kJointCount; ++i) {
+        std::vector<double> d(kJointCount, 0.0);
+        d[i] = factor * kRes;
+        actions.addMotionPrim(d, false);
+    }
+}
+
+struct FineLattice : public smpl::ManipLattice
+{
+    smpl::ManipLatticeActionSpace actions;
+};
+
+struct MultiResLattice : public smpl::MultiResManipLattice
+{
+    smpl::ManipLatticeActionSpace actions;
+    smpl::ManipLatticeActionSpace coarse_actions;
+
+    int getOrCreateState(const smpl::RobotState& state)
+    {
+        smpl::RobotCoord coord(state.size());
+        stateToCoord(state, coord);
+        return ManipLattice::getOrCreateState(coord, state);
+    }
+};
+
+static auto MakeGoal() -> smpl::GoalConstraint
+{
+    return MakeTipGoal(-0.4, 1.2);
+}
+
+struct PlanResult
+{
+    bool solved = false;
+    int expansions = 0;
+    int checks = 0;
+    std::vector<smpl::RobotState> path;
+};
+
+static auto Plan(
+    smpl::ManipLattice& space,
+    PlanarArmChecker& checker)
+    -> PlanResult
+{
+    PlanResult result;
+
+    smpl::EuclidDistHeuristic h;
+    BOOST_REQUIRE(h.init(&space));
+    h.setWeightRot(0.0);
+    space.insertHeuristic(&h);
+
+    smpl::ARAStar search(&space, &h);
+
+    BOOST_REQUIRE(space.setGoal(MakeGoal()));
+    BOOST_REQUIRE(space.setStart({ 0.0, 0.0, 0.0 }));
+    h.updateGoal(space.goal());
+    BOOST_REQUIRE(search.set_start(space.getStartStateID()));
+    BOOST_REQUIRE(search.set_goal(space.getGoalStateID()));
+
+    ReplanParams params(10.0);
+    params.initial_eps = 50.0;
+    params.final_eps = 50.0;
+    params.return_first_solution = true;
+
+    checker.check_count = 0;
+    std::vector<int> solution;
+    int cost;
+    result.solved = search.replan(&solution, params, &cost) &&
+            space.extractPath(solution, result.path);
+    result.expansions = search.get_n_expands();
+    result.checks = checker.check_count;
+
+    space.eraseHeuristic(&h);
+    return result;
+}
+
+static bool InitMultiResLattice(
+    PlanarArmModel* model,
+    PlanarArmChecker* checker,
+    const smpl::OccupancyGrid* grid,
+    MultiResLattice* space)
+{
+    smpl::MultiResManipLattice::Params params;
+    params.coarse_factor = 4;
+    params.fine_goal_distance = 0.2;
+    params.fine_obstacle_distance = 0.15;
+    std::vector<double> res(kJointCount, kRes);
+    if (!space->init(
+            model, checker, res,
+            &space->actions, &space->coarse_actions,
+            grid, params) ||
+        !space->actions.init(space) ||
+        !space->coarse_actions.init(space))
+    {
+        return false;
+    }
+    AddFinePrims(space->actions);
+    AddCoarsePrims(space->coarse_actions, params.coarse_factor);
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(CoarseSuccessorsTest)
+{
+    auto grid = MakePostGrid(0.9, 0.9);
+    PlanarArmModel model(kJointCount);
+    PlanarArmChecker checker(&model, &grid, kRes);
+    MultiResLattice space;
+    BOOST_REQUIRE(InitMultiResLattice(&model, &checker, &grid, &space));
+
+    smpl::EuclidDistHeuristic h;
+    BOOST_REQUIRE(h.init(&space));
+    space.insertHeuristic(&h);
+
+    BOOST_REQUIRE(space.setGoal(MakeGoal()));
+    BOOST_REQUIRE(space.setStart({ 0.0, 0.0, 0.0 }));
+    h.updateGoal(space.goal());
+
+    // the coarse lattice passes through the start state, which is far from
+    // the goal and from the post
+    auto start_id = space.getStartStateID();
+    BOOST_REQUIRE(space.isCoarseState(start_id));
+    BOOST_REQUIRE(space.useCoarseActions(start_id));
+
+    std::vector<int> succs, costs;
+    space.GetSuccs(start_id, &succs, &costs);
+    BOOST_REQUIRE_EQUAL(succs.size(), 2 * kJointCount);
+    for (size_t i = 0; i < succs.size(); ++i) {
+        BOOST_CHECK(space.isCoarseState(succs[i]));
+        BOOST_CHECK_EQUAL(costs[i], 4 * 1000);
+    }
+
+    // the true costs of lazily generated edges agree with their costs
+    std::vector<int> lazy_succs, lazy_costs;
+    std::vector<bool> true_costs;
+    space.GetLazySuccs(start_id, &lazy_succs, &lazy_costs, &true_costs);
+    BOOST_REQUIRE(lazy_succs == succs);
+    for (size_t i = 0; i < lazy_succs.size(); ++i) {
+        BOOST_CHECK_EQUAL(space.GetTrueCost(start_id, lazy_succs[i]), lazy_costs[i]);
+    }
+
+    // a state off the coarse lattice is expanded at the fine resolution, and
+    // shares its successors with the coarse lattice
+    auto off_id = space.getOrCreateState({ kRes, 0.0, 0.0 });
+    BOOST_CHECK(!space.isCoarseState(off_id));
+    BOOST_CHECK(!space.useCoarseActions(off_id));
+    std::vector<int> fine_succs, fine_costs;
+    space.GetSuccs(off_id, &fine_succs, &fine_costs);
+    BOOST_CHECK(std::find(fine_succs.begin(), fine_succs.end(), start_id) != fine_succs.end());
+    for (auto c : fine_costs) {
+        BOOST_CHECK_EQUAL(c, 1000);
+    }
+
+    // states near the goal are expanded at the fine resolution
+    auto near_id = space.getOrCreateState({ 28 * kRes, 36 * kRes, 0.0 });
+    smpl::Vector3 tip = model.computeFK(space.extractState(near_id)).translation();
+    BOOST_REQUIRE(space.isCoarseState(near_id));
+    BOOST_REQUIRE_LT((tip - MakeGoal().pose.translation()).norm(), 0.2);
+    BOOST_CHECK(!space.useCoarseActions(near_id));
+
+    space.eraseHeuristic(&h);
+}
+
+BOOST_AUTO_TEST_CASE(PlanExpansionsTest)
+{
+    auto grid = MakePostGrid(0.9, 0.9);
+    PlanarArmModel model(kJointCount);
+    PlanarArmChecker checker(&model, &grid, kRes);
+
+    FineLattice fine;
+    std::vector<double> res(kJointCount, kRes);
+    BOOST_REQUIRE(fine.init(&model, &checker, res, &fine.actions));
+    BOOST_REQUIRE(fine.actions.init(&fine));
+    AddFinePrims(fine.actions);
+
+    MultiResLattice multi;
+    BOOST_REQUIRE(InitMultiResLattice(&model, &checker, &grid, &multi));
+
+    auto fine_result = Plan(fine, checker);
+    auto multi_result = Plan(multi, checker);
+
+    printf("fine:             %6d expansions, %7d state checks, %zu waypoints\n",
+            fine_result.expansions, fine_result.checks, fine_result.path.size());
+    printf("multi-resolution: %6d expansions, %7d state checks, %zu waypoints\n",
+            multi_result.expansions, multi_result.checks, multi_result.path.size());
+
+    BOOST_REQUIRE(fine_result.solved);
+    BOOST_REQUIRE(multi_result.solved);
+
+    // the path reaches the goal without collisions
+    auto goal = MakeGoal();
+    smpl::Vector3 tip = model.computeFK(multi_result.path.back()).translation();
+    BOOST_CHECK_SMALL(tip.x() - goal.pose.translation().x(), 0.03 + 1e-9);
+    BOOST_CHECK_SMALL(tip.y() - goal.pose.translation().y(), 0.03 + 1e-9);
+    for (size_t i = 1; i < multi_result.path.size(); ++i) {
+        BOOST_CHECK(checker.isStateToStateValid(
+                multi_result.path[i - 1], multi_result.path[i], false));
+    }
+
+    BOOST_CHECK_LT(multi_result.expansions, fine_result.expansions);
+}
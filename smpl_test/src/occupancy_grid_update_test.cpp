@@ -0,0 +1,168 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <Eigen/Dense>
+#define BOOST_TEST_MODULE OccupancyGridUpdateTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/occupancy_grid.h>
+#include <smpl/geometry/voxelize.h>
+
+static const double kSizeX = 2.0;
+static const double kSizeY = 2.0;
+static const double kSizeZ = 1.0;
+static const double kRes = 0.02;
+static const double kOriginX = -1.0;
+static const double kOriginY = -1.0;
+static const double kOriginZ = 0.0;
+static const double kMaxDist = 0.2;
+
+static auto MakeGrid(bool ref_counted) -> smpl::OccupancyGrid
+{
+    return smpl::OccupancyGrid(
+            kSizeX, kSizeY, kSizeZ,
+            kRes,
+            kOriginX, kOriginY, kOriginZ,
+            kMaxDist,
+            ref_counted);
+}
+
+// voxelize a tote-sized box, the way a tracked collision object would be
+static auto VoxelizeObject(const Eigen::Vector3d& pos)
+    -> std::vector<Eigen::Vector3d>
+{
+    std::vector<Eigen::Vector3d> voxels;
+    smpl::geometry::VoxelizeBox(
+            0.4, 0.3, 0.2,
+            Eigen::Affine3d(Eigen::Translation3d(pos)),
+            kRes,
+            Eigen::Vector3d(kOriginX, kOriginY, kOriginZ),
+            voxels);
+    return voxels;
+}
+
+static bool SameDistances(
+    const smpl::OccupancyGrid& g1,
+    const smpl::OccupancyGrid& g2)
+{
+    for (int x = 0; x < g1.numCellsX(); ++x) {
+    for (int y = 0; y < g1.numCellsY(); ++y) {
+    for (int z = 0; z < g1.numCellsZ(); ++z) {
+        if (g1.getDistance(x, y, z) != g2.getDistance(x, y, z)) {
+            return false;
+        }
+    }
+    }
+    }
+    return true;
+}
+
+static void TestUpdateMatchesRemoveAdd(bool ref_counted)
+{
+    auto g1 = MakeGrid(ref_counted);
+    auto g2 = MakeGrid(ref_counted);
+
+    // a static obstacle that overlaps the path of the moving object. Without
+    // reference counting, the shared cells are cleared by either update.
+    if (ref_counted) {
+        auto wall = VoxelizeObject(Eigen::Vector3d(0.1, 0.0, 0.5));
+        g1.addPointsToField(wall);
+        g2.addPointsToField(wall);
+    }
+
+    Eigen::Vector3d pos(-0.5, 0.0, 0.5);
+    auto voxels = VoxelizeObject(pos);
+    g1.addPointsToField(voxels);
+    g2.addPointsToField(voxels);
+
+    for (int i = 0; i < 20; ++i) {
+        pos.x() += 0.05;
+        auto new_voxels = VoxelizeObject(pos);
+
+        g1.removePointsFromField(voxels);
+        g1.addPointsToField(new_voxels);
+
+        g2.updatePointsInField(voxels, new_voxels);
+
+        voxels = std::move(new_voxels);
+
+        BOOST_REQUIRE(SameDistances(g1, g2));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(UpdateMatchesRemoveAddTest)
+{
+    TestUpdateMatchesRemoveAdd(false);
+    TestUpdateMatchesRemoveAdd(true);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateRefCountsTest)
+{
+    auto g = MakeGrid(true);
+
+    auto voxels = VoxelizeObject(Eigen::Vector3d(0.0, 0.0, 0.5));
+    g.addPointsToField(voxels);
+    g.addPointsToField(voxels);
+
+    // moving one of two coincident objects must leave the other intact
+    auto moved = VoxelizeObject(Eigen::Vector3d(0.3, 0.0, 0.5));
+    g.updatePointsInField(voxels, moved);
+
+    for (auto& v : voxels) {
+        BOOST_REQUIRE(g.getDistanceFromPoint(v.x(), v.y(), v.z()) == 0.0);
+    }
+    for (auto& v : moved) {
+        BOOST_REQUIRE(g.getDistanceFromPoint(v.x(), v.y(), v.z()) == 0.0);
+    }
+
+    // removing both leaves only the moved object
+    g.removePointsFromField(voxels);
+    auto expected = MakeGrid(true);
+    expected.addPointsToField(moved);
+    BOOST_CHECK(SameDistances(g, expected));
+}
+
+// A tracked object moving 1 cm per frame through the grid, updated either by
+// removing and reinserting all of its voxels or by updating only the cells
+// that changed.
+BOOST_AUTO_TEST_CASE(MovingObjectBenchmark)
+{
+    const int num_frames = 100;
+    const double step = 0.01;
+
+    auto time = [&](const char* name, bool ref_counted, bool differential)
+    {
+        auto g = MakeGrid(ref_counted);
+        Eigen::Vector3d pos(-0.5, 0.0, 0.5);
+        auto voxels = VoxelizeObject(pos);
+        g.addPointsToField(voxels);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_frames; ++i) {
+            pos.x() += step;
+            auto new_voxels = VoxelizeObject(pos);
+            if (differential) {
+                g.updatePointsInField(voxels, new_voxels);
+            } else {
+                g.removePointsFromField(voxels);
+                g.addPointsToField(new_voxels);
+            }
+            voxels = std::move(new_voxels);
+        }
+        auto finish = std::chrono::steady_clock::now();
+        printf("%-24s %8.3f ms/frame\n", name,
+                std::chrono::duration<double, std::milli>(finish - start).count() /
+                        num_frames);
+        return g;
+    };
+
+    auto g1 = time("remove + add", false, false);
+    auto g2 = time("update", false, true);
+    auto g3 = time("remove + add (counted)", true, false);
+    auto g4 = time("update (counted)", true, true);
+
+    BOOST_CHECK(SameDistances(g1, g2));
+    BOOST_CHECK(SameDistances(g3, g4));
+}
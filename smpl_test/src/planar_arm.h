@@ -0,0 +1,199 @@
+#ifndef SMPL_TEST_PLANAR_ARM_H
+#define SMPL_TEST_PLANAR_ARM_H
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <smpl/collision_checker.h>
+#include <smpl/occupancy_grid.h>
+#include <smpl/robot_model.h>
+#include <smpl/spatial.h>
+#include <smpl/graph/goal_constraint.h>
+
+// a planar arm in the xy plane, with links of equal length and the planning
+// link at the tip of the last link
+class PlanarArmModel : public smpl::ForwardKinematicsInterface
+{
+public:
+
+    static constexpr double LinkLength = 0.5;
+
+    explicit PlanarArmModel(int joint_count) : m_joint_count(joint_count)
+    {
+        std::vector<std::string> joints;
+        for (int j = 0; j < joint_count; ++j) {
+            joints.push_back("j" + std::to_string(j));
+        }
+        setPlanningJoints(joints);
+    }
+
+    double minPosLimit(int vidx) const override { return -M_PI; }
+    double maxPosLimit(int vidx) const override { return M_PI; }
+    bool hasPosLimit(int vidx) const override { return true; }
+    bool isContinuous(int vidx) const override { return false; }
+    double velLimit(int vidx) const override { return 0.0; }
+    double accLimit(int vidx) const override { return 0.0; }
+
+    bool checkJointLimits(const smpl::RobotState& state, bool) override
+    {
+        for (auto& v : state) {
+            if (v < -M_PI || v > M_PI) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    smpl::Affine3 computeFK(const smpl::RobotState& state) override
+    {
+        auto points = linkPoints(state, 1);
+        return smpl::Affine3(smpl::Translation3(points.back()));
+    }
+
+    // points spaced evenly along the links of the arm
+    auto linkPoints(const smpl::RobotState& state, int per_link) const
+        -> std::vector<smpl::Vector3>
+    {
+        std::vector<smpl::Vector3> points;
+        smpl::Vector3 p(0.0, 0.0, 0.0);
+        double theta = 0.0;
+        for (int j = 0; j < m_joint_count; ++j) {
+            theta += state[j];
+            smpl::Vector3 d(std::cos(theta), std::sin(theta), 0.0);
+            for (int i = 1; i <= per_link; ++i) {
+                points.push_back(p + (LinkLength * i / per_link) * d);
+            }
+            p += LinkLength * d;
+        }
+        return points;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::RobotModel>() ||
+            class_code == smpl::GetClassCode<smpl::ForwardKinematicsInterface>())
+        {
+            return this;
+        }
+        return nullptr;
+    }
+
+private:
+
+    int m_joint_count;
+};
+
+// checks points along the links of the arm against the occupancy grid, and
+// motions at intermediate states no more than 'res' apart in any joint
+class PlanarArmChecker : public smpl::CollisionChecker
+{
+public:
+
+    PlanarArmChecker(
+        const PlanarArmModel* model,
+        const smpl::OccupancyGrid* grid,
+        double res)
+    :
+        m_model(model), m_grid(grid), m_res(res)
+    { }
+
+    int check_count = 0;
+
+    bool isStateValid(const smpl::RobotState& state, bool) override
+    {
+        ++check_count;
+        for (auto& p : m_model->linkPoints(state, 25)) {
+            if (m_grid->getDistanceFromPoint(p.x(), p.y(), p.z()) <= 0.0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isStateToStateValid(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        bool) override
+    {
+        std::vector<smpl::RobotState> path;
+        interpolatePath(start, finish, path);
+        for (auto& state : path) {
+            if (!isStateValid(state, false)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool interpolatePath(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        std::vector<smpl::RobotState>& path) override
+    {
+        auto max_diff = 0.0;
+        for (size_t i = 0; i < start.size(); ++i) {
+            max_diff = std::max(max_diff, std::fabs(finish[i] - start[i]));
+        }
+        auto steps = std::max(1, (int)std::ceil(max_diff / m_res));
+        path.clear();
+        for (int s = 0; s <= steps; ++s) {
+            auto t = (double)s / (double)steps;
+            smpl::RobotState state(start.size());
+            for (size_t i = 0; i < start.size(); ++i) {
+                state[i] = (1.0 - t) * start[i] + t * finish[i];
+            }
+            path.push_back(state);
+        }
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::CollisionChecker>()) {
+            return this;
+        }
+        return nullptr;
+    }
+
+private:
+
+    const PlanarArmModel* m_model;
+    const smpl::OccupancyGrid* m_grid;
+    double m_res;
+};
+
+// a 4m x 4m world around the base of the arm with a post of radius 0.1m at
+// (x, y)
+inline auto MakePostGrid(double x, double y) -> smpl::OccupancyGrid
+{
+    smpl::OccupancyGrid grid(4.0, 4.0, 1.0, 0.02, -2.0, -2.0, -0.5, 0.4, false);
+    std::vector<Eigen::Vector3d> points;
+    for (double dx = -0.1; dx <= 0.1; dx += 0.02) {
+    for (double dy = -0.1; dy <= 0.1; dy += 0.02) {
+        if (dx * dx + dy * dy <= 0.01) {
+            points.emplace_back(x + dx, y + dy, 0.0);
+        }
+    }
+    }
+    grid.addPointsToField(points);
+    return grid;
+}
+
+// a goal position for the tip of the arm, within 3cm
+inline auto MakeTipGoal(double x, double y) -> smpl::GoalConstraint
+{
+    smpl::GoalConstraint goal;
+    goal.type = smpl::GoalType::XYZ_GOAL;
+    goal.pose = smpl::Affine3(smpl::Translation3(x, y, 0.0));
+    goal.xyz_tolerance[0] = 0.03;
+    goal.xyz_tolerance[1] = 0.03;
+    goal.xyz_tolerance[2] = 0.03;
+    goal.rpy_tolerance[0] = M_PI;
+    goal.rpy_tolerance[1] = M_PI;
+    goal.rpy_tolerance[2] = M_PI;
+    return goal;
+}
+
+#endif
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#define BOOST_TEST_MODULE PrimitiveCollisionTableTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/collision_checker.h>
+#include <smpl/robot_model.h>
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/graph/manip_lattice_action_space.h>
+#include <smpl/graph/primitive_collision_table.h>
+
+// A two-link arm that collides with itself whenever the second joint is
+// within pi/6 of +/-pi, so that the first and last of 12 cells of the second
+// joint are entirely in collision
+class FoldingChecker : public smpl::SelfCollisionCheckerExtension
+{
+public:
+
+    bool isStateSelfValid(const smpl::RobotState& state, bool) override
+    {
+        return std::fabs(state[1]) < M_PI - M_PI / 6.0;
+    }
+
+    bool isStateToStateSelfValid(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        bool) override
+    {
+        for (int i = 0; i <= 10; ++i) {
+            auto t = 0.1 * i;
+            smpl::RobotState state = {
+                (1.0 - t) * start[0] + t * finish[0],
+                (1.0 - t) * start[1] + t * finish[1],
+            };
+            if (!isStateSelfValid(state, false)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isStateWorldValid(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    bool isStateToStateWorldValid(
+        const smpl::RobotState&,
+        const smpl::RobotState&,
+        bool) override
+    {
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::SelfCollisionCheckerExtension>()) {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+static auto MakeTable() -> smpl::PrimitiveCollisionTable
+{
+    smpl::PrimitiveCollisionTable table;
+    BOOST_REQUIRE(table.init(
+            { -M_PI, -M_PI }, { M_PI, M_PI }, { true, false }, { 1, 12 }));
+    table.addPrimitive({ { 0.0, 0.1 } });
+    table.addPrimitive({ { 0.0, -0.1 } });
+    table.addPrimitive({ { 0.1, 0.0 } });
+    return table;
+}
+
+BOOST_AUTO_TEST_CASE(CellIndexTest)
+{
+    auto table = MakeTable();
+    BOOST_CHECK_EQUAL(table.cellCount(), 12);
+    BOOST_CHECK_EQUAL(table.primitiveCount(), 3);
+
+    for (int c = 0; c < table.cellCount(); ++c) {
+        smpl::RobotState min, max;
+        table.cellBounds(c, min, max);
+        smpl::RobotState mid = { 0.5 * (min[0] + max[0]), 0.5 * (min[1] + max[1]) };
+        BOOST_CHECK_EQUAL(table.cellIndex(mid), c);
+    }
+
+    // the first variable is continuous, and has a single cell
+    BOOST_CHECK_EQUAL(table.cellIndex({ 10.0, 0.1 }), table.cellIndex({ 0.0, 0.1 }));
+
+    // the second variable is bounded
+    BOOST_CHECK_EQUAL(table.cellIndex({ 0.0, 4.0 }), -1);
+}
+
+BOOST_AUTO_TEST_CASE(FindPrimitiveTest)
+{
+    auto table = MakeTable();
+    smpl::RobotState state = { 0.3, 0.2 };
+    BOOST_CHECK_EQUAL(table.findPrimitive(state, { { 0.3, 0.1 } }), 1);
+    BOOST_CHECK_EQUAL(table.findPrimitive(state, { { 0.4, 0.2 } }), 2);
+    BOOST_CHECK_EQUAL(table.findPrimitive(state, { { 0.5, 0.2 } }), -1);
+}
+
+BOOST_AUTO_TEST_CASE(StatusTest)
+{
+    auto table = MakeTable();
+    BOOST_CHECK_EQUAL(table.statusCount(smpl::PrimitiveCollisionTable::Unknown), 36);
+
+    table.setStatus(1, 5, smpl::PrimitiveCollisionTable::Free);
+    table.setStatus(2, 11, smpl::PrimitiveCollisionTable::Colliding);
+    BOOST_CHECK_EQUAL(table.status(1, 5), smpl::PrimitiveCollisionTable::Free);
+    BOOST_CHECK_EQUAL(table.status(2, 11), smpl::PrimitiveCollisionTable::Colliding);
+    BOOST_CHECK_EQUAL(table.status(1, 4), smpl::PrimitiveCollisionTable::Unknown);
+    BOOST_CHECK_EQUAL(table.status(1, 6), smpl::PrimitiveCollisionTable::Unknown);
+
+    table.setStatus(1, 5, smpl::PrimitiveCollisionTable::Unknown);
+    BOOST_CHECK_EQUAL(table.status(1, 5), smpl::PrimitiveCollisionTable::Unknown);
+}
+
+BOOST_AUTO_TEST_CASE(BuildTest)
+{
+    auto table = MakeTable();
+    FoldingChecker checker;
+    BOOST_REQUIRE(smpl::BuildPrimitiveCollisionTable(table, &checker, 16));
+
+    // a primitive that does not move the second joint is either entirely free
+    // or entirely in collision within each cell
+    for (int c = 0; c < table.cellCount(); ++c) {
+        auto expected = (c == 0 || c == table.cellCount() - 1) ?
+                smpl::PrimitiveCollisionTable::Colliding :
+                smpl::PrimitiveCollisionTable::Free;
+        BOOST_CHECK_EQUAL(table.status(2, c), expected);
+    }
+
+    // primitives that move toward the colliding cells may only be free in
+    // cells that they can not leave
+    for (int c = 0; c < table.cellCount(); ++c) {
+        if (table.status(0, c) == smpl::PrimitiveCollisionTable::Free) {
+            BOOST_CHECK_LT(c, table.cellCount() - 2);
+        }
+        if (table.status(1, c) == smpl::PrimitiveCollisionTable::Free) {
+            BOOST_CHECK_GT(c, 1);
+        }
+    }
+
+    // the middle of the range is free and the ends are in collision
+    BOOST_CHECK_EQUAL(table.status({ 0.0, 0.0 }, { { 0.1, 0.0 } }), smpl::PrimitiveCollisionTable::Free);
+    BOOST_CHECK_EQUAL(table.status({ 0.0, 3.0 }, { { 0.1, 3.0 } }), smpl::PrimitiveCollisionTable::Colliding);
+
+    printf("free: %d, colliding: %d, unknown: %d\n",
+            table.statusCount(smpl::PrimitiveCollisionTable::Free),
+            table.statusCount(smpl::PrimitiveCollisionTable::Colliding),
+            table.statusCount(smpl::PrimitiveCollisionTable::Unknown));
+}
+
+BOOST_AUTO_TEST_CASE(SaveLoadTest)
+{
+    auto table = MakeTable();
+    FoldingChecker checker;
+    BOOST_REQUIRE(smpl::BuildPrimitiveCollisionTable(table, &checker, 4));
+
+    auto path = "/tmp/primitive_collision_table_test.pct";
+    BOOST_REQUIRE(table.save(path));
+
+    smpl::PrimitiveCollisionTable loaded;
+    BOOST_REQUIRE(loaded.load(path));
+    std::remove(path);
+
+    BOOST_REQUIRE_EQUAL(loaded.cellCount(), table.cellCount());
+    BOOST_REQUIRE_EQUAL(loaded.primitiveCount(), table.primitiveCount());
+    for (int p = 0; p < table.primitiveCount(); ++p) {
+        BOOST_CHECK(loaded.primitive(p) == table.primitive(p));
+        for (int c = 0; c < table.cellCount(); ++c) {
+            BOOST_CHECK_EQUAL(loaded.status(p, c), table.status(p, c));
+        }
+    }
+}
+
+class JointModel : public smpl::RobotModel
+{
+public:
+
+    JointModel() { setPlanningJoints({ "j0" }); }
+
+    double minPosLimit(int vidx) const override { return -1.0; }
+    double maxPosLimit(int vidx) const override { return 1.0; }
+    bool hasPosLimit(int vidx) const override { return true; }
+    bool isContinuous(int vidx) const override { return false; }
+    double velLimit(int vidx) const override { return 0.0; }
+    double accLimit(int vidx) const override { return 0.0; }
+
+    bool checkJointLimits(const smpl::RobotState& state, bool) override
+    {
+        return state[0] >= -1.0 - 1e-9 && state[0] <= 1.0 + 1e-9;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::RobotModel>()) {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+// A single joint in self collision at positions above 0.25, with no world
+// obstacles
+class JointSelfChecker :
+    public smpl::CollisionChecker,
+    public smpl::SelfCollisionCheckerExtension
+{
+public:
+
+    bool isStateValid(const smpl::RobotState& state, bool) override
+    {
+        return isStateSelfValid(state, false);
+    }
+
+    bool isStateToStateValid(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        bool) override
+    {
+        return isStateToStateSelfValid(start, finish, false);
+    }
+
+    bool interpolatePath(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        std::vector<smpl::RobotState>& path) override
+    {
+        path = { start, finish };
+        return true;
+    }
+
+    bool isStateSelfValid(const smpl::RobotState& state, bool) override
+    {
+        return state[0] <= 0.25;
+    }
+
+    bool isStateToStateSelfValid(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        bool) override
+    {
+        return std::max(start[0], finish[0]) <= 0.25;
+    }
+
+    bool isStateWorldValid(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    bool isStateToStateWorldValid(
+        const smpl::RobotState&,
+        const smpl::RobotState&,
+        bool) override
+    {
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::CollisionChecker>() ||
+            class_code == smpl::GetClassCode<smpl::SelfCollisionCheckerExtension>())
+        {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(ExtractPathRechecksFreeMotionsTest)
+{
+    JointModel model;
+    JointSelfChecker checker;
+    smpl::ManipLattice space;
+    smpl::ManipLatticeActionSpace actions;
+    BOOST_REQUIRE(space.init(&model, &checker, { 0.1 }, &actions));
+    BOOST_REQUIRE(actions.init(&space));
+    actions.addMotionPrim({ 0.1 }, false);
+
+    // a table that wrongly certifies every motion free of self collisions, as
+    // may happen when a cell is sampled too sparsely
+    smpl::PrimitiveCollisionTable table;
+    BOOST_REQUIRE(table.init({ -1.0 }, { 1.0 }, { false }, { 4 }));
+    table.addPrimitive({ { 0.1 } });
+    table.addPrimitive({ { -0.1 } });
+    for (int p = 0; p < table.primitiveCount(); ++p) {
+        for (int c = 0; c < table.cellCount(); ++c) {
+            table.setStatus(p, c, smpl::PrimitiveCollisionTable::Free);
+        }
+    }
+    space.setPrimitiveCollisionTable(&table);
+
+    smpl::GoalConstraint goal;
+    goal.type = smpl::GoalType::JOINT_STATE_GOAL;
+    goal.angles = { 0.8 };
+    goal.angle_tolerances = { 0.05 };
+    BOOST_REQUIRE(space.setGoal(goal));
+    BOOST_REQUIRE(space.setStart({ 0.2 }));
+
+    // the search trusts the table and generates the colliding successor...
+    auto start_id = space.getStartStateID();
+    std::vector<int> succs, costs;
+    space.GetSuccs(start_id, &succs, &costs);
+    auto up_id = -1;
+    for (auto succ_id : succs) {
+        if (succ_id != space.getGoalStateID() &&
+            std::fabs(space.extractState(succ_id)[0] - 0.3) < 1e-6)
+        {
+            up_id = succ_id;
+        }
+    }
+    BOOST_REQUIRE_GE(up_id, 0);
+
+    // ...but the path through it is rejected during extraction
+    std::vector<smpl::RobotState> path;
+    BOOST_CHECK(!space.extractPath({ start_id, up_id }, path));
+
+    // without the table, the successor is never generated
+    space.setPrimitiveCollisionTable(nullptr);
+    succs.clear();
+    costs.clear();
+    space.GetSuccs(start_id, &succs, &costs);
+    BOOST_CHECK(std::find(succs.begin(), succs.end(), up_id) == succs.end());
+}
+
+BOOST_AUTO_TEST_CASE(CollidingMotionsAreCheckedTest)
+{
+    JointModel model;
+    JointSelfChecker checker;
+    smpl::ManipLattice space;
+    smpl::ManipLatticeActionSpace actions;
+    BOOST_REQUIRE(space.init(&model, &checker, { 0.1 }, &actions));
+    BOOST_REQUIRE(actions.init(&space));
+    actions.addMotionPrim({ 0.1 }, false);
+
+    // a table that wrongly classifies every motion as in self collision
+    smpl::PrimitiveCollisionTable table;
+    BOOST_REQUIRE(table.init({ -1.0 }, { 1.0 }, { false }, { 4 }));
+    table.addPrimitive({ { 0.1 } });
+    table.addPrimitive({ { -0.1 } });
+    for (int p = 0; p < table.primitiveCount(); ++p) {
+        for (int c = 0; c < table.cellCount(); ++c) {
+            table.setStatus(p, c, smpl::PrimitiveCollisionTable::Colliding);
+        }
+    }
+    space.setPrimitiveCollisionTable(&table);
+
+    smpl::GoalConstraint goal;
+    goal.type = smpl::GoalType::JOINT_STATE_GOAL;
+    goal.angles = { -0.8 };
+    goal.angle_tolerances = { 0.05 };
+    BOOST_REQUIRE(space.setGoal(goal));
+    BOOST_REQUIRE(space.setStart({ 0.2 }));
+
+    // the valid successor is still generated, and the invalid one is not
+    auto start_id = space.getStartStateID();
+    std::vector<int> succs, costs;
+    space.GetSuccs(start_id, &succs, &costs);
+    auto down = false;
+    auto up = false;
+    for (auto succ_id : succs) {
+        if (succ_id == space.getGoalStateID()) {
+            continue;
+        }
+        auto& state = space.extractState(succ_id);
+        down |= std::fabs(state[0] - 0.1) < 1e-6;
+        up |= std::fabs(state[0] - 0.3) < 1e-6;
+    }
+    BOOST_CHECK(down);
+    BOOST_CHECK(!up);
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE SO3GridTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/angles.h>
+#include <smpl/spatial.h>
+#include <smpl/geometry/so3_grid.h>
+
+using smpl::geometry::SO3Grid;
+
+static double Distance(const smpl::Quaternion& a, const smpl::Quaternion& b)
+{
+    return 2.0 * std::acos(std::min(1.0, std::fabs(a.dot(b))));
+}
+
+static auto RandomRotation(std::mt19937& rng) -> smpl::Quaternion
+{
+    std::normal_distribution<double> n;
+    smpl::Quaternion q(n(rng), n(rng), n(rng), n(rng));
+    q.normalize();
+    return q;
+}
+
+BOOST_AUTO_TEST_CASE(HealpixRoundTripTest)
+{
+    for (int nside = 1; nside <= 8; ++nside) {
+        for (int pix = 0; pix < 12 * nside * nside; ++pix) {
+            double theta, phi;
+            smpl::geometry::HealpixPixelToAngle(nside, pix, &theta, &phi);
+            BOOST_REQUIRE_EQUAL(smpl::geometry::HealpixAngleToPixel(nside, theta, phi), pix);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CellCentersTest)
+{
+    for (int nside = 1; nside <= 4; ++nside) {
+        SO3Grid grid;
+        grid.initNSide(nside);
+        BOOST_REQUIRE_EQUAL(grid.cellCount(), 72 * nside * nside * nside);
+        for (int i = 0; i < grid.cellCount(); ++i) {
+            BOOST_REQUIRE_EQUAL(grid.cellIndex(grid.cellCenter(i)), i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NeighborsTest)
+{
+    SO3Grid grid;
+    grid.initNSide(4);
+
+    for (int i = 0; i < grid.cellCount(); ++i) {
+        BOOST_REQUIRE_GT(grid.neighborCount(i), 0);
+        for (auto* n = grid.neighborsBegin(i); n != grid.neighborsEnd(i); ++n) {
+            BOOST_REQUIRE_NE(*n, i);
+            BOOST_REQUIRE(std::find(grid.neighborsBegin(*n), grid.neighborsEnd(*n), i) != grid.neighborsEnd(*n));
+        }
+    }
+
+    // every cell is reachable from every other cell through its neighbors
+    std::vector<bool> visited(grid.cellCount(), false);
+    std::deque<int> open = { 0 };
+    visited[0] = true;
+    int count = 1;
+    while (!open.empty()) {
+        auto i = open.front();
+        open.pop_front();
+        for (auto* n = grid.neighborsBegin(i); n != grid.neighborsEnd(i); ++n) {
+            if (!visited[*n]) {
+                visited[*n] = true;
+                ++count;
+                open.push_back(*n);
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(count, grid.cellCount());
+}
+
+BOOST_AUTO_TEST_CASE(NearestCellTest)
+{
+    SO3Grid grid;
+    grid.init(0.5);
+    BOOST_REQUIRE_LE(grid.resolution(), 0.5);
+
+    std::mt19937 rng(1);
+    for (int i = 0; i < 1000; ++i) {
+        auto q = RandomRotation(rng);
+        auto best = 0;
+        for (int j = 1; j < grid.cellCount(); ++j) {
+            if (Distance(q, grid.cellCenter(j)) < Distance(q, grid.cellCenter(best))) {
+                best = j;
+            }
+        }
+        auto d = Distance(q, grid.cellCenter(grid.cellIndex(q)));
+        BOOST_REQUIRE_LE(d, grid.resolution());
+        BOOST_REQUIRE_LE(d - Distance(q, grid.cellCenter(best)), 0.25 * grid.resolution());
+    }
+}
+
+// Compare the quantization error of the uniform grid against independent
+// roll, pitch, and yaw bins, as used by WorkspaceLatticeBase, with a similar
+// number of cells
+BOOST_AUTO_TEST_CASE(QuantizationErrorBenchmark)
+{
+    const int num_samples = 100000;
+
+    SO3Grid grid;
+    grid.initNSide(6);
+
+    const int R_count = 36, P_count = 19, Y_count = 36;
+    const double res_R = 2.0 * M_PI / R_count;
+    const double res_P = M_PI / (P_count - 1);
+    const double res_Y = 2.0 * M_PI / Y_count;
+
+    std::mt19937 rng(1);
+    double grid_max = 0.0, grid_sum = 0.0;
+    double euler_max = 0.0, euler_sum = 0.0;
+    for (int i = 0; i < num_samples; ++i) {
+        auto q = RandomRotation(rng);
+
+        auto d = Distance(q, grid.cellCenter(grid.cellIndex(q)));
+        grid_max = std::max(grid_max, d);
+        grid_sum += d;
+
+        double y, p, r;
+        smpl::get_euler_zyx(q, y, p, r);
+        auto gr = (int)std::round(smpl::angles::normalize_angle_positive(r) / res_R) % R_count;
+        auto gp = (int)std::round((p + 0.5 * M_PI) / res_P);
+        auto gy = (int)std::round(smpl::angles::normalize_angle_positive(y) / res_Y) % Y_count;
+        smpl::Quaternion c;
+        smpl::from_euler_zyx(gy * res_Y, -0.5 * M_PI + gp * res_P, gr * res_R, c);
+        d = Distance(q, c);
+        euler_max = std::max(euler_max, d);
+        euler_sum += d;
+    }
+
+    printf("uniform: %6d cells, max error %0.3f, mean error %0.3f\n",
+            grid.cellCount(), grid_max, grid_sum / num_samples);
+    printf("euler:   %6d cells, max error %0.3f, mean error %0.3f\n",
+            R_count * P_count * Y_count, euler_max, euler_sum / num_samples);
+
+    BOOST_CHECK_LT(grid.cellCount(), R_count * P_count * Y_count);
+    BOOST_CHECK_LT(grid_max, euler_max);
+}
@@ -0,0 +1,98 @@
+#include <vector>
+
+#define BOOST_TEST_MODULE SparseBfsHeuristicTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/occupancy_grid.h>
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/heuristic/sparse_bfs_heuristic.h>
+
+static const double kRes = 0.02;
+
+// cell centers of a closed box shell, one cell thick, enclosing a pocket of
+// free cells
+static auto MakeShell(int x0, int y0, int z0, int size)
+    -> std::vector<Eigen::Vector3d>
+{
+    std::vector<Eigen::Vector3d> points;
+    for (int x = x0; x < x0 + size; ++x) {
+    for (int y = y0; y < y0 + size; ++y) {
+    for (int z = z0; z < z0 + size; ++z) {
+        if (x == x0 || x == x0 + size - 1 ||
+            y == y0 || y == y0 + size - 1 ||
+            z == z0 || z == z0 + size - 1)
+        {
+            points.emplace_back(
+                    (x + 0.5) * kRes, (y + 0.5) * kRes, (z + 0.5) * kRes);
+        }
+    }
+    }
+    }
+    return points;
+}
+
+static auto MakeGoal(double x, double y, double z) -> smpl::GoalConstraint
+{
+    smpl::GoalConstraint goal;
+    goal.type = smpl::GoalType::XYZ_GOAL;
+    goal.pose = smpl::Affine3(smpl::Translation3(x, y, z));
+    return goal;
+}
+
+struct SparseBfsFixture
+{
+    // 100 x 100 x 50 cells, with a shell enclosing 7 x 7 x 7 cells far from
+    // the goal
+    smpl::OccupancyGrid grid { 2.0, 2.0, 1.0, kRes, 0.0, 0.0, 0.0, 0.2, false };
+    smpl::ManipLattice space;
+    smpl::SparseBfsHeuristic h;
+
+    SparseBfsFixture()
+    {
+        grid.addPointsToField(MakeShell(80, 80, 21, 9));
+        BOOST_REQUIRE(h.init(&space, &grid));
+        h.updateGoal(MakeGoal((10 + 0.5) * kRes, (10 + 0.5) * kRes, (25 + 0.5) * kRes));
+    }
+
+    static double cellCenter(int i) { return (i + 0.5) * kRes; }
+
+    double distance(int x, int y, int z)
+    {
+        return h.getMetricGoalDistance(cellCenter(x), cellCenter(y), cellCenter(z));
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(FreeQueryTest, SparseBfsFixture)
+{
+    BOOST_CHECK_CLOSE(distance(15, 10, 25), 5 * kRes, 1e-6);
+    BOOST_CHECK_CLOSE(distance(15, 13, 22), 5 * kRes, 1e-6);
+
+    // only the neighborhood of the goal is discovered
+    BOOST_CHECK_LT(h.discoveredCellCount(), 2000);
+}
+
+BOOST_FIXTURE_TEST_CASE(WallQueryTest, SparseBfsFixture)
+{
+    BOOST_CHECK_GT(distance(80, 84, 25), 1000.0);
+
+    // the wavefront is not advanced toward the wall
+    BOOST_CHECK_EQUAL(h.discoveredCellCount(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(DisconnectedQueryTest, SparseBfsFixture)
+{
+    BOOST_CHECK_GT(distance(84, 84, 25), 1000.0);
+
+    // the wavefront is advanced only while the pocket is flood filled, far
+    // short of the 500000 cells in the grid
+    auto discovered = h.discoveredCellCount();
+    BOOST_CHECK_LT(discovered, 25000);
+
+    // the remaining cells of the pocket are remembered as unreachable
+    BOOST_CHECK_GT(distance(82, 86, 23), 1000.0);
+    BOOST_CHECK_EQUAL(h.discoveredCellCount(), discovered);
+
+    // cells outside the shell remain reachable
+    BOOST_CHECK_LT(distance(78, 84, 25), 1000.0);
+}
@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define BOOST_TEST_MODULE TimedManipLatticeTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/collision_checker.h>
+#include <smpl/robot_model.h>
+#include <smpl/graph/manip_lattice.h>
+#include <smpl/graph/manip_lattice_action_space.h>
+#include <smpl/heuristic/joint_dist_heuristic.h>
+#include <smpl/search/arastar.h>
+
+static const double kRes = 0.1;
+static const double kActionDuration = 0.1;
+
+class JointModel : public smpl::RobotModel
+{
+public:
+
+    JointModel() { setPlanningJoints({ "j0" }); }
+
+    double minPosLimit(int vidx) const override { return -1.0; }
+    double maxPosLimit(int vidx) const override { return 1.0; }
+    bool hasPosLimit(int vidx) const override { return true; }
+    bool isContinuous(int vidx) const override { return false; }
+    double velLimit(int vidx) const override { return 0.0; }
+    double accLimit(int vidx) const override { return 0.0; }
+
+    bool checkJointLimits(const smpl::RobotState& state, bool) override
+    {
+        return state[0] >= -1.0 - 1e-9 && state[0] <= 1.0 + 1e-9;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::RobotModel>()) {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+// an obstacle that sweeps through the positions above 0.05 between 0.15 and
+// 0.35 seconds
+class TimedChecker :
+    public smpl::CollisionChecker,
+    public smpl::TimedCollisionCheckerExtension
+{
+public:
+
+    bool isStateValid(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    bool isStateToStateValid(
+        const smpl::RobotState&,
+        const smpl::RobotState&,
+        bool) override
+    {
+        return true;
+    }
+
+    bool interpolatePath(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        std::vector<smpl::RobotState>& path) override
+    {
+        path = { start, finish };
+        return true;
+    }
+
+    bool hasTimedObstacles() override
+    {
+        return true;
+    }
+
+    bool isStateValidAtTime(
+        const smpl::RobotState& state,
+        double time,
+        bool) override
+    {
+        return !(state[0] > 0.05 && time >= 0.15 && time < 0.35);
+    }
+
+    bool isStateToStateValidAtTime(
+        const smpl::RobotState& start,
+        double start_time,
+        const smpl::RobotState& finish,
+        double finish_time,
+        bool) override
+    {
+        if (std::max(start[0], finish[0]) <= 0.05) {
+            return true;
+        }
+        return finish_time <= 0.15 || start_time >= 0.35;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::CollisionChecker>() ||
+            class_code == smpl::GetClassCode<smpl::TimedCollisionCheckerExtension>())
+        {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+struct TimedLatticeFixture
+{
+    JointModel model;
+    TimedChecker checker;
+    smpl::ManipLattice space;
+    smpl::ManipLatticeActionSpace actions;
+
+    TimedLatticeFixture()
+    {
+        std::vector<double> res = { kRes };
+        BOOST_REQUIRE(space.init(&model, &checker, res, &actions));
+        BOOST_REQUIRE(actions.init(&space));
+        actions.addMotionPrim({ kRes }, false);
+        space.setActionDuration(kActionDuration);
+
+        smpl::GoalConstraint goal;
+        goal.type = smpl::GoalType::JOINT_STATE_GOAL;
+        goal.angles = { 0.8 };
+        goal.angle_tolerances = { 0.05 };
+        BOOST_REQUIRE(space.setGoal(goal));
+        BOOST_REQUIRE(space.setStart({ 0.0 }));
+    }
+
+    // return the id of the successor of a state at a position
+    int successor(int state_id, double position)
+    {
+        std::vector<int> succs, costs;
+        space.GetSuccs(state_id, &succs, &costs);
+        for (auto succ_id : succs) {
+            if (succ_id == space.getGoalStateID()) {
+                continue;
+            }
+            if (std::fabs(space.extractState(succ_id)[0] - position) < 1e-6) {
+                return succ_id;
+            }
+        }
+        return -1;
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(StatesDistinguishedByStepTest, TimedLatticeFixture)
+{
+    auto start_id = space.getStartStateID();
+
+    // reached directly from the start, arriving at 0.1 seconds, before the
+    // obstacle arrives
+    auto up_id = successor(start_id, kRes);
+    BOOST_REQUIRE_GE(up_id, 0);
+
+    // returning to the start position after a detour reaches a different
+    // state, from which the same motion runs into the obstacle
+    auto down_id = successor(start_id, -kRes);
+    BOOST_REQUIRE_GE(down_id, 0);
+    auto back_id = successor(down_id, 0.0);
+    BOOST_REQUIRE_GE(back_id, 0);
+    BOOST_CHECK_NE(back_id, start_id);
+    BOOST_CHECK_EQUAL(successor(back_id, kRes), -1);
+
+    // once the obstacle has passed, the motion is valid again
+    auto down2_id = successor(back_id, -kRes);
+    BOOST_REQUIRE_GE(down2_id, 0);
+    auto back2_id = successor(down2_id, 0.0);
+    BOOST_REQUIRE_GE(back2_id, 0);
+    auto up2_id = successor(back2_id, kRes);
+    BOOST_REQUIRE_GE(up2_id, 0);
+    BOOST_CHECK_NE(up2_id, up_id);
+
+    // paths through the generated successors are valid during extraction
+    std::vector<smpl::RobotState> path;
+    BOOST_CHECK(space.extractPath({ start_id, up_id }, path));
+    BOOST_CHECK_EQUAL(path.size(), 2);
+    BOOST_CHECK(space.extractPath(
+            { start_id, down_id, back_id, down2_id, back2_id, up2_id }, path));
+    BOOST_CHECK_EQUAL(path.size(), 6);
+}
+
+BOOST_FIXTURE_TEST_CASE(GoalTransitionAtStateTimeTest, TimedLatticeFixture)
+{
+    smpl::GoalConstraint goal;
+    goal.type = smpl::GoalType::JOINT_STATE_GOAL;
+    goal.angles = { kRes };
+    goal.angle_tolerances = { 0.05 };
+    BOOST_REQUIRE(space.setGoal(goal));
+
+    auto start_id = space.getStartStateID();
+    auto goal_id = space.getGoalStateID();
+    auto down_id = successor(start_id, -kRes);
+    BOOST_REQUIRE_GE(down_id, 0);
+    auto back_id = successor(down_id, 0.0);
+    BOOST_REQUIRE_GE(back_id, 0);
+
+    std::vector<int> succs, costs;
+    space.GetSuccs(start_id, &succs, &costs);
+    BOOST_CHECK(std::find(succs.begin(), succs.end(), goal_id) != succs.end());
+    succs.clear();
+    costs.clear();
+    space.GetSuccs(back_id, &succs, &costs);
+    BOOST_CHECK(std::find(succs.begin(), succs.end(), goal_id) == succs.end());
+
+    std::vector<smpl::RobotState> path;
+    BOOST_CHECK(space.extractPath({ start_id, goal_id }, path));
+}
+
+// The search must wait below the obstacle for it to pass, and the path it
+// finds must be valid when extracted
+BOOST_FIXTURE_TEST_CASE(PlanAroundTimedObstacleTest, TimedLatticeFixture)
+{
+    smpl::JointDistHeuristic h;
+    BOOST_REQUIRE(h.init(&space));
+    space.insertHeuristic(&h);
+    h.updateGoal(space.goal());
+
+    smpl::ARAStar search(&space, &h);
+    BOOST_REQUIRE(search.set_start(space.getStartStateID()));
+    BOOST_REQUIRE(search.set_goal(space.getGoalStateID()));
+
+    ReplanParams params(10.0);
+    params.initial_eps = 1.0;
+    params.final_eps = 1.0;
+    params.return_first_solution = true;
+
+    std::vector<int> solution;
+    int cost;
+    BOOST_REQUIRE(search.replan(&solution, params, &cost));
+
+    std::vector<smpl::RobotState> path;
+    BOOST_REQUIRE(space.extractPath(solution, path));
+    for (size_t i = 1; i < path.size(); ++i) {
+        BOOST_CHECK(checker.isStateToStateValidAtTime(
+                path[i - 1], (double)(i - 1) * kActionDuration,
+                path[i], (double)i * kActionDuration,
+                false));
+    }
+    BOOST_CHECK_LE(std::fabs(path.back()[0] - 0.8), 0.05);
+
+    space.eraseHeuristic(&h);
+}
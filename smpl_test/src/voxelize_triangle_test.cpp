@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE VoxelizeTriangleTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/geometry/utils.h>
+#include <smpl/geometry/voxel_grid.h>
+#include <smpl/geometry/voxelize.h>
+
+namespace geometry = smpl::geometry;
+
+static const double kRes = 0.02;
+
+// The triangle voxelization before columns were clipped to the slab around
+// the triangle's plane: every voxel in the bounding box of the triangle is
+// tested
+static void ReferenceVoxelizeTriangle(
+    const smpl::Vector3& a,
+    const smpl::Vector3& b,
+    const smpl::Vector3& c,
+    geometry::PivotVoxelGrid& vg)
+{
+    smpl::Vector3 p1 = a;
+    smpl::Vector3 p2 = b;
+    smpl::Vector3 p3 = c;
+
+    double det = ((p2 - p1).cross(p3 - p1).norm());
+    if (det == 0) {
+        return;
+    }
+
+    double rc = sqrt(3.0) * 0.5 * vg.res().x();
+    double rc2 = rc * rc;
+
+    smpl::Vector3 u = p2 - p1;
+    smpl::Vector3 v = p3 - p2;
+    smpl::Vector3 w = p1 - p3;
+    smpl::Vector3 n = u.cross(v);
+    n.normalize();
+
+    double corners[] = {
+        smpl::Vector3(-0.5774, -0.5774, -0.5774).dot(n),
+        smpl::Vector3(-0.5774, -0.5774,  0.5774).dot(n),
+        smpl::Vector3(-0.5774,  0.5774, -0.5774).dot(n),
+        smpl::Vector3(-0.5774,  0.5774,  0.5774).dot(n),
+        smpl::Vector3( 0.5774, -0.5774, -0.5774).dot(n),
+        smpl::Vector3( 0.5774, -0.5774,  0.5774).dot(n),
+        smpl::Vector3( 0.5774,  0.5774, -0.5774).dot(n),
+        smpl::Vector3( 0.5774,  0.5774,  0.5774).dot(n)
+    };
+    double ca = *std::max_element(corners, corners + 8);
+    double t = rc * ca;
+    double d = -n.dot(p1);
+
+    smpl::Vector3 e1 = -u.cross(n);
+    e1.normalize();
+    smpl::Vector3 e2 = -v.cross(n);
+    e2.normalize();
+    smpl::Vector3 e3 = -w.cross(n);
+    e3.normalize();
+
+    double d1 = -e1.dot(p1);
+    double d2 = -e2.dot(p2);
+    double d3 = -e3.dot(p3);
+
+    smpl::Vector3 mintri = a.cwiseMin(b).cwiseMin(c);
+    smpl::Vector3 maxtri = a.cwiseMax(b).cwiseMax(c);
+    auto mingc = vg.worldToGrid(geometry::WorldCoord(mintri.x(), mintri.y(), mintri.z()));
+    auto maxgc = vg.worldToGrid(geometry::WorldCoord(maxtri.x(), maxtri.y(), maxtri.z()));
+
+    for (int gx = mingc.x; gx <= maxgc.x; gx++) {
+    for (int gy = mingc.y; gy <= maxgc.y; gy++) {
+    for (int gz = mingc.z; gz <= maxgc.z; gz++) {
+        geometry::GridCoord gc(gx, gy, gz);
+        if (vg[gc]) {
+            continue;
+        }
+
+        auto wc = vg.gridToWorld(gc);
+        smpl::Vector3 voxel_p(wc.x, wc.y, wc.z);
+
+        if ((voxel_p - p1).squaredNorm() <= rc2 ||
+            (voxel_p - p2).squaredNorm() <= rc2 ||
+            (voxel_p - p3).squaredNorm() <= rc2)
+        {
+            vg[gc] = 1;
+        } else if (
+                geometry::Distance(p1, p3, rc2, voxel_p) != -1.0 ||
+                geometry::Distance(p2, p3, rc2, voxel_p) != -1.0 ||
+                geometry::Distance(p3, p1, rc2, voxel_p) != -1.0)
+        {
+            vg[gc] = 1;
+        } else if (
+                smpl::utils::sign(n.dot(voxel_p) + (d + t)) !=
+                        smpl::utils::sign(n.dot(voxel_p) + (d - t)) &&
+                (e1.dot(voxel_p) + d1 > 0.0) &&
+                (e2.dot(voxel_p) + d2 > 0.0) &&
+                (e3.dot(voxel_p) + d3 > 0.0))
+        {
+            vg[gc] = 1;
+        }
+    }
+    }
+    }
+}
+
+static auto MakeGrid() -> geometry::PivotVoxelGrid
+{
+    return geometry::PivotVoxelGrid(
+            smpl::Vector3(-0.6, -0.6, -0.6),
+            smpl::Vector3(0.6, 0.6, 0.6),
+            smpl::Vector3(kRes, kRes, kRes),
+            smpl::Vector3::Zero(),
+            0);
+}
+
+// Voxelize a triangle with both algorithms and return the number of voxels on
+// which they disagree
+static int CountMismatches(
+    const smpl::Vector3& a,
+    const smpl::Vector3& b,
+    const smpl::Vector3& c)
+{
+    auto expected = MakeGrid();
+    ReferenceVoxelizeTriangle(a, b, c, expected);
+
+    auto actual = MakeGrid();
+    geometry::VoxelizeTriangle(a, b, c, actual);
+
+    int mismatches = 0;
+    int filled = 0;
+    for (int x = 0; x < expected.sizeX(); ++x) {
+    for (int y = 0; y < expected.sizeY(); ++y) {
+    for (int z = 0; z < expected.sizeZ(); ++z) {
+        geometry::MemoryCoord mc(x, y, z);
+        if (expected[mc]) {
+            ++filled;
+        }
+        if (expected[mc] != actual[mc]) {
+            ++mismatches;
+        }
+    }
+    }
+    }
+    BOOST_REQUIRE_GT(filled, 0);
+    return mismatches;
+}
+
+BOOST_AUTO_TEST_CASE(RandomTrianglesTest)
+{
+    std::default_random_engine rng;
+    std::uniform_real_distribution<double> dist(-0.5, 0.5);
+    for (int i = 0; i < 200; ++i) {
+        smpl::Vector3 a(dist(rng), dist(rng), dist(rng));
+        smpl::Vector3 b(dist(rng), dist(rng), dist(rng));
+        smpl::Vector3 c(dist(rng), dist(rng), dist(rng));
+        BOOST_CHECK_EQUAL(CountMismatches(a, b, c), 0);
+    }
+}
+
+// Triangles whose normals lie along a diagonal of the voxels, for which the
+// thickness of the triangle slightly exceeds the fill radius around its
+// vertices and edges, offset so that a layer of voxel centers lies between the
+// two
+BOOST_AUTO_TEST_CASE(DiagonalTrianglesTest)
+{
+    const smpl::Vector3 n = smpl::Vector3(1.0, 1.0, 1.0).normalized();
+    const double rc = std::sqrt(3.0) * 0.5 * kRes;
+    for (double scale : { 1.00001, 1.00004, 1.00008 }) {
+        smpl::Vector3 o = -scale * rc * n;
+        smpl::Vector3 a = o + smpl::Vector3(0.5, -0.25, -0.25);
+        smpl::Vector3 b = o + smpl::Vector3(-0.25, 0.5, -0.25);
+        smpl::Vector3 c = o + smpl::Vector3(-0.25, -0.25, 0.5);
+        BOOST_CHECK_EQUAL(CountMismatches(a, b, c), 0);
+    }
+}
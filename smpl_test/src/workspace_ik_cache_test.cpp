@@ -0,0 +1,82 @@
+#include <vector>
+
+#define BOOST_TEST_MODULE WorkspaceIKCacheTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/graph/workspace_ik_cache.h>
+
+static auto MakeCoord(int i) -> smpl::WorkspaceCoord
+{
+    return { i, 0, 0, 0, 0, 0, 0 };
+}
+
+static auto MakeState(int i) -> smpl::WorkspaceState
+{
+    return { 0.02 * i, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+}
+
+BOOST_AUTO_TEST_CASE(LookupTest)
+{
+    smpl::WorkspaceIKCache cache;
+
+    BOOST_CHECK(cache.lookup(MakeCoord(0), MakeState(0)) == nullptr);
+
+    smpl::RobotState solution = { 1.0, 2.0, 3.0 };
+    cache.insert(MakeCoord(0), MakeState(0), &solution);
+    cache.insert(MakeCoord(1), MakeState(1), nullptr);
+
+    auto* entry = cache.lookup(MakeCoord(0), MakeState(0));
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_CHECK(entry->valid);
+    BOOST_CHECK(entry->solution == solution);
+
+    // failures are cached too
+    entry = cache.lookup(MakeCoord(1), MakeState(1));
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_CHECK(!entry->valid);
+
+    // a different pose in the same cell misses
+    auto state = MakeState(0);
+    state[0] += 0.005;
+    BOOST_CHECK(cache.lookup(MakeCoord(0), state) == nullptr);
+    BOOST_CHECK(!cache.contains(MakeCoord(0), state));
+    BOOST_CHECK(cache.contains(MakeCoord(0), MakeState(0)));
+
+    BOOST_CHECK_EQUAL(cache.hitCount(), 2);
+    BOOST_CHECK_EQUAL(cache.missCount(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(EvictLeastRecentlyUsedTest)
+{
+    smpl::WorkspaceIKCache cache(3);
+
+    smpl::RobotState solution = { 0.0 };
+    for (int i = 0; i < 3; ++i) {
+        cache.insert(MakeCoord(i), MakeState(i), &solution);
+    }
+
+    // touch the oldest entry so that the second becomes least recently used
+    BOOST_CHECK(cache.lookup(MakeCoord(0), MakeState(0)) != nullptr);
+
+    cache.insert(MakeCoord(3), MakeState(3), &solution);
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+    BOOST_CHECK(cache.contains(MakeCoord(0), MakeState(0)));
+    BOOST_CHECK(!cache.contains(MakeCoord(1), MakeState(1)));
+    BOOST_CHECK(cache.contains(MakeCoord(2), MakeState(2)));
+    BOOST_CHECK(cache.contains(MakeCoord(3), MakeState(3)));
+
+    // replacing an entry does not grow the cache
+    cache.insert(MakeCoord(2), MakeState(2), nullptr);
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+    BOOST_CHECK(!cache.lookup(MakeCoord(2), MakeState(2))->valid);
+
+    cache.setCapacity(1);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK(cache.contains(MakeCoord(2), MakeState(2)));
+
+    cache.setCapacity(0);
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    cache.insert(MakeCoord(0), MakeState(0), &solution);
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+}
@@ -1,5 +1,6 @@
 #include <cmath>
 #include <chrono>
+#include <iostream>
 
 #include <smpl/collision_checker.h>
 #include <smpl/occupancy_grid.h>
@@ -8,10 +9,8 @@
 #include <smpl/console/console.h>
 #include <smpl/console/nonstd.h>
 #include <smpl/console/ansi.h>
-#include <smpl/graph/manip_lattice.h>
-#include <smpl/graph/manip_lattice_action_space.h>
-#include <smpl/heuristic/attractor_heuristic.h>
-#include <smpl/heuristic/joint_dist_heuristic.h>
+#include <smpl/graph/xytheta_lattice.h>
+#include <smpl/heuristic/dijkstra_2d_heuristic.h>
 
 template <class CharT, class Traits = std::char_traits<CharT>>
 auto donothing(std::basic_ostream<CharT, Traits>& o)
@@ -21,7 +20,7 @@ auto donothing(std::basic_ostream<CharT, Traits>& o)
 const bool g_colorize = true;
 #define COLOR(o, color) if (g_colorize) { o << (color); }
 
-/// \brief Defines a Robot Model for an (x, y) point robot
+/// \brief Defines a Robot Model for an (x, y, theta) mobile base
 ///
 /// RobotModel base: basic requirements (variable types and limits)
 ///
@@ -35,7 +34,7 @@ public:
 
     KinematicVehicleModel() : smpl::RobotModel(), smpl::ForwardKinematicsInterface()
     {
-        const std::vector<std::string> joint_names = { "x", "y" };
+        const std::vector<std::string> joint_names = { "x", "y", "theta" };
         setPlanningJoints(joint_names);
     }
 
@@ -43,7 +42,8 @@ public:
     ///@{
     Eigen::Affine3d computeFK(const smpl::RobotState& state) override
     {
-        return Eigen::Affine3d(Eigen::Translation3d(state[0], state[1], 0.0));
+        return Eigen::Translation3d(state[0], state[1], 0.0) *
+                Eigen::AngleAxisd(state[2], Eigen::Vector3d::UnitZ());
     }
     ///@}
 
@@ -52,7 +52,7 @@ public:
     double minPosLimit(int jidx) const override { return 0.0; }
     double maxPosLimit(int jidx) const override { return 0.0; }
     bool hasPosLimit(int jidx) const override { return false; }
-    bool isContinuous(int jidx) const override { return false; }
+    bool isContinuous(int jidx) const override { return jidx == 2; }
     double velLimit(int jidx) const override { return 0.0; }
     double accLimit(int jidx) const override { return 0.0; }
 
@@ -248,35 +248,6 @@ void PrintGrid(std::ostream& o, smpl::OccupancyGrid& grid)
     o << '\n';
 }
 
-void PrintActionSpace(const smpl::ManipLatticeActionSpace& aspace)
-{
-    SMPL_INFO("Action Set:");
-    for (int i = 0; i < smpl::MotionPrimitive::Type::NUMBER_OF_MPRIM_TYPES; ++i) {
-        smpl::MotionPrimitive::Type prim((smpl::MotionPrimitive::Type)i);
-        SMPL_INFO("  %s: %s @ %0.3f", to_cstring(prim), aspace.useAmp(prim) ? "true" : "false", aspace.ampThresh(prim));
-    }
-    for (auto ait = aspace.begin(); ait != aspace.end(); ++ait) {
-        SMPL_INFO("  type: %s", to_cstring(ait->type));
-        if (ait->type == smpl::MotionPrimitive::SNAP_TO_RPY) {
-            SMPL_INFO("    enabled: %s", aspace.useAmp(smpl::MotionPrimitive::SNAP_TO_RPY) ? "true" : "false");
-            SMPL_INFO("    thresh: %0.3f", aspace.ampThresh(smpl::MotionPrimitive::SNAP_TO_RPY));
-        }
-        else if (ait->type == smpl::MotionPrimitive::SNAP_TO_XYZ) {
-            SMPL_INFO("    enabled: %s", aspace.useAmp(smpl::MotionPrimitive::SNAP_TO_XYZ) ? "true" : "false");
-            SMPL_INFO("    thresh: %0.3f", aspace.ampThresh(smpl::MotionPrimitive::SNAP_TO_XYZ));
-        }
-        else if (ait->type == smpl::MotionPrimitive::SNAP_TO_XYZ_RPY) {
-            SMPL_INFO("    enabled: %s", aspace.useAmp(smpl::MotionPrimitive::SNAP_TO_XYZ_RPY) ? "true" : "false");
-            SMPL_INFO("    thresh: %0.3f", aspace.ampThresh(smpl::MotionPrimitive::SNAP_TO_XYZ_RPY));
-        }
-        else if (ait->type == smpl::MotionPrimitive::LONG_DISTANCE ||
-                ait->type == smpl::MotionPrimitive::SHORT_DISTANCE)
-        {
-            SMPL_INFO_STREAM("    action: " << ait->action);
-        }
-    }
-}
-
 void PrintSolution(
     std::ostream& o,
     const smpl::OccupancyGrid& grid,
@@ -336,14 +307,6 @@ void PrintSolution(
 
 int main(int argc, char* argv[])
 {
-    if (argc < 2) {
-        printf("Usage: xytheta <mprim filepath>\n");
-        return 1;
-    }
-
-    const char* mprim_path = argv[1];
-    SMPL_INFO("Load motion primitives from %s", mprim_path);
-
     // 1. Create Robot Model
     KinematicVehicleModel robot_model;
 
@@ -371,70 +334,55 @@ int main(int argc, char* argv[])
     // 3. Create Collision Checker
     GridCollisionChecker cc(&grid);
 
-    // 5. Create Action Space
-    smpl::ManipLatticeActionSpace actions;
-
-    // 6. Create Planning Space
-    smpl::ManipLattice space;
-
-    // 7. Initialize Manipulation Lattice with RobotModel, CollisionChecker,
-    // variable resolutions, and ActionSpace
-    std::vector<double> resolutions = { res, res };
-    if (!space.init(&robot_model, &cc, resolutions, &actions)) {
-        SMPL_ERROR("Failed to initialize Manip Lattice");
+    // 4. Create Planning Space. The lattice checks motions against the grid
+    // using the footprint cells swept by each of its motion primitives.
+    smpl::XYThetaLattice space;
+
+    // 5. Initialize the lattice with the RobotModel, CollisionChecker, the
+    // grid to plan in, and the properties of the vehicle
+    smpl::XYThetaLattice::Params params;
+    params.num_headings = 16;
+    params.min_turning_radius = 2.0 * res;
+    if (!space.init(&robot_model, &cc, &grid, params)) {
+        SMPL_ERROR("Failed to initialize XYTheta Lattice");
         return 1;
     }
 
-    space.setVisualizationFrameId("map"); // for correct rviz visualization
-
-    // 8. Initialize Manipulation Lattice Action Space
-
-    // associate actions with planning space
-    if (!actions.init(&space)) {
-        SMPL_ERROR("Failed to initialize Manip Lattice Action Space");
+    // 6. Create Heuristic
+    smpl::Dijkstra2DHeuristic h;
+    if (!h.init(&space, &grid)) {
+        SMPL_ERROR("Failed to initialize Dijkstra 2D Heuristic");
         return 1;
     }
+    h.setCostPerMeter(params.cost_per_meter);
 
-    // load primitives from file, whose path is stored on the param server
-    if (!actions.load(mprim_path)) {
-        return 1;
-    }
-//    PrintActionSpace(actions);
-
-    // 9. Create Heuristic
-    smpl::JointDistHeuristic h;
-    if (!h.init(&space)) {
-        SMPL_ERROR("Failed to initialize Joint Dist Heuristic");
-        return 1;
-    }
-
-    // 10. Associate Heuristic with Planning Space. In this case, Manip Lattice
-    // Action Space may use this to determine when to use adaptive motion
-    // primitives.
+    // 7. Associate Heuristic with Planning Space
     space.insertHeuristic(&h);
 
-    // 11. Create Search, associated with the planning space and heuristic
+    // 8. Create Search, associated with the planning space and heuristic
     smpl::ARAStar search(&space, &h);
 
-    // 12. Configure Search Behavior
+    // 9. Configure Search Behavior
     const double epsilon = 5.0;
     search.set_initialsolution_eps(epsilon);
     search.set_search_mode(false);
 
-    // 13. Set start state and goal condition in the Planning Space and
+    // 10. Set start state and goal condition in the Planning Space and
     // propagate state IDs to search
     double start_x = 0.5 * world_size_x;
     double start_y = 0.33 * world_size_y;
-    const smpl::RobotState start_state = space.getDiscreteCenter({ start_x, start_y });
+    const smpl::RobotState start_state =
+            space.getDiscreteCenter({ start_x, start_y, 0.0 });
 
     double goal_x = 0.5 * world_size_x;
     double goal_y = 0.66 * world_size_y;
-    const smpl::RobotState goal_state = space.getDiscreteCenter({ goal_x, goal_y });
+    const smpl::RobotState goal_state =
+            space.getDiscreteCenter({ goal_x, goal_y, M_PI });
 
     smpl::GoalConstraint goal;
     goal.type = smpl::GoalType::JOINT_STATE_GOAL;
     goal.angles = goal_state;
-    goal.angle_tolerances = { res, res };
+    goal.angle_tolerances = { res, res, M_PI / 8.0 };
 
     if (!space.setGoal(goal)) {
         SMPL_ERROR("Failed to set goal");
@@ -446,6 +394,8 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    h.updateGoal(space.goal());
+
     int start_id = space.getStartStateID();
     if (start_id < 0) {
         SMPL_ERROR("Start state id is invalid");
@@ -468,7 +418,7 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    // 14. Plan a path
+    // 11. Plan a path
 
     ReplanParams search_params(10.0);
     search_params.initial_eps = epsilon;
@@ -488,7 +438,7 @@ int main(int argc, char* argv[])
     auto now = std::chrono::high_resolution_clock::now();
     const double elapsed = std::chrono::duration<double>(now - then).count();
 
-    // 15. Extract path from Planning Space
+    // 12. Extract path from Planning Space
 
     std::vector<smpl::RobotState> path;
     if (!space.extractPath(solution, path)) {
@@ -500,15 +450,12 @@ int main(int argc, char* argv[])
     SMPL_INFO("  Expansion Count (total): %d", search.get_n_expands());
     SMPL_INFO("  Expansion Count (initial): %d", search.get_n_expands_init_solution());
     SMPL_INFO("  Solution (%zu)", solution.size());
-//    for (int id : solution) {
-//        SMPL_INFO("    %d", id);
-//    }
     SMPL_INFO("  Path (%zu)", path.size());
 
     PrintSolution(std::cout, grid, path);
 
 //    for (const smpl::RobotState& point : path) {
-//        SMPL_INFO("    (x: %0.3f, y: %0.3f)", point[0], point[1]);
+//        SMPL_INFO("    (x: %0.3f, y: %0.3f, theta: %0.3f)", point[0], point[1], point[2]);
 //    }
 
     return 0;
@@ -0,0 +1,252 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#define BOOST_TEST_MODULE XYThetaLatticeTest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <smpl/angles.h>
+#include <smpl/collision_checker.h>
+#include <smpl/occupancy_grid.h>
+#include <smpl/robot_model.h>
+#include <smpl/graph/xytheta_lattice.h>
+#include <smpl/heuristic/dijkstra_2d_heuristic.h>
+#include <smpl/search/arastar.h>
+
+class BaseModel : public smpl::RobotModel
+{
+public:
+
+    BaseModel() { setPlanningJoints({ "x", "y", "theta" }); }
+
+    double minPosLimit(int vidx) const override { return 0.0; }
+    double maxPosLimit(int vidx) const override { return 0.0; }
+    bool hasPosLimit(int vidx) const override { return false; }
+    bool isContinuous(int vidx) const override { return vidx == 2; }
+    double velLimit(int vidx) const override { return 0.0; }
+    double accLimit(int vidx) const override { return 0.0; }
+
+    bool checkJointLimits(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::RobotModel>()) {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+// collisions are checked by the lattice itself
+class NullChecker : public smpl::CollisionChecker
+{
+public:
+
+    bool isStateValid(const smpl::RobotState&, bool) override
+    {
+        return true;
+    }
+
+    bool isStateToStateValid(
+        const smpl::RobotState&,
+        const smpl::RobotState&,
+        bool) override
+    {
+        return true;
+    }
+
+    bool interpolatePath(
+        const smpl::RobotState& start,
+        const smpl::RobotState& finish,
+        std::vector<smpl::RobotState>& path) override
+    {
+        path = { start, finish };
+        return true;
+    }
+
+    Extension* getExtension(size_t class_code) override
+    {
+        if (class_code == smpl::GetClassCode<smpl::CollisionChecker>()) {
+            return this;
+        }
+        return nullptr;
+    }
+};
+
+static const double kRes = 0.05;
+
+// a 10m x 10m world with a wall across the middle and a 1m gap in it
+static auto MakeGrid() -> smpl::OccupancyGrid
+{
+    smpl::OccupancyGrid grid(10.0, 10.0, kRes, kRes, 0.0, 0.0, 0.0, 1.0, false);
+    std::vector<Eigen::Vector3d> points;
+    for (double x = 0.5 * kRes; x < 10.0; x += kRes) {
+        if (x > 6.0 && x < 7.0) {
+            continue;
+        }
+        points.emplace_back(x, 5.0, 0.0);
+    }
+    grid.addPointsToField(points);
+    return grid;
+}
+
+static auto MakeParams() -> smpl::XYThetaLattice::Params
+{
+    smpl::XYThetaLattice::Params params;
+    params.footprint = {
+        { -0.3, -0.2 }, { 0.3, -0.2 }, { 0.3, 0.2 }, { -0.3, 0.2 }
+    };
+    params.min_turning_radius = 0.3;
+    return params;
+}
+
+static auto MakeGoal(double x, double y, double theta) -> smpl::GoalConstraint
+{
+    smpl::GoalConstraint goal;
+    goal.type = smpl::GoalType::JOINT_STATE_GOAL;
+    goal.angles = { x, y, theta };
+    goal.angle_tolerances = { 0.1, 0.1, 0.5 };
+    return goal;
+}
+
+BOOST_AUTO_TEST_CASE(PrimitivesEndAtLatticeStatesTest)
+{
+    auto grid = MakeGrid();
+    BaseModel model;
+    NullChecker checker;
+    smpl::XYThetaLattice space;
+    BOOST_REQUIRE(space.init(&model, &checker, &grid, MakeParams()));
+
+    for (int h = 0; h < space.numHeadings(); ++h) {
+        auto& prims = space.primitives(h);
+
+        // short and long straight motions, two arcs, and two turns in place
+        BOOST_CHECK_EQUAL(prims.size(), 6);
+
+        for (auto& prim : prims) {
+            BOOST_REQUIRE(!prim.poses.empty());
+            BOOST_REQUIRE(!prim.cells.empty());
+            BOOST_CHECK_GT(prim.cost, 0);
+
+            auto& end = prim.poses.back();
+            BOOST_CHECK_SMALL(end.x - kRes * prim.dx, 1e-9);
+            BOOST_CHECK_SMALL(end.y - kRes * prim.dy, 1e-9);
+            BOOST_CHECK_SMALL(smpl::shortest_angle_diff(
+                    end.theta, space.headingAngle(prim.end_heading)), 1e-9);
+
+            // the swept cells cover the footprint at both ends of the motion
+            for (auto& cell : space.footprintCells(h)) {
+                BOOST_CHECK(std::find(prim.cells.begin(), prim.cells.end(), cell) != prim.cells.end());
+            }
+        }
+    }
+}
+
+static bool Plan(
+    smpl::XYThetaLattice& space,
+    smpl::ARAStar& search,
+    const smpl::RobotState& start,
+    const smpl::GoalConstraint& goal,
+    std::vector<smpl::RobotState>& path)
+{
+    space.clearStates();
+    search.force_planning_from_scratch_and_free_memory();
+    if (!space.setGoal(goal) || !space.setStart(start)) {
+        return false;
+    }
+    for (size_t i = 0; i < space.numHeuristics(); ++i) {
+        space.heuristic(i)->updateGoal(space.goal());
+    }
+    if (!search.set_start(space.getStartStateID()) ||
+        !search.set_goal(space.getGoalStateID()))
+    {
+        return false;
+    }
+
+    ReplanParams params(1.0);
+    params.initial_eps = 5.0;
+    params.final_eps = 5.0;
+    params.return_first_solution = true;
+
+    std::vector<int> solution;
+    int cost;
+    if (!search.replan(&solution, params, &cost)) {
+        return false;
+    }
+    return space.extractPath(solution, path);
+}
+
+BOOST_AUTO_TEST_CASE(PlanThroughGapTest)
+{
+    auto grid = MakeGrid();
+    BaseModel model;
+    NullChecker checker;
+    smpl::XYThetaLattice space;
+    BOOST_REQUIRE(space.init(&model, &checker, &grid, MakeParams()));
+
+    smpl::Dijkstra2DHeuristic h;
+    BOOST_REQUIRE(h.init(&space, &grid));
+    space.insertHeuristic(&h);
+
+    smpl::ARAStar search(&space, &h);
+
+    std::vector<smpl::RobotState> path;
+    BOOST_REQUIRE(Plan(space, search, { 2.0, 2.0, 0.0 }, MakeGoal(2.0, 8.0, M_PI), path));
+    BOOST_REQUIRE(path.size() > 2);
+
+    auto& last = path.back();
+    BOOST_CHECK_SMALL(last[0] - 2.0, 0.1 + 1e-9);
+    BOOST_CHECK_SMALL(last[1] - 8.0, 0.1 + 1e-9);
+
+    // the only way across the wall is through the gap
+    auto crossed = false;
+    for (size_t i = 1; i < path.size(); ++i) {
+        auto& a = path[i - 1];
+        auto& b = path[i];
+        BOOST_CHECK(grid.getDistanceFromPoint(b[0], b[1], 0.0) > 0.0);
+        if (a[1] < 5.0 && b[1] >= 5.0) {
+            BOOST_CHECK(b[0] > 6.0 && b[0] < 7.0);
+            crossed = true;
+        }
+    }
+    BOOST_CHECK(crossed);
+}
+
+BOOST_AUTO_TEST_CASE(QueryThroughputBenchmark)
+{
+    auto grid = MakeGrid();
+    BaseModel model;
+    NullChecker checker;
+    smpl::XYThetaLattice space;
+    BOOST_REQUIRE(space.init(&model, &checker, &grid, MakeParams()));
+
+    smpl::Dijkstra2DHeuristic h;
+    BOOST_REQUIRE(h.init(&space, &grid));
+    space.insertHeuristic(&h);
+
+    smpl::ARAStar search(&space, &h);
+
+    const int num_queries = 200;
+    int num_solved = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_queries; ++i) {
+        // short hops around the lower half of the world
+        double x = 1.0 + 0.04 * (i % 100);
+        double gx = x + 1.0;
+        std::vector<smpl::RobotState> path;
+        if (Plan(space, search, { x, 2.0, 0.0 }, MakeGoal(gx, 3.0, 0.5 * M_PI), path)) {
+            ++num_solved;
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    auto secs = std::chrono::duration<double>(finish - start).count();
+    printf("%d/%d queries solved, %0.1f queries/sec\n",
+            num_solved, num_queries, (double)num_queries / secs);
+
+    BOOST_CHECK_EQUAL(num_solved, num_queries);
+}
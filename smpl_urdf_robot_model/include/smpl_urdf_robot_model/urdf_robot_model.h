@@ -14,7 +14,8 @@ struct RobotModel;
 
 struct URDFRobotModel :
     public virtual smpl::RobotModel,
-    public virtual smpl::ForwardKinematicsInterface
+    public virtual smpl::ForwardKinematicsInterface,
+    public virtual smpl::CloneableForwardKinematicsInterface
 {
     struct VariableProperties
     {
@@ -48,6 +49,9 @@ struct URDFRobotModel :
         const smpl::RobotState& state,
         bool verbose = false) override;
 
+    auto cloneForwardKinematics()
+        -> std::unique_ptr<smpl::ForwardKinematicsInterface> override;
+
     auto getExtension(size_t class_code) -> smpl::Extension* override;
 };
 
@@ -144,10 +144,31 @@ bool URDFRobotModel::checkJointLimits(
     return true;
 }
 
+// The copy computes the forward kinematics of the planning link as this model
+// does; it shares the kinematic tree and starts from the current reference
+// state.
+auto URDFRobotModel::cloneForwardKinematics()
+    -> std::unique_ptr<smpl::ForwardKinematicsInterface>
+{
+    std::unique_ptr<URDFRobotModel> copy(new URDFRobotModel);
+    copy->setPlanningJoints(this->getPlanningJoints());
+    copy->robot_model = this->robot_model;
+    copy->vprops = this->vprops;
+    copy->planning_to_state_variable = this->planning_to_state_variable;
+    copy->planning_link = this->planning_link;
+    if (!InitRobotState(&copy->robot_state, this->robot_model)) {
+        return NULL;
+    }
+    SetVariablePositions(
+            &copy->robot_state, GetVariablePositions(&this->robot_state));
+    return std::move(copy);
+}
+
 auto URDFRobotModel::getExtension(size_t class_code) -> smpl::Extension*
 {
     if (class_code == smpl::GetClassCode<smpl::RobotModel>()) return this;
     if (class_code == smpl::GetClassCode<smpl::ForwardKinematicsInterface>()) return this;
+    if (class_code == smpl::GetClassCode<smpl::CloneableForwardKinematicsInterface>()) return this;
     return NULL;
 }
 